@@ -1,5 +1,5 @@
 #-------------------------------------------------------------------------------
-# Copyright (c) 2020-2024, Arm Limited. All rights reserved.
+# Copyright (c) 2020-2026, Arm Limited. All rights reserved.
 # Copyright (c) 2022-2023 Cypress Semiconductor Corporation (an Infineon company)
 # or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
 #
@@ -34,6 +34,7 @@ install(FILES       ${CMAKE_BINARY_DIR}/generated/interface/include/config_impl.
 
 install(FILES       ${INTERFACE_INC_DIR}/tfm_veneers.h
                     ${INTERFACE_INC_DIR}/tfm_ns_interface.h
+                    ${INTERFACE_INC_DIR}/tfm_psa_call_batch.h
         DESTINATION ${INSTALL_INTERFACE_INC_DIR})
 
 install(FILES       ${INTERFACE_INC_DIR}/tfm_ns_client_ext.h
@@ -71,6 +72,9 @@ if (TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
                         ${INTERFACE_INC_DIR}/psa/storage_common.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR}/psa)
     install(FILES       ${INTERFACE_INC_DIR}/tfm_its_defs.h
+                        ${INTERFACE_INC_DIR}/tfm_its_transaction.h
+                        ${INTERFACE_INC_DIR}/tfm_its_wear_stats.h
+                        ${INTERFACE_INC_DIR}/tfm_its_compact.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR})
 endif()
 
@@ -100,6 +104,8 @@ if (TFM_PARTITION_CRYPTO)
                         ${INTERFACE_INC_DIR}/psa/crypto_values.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR}/psa)
     install(FILES       ${INTERFACE_INC_DIR}/tfm_crypto_defs.h
+                        ${INTERFACE_INC_DIR}/tfm_crypto_batch.h
+                        ${INTERFACE_INC_DIR}/tfm_crypto_random.h
             DESTINATION ${INSTALL_INTERFACE_INC_DIR})
     install(DIRECTORY   ${INTERFACE_INC_DIR}/mbedtls
             DESTINATION ${INSTALL_INTERFACE_INC_DIR})
@@ -99,6 +99,8 @@ set(CONFIG_TFM_BRANCH_PROTECTION_FEAT   BRANCH_PROTECTION_DISABLED   CACHE STRIN
 ############################ Platform ##########################################
 
 set(NUM_MAILBOX_QUEUE_SLOT              1           CACHE BOOL      "Number of mailbox queue slots")
+set(NUM_SPE_MAILBOX_QUEUE_SLOT          ""          CACHE STRING    "Number of SPE mailbox queue slots. Same as NUM_MAILBOX_QUEUE_SLOT if empty")
+set(MAILBOX_RING_TRANSPORT              OFF         CACHE BOOL      "Whether to exchange mailbox requests and replies through lock-free rings instead of slot bitmaps")
 set(TFM_PLAT_SPECIFIC_MULTI_CORE_COMM   OFF         CACHE BOOL      "Whether to use a platform specific inter-core communication instead of mailbox in dual-cpu topology")
 
 set(DEBUG_AUTHENTICATION                CHIP_DEFAULT CACHE STRING   "Debug authentication setting. [CHIP_DEFAULT, NONE, NS_ONLY, FULL")
@@ -125,6 +127,7 @@ set(PLATFORM_DEFAULT_OTP                ON          CACHE BOOL      "Use trusted
 set(PLATFORM_DEFAULT_OTP_WRITEABLE      ON          CACHE BOOL      "Use OTP memory with write support")
 set(PLATFORM_DEFAULT_PROVISIONING       ON          CACHE BOOL      "Use default provisioning implementation")
 set(PLATFORM_DEFAULT_SYSTEM_RESET_HALT  ON          CACHE BOOL      "Use default system reset/halt implementation")
+set(PLATFORM_DEFAULT_TRACE_TIMER        ON          CACHE BOOL      "Use default DWT cycle counter for SPM tracing")
 set(PLATFORM_DEFAULT_IMAGE_SIGNING      ON          CACHE BOOL      "Use default image signing implementation")
 set(PLATFORM_DEFAULT_PROV_LINKER_SCRIPT ON          CACHE BOOL      "Use default provisioning linker script")
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2023-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -44,16 +44,53 @@
 #define CRYPTO_ENGINE_BUF_SIZE                 0x3000
 #endif
 
+/*
+ * Serve the crypto backend allocations from pools of fixed size blocks and an
+ * arena carved out of the CRYPTO_ENGINE_BUF_SIZE buffer instead of the Mbed TLS
+ * allocator
+ */
+#ifndef CRYPTO_ENGINE_BUF_POOLS
+#define CRYPTO_ENGINE_BUF_POOLS                0
+#endif
+
+/*
+ * Size classes of the crypto backend pools, as {block size, number of blocks}
+ * by increasing block size. The rest of the buffer is the arena.
+ */
+#ifndef CRYPTO_ENGINE_BUF_POOL_CLASSES
+#define CRYPTO_ENGINE_BUF_POOL_CLASSES         {32, 16}, {64, 16}, {128, 8}, \
+                                               {256, 4}
+#endif
+
 /* The max number of concurrent operations that can be active (allocated) at any time in Crypto */
 #ifndef CRYPTO_CONC_OPER_NUM
 #define CRYPTO_CONC_OPER_NUM                   8
 #endif
 
+/* The max number of concurrent operations that a single client can have active
+ * at any time in Crypto, 0 for no limit other than CRYPTO_CONC_OPER_NUM
+ */
+#ifndef CRYPTO_CONC_OPER_PER_CLIENT_NUM
+#define CRYPTO_CONC_OPER_PER_CLIENT_NUM        0
+#endif
+
 /* Enable PSA Crypto random number generator module */
 #ifndef CRYPTO_RNG_MODULE_ENABLED
 #define CRYPTO_RNG_MODULE_ENABLED              1
 #endif
 
+/* The size of the pool of random bytes generated in advance, from which the
+ * small random number requests are served, 0 to call the DRBG on each request
+ */
+#ifndef CRYPTO_RNG_POOL_SIZE
+#define CRYPTO_RNG_POOL_SIZE                   0
+#endif
+
+/* The largest random number request served from the pool */
+#ifndef CRYPTO_RNG_POOL_MAX_REQUEST
+#define CRYPTO_RNG_POOL_MAX_REQUEST            32
+#endif
+
 /* Enable PSA Crypto Key module */
 #ifndef CRYPTO_KEY_MODULE_ENABLED
 #define CRYPTO_KEY_MODULE_ENABLED              1
@@ -84,6 +121,13 @@
 #define CRYPTO_ASYM_SIGN_MODULE_ENABLED        1
 #endif
 
+/* Enable the PSA Crypto interruptible sign and verify hash functions, which
+ * split an ECDSA operation into calls of a bounded number of basic operations
+ */
+#ifndef CRYPTO_ASYM_SIGN_INTERRUPTIBLE
+#define CRYPTO_ASYM_SIGN_INTERRUPTIBLE         0
+#endif
+
 /* Enable PSA Crypto asymmetric key encryption module */
 #ifndef CRYPTO_ASYM_ENCRYPT_MODULE_ENABLED
 #define CRYPTO_ASYM_ENCRYPT_MODULE_ENABLED     1
@@ -94,6 +138,11 @@
 #define CRYPTO_KEY_DERIVATION_MODULE_ENABLED   1
 #endif
 
+/* Enable the TF-M Crypto batch module, running several commands in one call */
+#ifndef CRYPTO_BATCH_MODULE_ENABLED
+#define CRYPTO_BATCH_MODULE_ENABLED            0
+#endif
+
 /* Default size of the internal scratch buffer used for PSA FF IOVec allocations */
 #ifndef CRYPTO_IOVEC_BUFFER_SIZE
 #define CRYPTO_IOVEC_BUFFER_SIZE               5120
@@ -180,6 +229,41 @@
 #define ITS_VALIDATE_METADATA_FROM_FLASH       1
 #endif
 
+/* Keep a RAM index of file IDs to avoid scanning the metadata table in flash */
+#ifndef ITS_RAM_FILE_INDEX
+#define ITS_RAM_FILE_INDEX                     0
+#endif
+
+/* Size in bytes of the metadata journal area of the metadata block, 0 to disable */
+#ifndef ITS_METADATA_JOURNAL_SIZE
+#define ITS_METADATA_JOURNAL_SIZE              0
+#endif
+
+/* Difference of erase counts which triggers wear leveling, 0 to disable */
+#ifndef ITS_WEAR_LEVELING_THRESHOLD
+#define ITS_WEAR_LEVELING_THRESHOLD            0
+#endif
+
+/* Maximum number of filesystem blocks of which the erases are counted */
+#ifndef ITS_WEAR_LEVELING_MAX_BLOCKS
+#define ITS_WEAR_LEVELING_MAX_BLOCKS           32
+#endif
+
+/* Only mark deleted files, and compact the data blocks when idle or when the space is needed */
+#ifndef ITS_DEFERRED_COMPACTION
+#define ITS_DEFERRED_COMPACTION                0
+#endif
+
+/* Number of flash lines cached in RAM by the NOR and NAND back ends, 0 to disable */
+#ifndef ITS_FLASH_CACHE_LINES
+#define ITS_FLASH_CACHE_LINES                  0
+#endif
+
+/* Size in bytes of a flash cache line and of the NOR write combining buffer */
+#ifndef ITS_FLASH_CACHE_LINE_SIZE
+#define ITS_FLASH_CACHE_LINE_SIZE              64
+#endif
+
 /* The maximum asset size to be stored in the Internal Trusted Storage */
 #ifndef ITS_MAX_ASSET_SIZE
 #define ITS_MAX_ASSET_SIZE                     512
@@ -198,6 +282,28 @@
 #define ITS_NUM_ASSETS                         10
 #endif
 
+/* The maximum number of changes in an ITS transaction, 0 to disable transactions */
+#ifndef ITS_TRANSACTION_MAX_OPS
+#define ITS_TRANSACTION_MAX_OPS                0
+#endif
+
+/* Size of the buffer holding the data written by an ITS transaction */
+#ifndef ITS_TRANSACTION_BUF_SIZE
+#define ITS_TRANSACTION_BUF_SIZE               ITS_MAX_ASSET_SIZE
+#endif
+
+/* The number of ITS transactions open at the same time, one per client */
+#ifndef ITS_TRANSACTION_NUM_SLOTS
+#define ITS_TRANSACTION_NUM_SLOTS              2
+#endif
+
+/* The number of ITS transaction requests after which an idle transaction can
+ * be aborted to open another one, 0 to never abort it
+ */
+#ifndef ITS_TRANSACTION_TIMEOUT
+#define ITS_TRANSACTION_TIMEOUT                64
+#endif
+
 /* The stack size of the Internal Trusted Storage Secure Partition */
 #ifndef ITS_STACK_SIZE
 #define ITS_STACK_SIZE                         0x720
@@ -218,6 +324,11 @@
 #define TFM_ITS_ENC_NONCE_LENGTH               12
 #endif
 
+/* Size in bytes of the chunks encrypted separately in ITS files, 0 to encrypt each file as a whole */
+#ifndef ITS_ENCRYPTION_CHUNK_SIZE
+#define ITS_ENCRYPTION_CHUNK_SIZE              0
+#endif
+
 /* PS Partition Configs */
 
 /* Create flash FS if it doesn't exist for Protected Storage partition */
@@ -250,6 +361,18 @@
 #define PS_NUM_ASSETS                          10
 #endif
 
+/* Keep a hash index of the object table in RAM */
+#ifndef PS_RAM_OBJECT_INDEX
+#define PS_RAM_OBJECT_INDEX                    0
+#endif
+
+/* Size of the separately encrypted segments of the Protected Storage objects,
+ * 0 to encrypt each object as a whole
+ */
+#ifndef PS_OBJECT_SEGMENT_SIZE
+#define PS_OBJECT_SEGMENT_SIZE                 0
+#endif
+
 /* The stack size of the Protected Storage Secure Partition */
 #ifndef PS_STACK_SIZE
 #define PS_STACK_SIZE                          0x700
@@ -289,6 +412,11 @@
 #endif
 #endif
 
+/* The number of stateless connections kept bound for reuse, 0 to disable */
+#ifndef CONFIG_TFM_STATELESS_CONN_CACHE_NUM
+#define CONFIG_TFM_STATELESS_CONN_CACHE_NUM     0
+#endif
+
 /* Disable the doorbell APIs */
 #ifndef CONFIG_TFM_DOORBELL_API
 #define CONFIG_TFM_DOORBELL_API                 0
@@ -312,6 +440,26 @@
 #define CONFIG_TFM_POST_PARTITION_INIT_HOOK     0
 #endif
 
+/* Pick the next thread from a priority-ordered ready bitmap instead of a list walk */
+#ifndef CONFIG_TFM_SPM_SCHED_BITMAP
+#define CONFIG_TFM_SPM_SCHED_BITMAP             0
+#endif
+
+/* Record timestamped trace points of the PSA call path in a ring buffer */
+#ifndef CONFIG_TFM_SPM_TRACE
+#define CONFIG_TFM_SPM_TRACE                    0
+#endif
+
+/* The number of records in the SPM trace ring buffer, a power of 2 */
+#ifndef CONFIG_TFM_SPM_TRACE_REC_NUM
+#define CONFIG_TFM_SPM_TRACE_REC_NUM            128
+#endif
+
+/* Number of validated memory ranges cached by the isolation HAL, 0 to disable */
+#ifndef CONFIG_TFM_MEM_CHECK_CACHE_NUM
+#define CONFIG_TFM_MEM_CHECK_CACHE_NUM          0
+#endif
+
 /* Enable OTP/NV_COUNTERS emulation in RAM */
 #ifndef OTP_NV_COUNTERS_RAM_EMULATION
 #define OTP_NV_COUNTERS_RAM_EMULATION           0
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022-2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -133,6 +133,53 @@ struct mailbox_slot_t {
 
 typedef uint32_t   mailbox_queue_status_t;
 
+#ifdef MAILBOX_RING_TRANSPORT
+/*
+ * Ring indices count from 0 to (2 * NUM_MAILBOX_QUEUE_SLOT - 1) and wrap to 0,
+ * so that the entry an index refers to stays the same across the wrap for any
+ * number of slots, and a full ring is told apart from an empty one.
+ */
+#define MAILBOX_RING_IDX_WRAP               (2U * NUM_MAILBOX_QUEUE_SLOT)
+
+/* Index following idx */
+#define MAILBOX_RING_NEXT(idx)              \
+    (((idx) + 1U) % MAILBOX_RING_IDX_WRAP)
+
+/* Entry of the ring an index refers to */
+#define MAILBOX_RING_ENTRY(idx)             ((idx) % NUM_MAILBOX_QUEUE_SLOT)
+
+/* Number of entries between tail and head */
+#define MAILBOX_RING_COUNT(head, tail)      \
+    (((head) + MAILBOX_RING_IDX_WRAP - (tail)) % MAILBOX_RING_IDX_WRAP)
+
+/*
+ * A ring index, see MAILBOX_RING_IDX_WRAP. Each index is written by a single
+ * core and is kept in its own cache line so that cleaning or invalidating one
+ * index never touches an index owned by the peer.
+ */
+struct mailbox_ring_idx_t {
+    uint32_t                 val;
+} MAILBOX_ALIGN;
+
+/*
+ * NSPE mailbox status shared between TF-M and mailbox client.
+ * The request ring carries indices of slots pending for SPE handling and the
+ * completion ring carries indices of slots containing a PSA client call return
+ * result. Each ring has a single producer and a single consumer, so no
+ * critical section between cores is required.
+ * An entry is written before the head index is published and it is read after
+ * the head index is observed.
+ */
+struct mailbox_status_t {
+    struct mailbox_ring_idx_t req_head;         /* Written by NSPE */
+    struct mailbox_ring_idx_t req_tail;         /* Written by SPE */
+    struct mailbox_ring_idx_t cpl_head;         /* Written by SPE */
+    struct mailbox_ring_idx_t cpl_tail;         /* Written by NSPE */
+
+    uint8_t                   req[NUM_MAILBOX_QUEUE_SLOT] MAILBOX_ALIGN;
+    uint8_t                   cpl[NUM_MAILBOX_QUEUE_SLOT] MAILBOX_ALIGN;
+} MAILBOX_ALIGN;
+#else /* MAILBOX_RING_TRANSPORT */
 /*
  * NSPE mailbox status shared between TF-M and mailbox client.
  * This structure is separated from slots to allow flexible allocation of slots.
@@ -149,6 +196,7 @@ struct mailbox_status_t {
                                                  * return result
                                                  */
 } MAILBOX_ALIGN;
+#endif /* MAILBOX_RING_TRANSPORT */
 
 /*
  * Data used to send information to mailbox partition about mailbox queue
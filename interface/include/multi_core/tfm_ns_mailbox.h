@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -66,7 +66,13 @@ struct ns_mailbox_queue_t {
     /* Following data are not shared with secure */
     struct ns_mailbox_slot_t slots_ns[NUM_MAILBOX_QUEUE_SLOT] MAILBOX_ALIGN;
 
+#ifdef MAILBOX_RING_TRANSPORT
+    uint8_t                  free_slots[NUM_MAILBOX_QUEUE_SLOT];
+                                                /* Stack of empty slots */
+    uint8_t                  nr_free_slots;     /* Number of empty slots */
+#else
     mailbox_queue_status_t   empty_slots;       /* Bitmask of empty slots */
+#endif
 
 #ifdef TFM_MULTI_CORE_TEST
     uint32_t                 nr_tx;             /* The total number of
@@ -365,6 +371,7 @@ static inline int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 #define tfm_ns_mailbox_os_spin_unlock() do {} while (0)
 #endif /* TFM_MULTI_CORE_NS_OS */
 
+#ifndef MAILBOX_RING_TRANSPORT
 /* The following inline functions configure non-secure mailbox queue status */
 static inline void clear_queue_slot_empty(struct ns_mailbox_queue_t *queue_ptr,
                                           uint8_t idx)
@@ -399,6 +406,7 @@ static inline mailbox_queue_status_t clear_queue_slot_all_replied(
                         sizeof(queue_ptr->status));
     return status;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/** This file describes the TF-M Crypto batch API, which runs several short
+ *  PSA Crypto operations with a single call to the Crypto service
+ */
+
+#ifndef __TFM_CRYPTO_BATCH_H__
+#define __TFM_CRYPTO_BATCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/crypto.h"
+#include "tfm_crypto_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief A batch being built. The inputs of the commands are copied in the
+ *        input buffer when they are added, and their outputs are written in
+ *        the output buffer when the batch is run. All the fields are private
+ *        to the functions below.
+ */
+struct tfm_crypto_batch_t {
+    struct tfm_crypto_batch_cmd *cmds; /*!< Commands of the batch */
+    size_t max_num;                    /*!< Room in \a cmds */
+    size_t num;                        /*!< Number of commands added */
+    uint8_t *in_buf;                   /*!< Shared input buffer */
+    size_t in_size;                    /*!< Size of \a in_buf */
+    size_t in_used;                    /*!< Bytes of \a in_buf in use */
+    uint8_t *out_buf;                  /*!< Shared output buffer */
+    size_t out_size;                   /*!< Size of \a out_buf */
+    size_t out_used;                   /*!< Bytes of \a out_buf in use */
+};
+
+/**
+ * \brief Initialises an empty batch on the buffers provided by the caller
+ *
+ * The inputs and outputs of the commands are placed at offsets aligned to
+ * \ref TFM_CRYPTO_IOVEC_ALIGNMENT in the buffers, so the buffers must be
+ * aligned to it as well.
+ *
+ * \param[out] batch     The batch to initialise
+ * \param[in]  cmds      Array to hold the commands
+ * \param[in]  max_num   Number of elements of \p cmds, at most
+ *                       \ref TFM_CRYPTO_BATCH_MAX_NUM are used
+ * \param[in]  in_buf    Buffer to hold the inputs of the commands
+ * \param[in]  in_size   Size of \p in_buf in bytes
+ * \param[in]  out_buf   Buffer to hold the outputs of the commands
+ * \param[in]  out_size  Size of \p out_buf in bytes
+ */
+void tfm_crypto_batch_init(struct tfm_crypto_batch_t *batch,
+                           struct tfm_crypto_batch_cmd *cmds,
+                           size_t max_num,
+                           uint8_t *in_buf,
+                           size_t in_size,
+                           uint8_t *out_buf,
+                           size_t out_size);
+
+/**
+ * \brief Adds a psa_hash_compute() command to the batch
+ *
+ * \param[in,out] batch         The batch
+ * \param[in]     alg           The hash algorithm
+ * \param[in]     input         Buffer containing the message to hash
+ * \param[in]     input_length  Size of \p input in bytes
+ * \param[in]     hash_size     Size of the hash buffer in bytes
+ * \param[out]    hash          Set to the location in the output buffer where
+ *                              the hash is written when the batch is run
+ *
+ * \retval PSA_SUCCESS                    The command has been added
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The batch has no room left for the
+ *                                        command, its input or its output
+ */
+psa_status_t tfm_crypto_batch_add_hash_compute(struct tfm_crypto_batch_t *batch,
+                                               psa_algorithm_t alg,
+                                               const uint8_t *input,
+                                               size_t input_length,
+                                               size_t hash_size,
+                                               uint8_t **hash);
+
+/**
+ * \brief Adds a psa_mac_compute() command to the batch
+ *
+ * \param[in,out] batch         The batch
+ * \param[in]     key           Identifier of the key to use
+ * \param[in]     alg           The MAC algorithm
+ * \param[in]     input         Buffer containing the input message
+ * \param[in]     input_length  Size of \p input in bytes
+ * \param[in]     mac_size      Size of the MAC buffer in bytes
+ * \param[out]    mac           Set to the location in the output buffer where
+ *                              the MAC is written when the batch is run
+ *
+ * \retval PSA_SUCCESS                    The command has been added
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The batch has no room left for the
+ *                                        command, its input or its output
+ */
+psa_status_t tfm_crypto_batch_add_mac_compute(struct tfm_crypto_batch_t *batch,
+                                              psa_key_id_t key,
+                                              psa_algorithm_t alg,
+                                              const uint8_t *input,
+                                              size_t input_length,
+                                              size_t mac_size,
+                                              uint8_t **mac);
+
+/**
+ * \brief Adds a psa_mac_verify() command to the batch
+ *
+ * \param[in,out] batch         The batch
+ * \param[in]     key           Identifier of the key to use
+ * \param[in]     alg           The MAC algorithm
+ * \param[in]     input         Buffer containing the input message
+ * \param[in]     input_length  Size of \p input in bytes
+ * \param[in]     mac           Buffer containing the expected MAC value
+ * \param[in]     mac_length    Size of \p mac in bytes
+ *
+ * \retval PSA_SUCCESS                    The command has been added
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The batch has no room left for the
+ *                                        command or its inputs
+ */
+psa_status_t tfm_crypto_batch_add_mac_verify(struct tfm_crypto_batch_t *batch,
+                                             psa_key_id_t key,
+                                             psa_algorithm_t alg,
+                                             const uint8_t *input,
+                                             size_t input_length,
+                                             const uint8_t *mac,
+                                             size_t mac_length);
+
+/**
+ * \brief Adds a psa_cipher_encrypt() command to the batch
+ *
+ * \param[in,out] batch         The batch
+ * \param[in]     key           Identifier of the key to use
+ * \param[in]     alg           The cipher algorithm
+ * \param[in]     input         Buffer containing the message to encrypt
+ * \param[in]     input_length  Size of \p input in bytes
+ * \param[in]     output_size   Size of the output buffer in bytes
+ * \param[out]    output        Set to the location in the output buffer where
+ *                              the output is written when the batch is run
+ *
+ * \retval PSA_SUCCESS                    The command has been added
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The batch has no room left for the
+ *                                        command, its input or its output
+ */
+psa_status_t tfm_crypto_batch_add_cipher_encrypt(
+                                              struct tfm_crypto_batch_t *batch,
+                                              psa_key_id_t key,
+                                              psa_algorithm_t alg,
+                                              const uint8_t *input,
+                                              size_t input_length,
+                                              size_t output_size,
+                                              uint8_t **output);
+
+/**
+ * \brief Adds a psa_cipher_decrypt() command to the batch
+ *
+ * \param[in,out] batch         The batch
+ * \param[in]     key           Identifier of the key to use
+ * \param[in]     alg           The cipher algorithm
+ * \param[in]     input         Buffer containing the message to decrypt
+ * \param[in]     input_length  Size of \p input in bytes
+ * \param[in]     output_size   Size of the output buffer in bytes
+ * \param[out]    output        Set to the location in the output buffer where
+ *                              the output is written when the batch is run
+ *
+ * \retval PSA_SUCCESS                    The command has been added
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The batch has no room left for the
+ *                                        command, its input or its output
+ */
+psa_status_t tfm_crypto_batch_add_cipher_decrypt(
+                                              struct tfm_crypto_batch_t *batch,
+                                              psa_key_id_t key,
+                                              psa_algorithm_t alg,
+                                              const uint8_t *input,
+                                              size_t input_length,
+                                              size_t output_size,
+                                              uint8_t **output);
+
+/**
+ * \brief Runs all the commands of the batch with one call to the Crypto
+ *        service, in the order they were added
+ *
+ * A failing command does not stop the following ones. The status of each
+ * command and the length of its outputs are returned in \p results. The batch
+ * is left unchanged, so it can be run again.
+ *
+ * \param[in]  batch    The batch
+ * \param[out] results  Array of as many results as commands in the batch
+ *
+ * \retval PSA_SUCCESS                 All the commands have been run, the
+ *                                     status of each one is in \p results
+ * \retval PSA_ERROR_NOT_SUPPORTED     The Crypto service has no batch support
+ * \retval PSA_ERROR_INVALID_ARGUMENT  The batch is empty
+ */
+psa_status_t tfm_crypto_batch_run(const struct tfm_crypto_batch_t *batch,
+                                  struct tfm_crypto_batch_result *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_CRYPTO_BATCH_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -59,13 +59,65 @@ struct tfm_crypto_pack_iovec {
     union {
         uint32_t capacity;   /*!< Key derivation capacity */
         uint64_t value;      /*!< Key derivation integer for update*/
+        uint32_t max_ops;    /*!< Max ops of an interruptible operation */
     };
 };
 
+/**
+ * \brief Maximum alignment required by any iovec parameters to the TF-M Crypto
+ *        partition. The buffers of the commands of a batch start at offsets
+ *        which are multiples of it in the shared buffers of the batch.
+ */
+#define TFM_CRYPTO_IOVEC_ALIGNMENT (4u)
+
+/**
+ * \brief The maximum number of input and output buffers of a command of a
+ *        batch, in addition to its tfm_crypto_pack_iovec
+ */
+#define TFM_CRYPTO_BATCH_MAX_IN  (3u)
+#define TFM_CRYPTO_BATCH_MAX_OUT (2u)
+
+/**
+ * \brief The maximum number of commands in a batch
+ */
+#define TFM_CRYPTO_BATCH_MAX_NUM (16u)
+
+/**
+ * \brief Location of a buffer of a batch command in the input or output
+ *        buffer shared by all the commands of the batch
+ */
+struct tfm_crypto_batch_buf {
+    uint32_t offset; /*!< Offset from the start of the shared buffer */
+    uint32_t len;    /*!< Length, 0 if the buffer is not used */
+};
+
+/**
+ * \brief Structure describing a command of a batch. The command is run as if
+ *        it was requested alone with \a iov in the first invec, followed by
+ *        the \a in buffers as invecs and the \a out buffers as outvecs
+ */
+struct tfm_crypto_batch_cmd {
+    struct tfm_crypto_pack_iovec iov;                   /*!< Packed parameters
+                                                         *   of the command
+                                                         */
+    struct tfm_crypto_batch_buf in[TFM_CRYPTO_BATCH_MAX_IN];   /*!< Inputs */
+    struct tfm_crypto_batch_buf out[TFM_CRYPTO_BATCH_MAX_OUT]; /*!< Outputs */
+};
+
+/**
+ * \brief Structure holding the result of a command of a batch
+ */
+struct tfm_crypto_batch_result {
+    psa_status_t status;                      /*!< Status of the command */
+    uint32_t out_len[TFM_CRYPTO_BATCH_MAX_OUT]; /*!< Length written to each
+                                                 *   output of the command
+                                                 */
+};
+
 /**
  * \brief Type associated to the group of a function encoding. There can be
- *        nine groups (Random, Key management, Hash, MAC, Cipher, AEAD,
- *        Asym sign, Asym encrypt, Key derivation).
+ *        ten groups (Random, Key management, Hash, MAC, Cipher, AEAD,
+ *        Asym sign, Asym encrypt, Key derivation, Batch).
  */
 enum tfm_crypto_group_id_t {
     TFM_CRYPTO_GROUP_ID_RANDOM          = UINT8_C(1),
@@ -76,12 +128,14 @@ enum tfm_crypto_group_id_t {
     TFM_CRYPTO_GROUP_ID_AEAD            = UINT8_C(6),
     TFM_CRYPTO_GROUP_ID_ASYM_SIGN       = UINT8_C(7),
     TFM_CRYPTO_GROUP_ID_ASYM_ENCRYPT    = UINT8_C(8),
-    TFM_CRYPTO_GROUP_ID_KEY_DERIVATION  = UINT8_C(9)
+    TFM_CRYPTO_GROUP_ID_KEY_DERIVATION  = UINT8_C(9),
+    TFM_CRYPTO_GROUP_ID_BATCH           = UINT8_C(10)
 };
 
 /* Set of X macros describing each of the available PSA Crypto APIs */
 #define RANDOM_FUNCS                               \
-    X(TFM_CRYPTO_GENERATE_RANDOM)
+    X(TFM_CRYPTO_GENERATE_RANDOM)                  \
+    X(TFM_CRYPTO_GENERATE_RANDOM_FRESH)
 
 #define KEY_MANAGEMENT_FUNCS                       \
     X(TFM_CRYPTO_GET_KEY_ATTRIBUTES)               \
@@ -144,7 +198,15 @@ enum tfm_crypto_group_id_t {
     X(TFM_CRYPTO_ASYMMETRIC_SIGN_MESSAGE)          \
     X(TFM_CRYPTO_ASYMMETRIC_VERIFY_MESSAGE)        \
     X(TFM_CRYPTO_ASYMMETRIC_SIGN_HASH)             \
-    X(TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH)
+    X(TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH)           \
+    X(TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_START)       \
+    X(TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_COMPLETE)    \
+    X(TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_ABORT)       \
+    X(TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_GET_NUM_OPS) \
+    X(TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_START)     \
+    X(TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_COMPLETE)  \
+    X(TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_ABORT)     \
+    X(TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_GET_NUM_OPS)
 
 #define ASYM_ENCRYPT_FUNCS                         \
     X(TFM_CRYPTO_ASYMMETRIC_ENCRYPT)               \
@@ -163,6 +225,9 @@ enum tfm_crypto_group_id_t {
     X(TFM_CRYPTO_KEY_DERIVATION_OUTPUT_KEY)        \
     X(TFM_CRYPTO_KEY_DERIVATION_ABORT)
 
+#define BATCH_FUNCS                                \
+    X(TFM_CRYPTO_BATCH)
+
 #define BASE__VALUE(x) ((uint16_t)((((uint16_t)(x)) << 8) & 0xFF00))
 
 /**
@@ -197,6 +262,8 @@ enum tfm_crypto_func_sid_t {
     ASYM_ENCRYPT_FUNCS
     BASE__KEY_DERIVATION = BASE__VALUE(TFM_CRYPTO_GROUP_ID_KEY_DERIVATION) - 1,
     KEY_DERIVATION_FUNCS
+    BASE__BATCH          = BASE__VALUE(TFM_CRYPTO_GROUP_ID_BATCH) - 1,
+    BATCH_FUNCS
 #undef X
 };
 
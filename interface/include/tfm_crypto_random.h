@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/** This file describes the TF-M Crypto random generation extension, which
+ *  extends psa_generate_random() of the PSA Crypto API
+ */
+
+#ifndef __TFM_CRYPTO_RANDOM_H__
+#define __TFM_CRYPTO_RANDOM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Generates random bytes with a DRBG call made for this request
+ *
+ * Same as psa_generate_random(), except that the bytes are never taken from
+ * the pool of random bytes of the Crypto service, which holds bytes generated
+ * before the request when CRYPTO_RNG_POOL_SIZE is not 0. To be used when the
+ * output must benefit from the prediction resistance of the DRBG.
+ *
+ * \param[out] output       Output buffer for the generated data
+ * \param[in]  output_size  Number of bytes to generate and output
+ *
+ * \return Return values as described for psa_generate_random()
+ */
+psa_status_t tfm_crypto_generate_random_fresh(uint8_t *output,
+                                              size_t output_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_CRYPTO_RANDOM_H__ */
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/** This file describes the TF-M Internal Trusted Storage deferred compaction
+ *  API, which extends the PSA Internal Trusted Storage API
+ */
+
+#ifndef __TFM_ITS_COMPACT_H__
+#define __TFM_ITS_COMPACT_H__
+
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Reclaims the space of one deleted file of the storage filesystems,
+ *        when ITS_DEFERRED_COMPACTION is enabled
+ *
+ * Each call moves the data of at most one data block, so that it can be called
+ * repeatedly when the system is idle.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                The space of a deleted file has been
+ *                                    reclaimed, more may remain
+ * \retval PSA_ERROR_DOES_NOT_EXIST   There is no space left to reclaim
+ * \retval PSA_ERROR_NOT_SUPPORTED    Compaction is not deferred
+ * \retval PSA_ERROR_STORAGE_FAILURE  The operation failed because the physical
+ *                                    storage has failed
+ */
+psa_status_t tfm_its_compact_step(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_ITS_COMPACT_H__ */
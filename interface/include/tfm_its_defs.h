@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -21,6 +21,19 @@ extern "C" {
 #define TFM_ITS_GET_INFO           1003
 #define TFM_ITS_REMOVE             1004
 
+/* ITS message types of the transaction services */
+#define TFM_ITS_TRANSACTION_BEGIN  1005
+#define TFM_ITS_TRANSACTION_SET    1006
+#define TFM_ITS_TRANSACTION_REMOVE 1007
+#define TFM_ITS_TRANSACTION_COMMIT 1008
+#define TFM_ITS_TRANSACTION_ABORT  1009
+
+/* ITS message type of the wear statistics service */
+#define TFM_ITS_WEAR_STATS         1010
+
+/* ITS message type of the deferred compaction service */
+#define TFM_ITS_COMPACT_STEP       1011
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/** This file describes the TF-M Internal Trusted Storage transaction API,
+ *  which extends the PSA Internal Trusted Storage API
+ */
+
+#ifndef __TFM_ITS_TRANSACTION_H__
+#define __TFM_ITS_TRANSACTION_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/error.h"
+#include "psa/storage_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Opens a transaction for the caller
+ *
+ * The changes staged with \ref tfm_its_transaction_set and
+ * \ref tfm_its_transaction_remove are applied together by
+ * \ref tfm_its_transaction_commit: either all or none of them are applied,
+ * including after a power failure. Each caller can have one open
+ * transaction. A transaction left idle while the other clients use the
+ * service can be aborted to open the transaction of another client.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS          The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE  The operation failed because the caller has a
+ *                              transaction open already, or the service
+ *                              cannot open more transactions
+ */
+psa_status_t tfm_its_transaction_begin(void);
+
+/**
+ * \brief Stages the creation or modification of a uid/value pair in the open
+ *        transaction
+ *
+ * The data is copied by the service when the change is staged. A change
+ * staged for a uid replaces the change staged before for the same uid.
+ *
+ * \param[in] uid           The identifier for the data
+ * \param[in] data_length   The size in bytes of the data in `p_data`
+ * \param[in] p_data        A buffer containing the data
+ * \param[in] create_flags  The flags that the data will be stored with
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                    The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE            The caller has no open transaction
+ * \retval PSA_ERROR_NOT_SUPPORTED        One or more of the flags provided in
+ *                                        `create_flags` is not supported or
+ *                                        is not valid
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The transaction has no room left for
+ *                                        the change
+ * \retval PSA_ERROR_INVALID_ARGUMENT     One of the arguments is invalid
+ */
+psa_status_t tfm_its_transaction_set(psa_storage_uid_t uid,
+                                     size_t data_length,
+                                     const void *p_data,
+                                     psa_storage_create_flags_t create_flags);
+
+/**
+ * \brief Stages the removal of a uid and its data in the open transaction
+ *
+ * \param[in] uid  The identifier for the data
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                    The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE            The caller has no open transaction
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The transaction has no room left for
+ *                                        the change
+ * \retval PSA_ERROR_INVALID_ARGUMENT     The `uid` value is invalid
+ */
+psa_status_t tfm_its_transaction_remove(psa_storage_uid_t uid);
+
+/**
+ * \brief Applies all the changes of the open transaction and closes it
+ *
+ * The transaction is closed whatever the result.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                     The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE             The caller has no open transaction
+ * \retval PSA_ERROR_DOES_NOT_EXIST        A uid to remove was not found in the
+ *                                         storage
+ * \retval PSA_ERROR_NOT_PERMITTED         A uid to modify or remove was
+ *                                         created with
+ *                                         PSA_STORAGE_FLAG_WRITE_ONCE
+ * \retval PSA_ERROR_INSUFFICIENT_STORAGE  There was insufficient space on the
+ *                                         storage medium for the changes
+ * \retval PSA_ERROR_STORAGE_FAILURE       The physical storage has failed
+ *                                         (Fatal error)
+ */
+psa_status_t tfm_its_transaction_commit(void);
+
+/**
+ * \brief Discards the changes of the open transaction and closes it
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS          The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE  The caller has no open transaction
+ */
+psa_status_t tfm_its_transaction_abort(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_ITS_TRANSACTION_H__ */
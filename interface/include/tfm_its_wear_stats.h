@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/** This file describes the TF-M Internal Trusted Storage wear statistics API,
+ *  which extends the PSA Internal Trusted Storage API
+ */
+
+#ifndef __TFM_ITS_WEAR_STATS_H__
+#define __TFM_ITS_WEAR_STATS_H__
+
+#include <stdint.h>
+
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of bins of the erase count histogram */
+#define TFM_ITS_WEAR_HIST_BINS  8
+
+/**
+ * \brief Erase statistics of the blocks of a storage filesystem
+ *
+ * Bin i of the histogram counts the blocks erased between
+ * min_erase_count + i * bin_width and
+ * min_erase_count + (i + 1) * bin_width - 1 times.
+ */
+struct tfm_its_wear_stats_t {
+    uint32_t num_blocks;       /**< Number of blocks of the filesystem */
+    uint32_t min_erase_count;  /**< Lowest erase count of a block */
+    uint32_t max_erase_count;  /**< Highest erase count of a block */
+    uint32_t bin_width;        /**< Number of erase counts per bin */
+    uint32_t histogram[TFM_ITS_WEAR_HIST_BINS]; /**< Number of blocks per
+                                                 *   erase count bin
+                                                 */
+};
+
+/**
+ * \brief Gets the erase statistics of the blocks of the filesystem which
+ *        stores the caller's data
+ *
+ * \param[out] p_stats  A pointer to the erase statistics
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS              The operation completed successfully
+ * \retval PSA_ERROR_NOT_SUPPORTED  The erases of the blocks are not counted
+ */
+psa_status_t tfm_its_get_wear_stats(struct tfm_its_wear_stats_t *p_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_ITS_WEAR_STATS_H__ */
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_PSA_CALL_BATCH_H__
+#define __TFM_PSA_CALL_BATCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of descriptors accepted by one tfm_psa_call_batch() */
+#define TFM_PSA_CALL_BATCH_MAX_NUM    32
+
+/* One psa_call() request of a batch. */
+struct tfm_psa_call_desc_t {
+    psa_handle_t handle;          /* Handle of the target service         */
+    int32_t type;                 /* Request type, as for psa_call()      */
+    const psa_invec *in_vec;      /* Input vectors, as for psa_call()     */
+    size_t in_len;                /* Number of input vectors              */
+    psa_outvec *out_vec;          /* Output vectors, as for psa_call()    */
+    size_t out_len;               /* Number of output vectors             */
+    psa_status_t status;          /* [out] Status returned by the call    */
+};
+
+/**
+ * \brief Issue a sequence of psa_call() requests with one entry into TF-M.
+ *
+ * \details The requests are processed in array order, each one exactly as a
+ *          standalone psa_call() would be. A failing request does not stop
+ *          the following ones; check the status field of every descriptor.
+ *          A request with an invalid type or number of vectors gets
+ *          PSA_ERROR_PROGRAMMER_ERROR as its status rather than a panic.
+ *          For Non-secure clients the batch costs a single Non-secure to
+ *          Secure transition instead of one per request.
+ *
+ * \param[in,out] descs         Array of request descriptors.
+ * \param[in] num               Number of descriptors in \p descs, from 1 to
+ *                              \ref TFM_PSA_CALL_BATCH_MAX_NUM.
+ *
+ * \retval PSA_SUCCESS          All requests have been issued, per request
+ *                              results are in the status fields.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR
+ *                              The descriptor array is invalid, no request
+ *                              has been issued.
+ */
+psa_status_t tfm_psa_call_batch(struct tfm_psa_call_desc_t *descs,
+                                size_t num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_PSA_CALL_BATCH_H__ */
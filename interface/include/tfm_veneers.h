@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include "psa/client.h"
+#include "tfm_psa_call_batch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -59,6 +60,17 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
                                  const psa_invec *in_vec,
                                  psa_outvec *out_vec);
 
+/**
+ * \brief Call a sequence of secure functions with one veneer crossing.
+ *
+ * \param[in,out] descs        Array of \ref tfm_psa_call_desc_t descriptors.
+ * \param[in] num              Number of descriptors.
+ *
+ * \return Returns \ref psa_status_t status code.
+ */
+psa_status_t tfm_psa_call_batch_veneer(struct tfm_psa_call_desc_t *descs,
+                                       uint32_t num);
+
 /**
  * \brief Close connection to secure function referenced by a connection handle.
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -22,7 +22,11 @@ static int32_t mailbox_wait_reply(uint8_t idx);
 static inline void set_queue_slot_empty(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+#ifdef MAILBOX_RING_TRANSPORT
+        mailbox_queue_ptr->free_slots[mailbox_queue_ptr->nr_free_slots++] = idx;
+#else
         mailbox_queue_ptr->empty_slots |= (1UL << idx);
+#endif
     }
 }
 
@@ -49,7 +53,82 @@ static inline void clear_queue_slot_woken(uint8_t idx)
     }
 }
 
-#ifndef TFM_MULTI_CORE_NS_OS
+#ifdef MAILBOX_RING_TRANSPORT
+/*
+ * Publish slot idx in the request ring.
+ * NS tasks are serialized by tfm_ns_mailbox_os_spin_lock(), so NSPE is the
+ * single producer. A slot has at most one entry in flight and it is released
+ * only after SPE has consumed its request, so the ring cannot overflow.
+ */
+static void push_queue_slot_req(uint8_t idx)
+{
+    struct mailbox_status_t *status = &mailbox_queue_ptr->status;
+    uint32_t head = status->req_head.val;
+    uint8_t *entry = &status->req[MAILBOX_RING_ENTRY(head)];
+
+    *entry = idx;
+    MAILBOX_CLEAN_CACHE(entry, sizeof(*entry));
+
+    /* The entry must be visible before the head index */
+    __DMB();
+
+    status->req_head.val = MAILBOX_RING_NEXT(head);
+    MAILBOX_CLEAN_CACHE(&status->req_head, sizeof(status->req_head));
+}
+
+/*
+ * Consume all the entries in the completion ring and mark the slots as woken.
+ * The owner tasks are woken up if NS OS is present.
+ * Only a single context drains the ring: the mailbox interrupt handler if NS
+ * OS is present, otherwise the only NS thread.
+ */
+static int32_t mailbox_drain_replies(void)
+{
+    struct mailbox_status_t *status = &mailbox_queue_ptr->status;
+    uint32_t head, tail = status->cpl_tail.val;
+    const uint8_t *entry;
+    uint8_t idx;
+
+    MAILBOX_INVALIDATE_CACHE(&status->cpl_head, sizeof(status->cpl_head));
+    head = status->cpl_head.val;
+
+    if (head == tail) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
+    /* Completion entries are read only after the head index is observed */
+    __DMB();
+
+    /* SPE never has more replies in flight than there are slots */
+    if ((head >= MAILBOX_RING_IDX_WRAP) ||
+        (MAILBOX_RING_COUNT(head, tail) > NUM_MAILBOX_QUEUE_SLOT)) {
+        return MAILBOX_GENERIC_ERROR;
+    }
+
+    for (; tail != head; tail = MAILBOX_RING_NEXT(tail)) {
+        entry = &status->cpl[MAILBOX_RING_ENTRY(tail)];
+        MAILBOX_INVALIDATE_CACHE(entry, sizeof(*entry));
+        idx = *entry;
+
+        if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+            continue;
+        }
+
+        /* Set woken-up flag */
+        tfm_ns_mailbox_os_spin_lock();
+        set_queue_slot_woken(idx);
+        tfm_ns_mailbox_os_spin_unlock();
+
+        tfm_ns_mailbox_os_wake_task_isr(
+                                     mailbox_queue_ptr->slots_ns[idx].owner);
+    }
+
+    status->cpl_tail.val = tail;
+    MAILBOX_CLEAN_CACHE(&status->cpl_tail, sizeof(status->cpl_tail));
+
+    return MAILBOX_SUCCESS;
+}
+#elif !defined(TFM_MULTI_CORE_NS_OS)
 static inline void clear_queue_slot_replied(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
@@ -71,8 +150,24 @@ static inline bool is_queue_slot_replied(uint8_t idx)
 
     return false;
 }
-#endif /* !defined TFM_MULTI_CORE_NS_OS */
+#endif /* MAILBOX_RING_TRANSPORT */
 
+#ifdef MAILBOX_RING_TRANSPORT
+static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
+{
+    uint8_t idx = NUM_MAILBOX_QUEUE_SLOT;
+
+    tfm_ns_mailbox_os_spin_lock();
+
+    if (queue->nr_free_slots) {
+        idx = queue->free_slots[--queue->nr_free_slots];
+    }
+
+    tfm_ns_mailbox_os_spin_unlock();
+
+    return idx;
+}
+#else /* MAILBOX_RING_TRANSPORT */
 static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
 {
     uint8_t idx;
@@ -98,6 +193,7 @@ static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
 
     return idx;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 static void set_msg_owner(uint8_t idx, const void *owner)
 {
@@ -114,7 +210,9 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     uint8_t idx;
     struct mailbox_msg_t *msg_ptr;
     const void *task_handle;
+#ifndef MAILBOX_RING_TRANSPORT
     uint32_t critical_section;
+#endif
 
     idx = acquire_empty_slot(mailbox_queue_ptr);
     if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
@@ -140,9 +238,16 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     task_handle = tfm_ns_mailbox_os_get_task_handle();
     set_msg_owner(idx, task_handle);
 
+#ifdef MAILBOX_RING_TRANSPORT
+    /* Only NS tasks have to be serialized, SPE is the ring consumer */
+    tfm_ns_mailbox_os_spin_lock();
+    push_queue_slot_req(idx);
+    tfm_ns_mailbox_os_spin_unlock();
+#else
     critical_section = tfm_ns_mailbox_hal_enter_critical();
     set_queue_slot_pend(mailbox_queue_ptr, idx);
     tfm_ns_mailbox_hal_exit_critical(critical_section);
+#endif
 
     tfm_ns_mailbox_hal_notify_peer();
 
@@ -217,6 +322,16 @@ exit:
 }
 
 #ifdef TFM_MULTI_CORE_NS_OS
+#ifdef MAILBOX_RING_TRANSPORT
+int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
+{
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    return mailbox_drain_replies();
+}
+#else /* MAILBOX_RING_TRANSPORT */
 int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 {
     uint8_t idx;
@@ -260,6 +375,7 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 
     return MAILBOX_SUCCESS;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 static inline bool mailbox_wait_reply_signal(uint8_t idx)
 {
@@ -276,6 +392,18 @@ static inline bool mailbox_wait_reply_signal(uint8_t idx)
 
     return is_set;
 }
+#elif defined(MAILBOX_RING_TRANSPORT)
+static inline bool mailbox_wait_reply_signal(uint8_t idx)
+{
+    (void)mailbox_drain_replies();
+
+    if (is_queue_slot_woken(idx)) {
+        clear_queue_slot_woken(idx);
+        return true;
+    }
+
+    return false;
+}
 #else /* TFM_MULTI_CORE_NS_OS */
 static inline bool mailbox_wait_reply_signal(uint8_t idx)
 {
@@ -325,6 +453,9 @@ static int32_t mailbox_wait_reply(uint8_t idx)
 int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 {
     int32_t ret;
+#ifdef MAILBOX_RING_TRANSPORT
+    uint16_t idx;
+#endif
 
     if (!queue) {
         return MAILBOX_INVAL_PARAMS;
@@ -337,13 +468,20 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
 
     memset(queue, 0, sizeof(*queue));
 
+    mailbox_queue_ptr = queue;
+
+#ifdef MAILBOX_RING_TRANSPORT
+    /* Initialize the stack of empty slots */
+    for (idx = NUM_MAILBOX_QUEUE_SLOT; idx > 0; idx--) {
+        set_queue_slot_empty(idx - 1);
+    }
+#else
     /* Initialize empty bitmask */
     queue->empty_slots =
             (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
     queue->empty_slots +=
             (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
-
-    mailbox_queue_ptr = queue;
+#endif
 
     /* Platform specific initialization. */
     ret = tfm_ns_mailbox_hal_init(queue);
@@ -11,6 +11,10 @@
 
 #include "tfm_ns_mailbox.h"
 
+#ifdef MAILBOX_RING_TRANSPORT
+#error "The NS mailbox thread does not support MAILBOX_RING_TRANSPORT"
+#endif
+
 /* Thread woken up flag */
 #define NOT_WOKEN        0x0
 #define WOKEN_UP        0x5C
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,7 +8,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "tfm_crypto_batch.h"
 #include "tfm_crypto_defs.h"
+#include "tfm_crypto_random.h"
 
 #include "psa/client.h"
 #include "psa_manifest/sid.h"
@@ -1195,6 +1197,209 @@ TFM_CRYPTO_API(psa_status_t, psa_verify_hash)(psa_key_id_t key,
     return API_DISPATCH_NO_OUTVEC(in_vec);
 }
 
+/* The max ops are kept by the client and sent with each call of the
+ * interruptible functions, as the service is shared by all the clients.
+ */
+static uint32_t g_interruptible_max_ops = PSA_INTERRUPTIBLE_MAX_OPS_UNLIMITED;
+
+TFM_CRYPTO_API(void, psa_interruptible_set_max_ops)(uint32_t max_ops)
+{
+    g_interruptible_max_ops = max_ops;
+}
+
+TFM_CRYPTO_API(uint32_t, psa_interruptible_get_max_ops)(void)
+{
+    return g_interruptible_max_ops;
+}
+
+TFM_CRYPTO_API(uint32_t, psa_sign_hash_get_num_ops)(
+                        const psa_sign_hash_interruptible_operation_t *operation)
+{
+    psa_status_t status;
+    uint32_t num_ops = 0;
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_GET_NUM_OPS_SID,
+        .op_handle = operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &num_ops, .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(in_vec, out_vec);
+    if (status != PSA_SUCCESS) {
+        return 0;
+    }
+
+    return num_ops;
+}
+
+TFM_CRYPTO_API(uint32_t, psa_verify_hash_get_num_ops)(
+                      const psa_verify_hash_interruptible_operation_t *operation)
+{
+    psa_status_t status;
+    uint32_t num_ops = 0;
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_GET_NUM_OPS_SID,
+        .op_handle = operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &num_ops, .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(in_vec, out_vec);
+    if (status != PSA_SUCCESS) {
+        return 0;
+    }
+
+    return num_ops;
+}
+
+TFM_CRYPTO_API(psa_status_t, psa_sign_hash_start)(
+                              psa_sign_hash_interruptible_operation_t *operation,
+                              psa_key_id_t key,
+                              psa_algorithm_t alg,
+                              const uint8_t *hash,
+                              size_t hash_length)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_START_SID,
+        .key_id = key,
+        .alg = alg,
+        .op_handle = operation->handle,
+        .max_ops = g_interruptible_max_ops,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = hash, .len = hash_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
+TFM_CRYPTO_API(psa_status_t, psa_sign_hash_complete)(
+                              psa_sign_hash_interruptible_operation_t *operation,
+                              uint8_t *signature,
+                              size_t signature_size,
+                              size_t *signature_length)
+{
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_COMPLETE_SID,
+        .op_handle = operation->handle,
+        .max_ops = g_interruptible_max_ops,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = signature, .len = signature_size},
+    };
+
+    status = API_DISPATCH(in_vec, out_vec);
+
+    *signature_length = out_vec[1].len;
+
+    return status;
+}
+
+TFM_CRYPTO_API(psa_status_t, psa_sign_hash_abort)(
+                              psa_sign_hash_interruptible_operation_t *operation)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_ABORT_SID,
+        .op_handle = operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
+TFM_CRYPTO_API(psa_status_t, psa_verify_hash_start)(
+                            psa_verify_hash_interruptible_operation_t *operation,
+                            psa_key_id_t key,
+                            psa_algorithm_t alg,
+                            const uint8_t *hash,
+                            size_t hash_length,
+                            const uint8_t *signature,
+                            size_t signature_length)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_START_SID,
+        .key_id = key,
+        .alg = alg,
+        .op_handle = operation->handle,
+        .max_ops = g_interruptible_max_ops,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = hash, .len = hash_length},
+        {.base = signature, .len = signature_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
+TFM_CRYPTO_API(psa_status_t, psa_verify_hash_complete)(
+                            psa_verify_hash_interruptible_operation_t *operation)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_COMPLETE_SID,
+        .op_handle = operation->handle,
+        .max_ops = g_interruptible_max_ops,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
+TFM_CRYPTO_API(psa_status_t, psa_verify_hash_abort)(
+                            psa_verify_hash_interruptible_operation_t *operation)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_ABORT_SID,
+        .op_handle = operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
 TFM_CRYPTO_API(psa_status_t, psa_asymmetric_encrypt)(psa_key_id_t key,
                                                      psa_algorithm_t alg,
                                                      const uint8_t *input,
@@ -1407,6 +1612,28 @@ TFM_CRYPTO_API(psa_status_t, psa_generate_random)(uint8_t *output,
     return API_DISPATCH(in_vec, out_vec);
 }
 
+psa_status_t tfm_crypto_generate_random_fresh(uint8_t *output,
+                                              size_t output_size)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_GENERATE_RANDOM_FRESH_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+    };
+
+    if (output_size == 0) {
+        return PSA_SUCCESS;
+    }
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
 TFM_CRYPTO_API(psa_status_t, psa_generate_key)(const psa_key_attributes_t *attributes,
                                                psa_key_id_t *key)
 {
@@ -1690,3 +1917,215 @@ TFM_CRYPTO_API(void, psa_reset_key_attributes)(
 {
     memset(attributes, 0, sizeof(*attributes));
 }
+
+void tfm_crypto_batch_init(struct tfm_crypto_batch_t *batch,
+                           struct tfm_crypto_batch_cmd *cmds,
+                           size_t max_num,
+                           uint8_t *in_buf,
+                           size_t in_size,
+                           uint8_t *out_buf,
+                           size_t out_size)
+{
+    batch->cmds = cmds;
+    batch->max_num = (max_num < TFM_CRYPTO_BATCH_MAX_NUM) ?
+                     max_num : TFM_CRYPTO_BATCH_MAX_NUM;
+    batch->num = 0;
+    batch->in_buf = in_buf;
+    batch->in_size = in_size;
+    batch->in_used = 0;
+    batch->out_buf = out_buf;
+    batch->out_size = out_size;
+    batch->out_used = 0;
+}
+
+/* Gives the offset of the next buffer in a shared buffer of a batch, aligned
+ * as the iovecs of the Crypto service are. The padding after the last buffer
+ * does not have to fit.
+ */
+static size_t tfm_crypto_batch_pad(size_t used, size_t size)
+{
+    used = (used + (TFM_CRYPTO_IOVEC_ALIGNMENT - 1)) &
+           ~(size_t)(TFM_CRYPTO_IOVEC_ALIGNMENT - 1);
+
+    return (used < size) ? used : size;
+}
+
+/* Adds a command with up to two inputs, copied in the shared input buffer,
+ * and up to one output, reserved in the shared output buffer. An unused
+ * buffer is left at offset 0.
+ */
+static psa_status_t tfm_crypto_batch_add(struct tfm_crypto_batch_t *batch,
+                                         const struct tfm_crypto_pack_iovec *iov,
+                                         const uint8_t *input,
+                                         size_t input_length,
+                                         const uint8_t *input2,
+                                         size_t input2_length,
+                                         size_t output_size,
+                                         uint8_t **output)
+{
+    struct tfm_crypto_batch_cmd *cmd;
+    size_t in2_offset = batch->in_used;
+
+    if ((batch->num >= batch->max_num) ||
+        (input_length > batch->in_size - batch->in_used) ||
+        (output_size > batch->out_size - batch->out_used)) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    if (input_length != 0) {
+        in2_offset = tfm_crypto_batch_pad(batch->in_used + input_length,
+                                          batch->in_size);
+    }
+    if (input2_length > batch->in_size - in2_offset) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    cmd = &batch->cmds[batch->num];
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->iov = *iov;
+
+    if (input_length != 0) {
+        cmd->in[0].offset = (uint32_t)batch->in_used;
+        cmd->in[0].len = (uint32_t)input_length;
+        memcpy(&batch->in_buf[batch->in_used], input, input_length);
+        batch->in_used = in2_offset;
+    }
+
+    if (input2_length != 0) {
+        cmd->in[1].offset = (uint32_t)batch->in_used;
+        cmd->in[1].len = (uint32_t)input2_length;
+        memcpy(&batch->in_buf[batch->in_used], input2, input2_length);
+        batch->in_used = tfm_crypto_batch_pad(batch->in_used + input2_length,
+                                              batch->in_size);
+    }
+
+    if (output_size != 0) {
+        cmd->out[0].offset = (uint32_t)batch->out_used;
+        cmd->out[0].len = (uint32_t)output_size;
+    }
+    if (output != NULL) {
+        *output = &batch->out_buf[batch->out_used];
+    }
+    batch->out_used = tfm_crypto_batch_pad(batch->out_used + output_size,
+                                           batch->out_size);
+
+    batch->num++;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_crypto_batch_add_hash_compute(struct tfm_crypto_batch_t *batch,
+                                               psa_algorithm_t alg,
+                                               const uint8_t *input,
+                                               size_t input_length,
+                                               size_t hash_size,
+                                               uint8_t **hash)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_HASH_COMPUTE_SID,
+        .alg = alg,
+    };
+
+    return tfm_crypto_batch_add(batch, &iov, input, input_length, NULL, 0,
+                                hash_size, hash);
+}
+
+psa_status_t tfm_crypto_batch_add_mac_compute(struct tfm_crypto_batch_t *batch,
+                                              psa_key_id_t key,
+                                              psa_algorithm_t alg,
+                                              const uint8_t *input,
+                                              size_t input_length,
+                                              size_t mac_size,
+                                              uint8_t **mac)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_MAC_COMPUTE_SID,
+        .key_id = key,
+        .alg = alg,
+    };
+
+    return tfm_crypto_batch_add(batch, &iov, input, input_length, NULL, 0,
+                                mac_size, mac);
+}
+
+psa_status_t tfm_crypto_batch_add_mac_verify(struct tfm_crypto_batch_t *batch,
+                                             psa_key_id_t key,
+                                             psa_algorithm_t alg,
+                                             const uint8_t *input,
+                                             size_t input_length,
+                                             const uint8_t *mac,
+                                             size_t mac_length)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_MAC_VERIFY_SID,
+        .key_id = key,
+        .alg = alg,
+    };
+
+    return tfm_crypto_batch_add(batch, &iov, input, input_length,
+                                mac, mac_length, 0, NULL);
+}
+
+psa_status_t tfm_crypto_batch_add_cipher_encrypt(
+                                              struct tfm_crypto_batch_t *batch,
+                                              psa_key_id_t key,
+                                              psa_algorithm_t alg,
+                                              const uint8_t *input,
+                                              size_t input_length,
+                                              size_t output_size,
+                                              uint8_t **output)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_CIPHER_ENCRYPT_SID,
+        .key_id = key,
+        .alg = alg,
+    };
+
+    return tfm_crypto_batch_add(batch, &iov, input, input_length, NULL, 0,
+                                output_size, output);
+}
+
+psa_status_t tfm_crypto_batch_add_cipher_decrypt(
+                                              struct tfm_crypto_batch_t *batch,
+                                              psa_key_id_t key,
+                                              psa_algorithm_t alg,
+                                              const uint8_t *input,
+                                              size_t input_length,
+                                              size_t output_size,
+                                              uint8_t **output)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_CIPHER_DECRYPT_SID,
+        .key_id = key,
+        .alg = alg,
+    };
+
+    return tfm_crypto_batch_add(batch, &iov, input, input_length, NULL, 0,
+                                output_size, output);
+}
+
+psa_status_t tfm_crypto_batch_run(const struct tfm_crypto_batch_t *batch,
+                                  struct tfm_crypto_batch_result *results)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_BATCH_SID,
+    };
+
+    if (batch->num == 0) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = batch->cmds,
+         .len = batch->num * sizeof(struct tfm_crypto_batch_cmd)},
+        {.base = batch->in_buf, .len = batch->in_used},
+    };
+    psa_outvec out_vec[] = {
+        {.base = results,
+         .len = batch->num * sizeof(struct tfm_crypto_batch_result)},
+        {.base = batch->out_buf, .len = batch->out_used},
+    };
+
+    return API_DISPATCH(in_vec, out_vec);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,6 +9,9 @@
 #include "psa/internal_trusted_storage.h"
 #include "psa_manifest/sid.h"
 #include "tfm_its_defs.h"
+#include "tfm_its_transaction.h"
+#include "tfm_its_wear_stats.h"
+#include "tfm_its_compact.h"
 
 psa_status_t psa_its_set(psa_storage_uid_t uid,
                          size_t data_length,
@@ -91,3 +94,64 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
 
     return status;
 }
+
+psa_status_t tfm_its_transaction_begin(void)
+{
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_TRANSACTION_BEGIN, NULL, 0, NULL, 0);
+}
+
+psa_status_t tfm_its_transaction_set(psa_storage_uid_t uid,
+                                     size_t data_length,
+                                     const void *p_data,
+                                     psa_storage_create_flags_t create_flags)
+{
+    psa_invec in_vec[] = {
+        { .base = &uid, .len = sizeof(uid) },
+        { .base = p_data, .len = data_length },
+        { .base = &create_flags, .len = sizeof(create_flags) }
+    };
+
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_TRANSACTION_SET, in_vec, IOVEC_LEN(in_vec),
+                    NULL, 0);
+}
+
+psa_status_t tfm_its_transaction_remove(psa_storage_uid_t uid)
+{
+    psa_invec in_vec[] = {
+        { .base = &uid, .len = sizeof(uid) }
+    };
+
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_TRANSACTION_REMOVE, in_vec, IOVEC_LEN(in_vec),
+                    NULL, 0);
+}
+
+psa_status_t tfm_its_transaction_commit(void)
+{
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_TRANSACTION_COMMIT, NULL, 0, NULL, 0);
+}
+
+psa_status_t tfm_its_transaction_abort(void)
+{
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_TRANSACTION_ABORT, NULL, 0, NULL, 0);
+}
+
+psa_status_t tfm_its_get_wear_stats(struct tfm_its_wear_stats_t *p_stats)
+{
+    psa_outvec out_vec[] = {
+        { .base = p_stats, .len = sizeof(*p_stats) }
+    };
+
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_WEAR_STATS, NULL, 0, out_vec, IOVEC_LEN(out_vec));
+}
+
+psa_status_t tfm_its_compact_step(void)
+{
+    return psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                    TFM_ITS_COMPACT_STEP, NULL, 0, NULL, 0);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,6 +9,7 @@
 #include "psa/client.h"
 #include "psa/service.h"
 #include "tfm_psa_call_pack.h"
+#include "tfm_psa_call_batch.h"
 
 psa_status_t psa_call(psa_handle_t handle,
                       int32_t type,
@@ -27,3 +28,36 @@ psa_status_t psa_call(psa_handle_t handle,
     return tfm_psa_call_pack(handle, PARAM_PACK(type, in_len, out_len),
                              in_vec, out_vec);
 }
+
+psa_status_t tfm_psa_call_batch(struct tfm_psa_call_desc_t *descs,
+                                size_t num)
+{
+    size_t i;
+
+    if ((descs == NULL) ||
+        (num   == 0)    ||
+        (num   > TFM_PSA_CALL_BATCH_MAX_NUM)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /*
+     * Secure clients enter SPM once per request anyway, so the batch is a
+     * plain loop here. It is provided to keep one client API for both sides.
+     */
+    for (i = 0; i < num; i++) {
+        /* As on the Non-secure side, an invalid request fails on its own */
+        if ((descs[i].type    > PSA_CALL_TYPE_MAX) ||
+            (descs[i].type    < PSA_CALL_TYPE_MIN) ||
+            (descs[i].in_len  > PSA_MAX_IOVEC)     ||
+            (descs[i].out_len > PSA_MAX_IOVEC)) {
+            descs[i].status = PSA_ERROR_PROGRAMMER_ERROR;
+            continue;
+        }
+
+        descs[i].status = psa_call(descs[i].handle, descs[i].type,
+                                   descs[i].in_vec, descs[i].in_len,
+                                   descs[i].out_vec, descs[i].out_len);
+    }
+
+    return PSA_SUCCESS;
+}
@@ -8,6 +8,7 @@
 #include "psa/client.h"
 #include "tfm_ns_interface.h"
 #include "tfm_psa_call_pack.h"
+#include "tfm_psa_call_batch.h"
 
 /**** API functions ****/
 
@@ -52,6 +53,23 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
                                 (uint32_t)out_vec);
 }
 
+psa_status_t tfm_psa_call_batch(struct tfm_psa_call_desc_t *descs,
+                                size_t num)
+{
+    if ((descs == NULL) ||
+        (num   == 0)    ||
+        (num   > TFM_PSA_CALL_BATCH_MAX_NUM)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return tfm_ns_interface_dispatch(
+                                (veneer_fn)tfm_psa_call_batch_veneer,
+                                (uint32_t)descs,
+                                (uint32_t)num,
+                                0,
+                                0);
+}
+
 psa_handle_t psa_connect(uint32_t sid, uint32_t version)
 {
     return tfm_ns_interface_dispatch((veneer_fn)tfm_psa_connect_veneer, sid, version, 0, 0);
@@ -136,6 +136,16 @@
  */
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/**
+ * \def MBEDTLS_ECP_RESTARTABLE
+ *
+ * Enable the restartable ECC operations, needed by the PSA interruptible
+ * sign and verify hash functions.
+ */
+#if CRYPTO_ASYM_SIGN_INTERRUPTIBLE
+#define MBEDTLS_ECP_RESTARTABLE
+#endif
+
 /**
  * \def MBEDTLS_PK_PARSE_EC_EXTENDED
  *
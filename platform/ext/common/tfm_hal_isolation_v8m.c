@@ -17,6 +17,7 @@
 #include "region.h"
 #include "armv8m_mpu.h"
 #include "common_target_cfg.h"
+#include "config_tfm.h"
 #include "tfm_hal_defs.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_peripherals_def.h"
@@ -99,6 +100,97 @@ REGION_DECLARE(Image$$, PT_PSA_ROT_DATA_END, $$Base);
 
 #endif /* CONFIG_TFM_ENABLE_MEMORY_PROTECT */
 
+#if CONFIG_TFM_MEM_CHECK_CACHE_NUM > 0
+/*
+ * Ranges which passed cmse_check_address_range() recently. An entry is only
+ * valid for the boundary and the CMSE flags it was checked with, so a change
+ * of the caller privilege or of the access type never hits a stale entry.
+ * Entries depend on the SAU, MPC and MPU settings, which only change while
+ * boundaries are set up or bound, when the cache is flushed.
+ */
+struct mem_check_cache_entry_t {
+    uintptr_t boundary;
+    uintptr_t base;         /* Zero for an unused entry */
+    uintptr_t limit;        /* Last byte of the range */
+    int       flags;
+};
+
+static struct mem_check_cache_entry_t mem_check_cache[CONFIG_TFM_MEM_CHECK_CACHE_NUM];
+static uint32_t mem_check_cache_victim;
+
+static void mem_check_cache_flush(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < CONFIG_TFM_MEM_CHECK_CACHE_NUM; i++) {
+        mem_check_cache[i].base = 0;
+    }
+}
+
+static bool mem_check_cache_usable(int flags)
+{
+    /*
+     * The Non-secure MPU is programmed by the NSPE at any time, for example on
+     * each NS thread switch. Results depending on it can not be kept.
+     */
+    if ((flags & CMSE_NONSECURE) && (MPU_NS->CTRL & MPU_CTRL_ENABLE_Msk)) {
+        return false;
+    }
+
+    return true;
+}
+
+static bool mem_check_cache_lookup(uintptr_t boundary, uintptr_t base,
+                                   uintptr_t limit, int flags)
+{
+    const struct mem_check_cache_entry_t *p_entry;
+    bool hit = false;
+    uint32_t primask;
+    uint32_t i;
+
+    /* A read-write check also covers a read check of the same range */
+    int flags_rw = (flags & ~CMSE_MPU_READ) | CMSE_MPU_READWRITE;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    for (i = 0; i < CONFIG_TFM_MEM_CHECK_CACHE_NUM; i++) {
+        p_entry = &mem_check_cache[i];
+        if ((p_entry->base != 0) && (p_entry->boundary == boundary) &&
+            ((p_entry->flags == flags) || (p_entry->flags == flags_rw)) &&
+            (base >= p_entry->base) && (limit <= p_entry->limit)) {
+            hit = true;
+            break;
+        }
+    }
+
+    __set_PRIMASK(primask);
+
+    return hit;
+}
+
+static void mem_check_cache_insert(uintptr_t boundary, uintptr_t base,
+                                   uintptr_t limit, int flags)
+{
+    struct mem_check_cache_entry_t *p_entry;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    p_entry = &mem_check_cache[mem_check_cache_victim];
+    mem_check_cache_victim = (mem_check_cache_victim + 1) %
+                             CONFIG_TFM_MEM_CHECK_CACHE_NUM;
+
+    p_entry->boundary = boundary;
+    p_entry->base     = base;
+    p_entry->limit    = limit;
+    p_entry->flags    = flags;
+
+    __set_PRIMASK(primask);
+}
+#endif /* CONFIG_TFM_MEM_CHECK_CACHE_NUM > 0 */
+
 enum tfm_hal_status_t tfm_hal_set_up_static_boundaries(
                                             uintptr_t *p_spm_boundary)
 {
@@ -271,6 +363,10 @@ const ARM_MPU_Region_t mpu_region_attributes[] = {
 };
 #endif /* CONFIG_TFM_ENABLE_MEMORY_PROTECT */
 
+#if CONFIG_TFM_MEM_CHECK_CACHE_NUM > 0
+    mem_check_cache_flush();
+#endif
+
     /* Set up isolation boundaries between SPE and NSPE */
     sau_and_idau_cfg();
     if (mpc_init_cfg() != TFM_PLAT_ERR_SUCCESS) {
@@ -407,6 +503,11 @@ enum tfm_hal_status_t tfm_hal_bind_boundary(
         return TFM_HAL_ERROR_GENERIC;
     }
 
+#if CONFIG_TFM_MEM_CHECK_CACHE_NUM > 0
+    /* The MPU may be updated below */
+    mem_check_cache_flush();
+#endif
+
 #if TFM_ISOLATION_LEVEL == 1
     privileged = true;
 #else
@@ -725,6 +826,22 @@ enum tfm_hal_status_t tfm_hal_memory_check(uintptr_t boundary, uintptr_t base,
         flags |= CMSE_NONSECURE;
     }
 
+#if CONFIG_TFM_MEM_CHECK_CACHE_NUM > 0
+    /* Wrapping ranges are left to cmse_check_address_range() to reject */
+    if ((base + size - 1 >= base) && mem_check_cache_usable(flags)) {
+        if (mem_check_cache_lookup(boundary, base, base + size - 1, flags)) {
+            return TFM_HAL_SUCCESS;
+        }
+
+        if (cmse_check_address_range((void *)base, size, flags) == NULL) {
+            return TFM_HAL_ERROR_MEM_FAULT;
+        }
+
+        mem_check_cache_insert(boundary, base, base + size - 1, flags);
+        return TFM_HAL_SUCCESS;
+    }
+#endif /* CONFIG_TFM_MEM_CHECK_CACHE_NUM > 0 */
+
     if (cmse_check_address_range((void *)base, size, flags) != NULL) {
         return TFM_HAL_SUCCESS;
     } else {
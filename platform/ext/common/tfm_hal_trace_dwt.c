@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "config_tfm.h"
+#include "tfm_hal_device_header.h"
+#include "tfm_hal_trace.h"
+
+#if CONFIG_TFM_SPM_TRACE == 1
+
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_BASE__)
+#error "DWT cycle counter is not available, provide a platform trace timer."
+#endif
+
+enum tfm_hal_status_t tfm_hal_trace_timer_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    /* The cycle counter is optional, NOCYCCNT is set when it is absent. */
+    if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) {
+        return TFM_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    return TFM_HAL_SUCCESS;
+}
+
+uint32_t tfm_hal_trace_get_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif /* CONFIG_TFM_SPM_TRACE == 1 */
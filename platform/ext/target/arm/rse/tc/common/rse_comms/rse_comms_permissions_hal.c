@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -111,6 +111,7 @@ enum tfm_plat_err_t comms_permissions_service_check(psa_handle_t handle,
             switch(function_id) {
             case TFM_CRYPTO_EXPORT_PUBLIC_KEY_SID:
             case TFM_CRYPTO_GENERATE_RANDOM_SID:
+            case TFM_CRYPTO_GENERATE_RANDOM_FRESH_SID:
                 return TFM_PLAT_ERR_SUCCESS;
             default:
                 goto out_err;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -17,6 +17,18 @@ typedef int32_t    mailbox_msg_handle_t;
 
 #define MAILBOX_MSG_NULL_HANDLE             ((mailbox_msg_handle_t)0)
 
+/*
+ * Number of SPE mailbox queue slots. Any empty SPE slot can hold the message
+ * of any NSPE slot, so SPE concurrency can be tuned without changing NSPE.
+ */
+#ifndef NUM_SPE_MAILBOX_QUEUE_SLOT
+#define NUM_SPE_MAILBOX_QUEUE_SLOT          NUM_MAILBOX_QUEUE_SLOT
+#endif
+
+#if (NUM_SPE_MAILBOX_QUEUE_SLOT < 1) || (NUM_SPE_MAILBOX_QUEUE_SLOT > 255)
+#error "Error: Invalid NUM_SPE_MAILBOX_QUEUE_SLOT. The value should be between 1 and 255"
+#endif
+
 /* A single slot structure in SPE mailbox queue */
 struct secure_mailbox_slot_t {
     struct mailbox_msg_t msg;
@@ -25,10 +37,23 @@ struct secure_mailbox_slot_t {
     mailbox_msg_handle_t msg_handle;
 };
 
+/* Number of mailbox_queue_status_t words in the SPE empty slot bitmask */
+#define MAILBOX_EMPTY_STATUS_WORDS  ((NUM_SPE_MAILBOX_QUEUE_SLOT + 31) / 32)
+
 struct secure_mailbox_queue_t {
-    mailbox_queue_status_t       empty_slots;      /* bitmask of empty slots */
+    /* bitmask of empty slots */
+    mailbox_queue_status_t       empty_slots[MAILBOX_EMPTY_STATUS_WORDS];
+
+#ifdef MAILBOX_RING_TRANSPORT
+    /*
+     * SPE owned ring indices. They are only published to the shared status,
+     * never read back from it.
+     */
+    uint32_t                     req_tail;
+    uint32_t                     cpl_head;
+#endif
 
-    struct secure_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
+    struct secure_mailbox_slot_t queue[NUM_SPE_MAILBOX_QUEUE_SLOT];
     /* Shared data with fixed size */
     struct mailbox_status_t       *ns_status;
     /* Number of slots allocated by NS. */
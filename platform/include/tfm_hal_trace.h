@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_HAL_TRACE_H__
+#define __TFM_HAL_TRACE_H__
+
+#include <stdint.h>
+
+#include "tfm_hal_defs.h"
+
+/**
+ * \brief Start the free-running counter used to timestamp SPM trace records.
+ *
+ * \retval TFM_HAL_SUCCESS        The counter is running.
+ * \retval Other code             The counter can not be started.
+ */
+enum tfm_hal_status_t tfm_hal_trace_timer_init(void);
+
+/**
+ * \brief Read the SPM trace counter.
+ *
+ * \note This is called from SPM with interrupts masked, it must be short and
+ *       must not block. The counter is expected to wrap at 32 bits.
+ *
+ * \return The current counter value, in platform-defined cycles.
+ */
+uint32_t tfm_hal_trace_get_cycles(void);
+
+#endif /* __TFM_HAL_TRACE_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -19,4 +19,18 @@
 #error "Invalid config: NOT CRYPTO_NV_SEED AND NOT CRYPTO_EXT_RNG!"
 #endif
 
+/* The operation handles hold the context index plus one in 8 bits */
+#if (CRYPTO_CONC_OPER_NUM < 1) || (CRYPTO_CONC_OPER_NUM > 255)
+#error "Invalid config: CRYPTO_CONC_OPER_NUM out of range!"
+#endif
+
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM > CRYPTO_CONC_OPER_NUM
+#error "Invalid config: CRYPTO_CONC_OPER_PER_CLIENT_NUM > CRYPTO_CONC_OPER_NUM!"
+#endif
+
+#if (CRYPTO_RNG_POOL_SIZE > 0) && \
+    (CRYPTO_RNG_POOL_MAX_REQUEST > CRYPTO_RNG_POOL_SIZE)
+#error "Invalid config: CRYPTO_RNG_POOL_MAX_REQUEST > CRYPTO_RNG_POOL_SIZE!"
+#endif
+
 #endif /* __CONFIG_PARTITION_CRYPTO_H__ */
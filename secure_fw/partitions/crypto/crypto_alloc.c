@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -28,12 +28,34 @@ enum {
  */
 #define TFM_CRYPTO_INVALID_HANDLE (0x0u)
 
+/**
+ * \brief Handles are made of the index of the context plus one, in the low
+ *        bits, and of the generation of the context, which is incremented each
+ *        time the context is released, so that a stale handle is rejected once
+ *        the context has been reused.
+ */
+#define TFM_CRYPTO_HANDLE_INDEX_BITS (8u)
+#define TFM_CRYPTO_HANDLE_INDEX_MASK ((1u << TFM_CRYPTO_HANDLE_INDEX_BITS) - 1u)
+#define TFM_CRYPTO_HANDLE(index, generation) \
+    (((generation) << TFM_CRYPTO_HANDLE_INDEX_BITS) | ((index) + 1u))
+#define TFM_CRYPTO_HANDLE_INDEX(handle) \
+    (((handle) & TFM_CRYPTO_HANDLE_INDEX_MASK) - 1u)
+
 /**
  * \brief A type describing the context stored in Secure memory by the TF-M Crypto
  *        service to support multipart calls on secure side
  */
 struct tfm_crypto_operation_s {
     uint32_t in_use;                /*!< Indicates if the operation is in use */
+    uint32_t handle;                /*!< Handle of the context, valid while in
+                                     *   use
+                                     */
+    uint32_t generation;            /*!< Incremented each time the context is
+                                     *   released
+                                     */
+    uint32_t next_free;             /*!< Index of the next free context, while
+                                     *   not in use
+                                     */
     int32_t owner;                  /*!< Indicates an ID of the owner of
                                      *   the context
                                      */
@@ -44,11 +66,109 @@ struct tfm_crypto_operation_s {
         psa_hash_operation_t hash;        /*!< Hash operation context */
         psa_key_derivation_operation_t key_deriv; /*!< Key derivation operation context */
         psa_aead_operation_t aead;        /*!< AEAD operation context */
+#if CRYPTO_ASYM_SIGN_INTERRUPTIBLE
+        psa_sign_hash_interruptible_operation_t sign_hash;
+                                          /*!< Interruptible sign hash
+                                           *   operation context
+                                           */
+        psa_verify_hash_interruptible_operation_t verify_hash;
+                                          /*!< Interruptible verify hash
+                                           *   operation context
+                                           */
+#endif
     } operation;
 };
 
 static struct tfm_crypto_operation_s operations[CRYPTO_CONC_OPER_NUM] = {{0}};
 
+/* Index of the first free context, CRYPTO_CONC_OPER_NUM if there is none */
+static uint32_t free_head;
+
+/* Usage counters of the contexts */
+static struct tfm_crypto_alloc_stats_t alloc_stats;
+
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM
+/*
+ * Number of contexts held by each client holding at least one, in the first
+ * num_owners entries. There are fewer such clients than contexts.
+ */
+static struct {
+    int32_t owner;
+    uint32_t count;
+} owner_counts[CRYPTO_CONC_OPER_NUM];
+static uint32_t num_owners;
+#endif
+
+/*
+ * \brief Function used to look up the context referred to by an handle
+ *
+ * \param[in] handle Handle of the context
+ *
+ * \return Pointer to the context in use with this handle, NULL otherwise
+ *
+ */
+static struct tfm_crypto_operation_s *get_operation(uint32_t handle)
+{
+    uint32_t index = TFM_CRYPTO_HANDLE_INDEX(handle);
+
+    /* An invalid handle wraps around to an out of range index */
+    if (index >= CRYPTO_CONC_OPER_NUM) {
+        return NULL;
+    }
+
+    if ((operations[index].in_use != TFM_CRYPTO_IN_USE) ||
+        (operations[index].handle != handle)) {
+        return NULL;
+    }
+
+    return &operations[index];
+}
+
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM
+/*
+ * \brief Function used to find the count of the contexts held by a client
+ *
+ * \param[in] owner ID of the client
+ *
+ * \return Index of the count of the client, num_owners if it holds none
+ *
+ */
+static uint32_t find_owner_count(int32_t owner)
+{
+    uint32_t i;
+
+    for (i = 0; i < num_owners; i++) {
+        if (owner_counts[i].owner == owner) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/*
+ * \brief Function used to drop a context from the count of its client
+ *
+ * \param[in] owner ID of the client
+ *
+ * \return None
+ *
+ */
+static void put_owner_count(int32_t owner)
+{
+    uint32_t i = find_owner_count(owner);
+
+    if (i == num_owners) {
+        return;
+    }
+
+    /* Keep the clients holding contexts in the first entries */
+    if (--owner_counts[i].count == 0) {
+        owner_counts[i] = owner_counts[--num_owners];
+    }
+}
+#endif /* CRYPTO_CONC_OPER_PER_CLIENT_NUM */
+
 /*
  * \brief Function used to clear the memory associated to a backend context
  *
@@ -73,8 +193,21 @@ static void memset_operation_context(uint32_t index)
 /*!@{*/
 psa_status_t tfm_crypto_init_alloc(void)
 {
+    uint32_t i;
+
     /* Clear the contents of the local contexts */
     (void)memset(operations, 0, sizeof(operations));
+    (void)memset(&alloc_stats, 0, sizeof(alloc_stats));
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM
+    num_owners = 0;
+#endif
+
+    /* Chain all the contexts in the free list */
+    for (i = 0; i < CRYPTO_CONC_OPER_NUM; i++) {
+        operations[i].next_free = i + 1;
+    }
+    free_head = 0;
+
     return PSA_SUCCESS;
 }
 
@@ -85,6 +218,9 @@ psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
     uint32_t i = 0;
     int32_t partition_id = 0;
     psa_status_t status;
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM
+    uint32_t owner_idx;
+#endif
 
     /* Handle must be initialised before calling a setup function */
     if (*handle != TFM_CRYPTO_INVALID_HANDLE) {
@@ -102,31 +238,62 @@ psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
         return status;
     }
 
-    for (i = 0; i < CRYPTO_CONC_OPER_NUM; i++) {
-        if (operations[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            operations[i].in_use = TFM_CRYPTO_IN_USE;
-            operations[i].owner = partition_id;
-            operations[i].type = type;
-            *handle = i + 1;
-            *ctx = (void *) &(operations[i].operation);
-            return PSA_SUCCESS;
-        }
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM
+    /* Prevent a single client from taking all the contexts */
+    owner_idx = find_owner_count(partition_id);
+    if ((owner_idx < num_owners) &&
+        (owner_counts[owner_idx].count >= CRYPTO_CONC_OPER_PER_CLIENT_NUM)) {
+        alloc_stats.alloc_failures++;
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+#endif
+
+    if (free_head == CRYPTO_CONC_OPER_NUM) {
+        alloc_stats.alloc_failures++;
+        return PSA_ERROR_NOT_PERMITTED;
     }
 
-    return PSA_ERROR_NOT_PERMITTED;
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM
+    /* A context is free, so fewer clients than contexts hold one */
+    if (owner_idx == num_owners) {
+        owner_counts[owner_idx].owner = partition_id;
+        owner_counts[owner_idx].count = 0;
+        num_owners++;
+    }
+    owner_counts[owner_idx].count++;
+#endif
+
+    i = free_head;
+    free_head = operations[i].next_free;
+
+    operations[i].in_use = TFM_CRYPTO_IN_USE;
+    operations[i].owner = partition_id;
+    operations[i].type = type;
+    operations[i].handle = TFM_CRYPTO_HANDLE(i, operations[i].generation);
+    *handle = operations[i].handle;
+    *ctx = (void *) &(operations[i].operation);
+
+    alloc_stats.in_use++;
+    if (alloc_stats.in_use > alloc_stats.high_water_mark) {
+        alloc_stats.high_water_mark = alloc_stats.in_use;
+    }
+
+    return PSA_SUCCESS;
 }
 
 psa_status_t tfm_crypto_operation_release(uint32_t *handle)
 {
     uint32_t h_val = *handle;
+    struct tfm_crypto_operation_s *operation;
+    uint32_t index;
     int32_t partition_id = 0;
     psa_status_t status;
 
     /* Handle shall be cleaned up always at first */
     *handle = TFM_CRYPTO_INVALID_HANDLE;
 
-    if ((h_val == TFM_CRYPTO_INVALID_HANDLE) ||
-        (h_val > CRYPTO_CONC_OPER_NUM)) {
+    operation = get_operation(h_val);
+    if (operation == NULL) {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
@@ -135,13 +302,27 @@ psa_status_t tfm_crypto_operation_release(uint32_t *handle)
         return status;
     }
 
-    if ((operations[h_val - 1].in_use == TFM_CRYPTO_IN_USE) &&
-        (operations[h_val - 1].owner == partition_id)) {
+    if (operation->owner == partition_id) {
+        index = TFM_CRYPTO_HANDLE_INDEX(h_val);
+
+        memset_operation_context(index);
+        operation->in_use = TFM_CRYPTO_NOT_IN_USE;
+        operation->type = TFM_CRYPTO_OPERATION_NONE;
+        operation->owner = 0;
+        operation->handle = TFM_CRYPTO_INVALID_HANDLE;
 
-        memset_operation_context(h_val - 1);
-        operations[h_val - 1].in_use = TFM_CRYPTO_NOT_IN_USE;
-        operations[h_val - 1].type = TFM_CRYPTO_OPERATION_NONE;
-        operations[h_val - 1].owner = 0;
+        /* Invalidate the handles of the context. The generation is truncated
+         * to the bits available in the handles.
+         */
+        operation->generation = (operation->generation + 1) &
+                                (UINT32_MAX >> TFM_CRYPTO_HANDLE_INDEX_BITS);
+
+        operation->next_free = free_head;
+        free_head = index;
+        alloc_stats.in_use--;
+#if CRYPTO_CONC_OPER_PER_CLIENT_NUM
+        put_owner_count(partition_id);
+#endif
 
         return PSA_SUCCESS;
     }
@@ -153,11 +334,12 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
                                          uint32_t handle,
                                          void **ctx)
 {
+    struct tfm_crypto_operation_s *operation;
     int32_t partition_id = 0;
     psa_status_t status;
 
-    if ((handle == TFM_CRYPTO_INVALID_HANDLE) ||
-        (handle > CRYPTO_CONC_OPER_NUM)) {
+    operation = get_operation(handle);
+    if (operation == NULL) {
         return PSA_ERROR_BAD_STATE;
     }
 
@@ -170,13 +352,16 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
         return status;
     }
 
-    if ((operations[handle - 1].in_use == TFM_CRYPTO_IN_USE) &&
-        (operations[handle - 1].type == type) &&
-        (operations[handle - 1].owner == partition_id)) {
-        *ctx = (void *) &(operations[handle - 1].operation);
+    if ((operation->type == type) && (operation->owner == partition_id)) {
+        *ctx = (void *) &(operation->operation);
         return PSA_SUCCESS;
     }
 
     return PSA_ERROR_BAD_STATE;
 }
+
+void tfm_crypto_operation_get_stats(struct tfm_crypto_alloc_stats_t *stats)
+{
+    *stats = alloc_stats;
+}
 /*!@}*/
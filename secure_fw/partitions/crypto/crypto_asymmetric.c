@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -24,6 +25,161 @@
 
 /*!@{*/
 #if CRYPTO_ASYM_SIGN_MODULE_ENABLED
+#if CRYPTO_ASYM_SIGN_INTERRUPTIBLE
+/**
+ * \brief Handles the interruptible sign and verify hash functions, whose
+ *        operations are stored in the multipart operation contexts. Each call
+ *        runs at most the max ops set by the client, so that the requests of
+ *        other clients are served between the calls of a long operation.
+ *
+ * \param[in]  in_vec      Array of invec parameters
+ * \param[out] out_vec     Array of outvec parameters
+ * \param[in]  library_key Key encoded with partition_id and key_id
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_asymmetric_interruptible(
+                                        psa_invec in_vec[],
+                                        psa_outvec out_vec[],
+                                        tfm_crypto_library_key_id_t library_key)
+{
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    enum tfm_crypto_func_sid_t sid = (enum tfm_crypto_func_sid_t)iov->function_id;
+    psa_status_t status;
+    void *operation = NULL;
+    uint32_t *p_handle = NULL;
+    bool is_sign = (sid == TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_START_SID) ||
+                   (sid == TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_COMPLETE_SID) ||
+                   (sid == TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_ABORT_SID) ||
+                   (sid == TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_GET_NUM_OPS_SID);
+    enum tfm_crypto_operation_type type =
+        is_sign ? TFM_CRYPTO_SIGN_HASH_OPERATION
+                : TFM_CRYPTO_VERIFY_HASH_OPERATION;
+
+    if ((sid == TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_GET_NUM_OPS_SID) ||
+        (sid == TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_GET_NUM_OPS_SID)) {
+        if ((out_vec[0].base == NULL) || (out_vec[0].len < sizeof(uint32_t))) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+
+        status = tfm_crypto_operation_lookup(type, iov->op_handle, &operation);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        *(uint32_t *)out_vec[0].base = is_sign ?
+                                       psa_sign_hash_get_num_ops(operation) :
+                                       psa_verify_hash_get_num_ops(operation);
+        return PSA_SUCCESS;
+    }
+
+    /*
+     * The other functions put the handle in out_vec[0], which is set to the
+     * original handle value so that it is not overridden if the lookup fails.
+     */
+    p_handle = out_vec[0].base;
+    if ((out_vec[0].base == NULL) || (out_vec[0].len < sizeof(uint32_t))) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+    *p_handle = iov->op_handle;
+
+    if ((sid == TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_START_SID) ||
+        (sid == TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_START_SID)) {
+        status = tfm_crypto_operation_alloc(type, p_handle, &operation);
+    } else {
+        status = tfm_crypto_operation_lookup(type, iov->op_handle, &operation);
+    }
+    if (status != PSA_SUCCESS) {
+        if ((sid == TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_ABORT_SID) ||
+            (sid == TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_ABORT_SID)) {
+            /* Abort can be called multiple times */
+            return PSA_SUCCESS;
+        }
+        return status;
+    }
+
+    /* The library has a single limit for all the interruptible operations,
+     * set it to the one of the caller.
+     */
+    psa_interruptible_set_max_ops(iov->max_ops);
+
+    switch (sid) {
+    case TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_START_SID:
+    {
+        const uint8_t *hash = in_vec[1].base;
+        size_t hash_length = in_vec[1].len;
+
+        status = psa_sign_hash_start(operation, library_key, iov->alg,
+                                     hash, hash_length);
+        if (status != PSA_SUCCESS) {
+            goto release_operation_and_return;
+        }
+    }
+    break;
+    case TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_COMPLETE_SID:
+    {
+        uint8_t *signature = out_vec[1].base;
+        size_t signature_size = out_vec[1].len;
+
+        status = psa_sign_hash_complete(operation, signature, signature_size,
+                                        &(out_vec[1].len));
+        if (status == PSA_OPERATION_INCOMPLETE) {
+            out_vec[1].len = 0;
+            return status;
+        }
+        if (status != PSA_SUCCESS) {
+            out_vec[1].len = 0;
+        }
+        /* The operation has ended, successfully or not */
+        goto release_operation_and_return;
+    }
+    case TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_ABORT_SID:
+    {
+        status = psa_sign_hash_abort(operation);
+        goto release_operation_and_return;
+    }
+    case TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_START_SID:
+    {
+        const uint8_t *hash = in_vec[1].base;
+        size_t hash_length = in_vec[1].len;
+        const uint8_t *signature = in_vec[2].base;
+        size_t signature_length = in_vec[2].len;
+
+        status = psa_verify_hash_start(operation, library_key, iov->alg,
+                                       hash, hash_length,
+                                       signature, signature_length);
+        if (status != PSA_SUCCESS) {
+            goto release_operation_and_return;
+        }
+    }
+    break;
+    case TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_COMPLETE_SID:
+    {
+        status = psa_verify_hash_complete(operation);
+        if (status == PSA_OPERATION_INCOMPLETE) {
+            return status;
+        }
+        /* The operation has ended, successfully or not */
+        goto release_operation_and_return;
+    }
+    case TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_ABORT_SID:
+    {
+        status = psa_verify_hash_abort(operation);
+        goto release_operation_and_return;
+    }
+    default:
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    return status;
+
+release_operation_and_return:
+    /* Release the operation context, ignore if the release fails. */
+    (void)tfm_crypto_operation_release(p_handle);
+    return status;
+}
+#endif /* CRYPTO_ASYM_SIGN_INTERRUPTIBLE */
+
 psa_status_t tfm_crypto_asymmetric_sign_interface(psa_invec in_vec[],
                                                   psa_outvec out_vec[],
                                                   struct tfm_crypto_key_id_s *encoded_key)
@@ -82,6 +238,18 @@ psa_status_t tfm_crypto_asymmetric_sign_interface(psa_invec in_vec[],
         return psa_verify_hash(library_key, iov->alg, hash, hash_length,
                                signature, signature_length);
     }
+#if CRYPTO_ASYM_SIGN_INTERRUPTIBLE
+    case TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_START_SID:
+    case TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_COMPLETE_SID:
+    case TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_ABORT_SID:
+    case TFM_CRYPTO_ASYMMETRIC_SIGN_HASH_GET_NUM_OPS_SID:
+    case TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_START_SID:
+    case TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_COMPLETE_SID:
+    case TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_ABORT_SID:
+    case TFM_CRYPTO_ASYMMETRIC_VERIFY_HASH_GET_NUM_OPS_SID:
+        return tfm_crypto_asymmetric_interruptible(in_vec, out_vec,
+                                                   library_key);
+#endif /* CRYPTO_ASYM_SIGN_INTERRUPTIBLE */
     default:
         return PSA_ERROR_NOT_SUPPORTED;
     }
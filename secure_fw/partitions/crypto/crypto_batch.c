@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "config_tfm.h"
+#include "tfm_mbedcrypto_include.h"
+
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+
+/*!
+ * \addtogroup tfm_crypto_api_shim_layer
+ *
+ */
+
+/*!@{*/
+#if CRYPTO_BATCH_MODULE_ENABLED
+/**
+ * \brief Checks that a buffer of a command lies in the shared buffer of the
+ *        batch and gives its address
+ *
+ * \param[in]  buf         Location of the buffer in the shared buffer
+ * \param[in]  shared      Base of the shared buffer
+ * \param[in]  shared_len  Length of the shared buffer
+ * \param[out] p_base      Address of the buffer
+ *
+ * \return PSA_SUCCESS, or PSA_ERROR_INVALID_ARGUMENT if the buffer does not
+ *         lie in the shared buffer or is not aligned as a separate iovec is
+ */
+static psa_status_t batch_locate(const struct tfm_crypto_batch_buf *buf,
+                                 uint8_t *shared,
+                                 size_t shared_len,
+                                 void **p_base)
+{
+    if ((buf->offset % TFM_CRYPTO_IOVEC_ALIGNMENT) != 0) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((buf->offset > shared_len) || (buf->len > shared_len - buf->offset)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *p_base = (shared != NULL) ? &shared[buf->offset] : NULL;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Runs a single command of a batch through the dispatcher
+ *
+ * \param[in]  cmd      Command, copied out of the client memory
+ * \param[in]  in_vec   Invecs of the batch request
+ * \param[in]  out_vec  Outvecs of the batch request
+ * \param[out] result   Result of the command
+ * \param[out] out_end  End offset of the data written in the shared output
+ *                      buffer, updated if the command writes beyond it
+ */
+static void batch_run_cmd(const struct tfm_crypto_batch_cmd *cmd,
+                          const psa_invec in_vec[],
+                          const psa_outvec out_vec[],
+                          struct tfm_crypto_batch_result *result,
+                          size_t *out_end)
+{
+    psa_invec cmd_in[1 + TFM_CRYPTO_BATCH_MAX_IN] = { {NULL, 0} };
+    psa_outvec cmd_out[TFM_CRYPTO_BATCH_MAX_OUT] = { {NULL, 0} };
+    size_t in_len = 1, out_len = 0, i;
+    void *base;
+    psa_status_t status;
+
+    (void)memset(result, 0, sizeof(*result));
+
+    /* Commands are not allowed to nest batches */
+    if (TFM_CRYPTO_GET_GROUP_ID(cmd->iov.function_id) ==
+                                                   TFM_CRYPTO_GROUP_ID_BATCH) {
+        result->status = PSA_ERROR_NOT_SUPPORTED;
+        return;
+    }
+
+    cmd_in[0].base = &cmd->iov;
+    cmd_in[0].len = sizeof(struct tfm_crypto_pack_iovec);
+
+    for (i = 0; i < TFM_CRYPTO_BATCH_MAX_IN; i++) {
+        status = batch_locate(&cmd->in[i], (uint8_t *)in_vec[2].base,
+                              in_vec[2].len, &base);
+        if (status != PSA_SUCCESS) {
+            result->status = status;
+            return;
+        }
+        cmd_in[1 + i].base = base;
+        cmd_in[1 + i].len = cmd->in[i].len;
+        if (cmd->in[i].len != 0) {
+            in_len = 2 + i;
+        }
+    }
+
+    for (i = 0; i < TFM_CRYPTO_BATCH_MAX_OUT; i++) {
+        status = batch_locate(&cmd->out[i], (uint8_t *)out_vec[1].base,
+                              out_vec[1].len, &base);
+        if (status != PSA_SUCCESS) {
+            result->status = status;
+            return;
+        }
+        cmd_out[i].base = base;
+        cmd_out[i].len = cmd->out[i].len;
+        if (cmd->out[i].len != 0) {
+            out_len = 1 + i;
+        }
+    }
+
+    result->status = tfm_crypto_api_dispatcher(cmd_in, in_len,
+                                               cmd_out, out_len);
+
+    for (i = 0; i < out_len; i++) {
+        /* The dispatched functions only shrink the output lengths */
+        if (cmd_out[i].len > cmd->out[i].len) {
+            cmd_out[i].len = cmd->out[i].len;
+        }
+        result->out_len[i] = (uint32_t)cmd_out[i].len;
+        if ((cmd_out[i].len != 0) &&
+            (cmd->out[i].offset + cmd_out[i].len > *out_end)) {
+            *out_end = cmd->out[i].offset + cmd_out[i].len;
+        }
+    }
+}
+#endif /* CRYPTO_BATCH_MODULE_ENABLED */
+
+psa_status_t tfm_crypto_batch_interface(psa_invec in_vec[],
+                                        psa_outvec out_vec[])
+{
+#if !CRYPTO_BATCH_MODULE_ENABLED
+    (void)in_vec;
+    (void)out_vec;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    const uint8_t *cmds = in_vec[1].base;
+    uint8_t *results = out_vec[0].base;
+    struct tfm_crypto_batch_cmd cmd;
+    struct tfm_crypto_batch_result result;
+    size_t num, i, out_end = 0;
+
+    if ((in_vec[1].len == 0) ||
+        (in_vec[1].len % sizeof(struct tfm_crypto_batch_cmd) != 0)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = in_vec[1].len / sizeof(struct tfm_crypto_batch_cmd);
+    if (num > TFM_CRYPTO_BATCH_MAX_NUM) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (out_vec[0].len < num * sizeof(struct tfm_crypto_batch_result)) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    for (i = 0; i < num; i++) {
+        /* Work on a copy, as the client can still change its memory when
+         * the iovecs are mapped rather than copied
+         */
+        (void)memcpy(&cmd, &cmds[i * sizeof(cmd)], sizeof(cmd));
+
+        batch_run_cmd(&cmd, in_vec, out_vec, &result, &out_end);
+
+        (void)memcpy(&results[i * sizeof(result)], &result, sizeof(result));
+    }
+
+    out_vec[0].len = num * sizeof(struct tfm_crypto_batch_result);
+    out_vec[1].len = out_end;
+
+    /* The status of each command is in its result */
+    return PSA_SUCCESS;
+#endif
+}
+/*!@}*/
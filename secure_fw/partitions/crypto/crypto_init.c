@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -19,6 +19,10 @@
 
 #include "crypto_library.h"
 
+#if CRYPTO_ENGINE_BUF_POOLS
+#include "crypto_mem_pool.h"
+#endif /* CRYPTO_ENGINE_BUF_POOLS */
+
 #if CRYPTO_NV_SEED
 #include "tfm_plat_crypto_nv_seed.h"
 #endif /* CRYPTO_NV_SEED */
@@ -37,12 +41,6 @@
  */
 #define ALIGN(x, a) (((x) + ((a) - 1)) & ~((a) - 1))
 
-/**
- * \brief Maximum alignment required by any iovec parameters to the TF-M Crypto
- *        partition.
- */
-#define TFM_CRYPTO_IOVEC_ALIGNMENT (4u)
-
 #if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
 static int32_t g_client_id;
 
@@ -151,6 +149,12 @@ psa_status_t tfm_crypto_get_caller_id(int32_t *id)
     return tfm_crypto_get_scratch_owner(id);
 }
 
+/*
+ * Without MM-IOVEC the inputs are copied into the scratch even when the client
+ * shares the boundary of the partition, so that the client cannot change them
+ * while they are in use. Builds that move large buffers through the service
+ * avoid the copy with PSA_FRAMEWORK_HAS_MM_IOVEC.
+ */
 static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
                                            psa_invec in_vec[],
                                            size_t in_len,
@@ -192,10 +196,10 @@ static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
 }
 #endif /* PSA_FRAMEWORK_HAS_MM_IOVEC == 1 */
 
-static psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
-                                              size_t in_len,
-                                              psa_outvec out_vec[],
-                                              size_t out_len)
+psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
+                                       size_t in_len,
+                                       psa_outvec out_vec[],
+                                       size_t out_len)
 {
     psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
     const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
@@ -211,7 +215,8 @@ static psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
     group_id = TFM_CRYPTO_GET_GROUP_ID(iov->function_id);
 
     is_key_required = !((group_id == TFM_CRYPTO_GROUP_ID_HASH) ||
-                        (group_id == TFM_CRYPTO_GROUP_ID_RANDOM));
+                        (group_id == TFM_CRYPTO_GROUP_ID_RANDOM) ||
+                        (group_id == TFM_CRYPTO_GROUP_ID_BATCH));
 
     if (is_key_required) {
         status = tfm_crypto_get_caller_id(&caller_id);
@@ -249,12 +254,65 @@ static psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
                                                    &encoded_key);
     case TFM_CRYPTO_GROUP_ID_RANDOM:
         return tfm_crypto_random_interface(in_vec, out_vec);
+    case TFM_CRYPTO_GROUP_ID_BATCH:
+        return tfm_crypto_batch_interface(in_vec, out_vec);
     default:
         LOG_ERRFMT("[ERR][Crypto] Unsupported request!\r\n");
         return PSA_ERROR_NOT_SUPPORTED;
     }
 }
 
+#if (TFM_PARTITION_LOG_LEVEL == TFM_PARTITION_LOG_LEVEL_DEBUG)
+/**
+ * \brief Logs the usage counters of the operation contexts and of the crypto
+ *        library heap, only when an allocation failed since the last report
+ */
+static void tfm_crypto_log_usage_stats(void)
+{
+    static uint32_t reported_failures;
+    struct tfm_crypto_alloc_stats_t alloc_stats;
+    uint32_t failures;
+#if CRYPTO_ENGINE_BUF_POOLS
+    struct tfm_crypto_mem_stats_t mem_stats;
+    uint32_t i;
+#endif
+
+    tfm_crypto_operation_get_stats(&alloc_stats);
+    failures = alloc_stats.alloc_failures;
+#if CRYPTO_ENGINE_BUF_POOLS
+    tfm_crypto_mem_pool_get_stats(&mem_stats);
+    failures += mem_stats.alloc_failures;
+#endif
+
+    if (failures == reported_failures) {
+        return;
+    }
+    reported_failures = failures;
+
+    LOG_DBGFMT("[DBG][Crypto] Operations: in use %u, high water mark %u, failures %u\r\n",
+               (unsigned int)alloc_stats.in_use,
+               (unsigned int)alloc_stats.high_water_mark,
+               (unsigned int)alloc_stats.alloc_failures);
+#if CRYPTO_ENGINE_BUF_POOLS
+    LOG_DBGFMT("[DBG][Crypto] Heap: usage %u bytes, peak %u bytes, arena allocs %u, failures %u\r\n",
+               (unsigned int)mem_stats.current_usage,
+               (unsigned int)mem_stats.peak_usage,
+               (unsigned int)mem_stats.arena_allocs,
+               (unsigned int)mem_stats.alloc_failures);
+    for (i = 0; i < TFM_CRYPTO_MEM_HISTOGRAM_BINS - 1u; i++) {
+        if (mem_stats.histogram[i] != 0) {
+            LOG_DBGFMT("[DBG][Crypto] Heap: %u requests of up to %u bytes\r\n",
+                       (unsigned int)mem_stats.histogram[i],
+                       (unsigned int)(1u << i));
+        }
+    }
+    LOG_DBGFMT("[DBG][Crypto] Heap: %u requests of more than %u bytes\r\n",
+               (unsigned int)mem_stats.histogram[i],
+               (unsigned int)(1u << (i - 1u)));
+#endif /* CRYPTO_ENGINE_BUF_POOLS */
+}
+#endif /* TFM_PARTITION_LOG_LEVEL == TFM_PARTITION_LOG_LEVEL_DEBUG */
+
 static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
 {
     psa_status_t status = PSA_SUCCESS;
@@ -296,6 +354,10 @@ static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
     /* Call the dispatcher to the functions that implement the PSA Crypto API */
     status = tfm_crypto_api_dispatcher(in_vec, in_len, out_vec, out_len);
 
+#if (TFM_PARTITION_LOG_LEVEL == TFM_PARTITION_LOG_LEVEL_DEBUG)
+    tfm_crypto_log_usage_stats();
+#endif
+
 #if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
     for (i = 0; i < out_len; i++) {
         if (out_vec[i].base != NULL) {
@@ -394,6 +456,12 @@ psa_status_t tfm_crypto_init(void)
         return status;
     }
 
+    /* Initialise the modules which need the engine layer */
+    status = tfm_crypto_random_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
     return PSA_SUCCESS;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,6 +15,9 @@
 #include "psa/crypto.h"
 #include "psa/error.h"
 #include "crypto_library.h"
+#if CRYPTO_ENGINE_BUF_POOLS
+#include "crypto_mem_pool.h"
+#endif
 
 /**
  * \brief This include is required to get the underlying platform function
@@ -46,6 +49,10 @@
 #error "MBEDTLS_PSA_CRYPTO_KEY_ID_ENCODES_OWNER must be selected in Mbed TLS config file"
 #endif
 
+#if CRYPTO_ENGINE_BUF_POOLS && !defined(MBEDTLS_PLATFORM_MEMORY)
+#error "MBEDTLS_PLATFORM_MEMORY must be selected in Mbed TLS config file for CRYPTO_ENGINE_BUF_POOLS"
+#endif
+
 /**
  * \brief Static buffer containing the string describing the mbed TLS version. mbed TLS
  *        guarantees that the string will never be greater than 18 bytes
@@ -86,11 +93,26 @@ char *tfm_crypto_library_get_info(void)
 
 psa_status_t tfm_crypto_core_library_init(void)
 {
+#if CRYPTO_ENGINE_BUF_POOLS
+    psa_status_t status;
+
+    /* Serve the Mbed Crypto allocations from the size class pools and arena
+     * carved out of the provided buffer instead of using the heap
+     */
+    status = tfm_crypto_mem_pool_init(mbedtls_mem_buf, CRYPTO_ENGINE_BUF_SIZE);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    (void)mbedtls_platform_set_calloc_free(tfm_crypto_mem_pool_calloc,
+                                           tfm_crypto_mem_pool_free);
+#else
     /* Initialise the Mbed Crypto memory allocator to use static memory
      * allocation from the provided buffer instead of using the heap
      */
     mbedtls_memory_buffer_alloc_init(mbedtls_mem_buf,
                                      CRYPTO_ENGINE_BUF_SIZE);
+#endif /* CRYPTO_ENGINE_BUF_POOLS */
 
     mbedtls_platform_set_printf(null_printf);
 
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cmsis_compiler.h"
+#include "config_tfm.h"
+#include "crypto_mem_pool.h"
+
+#if CRYPTO_ENGINE_BUF_POOLS
+
+/**
+ * \brief Alignment of the memory returned, suitable for any type
+ */
+#define MEM_ALIGN           (8u)
+#define MEM_ALIGN_UP(x)     (((x) + (MEM_ALIGN - 1u)) & ~(MEM_ALIGN - 1u))
+
+/**
+ * \brief Size class of a pool, as set in CRYPTO_ENGINE_BUF_POOL_CLASSES
+ */
+struct mem_pool_class_t {
+    uint32_t block_size; /*!< Size of the blocks of the pool in bytes */
+    uint32_t num_blocks; /*!< Number of blocks of the pool */
+};
+
+/**
+ * \brief Pool of fixed size blocks. The free blocks are chained through their
+ *        first word.
+ */
+struct mem_pool_t {
+    uint8_t *start;      /*!< First block of the pool */
+    uint8_t *end;        /*!< End of the last block of the pool */
+    uint32_t block_size; /*!< Size of the blocks, aligned */
+    void *free_list;     /*!< First free block, NULL if there is none */
+};
+
+/**
+ * \brief Header of the blocks of the arena. The blocks follow each other in
+ *        the arena, so that a freed block is merged with its free neighbours.
+ */
+struct arena_hdr_t {
+    uint32_t size;      /*!< Size of the block including the header, ored
+                         *   with ARENA_USED while the block is allocated
+                         */
+    uint32_t prev_size; /*!< Size of the previous block, 0 for the first one */
+};
+
+/**
+ * \brief Free block of the arena, in the free list of the bin of its size
+ */
+struct arena_free_t {
+    struct arena_hdr_t hdr;    /*!< Block header */
+    struct arena_free_t *next; /*!< Next free block of the bin */
+    struct arena_free_t *prev; /*!< Previous free block of the bin */
+};
+
+#define ARENA_USED          (1u)
+#define ARENA_HDR_SIZE      MEM_ALIGN_UP(sizeof(struct arena_hdr_t))
+#define ARENA_MIN_BLOCK     MEM_ALIGN_UP(sizeof(struct arena_free_t))
+
+/**
+ * \brief The free blocks of the arena are kept in one bin per power of two:
+ *        the bin i holds the blocks of 2^i to 2^(i+1) - 1 bytes. A request
+ *        takes the first block of the lowest non-empty bin whose blocks are
+ *        all large enough, found from a bitmap of the non-empty bins, or else
+ *        the first block of its own bin if it is large enough, so that
+ *        allocating and freeing take constant time.
+ */
+#define ARENA_NUM_BINS      (32u)
+
+static const struct mem_pool_class_t pool_classes[] = {
+    CRYPTO_ENGINE_BUF_POOL_CLASSES
+};
+
+#define NUM_POOL_CLASSES    (sizeof(pool_classes) / sizeof(pool_classes[0]))
+
+static struct mem_pool_t pools[NUM_POOL_CLASSES];
+
+static struct arena_free_t *arena_bins[ARENA_NUM_BINS];
+static uint32_t arena_bitmap;
+static uint8_t *arena_start;
+static uint8_t *arena_end;
+
+static struct tfm_crypto_mem_stats_t mem_stats;
+
+/**
+ * \brief Gets the index of the highest bit set in a non-zero value
+ */
+static inline uint32_t log2_floor(uint32_t x)
+{
+    return 31u - __CLZ(x);
+}
+
+/**
+ * \brief Gets the index of the lowest bit set in a non-zero value
+ */
+static inline uint32_t lowest_bit(uint32_t x)
+{
+    return log2_floor(x & (0u - x));
+}
+
+static void arena_link(struct arena_free_t *blk)
+{
+    uint32_t bin = log2_floor(blk->hdr.size);
+
+    blk->prev = NULL;
+    blk->next = arena_bins[bin];
+    if (blk->next != NULL) {
+        blk->next->prev = blk;
+    }
+    arena_bins[bin] = blk;
+    arena_bitmap |= (1u << bin);
+}
+
+static void arena_unlink(struct arena_free_t *blk)
+{
+    uint32_t bin = log2_floor(blk->hdr.size);
+
+    if (blk->prev != NULL) {
+        blk->prev->next = blk->next;
+    } else {
+        arena_bins[bin] = blk->next;
+        if (blk->next == NULL) {
+            arena_bitmap &= ~(1u << bin);
+        }
+    }
+    if (blk->next != NULL) {
+        blk->next->prev = blk->prev;
+    }
+}
+
+/**
+ * \brief Updates the previous size of the block following the given one
+ */
+static void arena_set_next_prev_size(struct arena_hdr_t *blk, uint32_t size)
+{
+    struct arena_hdr_t *next = (struct arena_hdr_t *)((uint8_t *)blk + size);
+
+    if ((uint8_t *)next < arena_end) {
+        next->prev_size = size;
+    }
+}
+
+static void *arena_alloc(size_t size, uint32_t *blk_size)
+{
+    struct arena_free_t *blk;
+    struct arena_free_t *rest;
+    uint32_t need;
+    uint32_t bin;
+    uint32_t mask;
+    uint32_t size_found;
+
+    if (size > (size_t)(arena_end - arena_start)) {
+        return NULL;
+    }
+
+    need = MEM_ALIGN_UP((uint32_t)size + ARENA_HDR_SIZE);
+    if (need < ARENA_MIN_BLOCK) {
+        need = ARENA_MIN_BLOCK;
+    }
+
+    /* Round up to the bin whose blocks all fit the request */
+    bin = log2_floor(need - 1u) + 1u;
+    mask = (bin < ARENA_NUM_BINS) ? (arena_bitmap & ~((1u << bin) - 1u)) : 0u;
+
+    if (mask != 0) {
+        blk = arena_bins[lowest_bit(mask)];
+    } else {
+        /* Otherwise only the first block of the bin of the request size is
+         * tried, which still finds the whole arena when it is free.
+         */
+        blk = arena_bins[log2_floor(need)];
+        if ((blk == NULL) || (blk->hdr.size < need)) {
+            return NULL;
+        }
+    }
+
+    arena_unlink(blk);
+    size_found = blk->hdr.size;
+
+    /* Split the block if the remainder can hold a free block */
+    if ((size_found - need) >= ARENA_MIN_BLOCK) {
+        rest = (struct arena_free_t *)((uint8_t *)blk + need);
+        rest->hdr.size = size_found - need;
+        rest->hdr.prev_size = need;
+        arena_set_next_prev_size(&rest->hdr, rest->hdr.size);
+        arena_link(rest);
+        size_found = need;
+    }
+
+    blk->hdr.size = size_found | ARENA_USED;
+    *blk_size = size_found;
+
+    return (uint8_t *)blk + ARENA_HDR_SIZE;
+}
+
+static uint32_t arena_free(void *ptr)
+{
+    struct arena_free_t *blk =
+                    (struct arena_free_t *)((uint8_t *)ptr - ARENA_HDR_SIZE);
+    struct arena_free_t *neighbour;
+    uint32_t blk_size = blk->hdr.size & ~ARENA_USED;
+    uint32_t size = blk_size;
+
+    /* Merge with the next block if it is free */
+    neighbour = (struct arena_free_t *)((uint8_t *)blk + size);
+    if (((uint8_t *)neighbour < arena_end) &&
+        ((neighbour->hdr.size & ARENA_USED) == 0)) {
+        arena_unlink(neighbour);
+        size += neighbour->hdr.size;
+    }
+
+    /* Merge with the previous block if it is free */
+    if (blk->hdr.prev_size != 0) {
+        neighbour = (struct arena_free_t *)((uint8_t *)blk
+                                            - blk->hdr.prev_size);
+        if ((neighbour->hdr.size & ARENA_USED) == 0) {
+            arena_unlink(neighbour);
+            size += neighbour->hdr.size;
+            blk = neighbour;
+        }
+    }
+
+    blk->hdr.size = size;
+    arena_set_next_prev_size(&blk->hdr, size);
+    arena_link(blk);
+
+    return blk_size;
+}
+
+psa_status_t tfm_crypto_mem_pool_init(uint8_t *buf, size_t size)
+{
+    uint8_t *p;
+    uint8_t *end = buf + size;
+    struct arena_free_t *blk;
+    uint32_t pool_size;
+    uint32_t i;
+    uint32_t j;
+
+    (void)memset(pools, 0, sizeof(pools));
+    (void)memset(arena_bins, 0, sizeof(arena_bins));
+    (void)memset(&mem_stats, 0, sizeof(mem_stats));
+    arena_bitmap = 0;
+
+    p = buf + ((MEM_ALIGN - ((uintptr_t)buf % MEM_ALIGN)) % MEM_ALIGN);
+    if (p > end) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    /* Carve the pools at the start of the buffer */
+    for (i = 0; i < NUM_POOL_CLASSES; i++) {
+        pools[i].block_size = MEM_ALIGN_UP(pool_classes[i].block_size);
+        if (pools[i].block_size < sizeof(void *)) {
+            pools[i].block_size = MEM_ALIGN_UP(sizeof(void *));
+        }
+
+        pool_size = pools[i].block_size * pool_classes[i].num_blocks;
+        if (pool_size > (size_t)(end - p)) {
+            return PSA_ERROR_INSUFFICIENT_MEMORY;
+        }
+
+        pools[i].start = p;
+        pools[i].end = p + pool_size;
+        for (j = pool_classes[i].num_blocks; j > 0; j--) {
+            p = pools[i].start + ((j - 1) * pools[i].block_size);
+            *(void **)p = pools[i].free_list;
+            pools[i].free_list = p;
+        }
+        p = pools[i].end;
+    }
+
+    /* The rest of the buffer is the arena, made of a single free block */
+    arena_start = p;
+    arena_end = p + ((size_t)(end - p) - ((size_t)(end - p) % MEM_ALIGN));
+    if ((size_t)(arena_end - arena_start) >= ARENA_MIN_BLOCK) {
+        blk = (struct arena_free_t *)arena_start;
+        blk->hdr.size = (uint32_t)(arena_end - arena_start);
+        blk->hdr.prev_size = 0;
+        arena_link(blk);
+    }
+
+    return PSA_SUCCESS;
+}
+
+void *tfm_crypto_mem_pool_calloc(size_t nmemb, size_t size)
+{
+    void *ptr = NULL;
+    uint32_t blk_size = 0;
+    size_t total;
+    uint32_t bin;
+    uint32_t i;
+
+    if ((nmemb == 0) || (size == 0)) {
+        return NULL;
+    }
+
+    if (size > (SIZE_MAX / nmemb)) {
+        mem_stats.alloc_failures++;
+        return NULL;
+    }
+    total = nmemb * size;
+
+    if (total > (1u << (TFM_CRYPTO_MEM_HISTOGRAM_BINS - 1u))) {
+        bin = TFM_CRYPTO_MEM_HISTOGRAM_BINS - 1u;
+    } else {
+        bin = (total > 1u) ? (log2_floor((uint32_t)total - 1u) + 1u) : 0u;
+    }
+    mem_stats.histogram[bin]++;
+
+    /* Take a block from the smallest class which fits and has one free. The
+     * classes are listed by increasing block size.
+     */
+    for (i = 0; i < NUM_POOL_CLASSES; i++) {
+        if ((pools[i].block_size >= total) && (pools[i].free_list != NULL)) {
+            ptr = pools[i].free_list;
+            pools[i].free_list = *(void **)ptr;
+            blk_size = pools[i].block_size;
+            break;
+        }
+    }
+
+    if (ptr == NULL) {
+        ptr = arena_alloc(total, &blk_size);
+        if (ptr == NULL) {
+            mem_stats.alloc_failures++;
+            return NULL;
+        }
+        mem_stats.arena_allocs++;
+    }
+
+    mem_stats.current_usage += blk_size;
+    if (mem_stats.current_usage > mem_stats.peak_usage) {
+        mem_stats.peak_usage = mem_stats.current_usage;
+    }
+
+    (void)memset(ptr, 0, total);
+
+    return ptr;
+}
+
+void tfm_crypto_mem_pool_free(void *ptr)
+{
+    uint32_t i;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    if ((uint8_t *)ptr < arena_start) {
+        for (i = 0; i < NUM_POOL_CLASSES; i++) {
+            if (((uint8_t *)ptr >= pools[i].start) &&
+                ((uint8_t *)ptr < pools[i].end)) {
+                *(void **)ptr = pools[i].free_list;
+                pools[i].free_list = ptr;
+                mem_stats.current_usage -= pools[i].block_size;
+                return;
+            }
+        }
+        return;
+    }
+
+    mem_stats.current_usage -= arena_free(ptr);
+}
+
+void tfm_crypto_mem_pool_get_stats(struct tfm_crypto_mem_stats_t *stats)
+{
+    *stats = mem_stats;
+}
+
+#endif /* CRYPTO_ENGINE_BUF_POOLS */
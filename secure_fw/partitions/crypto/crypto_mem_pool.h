@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file crypto_mem_pool.h
+ *
+ * \brief Allocator of the heap given to the crypto library, used instead of
+ *        the library allocator when CRYPTO_ENGINE_BUF_POOLS is set. Requests
+ *        are served from pools of fixed size blocks, one per size class set
+ *        by CRYPTO_ENGINE_BUF_POOL_CLASSES, and from an arena taking the rest
+ *        of the buffer when no block of a large enough class is free.
+ */
+
+#ifndef __CRYPTO_MEM_POOL_H__
+#define __CRYPTO_MEM_POOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Number of bins of the histogram of the allocation sizes. The bin i
+ *        counts the requests of 2^(i-1) + 1 to 2^i bytes, the last bin also
+ *        counts all the larger ones.
+ */
+#define TFM_CRYPTO_MEM_HISTOGRAM_BINS (16u)
+
+/**
+ * \brief Usage counters of the crypto library heap
+ */
+struct tfm_crypto_mem_stats_t {
+    uint32_t current_usage;  /*!< Bytes currently allocated, including the
+                              *   rounding to the blocks
+                              */
+    uint32_t peak_usage;     /*!< Highest value of current_usage */
+    uint32_t arena_allocs;   /*!< Number of requests served by the arena */
+    uint32_t alloc_failures; /*!< Number of requests which failed */
+    uint32_t histogram[TFM_CRYPTO_MEM_HISTOGRAM_BINS]; /*!< Number of requests
+                                                        *   by size
+                                                        */
+};
+
+/**
+ * \brief Carves the pools and the arena out of the given buffer
+ *
+ * \param[in] buf   Buffer to use as heap
+ * \param[in] size  Size of the buffer in bytes
+ *
+ * \return PSA_SUCCESS, or PSA_ERROR_INSUFFICIENT_MEMORY if the pools do not
+ *         fit in the buffer
+ */
+psa_status_t tfm_crypto_mem_pool_init(uint8_t *buf, size_t size);
+
+/**
+ * \brief Allocates zeroed memory, with the calloc() semantics
+ *
+ * \param[in] nmemb  Number of elements
+ * \param[in] size   Size of each element in bytes
+ *
+ * \return Pointer to the memory, or NULL if there is not enough memory
+ */
+void *tfm_crypto_mem_pool_calloc(size_t nmemb, size_t size);
+
+/**
+ * \brief Releases memory allocated with \ref tfm_crypto_mem_pool_calloc
+ *
+ * \param[in] ptr  Pointer to the memory, or NULL
+ */
+void tfm_crypto_mem_pool_free(void *ptr);
+
+/**
+ * \brief Gets the usage counters of the heap
+ *
+ * \param[out] stats  Pointer to hold the usage counters
+ */
+void tfm_crypto_mem_pool_get_stats(struct tfm_crypto_mem_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRYPTO_MEM_POOL_H__ */
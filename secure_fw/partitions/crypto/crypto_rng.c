@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2021, Nordic Semiconductor ASA.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -8,6 +8,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "config_tfm.h"
 #include "tfm_mbedcrypto_include.h"
@@ -21,6 +22,75 @@
  */
 
 /*!@{*/
+#if CRYPTO_RNG_MODULE_ENABLED && (CRYPTO_RNG_POOL_SIZE > 0)
+/**
+ * \brief Random bytes generated in advance by a single DRBG call. The unread
+ *        bytes are the first \ref avail ones of \ref buf, bytes are read from
+ *        the end of that range and wiped as soon as they are read.
+ */
+static struct {
+    uint8_t buf[CRYPTO_RNG_POOL_SIZE];
+    size_t avail;
+} rng_pool;
+
+static psa_status_t rng_pool_refill(void)
+{
+    psa_status_t status;
+
+    status = psa_generate_random(rng_pool.buf, sizeof(rng_pool.buf));
+    if (status != PSA_SUCCESS) {
+        (void)memset(rng_pool.buf, 0, sizeof(rng_pool.buf));
+        rng_pool.avail = 0;
+        return status;
+    }
+
+    rng_pool.avail = sizeof(rng_pool.buf);
+
+    return PSA_SUCCESS;
+}
+
+static void rng_pool_take(uint8_t *output, size_t len)
+{
+    uint8_t *src = &rng_pool.buf[rng_pool.avail - len];
+
+    (void)memcpy(output, src, len);
+    (void)memset(src, 0, len);
+    rng_pool.avail -= len;
+}
+
+static psa_status_t rng_pool_read(uint8_t *output, size_t output_size)
+{
+    psa_status_t status;
+    size_t len;
+
+    while (output_size > 0) {
+        if (rng_pool.avail == 0) {
+            status = rng_pool_refill();
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+
+        len = (output_size < rng_pool.avail) ? output_size : rng_pool.avail;
+        rng_pool_take(output, len);
+        output += len;
+        output_size -= len;
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* CRYPTO_RNG_MODULE_ENABLED && (CRYPTO_RNG_POOL_SIZE > 0) */
+
+psa_status_t tfm_crypto_random_init(void)
+{
+#if CRYPTO_RNG_MODULE_ENABLED && (CRYPTO_RNG_POOL_SIZE > 0)
+    /* Fill the pool at boot, so that the first requests do not pay for it */
+    return rng_pool_refill();
+#else
+    return PSA_SUCCESS;
+#endif
+}
+
 psa_status_t tfm_crypto_random_interface(psa_invec in_vec[],
                                          psa_outvec out_vec[])
 {
@@ -30,9 +100,22 @@ psa_status_t tfm_crypto_random_interface(psa_invec in_vec[],
 
     return PSA_ERROR_NOT_SUPPORTED;
 #else
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
     uint8_t *output = out_vec[0].base;
     size_t output_size = out_vec[0].len;
 
+#if CRYPTO_RNG_POOL_SIZE > 0
+    /* Large requests would drain the pool, give them their own DRBG call,
+     * as well as the requests which need bytes generated after they arrive
+     */
+    if ((output_size <= CRYPTO_RNG_POOL_MAX_REQUEST) &&
+        (iov->function_id != TFM_CRYPTO_GENERATE_RANDOM_FRESH_SID)) {
+        return rng_pool_read(output, output_size);
+    }
+#else
+    (void)iov;
+#endif
+
     return psa_generate_random(output, output_size);
 #endif
 }
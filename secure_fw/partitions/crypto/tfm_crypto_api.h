@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -31,11 +31,27 @@ enum tfm_crypto_operation_type {
     TFM_CRYPTO_HASH_OPERATION = 3,
     TFM_CRYPTO_KEY_DERIVATION_OPERATION = 4,
     TFM_CRYPTO_AEAD_OPERATION = 5,
+    TFM_CRYPTO_SIGN_HASH_OPERATION = 6,
+    TFM_CRYPTO_VERIFY_HASH_OPERATION = 7,
 
     /* Used to force the enum size */
     TFM_CRYPTO_OPERATION_TYPE_MAX = INT_MAX
 };
 
+/**
+ * \brief Usage counters of the operation contexts of the Alloc module
+ */
+struct tfm_crypto_alloc_stats_t {
+    uint32_t in_use;          /*!< Number of contexts currently allocated */
+    uint32_t high_water_mark; /*!< Highest number of contexts allocated at
+                               *   once
+                               */
+    uint32_t alloc_failures;  /*!< Number of allocations refused because no
+                               *   context was free or the client quota was
+                               *   reached
+                               */
+};
+
 /**
  * \brief Initialise the service
  *
@@ -92,6 +108,12 @@ psa_status_t tfm_crypto_operation_release(uint32_t *handle);
 psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
                                          uint32_t handle,
                                          void **ctx);
+/**
+ * \brief Get the usage counters of the operation contexts in the backend
+ *
+ * \param[out] stats Pointer to hold the usage counters
+ */
+void tfm_crypto_operation_get_stats(struct tfm_crypto_alloc_stats_t *stats);
 /**
  * \brief This function acts as interface for the Key management module
  *
@@ -179,6 +201,14 @@ psa_status_t tfm_crypto_asymmetric_encrypt_interface(psa_invec in_vec[],
 psa_status_t tfm_crypto_key_derivation_interface(psa_invec in_vec[],
                                                  psa_outvec out_vec[],
                                                  struct tfm_crypto_key_id_s *encoded_key);
+/**
+ * \brief Initialise the Random module, filling the pool of random bytes when
+ *        CRYPTO_RNG_POOL_SIZE is set. To be called once the crypto library
+ *        is initialised
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_random_init(void);
 /**
  * \brief This function acts as interface for the Random module
  *
@@ -189,6 +219,33 @@ psa_status_t tfm_crypto_key_derivation_interface(psa_invec in_vec[],
  */
 psa_status_t tfm_crypto_random_interface(psa_invec in_vec[],
                                          psa_outvec out_vec[]);
+/**
+ * \brief This function acts as interface for the Batch module, which runs
+ *        the commands of a batch one after the other through
+ *        \ref tfm_crypto_api_dispatcher
+ *
+ * \param[in]  in_vec   Array of invec parameters
+ * \param[out] out_vec  Array of outvec parameters
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_batch_interface(psa_invec in_vec[],
+                                        psa_outvec out_vec[]);
+/**
+ * \brief Dispatches a request to the module of its function group
+ *
+ * \param[in]  in_vec   Array of invec parameters, the first one holding the
+ *                      tfm_crypto_pack_iovec of the request
+ * \param[in]  in_len   Number of invec parameters
+ * \param[out] out_vec  Array of outvec parameters
+ * \param[in]  out_len  Number of outvec parameters
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
+                                       size_t in_len,
+                                       psa_outvec out_vec[],
+                                       size_t out_len);
 /**
  * \brief This function acts as interface for the Hash module
  *
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string.h>
+
+#include "its_flash_cache.h"
+#include "flash_fs/its_flash_fs.h"
+
+/**
+ * \brief Gets the cached line holding the given block data.
+ *
+ * \param[in] cache     Flash cache
+ * \param[in] block_id  Block ID
+ * \param[in] offset    Offset of the line in the block
+ *
+ * \return Returns the index of the line, or num_lines if it is not cached.
+ */
+static uint32_t its_flash_cache_lookup(const struct its_flash_cache_t *cache,
+                                       uint32_t block_id, uint32_t offset)
+{
+    uint32_t i;
+
+    for (i = 0; i < cache->num_lines; i++) {
+        if ((cache->lines[i].block_id == block_id) &&
+            (cache->lines[i].offset == offset)) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * \brief Gets the line to evict: a free line if any, otherwise the least
+ *        recently used one.
+ *
+ * \param[in] cache  Flash cache
+ *
+ * \return Returns the index of the line.
+ */
+static uint32_t its_flash_cache_victim(const struct its_flash_cache_t *cache)
+{
+    uint32_t victim = 0;
+    uint32_t i;
+
+    for (i = 0; i < cache->num_lines; i++) {
+        if (cache->lines[i].block_id == ITS_BLOCK_INVALID_ID) {
+            return i;
+        }
+        if (cache->lines[i].last_use < cache->lines[victim].last_use) {
+            victim = i;
+        }
+    }
+
+    return victim;
+}
+
+psa_status_t its_flash_cache_init(const struct its_flash_fs_config_t *cfg)
+{
+    struct its_flash_cache_t *cache = cfg->cache;
+    uint32_t i;
+
+    if ((cache->num_lines == 0) || (cache->line_size == 0) ||
+        ((cfg->block_size % cache->line_size) != 0) ||
+        ((cache->line_size % cfg->program_unit) != 0)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    for (i = 0; i < cache->num_lines; i++) {
+        cache->lines[i].block_id = ITS_BLOCK_INVALID_ID;
+    }
+    cache->clock = 0;
+    cache->wc_size = 0;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_cache_read(const struct its_flash_fs_config_t *cfg,
+                                  its_flash_cache_fill_t fill,
+                                  uint32_t block_id, uint8_t *buf,
+                                  size_t offset, size_t size)
+{
+    struct its_flash_cache_t *cache = cfg->cache;
+    uint8_t *line_data;
+    uint32_t line_offset;
+    size_t chunk;
+    uint32_t i;
+    psa_status_t err;
+
+    /* Large reads are file data, which would only evict the metadata */
+    if (size > cache->line_size) {
+        return fill(cfg, block_id, buf, offset, size);
+    }
+
+    while (size > 0) {
+        line_offset = offset - (offset % cache->line_size);
+        chunk = ITS_UTILS_MIN(size, line_offset + cache->line_size - offset);
+
+        i = its_flash_cache_lookup(cache, block_id, line_offset);
+        if (i == cache->num_lines) {
+            i = its_flash_cache_victim(cache);
+            line_data = cache->data + (i * cache->line_size);
+
+            err = fill(cfg, block_id, line_data, line_offset,
+                       cache->line_size);
+            if (err != PSA_SUCCESS) {
+                /* The rest of the line may not be readable, for instance if a
+                 * NAND page has been left incompletely programmed, so only
+                 * read what was requested.
+                 */
+                cache->lines[i].block_id = ITS_BLOCK_INVALID_ID;
+                return fill(cfg, block_id, buf, offset, size);
+            }
+
+            cache->lines[i].block_id = block_id;
+            cache->lines[i].offset = line_offset;
+        }
+
+        line_data = cache->data + (i * cache->line_size);
+        (void)memcpy(buf, line_data + (offset - line_offset), chunk);
+        cache->lines[i].last_use = ++cache->clock;
+
+        buf += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+
+    return PSA_SUCCESS;
+}
+
+void its_flash_cache_update(struct its_flash_cache_t *cache, uint32_t block_id,
+                            const uint8_t *buf, size_t offset, size_t size)
+{
+    size_t start;
+    size_t end;
+    uint32_t i;
+
+    for (i = 0; i < cache->num_lines; i++) {
+        if (cache->lines[i].block_id != block_id) {
+            continue;
+        }
+
+        start = ITS_UTILS_MAX(offset, cache->lines[i].offset);
+        end = ITS_UTILS_MIN(offset + size,
+                            cache->lines[i].offset + cache->line_size);
+        if (start < end) {
+            (void)memcpy(cache->data + (i * cache->line_size)
+                         + (start - cache->lines[i].offset),
+                         buf + (start - offset), end - start);
+        }
+    }
+}
+
+void its_flash_cache_invalidate(struct its_flash_cache_t *cache,
+                                uint32_t block_id)
+{
+    uint32_t i;
+
+    for (i = 0; i < cache->num_lines; i++) {
+        if (cache->lines[i].block_id == block_id) {
+            cache->lines[i].block_id = ITS_BLOCK_INVALID_ID;
+        }
+    }
+}
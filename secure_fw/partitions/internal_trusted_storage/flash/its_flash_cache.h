@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file its_flash_cache.h
+ *
+ * \brief Cache of flash lines shared by the NOR and NAND flash back ends. Small
+ *        reads, such as the metadata reads of the filesystem, are served from
+ *        the least recently used lines kept in RAM. The NOR back end also uses
+ *        the write combining buffer of the cache to merge contiguous writes
+ *        into a single program operation.
+ */
+
+#ifndef __ITS_FLASH_CACHE_H__
+#define __ITS_FLASH_CACHE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct its_flash_fs_config_t;
+
+/**
+ * \struct its_flash_cache_line_t
+ *
+ * \brief Tag of a cache line.
+ */
+struct its_flash_cache_line_t {
+    uint32_t block_id; /**< Block of the cached data, ITS_BLOCK_INVALID_ID if
+                        *   the line is free
+                        */
+    uint32_t offset;   /**< Offset of the cached data in the block, a multiple
+                        *   of the line size
+                        */
+    uint32_t last_use; /**< Value of the cache clock at the last access */
+};
+
+/**
+ * \struct its_flash_cache_t
+ *
+ * \brief Flash cache of a filesystem.
+ *
+ * \note Use ITS_FLASH_CACHE_DEFINE to allocate the cache for a filesystem.
+ */
+struct its_flash_cache_t {
+    struct its_flash_cache_line_t *lines; /**< Tags of the lines */
+    uint8_t *data;         /**< Data of the lines, num_lines * line_size bytes
+                            */
+    uint8_t *wc_buf;       /**< Write combining buffer, line_size bytes */
+    uint32_t num_lines;    /**< Number of lines */
+    uint32_t line_size;    /**< Size of a line, it must divide the block size
+                            *   and be a multiple of the program unit
+                            */
+    uint32_t clock;        /**< Number of line accesses, for LRU eviction */
+    uint32_t wc_block_id;  /**< Block of the data in the write combining buffer
+                            */
+    uint32_t wc_offset;    /**< Offset of the data in the write combining
+                            *   buffer
+                            */
+    uint32_t wc_size;      /**< Size of the data in the write combining buffer,
+                            *   0 if nothing is pending
+                            */
+};
+
+/**
+ * \brief Allocates a cache of num_lines lines of line_size bytes.
+ */
+#define ITS_FLASH_CACHE_DEFINE(name, num_lines, line_size)                     \
+    static struct its_flash_cache_line_t name##_lines[num_lines];             \
+    static uint32_t name##_data[((num_lines) * (line_size) + 3) / 4];          \
+    static uint32_t name##_wc_buf[((line_size) + 3) / 4];                      \
+    static struct its_flash_cache_t name = {                                   \
+        .lines = name##_lines,                                                 \
+        .data = (uint8_t *)name##_data,                                        \
+        .wc_buf = (uint8_t *)name##_wc_buf,                                    \
+        .num_lines = (num_lines),                                              \
+        .line_size = (line_size),                                              \
+    }
+
+/**
+ * \brief Reads from the flash device, bypassing the cache.
+ *
+ * \param[in]  cfg       Filesystem configuration
+ * \param[in]  block_id  Block ID
+ * \param[out] buf       Buffer pointer to store the data read
+ * \param[in]  offset    Offset position from the init of the block
+ * \param[in]  size      Number of bytes to read
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+typedef psa_status_t (*its_flash_cache_fill_t)(
+                                        const struct its_flash_fs_config_t *cfg,
+                                        uint32_t block_id, uint8_t *buf,
+                                        size_t offset, size_t size);
+
+/**
+ * \brief Checks the cache geometry and empties the cache, dropping any pending
+ *        write.
+ *
+ * \param[in] cfg  Filesystem configuration, with a non-NULL cache
+ *
+ * \return Returns PSA_ERROR_PROGRAMMER_ERROR if the line size does not fit the
+ *         block size or the program unit, and PSA_SUCCESS otherwise.
+ */
+psa_status_t its_flash_cache_init(const struct its_flash_fs_config_t *cfg);
+
+/**
+ * \brief Reads block data through the cache. Reads larger than a line are
+ *        not cached and go to the device.
+ *
+ * \param[in]  cfg       Filesystem configuration, with a non-NULL cache
+ * \param[in]  fill      Function reading from the device
+ * \param[in]  block_id  Block ID
+ * \param[out] buf       Buffer pointer to store the data read
+ * \param[in]  offset    Offset position from the init of the block
+ * \param[in]  size      Number of bytes to read
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_cache_read(const struct its_flash_fs_config_t *cfg,
+                                  its_flash_cache_fill_t fill,
+                                  uint32_t block_id, uint8_t *buf,
+                                  size_t offset, size_t size);
+
+/**
+ * \brief Updates the cached lines of a block with written data.
+ *
+ * \param[in,out] cache     Flash cache
+ * \param[in]     block_id  Block ID
+ * \param[in]     buf       Data written
+ * \param[in]     offset    Offset position from the init of the block
+ * \param[in]     size      Number of bytes written
+ */
+void its_flash_cache_update(struct its_flash_cache_t *cache, uint32_t block_id,
+                            const uint8_t *buf, size_t offset, size_t size);
+
+/**
+ * \brief Drops the cached lines of a block.
+ *
+ * \param[in,out] cache     Flash cache
+ * \param[in]     block_id  Block ID
+ */
+void its_flash_cache_invalidate(struct its_flash_cache_t *cache,
+                                uint32_t block_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ITS_FLASH_CACHE_H__ */
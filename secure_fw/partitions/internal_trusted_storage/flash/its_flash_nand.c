@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include "its_flash_nand.h"
+#include "its_flash_cache.h"
 #include "flash_fs/its_flash_fs.h"
 
 /* Valid entries for data item width */
@@ -43,6 +44,12 @@ static psa_status_t its_flash_nand_init(const struct its_flash_fs_config_t *cfg)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    if (cfg->cache != NULL) {
+        if (its_flash_cache_init(cfg) != PSA_SUCCESS) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+    }
+
     err = flash_dev->driver->Initialize(NULL);
     if (err != ARM_DRIVER_OK) {
         return PSA_ERROR_STORAGE_FAILURE;
@@ -51,7 +58,19 @@ static psa_status_t its_flash_nand_init(const struct its_flash_fs_config_t *cfg)
     return PSA_SUCCESS;
 }
 
-static psa_status_t its_flash_nand_read(const struct its_flash_fs_config_t *cfg,
+/**
+ * \brief Reads block data from the flash device.
+ *
+ * \param[in]  cfg       Flash FS configuration
+ * \param[in]  block_id  Block ID
+ * \param[out] buff      Buffer pointer to store the data read
+ * \param[in]  offset    Offset position from the init of the block
+ * \param[in]  size      Number of bytes to read
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_nand_read_flash(
+                                        const struct its_flash_fs_config_t *cfg,
                                         uint32_t block_id, uint8_t *buff,
                                         size_t offset, size_t size)
 {
@@ -68,70 +87,85 @@ static psa_status_t its_flash_nand_read(const struct its_flash_fs_config_t *cfg,
     uint8_t data_width;
     int ret;
 
-    if (block_id == ITS_BLOCK_INVALID_ID) {
-        return PSA_ERROR_PROGRAMMER_ERROR;
-    }
-
-    if (block_id == flash_dev->buf_block_id_0) {
-        (void)memcpy(buff, flash_dev->write_buf_0 + offset, size);
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        (void)memcpy(buff, flash_dev->write_buf_1 + offset, size);
-    } else {
-        addr = get_phys_address(cfg, block_id, offset);
-        remaining_len = size;
-        DriverCapabilities = flash_dev->driver->GetCapabilities();
-        data_width = data_width_byte[DriverCapabilities.data_width];
-
-        /*
-         * CMSIS ARM_FLASH_ReadData API requires the `addr` data type size
-         * aligned. Data type size is specified by the data_width in
-         * ARM_FLASH_CAPABILITIES.
-         */
-        aligned_addr = (addr / data_width) * data_width;
+    addr = get_phys_address(cfg, block_id, offset);
+    remaining_len = size;
+    DriverCapabilities = flash_dev->driver->GetCapabilities();
+    data_width = data_width_byte[DriverCapabilities.data_width];
 
-        /* Read the first data_width bytes data if `addr` is not aligned. */
-        if (aligned_addr != addr) {
-            ret = flash_dev->driver->ReadData(aligned_addr, temp_buffer, 1);
-            if (ret < 0) {
-                return PSA_ERROR_STORAGE_FAILURE;
-            }
+    /*
+     * CMSIS ARM_FLASH_ReadData API requires the `addr` data type size
+     * aligned. Data type size is specified by the data_width in
+     * ARM_FLASH_CAPABILITIES.
+     */
+    aligned_addr = (addr / data_width) * data_width;
 
-            /* Record how many target data have been read. */
-            read_length = (((addr - aligned_addr + size) >= data_width) ?
-                                (data_width - (addr - aligned_addr)) : size);
-            /* Copy the read data. */
-            memcpy(buff, temp_buffer + addr - aligned_addr, read_length);
-            remaining_len -= read_length;
+    /* Read the first data_width bytes data if `addr` is not aligned. */
+    if (aligned_addr != addr) {
+        ret = flash_dev->driver->ReadData(aligned_addr, temp_buffer, 1);
+        if (ret < 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
         }
 
-        /*
-         * The `cnt` parameter in CMSIS ARM_FLASH_ReadData indicates number of
-         * data items to read.
-         */
-        if (remaining_len) {
-            item_number = remaining_len / data_width;
-            if (item_number) {
-                ret = flash_dev->driver->ReadData(addr + read_length,
-                                                  (uint8_t *)buff + read_length,
-                                                  item_number);
-                if (ret < 0) {
-                    return PSA_ERROR_STORAGE_FAILURE;
-                }
-                read_length += item_number * data_width;
-                remaining_len -= item_number * data_width;
-            }
-        }
+        /* Record how many target data have been read. */
+        read_length = (((addr - aligned_addr + size) >= data_width) ?
+                            (data_width - (addr - aligned_addr)) : size);
+        /* Copy the read data. */
+        memcpy(buff, temp_buffer + addr - aligned_addr, read_length);
+        remaining_len -= read_length;
+    }
 
-        /* Read the last data item if there is still remaing data. */
-        if (remaining_len) {
+    /*
+     * The `cnt` parameter in CMSIS ARM_FLASH_ReadData indicates number of
+     * data items to read.
+     */
+    if (remaining_len) {
+        item_number = remaining_len / data_width;
+        if (item_number) {
             ret = flash_dev->driver->ReadData(addr + read_length,
-                                              temp_buffer, 1);
+                                              (uint8_t *)buff + read_length,
+                                              item_number);
             if (ret < 0) {
                 return PSA_ERROR_STORAGE_FAILURE;
             }
-            /* Copy the read data. */
-            memcpy(buff + read_length, temp_buffer, remaining_len);
+            read_length += item_number * data_width;
+            remaining_len -= item_number * data_width;
+        }
+    }
+
+    /* Read the last data item if there is still remaing data. */
+    if (remaining_len) {
+        ret = flash_dev->driver->ReadData(addr + read_length,
+                                          temp_buffer, 1);
+        if (ret < 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
         }
+        /* Copy the read data. */
+        memcpy(buff + read_length, temp_buffer, remaining_len);
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t its_flash_nand_read(const struct its_flash_fs_config_t *cfg,
+                                        uint32_t block_id, uint8_t *buff,
+                                        size_t offset, size_t size)
+{
+    struct its_flash_nand_dev_t *flash_dev =
+        (struct its_flash_nand_dev_t *)cfg->flash_dev;
+
+    if (block_id == ITS_BLOCK_INVALID_ID) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (block_id == flash_dev->buf_block_id_0) {
+        (void)memcpy(buff, flash_dev->write_buf_0 + offset, size);
+    } else if (block_id == flash_dev->buf_block_id_1) {
+        (void)memcpy(buff, flash_dev->write_buf_1 + offset, size);
+    } else if (cfg->cache != NULL) {
+        return its_flash_cache_read(cfg, its_flash_nand_read_flash, block_id,
+                                    buff, offset, size);
+    } else {
+        return its_flash_nand_read_flash(cfg, block_id, buff, offset, size);
     }
 
     return PSA_SUCCESS;
@@ -166,6 +200,13 @@ static psa_status_t its_flash_nand_write(
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    /* Reads of a buffered block are served from its write buffer, so that its
+     * cached lines are stale from now on.
+     */
+    if (cfg->cache != NULL) {
+        its_flash_cache_invalidate(cfg->cache, block_id);
+    }
+
     return PSA_SUCCESS;
 }
 
@@ -227,6 +268,10 @@ static psa_status_t its_flash_nand_erase(const struct its_flash_fs_config_t *cfg
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
 
+    if (cfg->cache != NULL) {
+        its_flash_cache_invalidate(cfg->cache, block_id);
+    }
+
     for (offset = 0; offset < cfg->block_size; offset += cfg->sector_size) {
         addr = get_phys_address(cfg, block_id, offset);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -8,6 +8,7 @@
 #include <string.h>
 #include "its_flash_nor.h"
 
+#include "its_flash_cache.h"
 #include "flash_fs/its_flash_fs.h"
 #include "Driver_Flash.h"
 
@@ -37,6 +38,13 @@ static psa_status_t its_flash_nor_init(const struct its_flash_fs_config_t *cfg)
 {
     int32_t err;
 
+    if (cfg->cache != NULL) {
+        /* Writes held in the cache are lost, as they are on a power loss */
+        if (its_flash_cache_init(cfg) != PSA_SUCCESS) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+    }
+
     err = ((ARM_DRIVER_FLASH *)cfg->flash_dev)->Initialize(NULL);
     if (err != ARM_DRIVER_OK) {
         return PSA_ERROR_STORAGE_FAILURE;
@@ -121,20 +129,78 @@ static psa_status_t flash_read_unaligned(
 
     return PSA_SUCCESS;
 }
+
+/**
+ * \brief Reads block data from the flash device, with the writes still held in
+ *        the write combining buffer applied.
+ *
+ * \param[in]  cfg       Flash FS configuration
+ * \param[in]  block_id  Block ID
+ * \param[out] buff      Buffer pointer to store the data read
+ * \param[in]  offset    Offset position from the init of the block
+ * \param[in]  size      Number of bytes to read
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_nor_read_flash(
+                                        const struct its_flash_fs_config_t *cfg,
+                                        uint32_t block_id, uint8_t *buff,
+                                        size_t offset, size_t size)
+{
+    struct its_flash_cache_t *cache = cfg->cache;
+    size_t start;
+    size_t end;
+    psa_status_t err;
+
+    err = flash_read_unaligned(cfg, get_phys_address(cfg, block_id, offset),
+                               buff, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if ((cache != NULL) && (cache->wc_size != 0) &&
+        (cache->wc_block_id == block_id)) {
+        start = ITS_UTILS_MAX(offset, cache->wc_offset);
+        end = ITS_UTILS_MIN(offset + size, cache->wc_offset + cache->wc_size);
+        if (start < end) {
+            (void)memcpy(buff + (start - offset),
+                         cache->wc_buf + (start - cache->wc_offset),
+                         end - start);
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
 static psa_status_t its_flash_nor_read(const struct its_flash_fs_config_t *cfg,
                                        uint32_t block_id, uint8_t *buff,
                                        size_t offset, size_t size)
 {
-    uint32_t addr;
-
     if (size == 0) {
         return PSA_SUCCESS;
     }
-    addr = get_phys_address(cfg, block_id, offset);
-    return flash_read_unaligned(cfg, addr, buff, size);
+
+    if (cfg->cache != NULL) {
+        return its_flash_cache_read(cfg, its_flash_nor_read_flash, block_id,
+                                    buff, offset, size);
+    }
+
+    return its_flash_nor_read_flash(cfg, block_id, buff, offset, size);
 }
 
-static psa_status_t its_flash_nor_write(const struct its_flash_fs_config_t *cfg,
+/**
+ * \brief Programs block data to the flash device.
+ *
+ * \param[in] cfg       Flash FS configuration
+ * \param[in] block_id  Block ID
+ * \param[in] buff      Buffer pointer to the write data
+ * \param[in] offset    Offset position from the init of the block
+ * \param[in] size      Number of bytes to write
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_nor_program(
+                                        const struct its_flash_fs_config_t *cfg,
                                         uint32_t block_id, const uint8_t *buff,
                                         size_t offset, size_t size)
 {
@@ -158,15 +224,83 @@ static psa_status_t its_flash_nor_write(const struct its_flash_fs_config_t *cfg,
     return PSA_SUCCESS;
 }
 
+/**
+ * \brief Programs the writes held in the write combining buffer, if any.
+ *
+ * \param[in] cfg  Flash FS configuration
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_nor_program_pending(
+                                        const struct its_flash_fs_config_t *cfg)
+{
+    struct its_flash_cache_t *cache = cfg->cache;
+    uint32_t size;
+
+    if ((cache == NULL) || (cache->wc_size == 0)) {
+        return PSA_SUCCESS;
+    }
+
+    /* The writes are dropped even if programming fails, as the state of the
+     * flash is then unknown anyway.
+     */
+    size = cache->wc_size;
+    cache->wc_size = 0;
+
+    return its_flash_nor_program(cfg, cache->wc_block_id, cache->wc_buf,
+                                 cache->wc_offset, size);
+}
+
+static psa_status_t its_flash_nor_write(const struct its_flash_fs_config_t *cfg,
+                                        uint32_t block_id, const uint8_t *buff,
+                                        size_t offset, size_t size)
+{
+    struct its_flash_cache_t *cache = cfg->cache;
+    psa_status_t err;
+
+    if (cache == NULL) {
+        return its_flash_nor_program(cfg, block_id, buff, offset, size);
+    }
+
+    its_flash_cache_update(cache, block_id, buff, offset, size);
+
+    /* Append to the pending writes if the data directly follows them */
+    if ((cache->wc_size != 0) && (cache->wc_block_id == block_id) &&
+        (cache->wc_offset + cache->wc_size == offset) &&
+        (size <= cache->line_size - cache->wc_size)) {
+        (void)memcpy(cache->wc_buf + cache->wc_size, buff, size);
+        cache->wc_size += size;
+        return PSA_SUCCESS;
+    }
+
+    /* Otherwise program the pending writes first, to keep the program order */
+    err = its_flash_nor_program_pending(cfg);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (size >= cache->line_size) {
+        return its_flash_nor_program(cfg, block_id, buff, offset, size);
+    }
+
+    (void)memcpy(cache->wc_buf, buff, size);
+    cache->wc_block_id = block_id;
+    cache->wc_offset = offset;
+    cache->wc_size = size;
+
+    return PSA_SUCCESS;
+}
+
 static psa_status_t its_flash_nor_flush(const struct its_flash_fs_config_t *cfg,
                                         uint32_t block_id)
 {
-    /* Nothing needs to be done for NOR flash, as writes are commited to flash
-     * immediately.
+    /* Writes are commited to flash immediately, except the ones held in the
+     * write combining buffer. They are programmed whatever their block, as
+     * the flush marks a point where the filesystem needs all its previous
+     * writes to be in flash.
      */
-    (void)cfg;
     (void)block_id;
-    return PSA_SUCCESS;
+    return its_flash_nor_program_pending(cfg);
 }
 
 static psa_status_t its_flash_nor_erase(const struct its_flash_fs_config_t *cfg,
@@ -175,6 +309,22 @@ static psa_status_t its_flash_nor_erase(const struct its_flash_fs_config_t *cfg,
     int32_t err;
     uint32_t addr;
     size_t offset;
+    psa_status_t status;
+
+    if (cfg->cache != NULL) {
+        if ((cfg->cache->wc_size != 0) &&
+            (cfg->cache->wc_block_id == block_id)) {
+            /* The pending writes would be erased anyway */
+            cfg->cache->wc_size = 0;
+        }
+
+        status = its_flash_nor_program_pending(cfg);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        its_flash_cache_invalidate(cfg->cache, block_id);
+    }
 
     for (offset = 0; offset < cfg->block_size; offset += cfg->sector_size) {
         addr = get_phys_address(cfg, block_id, offset);
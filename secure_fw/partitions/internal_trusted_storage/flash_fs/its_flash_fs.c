@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -17,19 +17,28 @@
 
 /* Filesystem-internal flags, which cannot be passed by the caller */
 #define ITS_FLASH_FS_INTERNAL_FLAGS_MASK  (UINT32_MAX - ((1U << 24) - 1))
-/* Flag that indicates the file is to be deleted in the next block update */
-#define ITS_FLASH_FS_FLAG_DELETE          (1U << 24)
 
 static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
                                             uint32_t del_file_idx);
 
+/**
+ * \brief Runs wear leveling after an update has been committed. The update
+ *        has succeeded whatever the result, so a failure is not reported to
+ *        the caller and leveling is attempted again after the next update.
+ */
+static void its_flash_fs_wear_level(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    (void)its_flash_fs_mblock_wear_level(fs_ctx);
+}
+
 static psa_status_t its_flash_fs_file_write_aligned_data(
-                                      struct its_flash_fs_ctx_t *fs_ctx,
-                                      const struct its_block_meta_t *block_meta,
-                                      const struct its_file_meta_t *file_meta,
-                                      size_t offset,
-                                      size_t size,
-                                      const uint8_t *data)
+                                   struct its_flash_fs_ctx_t *fs_ctx,
+                                   const struct its_block_meta_t *block_meta,
+                                   const struct its_file_meta_t *file_meta,
+                                   size_t offset,
+                                   size_t size,
+                                   const uint8_t *data,
+                                   const struct its_flash_fs_stream_t *stream)
 {
 #if (ITS_FLASH_MAX_ALIGNMENT != 1)
     /* Check that the offset is aligned with the flash program unit */
@@ -53,7 +62,7 @@ static psa_status_t its_flash_fs_file_write_aligned_data(
     }
 
     return its_flash_fs_dblock_write_file(fs_ctx, block_meta, file_meta, offset,
-                                          size, data);
+                                          size, data, stream);
 }
 
 /* TODO This is very similar to (static) its_num_active_dblocks() */
@@ -84,7 +93,10 @@ static size_t its_flash_fs_all_metadata_size(
     return sizeof(struct its_metadata_block_header_t)
            + (its_flash_fs_num_active_dblocks(cfg)
               * sizeof(struct its_block_meta_t))
-           + (cfg->max_num_files * sizeof(struct its_file_meta_t));
+           + (cfg->max_num_files * sizeof(struct its_file_meta_t))
+           + ((cfg->erase_count != NULL) ?
+              ITS_UTILS_ALIGN(cfg->num_blocks * sizeof(uint32_t),
+                              cfg->program_unit) : 0);
 }
 
 /**
@@ -135,6 +147,21 @@ static psa_status_t its_flash_fs_validate_config(
         ret = PSA_ERROR_INVALID_ARGUMENT;
     }
 
+    if (cfg->journal_size != 0) {
+        /* The journal records updates of files in dedicated data blocks. It
+         * must fit in the metadata block with the metadata and hold at least
+         * one record.
+         */
+        if ((cfg->num_blocks == 2) || (cfg->journal_map == NULL) ||
+            !ITS_UTILS_IS_ALIGNED(cfg->journal_size, cfg->program_unit) ||
+            (cfg->journal_size <
+             ITS_JOURNAL_RECORD_SIZE(its_flash_fs_num_active_dblocks(cfg))) ||
+            ((its_flash_fs_all_metadata_size(cfg) + cfg->journal_size) >
+             cfg->block_size)) {
+            ret = PSA_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
     return ret;
 }
 
@@ -167,7 +194,6 @@ psa_status_t its_flash_fs_init_ctx(struct its_flash_fs_ctx_t *fs_ctx,
 psa_status_t its_flash_fs_prepare(struct its_flash_fs_ctx_t *fs_ctx)
 {
     psa_status_t err;
-    uint32_t idx;
 
     /* Initialize metadata block with the valid/active metablock */
     err = its_flash_fs_mblock_init(fs_ctx);
@@ -175,18 +201,21 @@ psa_status_t its_flash_fs_prepare(struct its_flash_fs_ctx_t *fs_ctx)
         return err;
     }
 
-    /* Check if a file marked for deletion has been left behind by a power
-     * failure. If so, delete it.
+    /* With deferred compaction, the files marked for deletion are removed
+     * later, like the ones deleted at run time.
      */
-    err = its_flash_fs_mblock_get_file_idx_flag(fs_ctx,
-                                                ITS_FLASH_FS_FLAG_DELETE, &idx);
-    if (err == PSA_SUCCESS) {
-        return its_flash_fs_delete_idx(fs_ctx, idx);
-    } else if (err != PSA_ERROR_DOES_NOT_EXIST) {
-        return err;
+    if (fs_ctx->cfg->deferred_compaction) {
+        return PSA_SUCCESS;
     }
 
-    return PSA_SUCCESS;
+    /* Check if files marked for deletion have been left behind by a power
+     * failure, or by a build with deferred compaction. If so, delete them.
+     */
+    do {
+        err = its_flash_fs_compact_step(fs_ctx);
+    } while (err == PSA_SUCCESS);
+
+    return (err == PSA_ERROR_DOES_NOT_EXIST) ? PSA_SUCCESS : err;
 }
 
 psa_status_t its_flash_fs_wipe_all(struct its_flash_fs_ctx_t *fs_ctx)
@@ -220,15 +249,25 @@ psa_status_t its_flash_fs_file_get_info(struct its_flash_fs_ctx_t *fs_ctx,
     return PSA_SUCCESS;
 }
 
-psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
-                                     const uint8_t *fid,
-                                     struct its_flash_fs_file_info_t *finfo,
-                                     size_t data_size,
-                                     size_t offset,
-                                     const uint8_t *data)
+/**
+ * \brief Writes a file, as its_flash_fs_file_write() does, without reclaiming
+ *        the space of the files marked to be deleted.
+ *
+ * \note PSA_ERROR_INSUFFICIENT_STORAGE is only returned before anything is
+ *       written to flash, so that the write can be retried after compaction.
+ */
+static psa_status_t its_flash_fs_file_update(
+                                   struct its_flash_fs_ctx_t *fs_ctx,
+                                   const uint8_t *fid,
+                                   struct its_flash_fs_file_info_t *finfo,
+                                   size_t data_size,
+                                   size_t offset,
+                                   const uint8_t *data,
+                                   const struct its_flash_fs_stream_t *stream)
 {
     struct its_block_meta_t block_meta;
     struct its_file_meta_t file_meta = {0};
+    struct its_file_meta_t old_meta;
     uint32_t cur_phys_block;
     psa_status_t err;
     uint32_t idx;
@@ -261,19 +300,6 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
                 file_meta.cur_size = 0;
                 file_meta.flags = finfo->flags;
                 new_idx = old_idx;
-            } else {
-                /* Mark the existing file to be deleted in this block update. It
-                 * will be deleted in a second block update, and if there is a
-                 * power failure before that block update completes, then
-                 * deletion will be re-attempted based on this flag.
-                 */
-                file_meta.flags |= ITS_FLASH_FS_FLAG_DELETE;
-                err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx,
-                                                                   old_idx,
-                                                                   &file_meta);
-                if (err != PSA_SUCCESS) {
-                    return PSA_ERROR_GENERIC_ERROR;
-                }
             }
         } else {
             /* Write to existing file */
@@ -298,6 +324,17 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         /* Only use the spare file if there is an old file to be deleted */
         use_spare = (old_idx != ITS_METADATA_INVALID_INDEX);
 
+        /* Mark the existing file to be deleted in this block update. It
+         * will be deleted in a second block update, or by a later compaction
+         * step if compaction is deferred, and if there is a power failure
+         * before that block update completes, then deletion will be
+         * re-attempted based on this flag.
+         */
+        if (use_spare) {
+            file_meta.flags |= ITS_FLASH_FS_FLAG_DELETE;
+            old_meta = file_meta;
+        }
+
         /* Try to reserve a new file based on the input parameters */
         err = its_flash_fs_mblock_reserve_file(fs_ctx, fid, use_spare,
                                                finfo->size_max, finfo->flags, &new_idx,
@@ -305,6 +342,15 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         if (err != PSA_SUCCESS) {
             return err;
         }
+
+        if (use_spare) {
+            err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx,
+                                                               old_idx,
+                                                               &old_meta);
+            if (err != PSA_SUCCESS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+        }
     } else {
         /* Read existing block metadata */
         err = its_flash_fs_mblock_read_block_metadata(fs_ctx, file_meta.lblock,
@@ -318,7 +364,7 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         /* Write the content into scratch data block */
         err = its_flash_fs_file_write_aligned_data(fs_ctx, &block_meta,
                                                    &file_meta, offset,
-                                                   data_size, data);
+                                                   data_size, data, stream);
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
         }
@@ -340,6 +386,27 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
                                              file_meta.lblock);
     }
 
+#ifdef ITS_ENCRYPTION
+    memcpy(file_meta.nonce, finfo->nonce, sizeof(finfo->nonce));
+    memcpy(file_meta.tag, finfo->tag, sizeof(finfo->tag));
+#endif
+
+#if ITS_METADATA_JOURNAL_SIZE
+    /* An update which does not replace an existing file is recorded in the
+     * metadata journal when possible, instead of swapping metadata blocks.
+     */
+    if ((old_idx == ITS_METADATA_INVALID_INDEX) || (old_idx == new_idx)) {
+        err = its_flash_fs_mblock_journal_update(fs_ctx, new_idx, &file_meta,
+                                                 &block_meta);
+        if (err == PSA_SUCCESS) {
+            its_flash_fs_wear_level(fs_ctx);
+            return PSA_SUCCESS;
+        } else if (err != PSA_ERROR_INSUFFICIENT_STORAGE) {
+            return err;
+        }
+    }
+#endif
+
     /* Update block metadata in scratch metadata block */
     err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx,
                                                         file_meta.lblock,
@@ -348,11 +415,6 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         return PSA_ERROR_GENERIC_ERROR;
     }
 
-#ifdef ITS_ENCRYPTION
-    memcpy(file_meta.nonce, finfo->nonce, sizeof(finfo->nonce));
-    memcpy(file_meta.tag, finfo->tag, sizeof(finfo->tag));
-#endif
-
     /* Write file metadata in the scratch metadata block */
     err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, new_idx,
                                                        &file_meta);
@@ -408,18 +470,88 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         return err;
     }
 
-    /* Delete the old file in a second block update.
+    /* Delete the old file in a second block update, unless compaction is
+     * deferred.
      * Note: A power failure after this point, but before the deletion has
      * completed, will leave the old file in the filesystem, so it is always
      * necessary to check for files to be deleted at initialisation time.
      */
-    if ((old_idx != ITS_METADATA_INVALID_INDEX) && (old_idx != new_idx)) {
+    if ((old_idx != ITS_METADATA_INVALID_INDEX) && (old_idx != new_idx) &&
+        !fs_ctx->cfg->deferred_compaction) {
         err = its_flash_fs_delete_idx(fs_ctx, old_idx);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    its_flash_fs_wear_level(fs_ctx);
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Writes data to a file from a buffer or from a stream, reclaiming the
+ *        space of the files marked to be deleted if needed.
+ */
+static psa_status_t its_flash_fs_file_write_data(
+                                   struct its_flash_fs_ctx_t *fs_ctx,
+                                   const uint8_t *fid,
+                                   struct its_flash_fs_file_info_t *finfo,
+                                   size_t data_size,
+                                   size_t offset,
+                                   const uint8_t *data,
+                                   const struct its_flash_fs_stream_t *stream)
+{
+    psa_status_t err;
+
+    err = its_flash_fs_file_update(fs_ctx, fid, finfo, data_size, offset,
+                                   data, stream);
+
+    /* Reclaim the space of the files marked to be deleted, one at a time,
+     * until the file fits.
+     */
+    while (err == PSA_ERROR_INSUFFICIENT_STORAGE) {
+        err = its_flash_fs_compact_step(fs_ctx);
+        if (err == PSA_ERROR_DOES_NOT_EXIST) {
+            return PSA_ERROR_INSUFFICIENT_STORAGE;
+        } else if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        err = its_flash_fs_file_update(fs_ctx, fid, finfo, data_size, offset,
+                                       data, stream);
     }
 
     return err;
 }
 
+psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
+                                     const uint8_t *fid,
+                                     struct its_flash_fs_file_info_t *finfo,
+                                     size_t data_size,
+                                     size_t offset,
+                                     const uint8_t *data)
+{
+    return its_flash_fs_file_write_data(fs_ctx, fid, finfo, data_size, offset,
+                                        data, NULL);
+}
+
+psa_status_t its_flash_fs_file_write_stream(
+                                   struct its_flash_fs_ctx_t *fs_ctx,
+                                   const uint8_t *fid,
+                                   struct its_flash_fs_file_info_t *finfo,
+                                   size_t data_size,
+                                   size_t offset,
+                                   const struct its_flash_fs_stream_t *stream)
+{
+    if ((stream == NULL) || (stream->next == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return its_flash_fs_file_write_data(fs_ctx, fid, finfo, data_size, offset,
+                                        NULL, stream);
+}
+
 static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
                                             uint32_t del_file_idx)
 {
@@ -551,19 +683,127 @@ static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
     return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
 }
 
+/**
+ * \brief Marks a file to be deleted, without moving any file data.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     idx        File metadata entry index
+ * \param[in,out] file_meta  File metadata of the entry
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_mark_delete(struct its_flash_fs_ctx_t *fs_ctx,
+                                             uint32_t idx,
+                                             struct its_file_meta_t *file_meta)
+{
+    struct its_block_meta_t block_meta;
+    psa_status_t err;
+
+    file_meta->flags |= ITS_FLASH_FS_FLAG_DELETE;
+
+#if ITS_METADATA_JOURNAL_SIZE
+    /* The data block is unchanged, so the update of a file in a dedicated
+     * data block is recorded in the metadata journal when possible.
+     */
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, file_meta->lblock,
+                                                  &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_mblock_journal_update(fs_ctx, idx, file_meta,
+                                             &block_meta);
+    if (err != PSA_ERROR_INSUFFICIENT_STORAGE) {
+        return err;
+    }
+#endif
+
+    /* Copy the block metadata to the scratch metadata block */
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, ITS_LOGICAL_DBLOCK0,
+                                                  &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx,
+                                                        ITS_LOGICAL_DBLOCK0,
+                                                        &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, idx, file_meta);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    err = its_flash_fs_mblock_cp_file_meta(fs_ctx, 0, idx);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    err = its_flash_fs_mblock_cp_file_meta(fs_ctx, idx + 1,
+                                           fs_ctx->cfg->max_num_files);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    err = its_flash_fs_mblock_migrate_lb0_data_to_scratch(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    /* Write metadata header, swap metadata blocks and erase scratch blocks */
+    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+}
+
 psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
                                       const uint8_t *fid)
 {
     psa_status_t err;
     uint32_t del_file_idx;
+    struct its_file_meta_t file_meta;
 
     /* Get the file index. */
-    err = its_flash_fs_mblock_get_file_idx_meta(fs_ctx, fid, &del_file_idx, NULL);
+    err = its_flash_fs_mblock_get_file_idx_meta(fs_ctx, fid, &del_file_idx,
+                                                &file_meta);
     if (err != PSA_SUCCESS) {
         return PSA_ERROR_DOES_NOT_EXIST;
     }
 
-    return its_flash_fs_delete_idx(fs_ctx, del_file_idx);
+    if (fs_ctx->cfg->deferred_compaction) {
+        err = its_flash_fs_mark_delete(fs_ctx, del_file_idx, &file_meta);
+    } else {
+        err = its_flash_fs_delete_idx(fs_ctx, del_file_idx);
+    }
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    its_flash_fs_wear_level(fs_ctx);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_compact_step(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+    uint32_t idx;
+
+    err = its_flash_fs_mblock_get_file_idx_flag(fs_ctx,
+                                                ITS_FLASH_FS_FLAG_DELETE, &idx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_delete_idx(fs_ctx, idx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    its_flash_fs_wear_level(fs_ctx);
+
+    return PSA_SUCCESS;
 }
 
 psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
@@ -597,3 +837,495 @@ psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
 
     return PSA_SUCCESS;
 }
+
+/**
+ * \brief Validates a batch of file updates and finds the metadata entries of
+ *        the existing files. The dedicated data block which holds existing
+ *        files of the batch, if any, is returned in dblock.
+ *
+ * \param[in,out] fs_ctx   Filesystem context
+ * \param[in,out] ops      Array of file updates
+ * \param[in]     num_ops  Number of file updates
+ * \param[out]    dblock   Dedicated logical block to rewrite, or
+ *                         ITS_BLOCK_INVALID_ID if there is none
+ * \param[out]    freed    Space released by the existing files in logical
+ *                         block 0 and in the dedicated block
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_batch_resolve(
+                                            struct its_flash_fs_ctx_t *fs_ctx,
+                                            struct its_flash_fs_file_op_t *ops,
+                                            uint32_t num_ops,
+                                            uint32_t *dblock,
+                                            size_t freed[2])
+{
+    struct its_file_meta_t file_meta;
+    psa_status_t err;
+    uint32_t i;
+    uint32_t j;
+
+    *dblock = ITS_BLOCK_INVALID_ID;
+    freed[0] = 0;
+    freed[1] = 0;
+
+    for (i = 0; i < num_ops; i++) {
+        if (its_utils_validate_fid(ops[i].fid) != PSA_SUCCESS) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        /* Each file can only be updated once in a batch */
+        for (j = 0; j < i; j++) {
+            if (memcmp(ops[i].fid, ops[j].fid, ITS_FILE_ID_SIZE) == 0) {
+                return PSA_ERROR_INVALID_ARGUMENT;
+            }
+        }
+
+        if (!ops[i].remove) {
+            /* Do not permit the user to pass filesystem-internal flags */
+            if (ops[i].finfo.flags & ITS_FLASH_FS_INTERNAL_FLAGS_MASK) {
+                return PSA_ERROR_INVALID_ARGUMENT;
+            }
+
+            ops[i].finfo.size_max = ops[i].finfo.size_current;
+#if (ITS_FLASH_MAX_ALIGNMENT != 1)
+            ops[i].finfo.size_max = ITS_UTILS_ALIGN(ops[i].finfo.size_max,
+                                                    fs_ctx->cfg->program_unit);
+#endif
+            if (ops[i].finfo.size_max > fs_ctx->cfg->max_file_size) {
+                return PSA_ERROR_INVALID_ARGUMENT;
+            }
+        }
+
+        err = its_flash_fs_mblock_get_file_idx_meta(fs_ctx, ops[i].fid,
+                                                    &ops[i].idx, &file_meta);
+        if (err == PSA_ERROR_DOES_NOT_EXIST) {
+            if (ops[i].remove) {
+                return PSA_ERROR_DOES_NOT_EXIST;
+            }
+
+            ops[i].idx = ITS_METADATA_INVALID_INDEX;
+            ops[i].lblock = ITS_BLOCK_INVALID_ID;
+            continue;
+        } else if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        /* Only one dedicated data block can be rewritten, as there is a
+         * single scratch data block.
+         */
+        if (file_meta.lblock != ITS_LOGICAL_DBLOCK0) {
+            if (*dblock == ITS_BLOCK_INVALID_ID) {
+                *dblock = file_meta.lblock;
+            } else if (*dblock != file_meta.lblock) {
+                return PSA_ERROR_INSUFFICIENT_STORAGE;
+            }
+        }
+
+        ops[i].lblock = file_meta.lblock;
+        freed[file_meta.lblock != ITS_LOGICAL_DBLOCK0] += file_meta.max_size;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Chooses the logical block of each file written by a batch, and
+ *        reserves a metadata entry for each new file.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in,out] ops        Array of file updates
+ * \param[in]     num_ops    Number of file updates
+ * \param[in,out] dblock     Dedicated logical block to rewrite, or
+ *                           ITS_BLOCK_INVALID_ID if there is none
+ * \param[in,out] free_size  Free space in logical block 0 and in the
+ *                           dedicated block once the existing files of the
+ *                           batch are removed
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_batch_place(struct its_flash_fs_ctx_t *fs_ctx,
+                                             struct its_flash_fs_file_op_t *ops,
+                                             uint32_t num_ops,
+                                             uint32_t *dblock,
+                                             size_t free_size[2])
+{
+    struct its_block_meta_t block_meta;
+    struct its_file_meta_t file_meta;
+    psa_status_t err;
+    uint32_t num_new = 0;
+    uint32_t num_free = 0;
+    uint32_t lblock;
+    uint32_t idx;
+    uint32_t i;
+
+    for (i = 0; i < num_ops; i++) {
+        if (ops[i].remove) {
+            continue;
+        }
+
+        if (ops[i].idx == ITS_METADATA_INVALID_INDEX) {
+            num_new++;
+        }
+
+        /* Keep the file in its current block if it fits, otherwise prefer the
+         * dedicated block to logical block 0.
+         */
+        lblock = ops[i].lblock;
+        if ((lblock == ITS_BLOCK_INVALID_ID) ||
+            (free_size[lblock != ITS_LOGICAL_DBLOCK0] <
+             ops[i].finfo.size_max)) {
+            if ((*dblock != ITS_BLOCK_INVALID_ID) &&
+                (free_size[1] >= ops[i].finfo.size_max)) {
+                lblock = *dblock;
+            } else if (free_size[0] >= ops[i].finfo.size_max) {
+                lblock = ITS_LOGICAL_DBLOCK0;
+            } else {
+                lblock = ITS_BLOCK_INVALID_ID;
+            }
+        }
+
+        /* Otherwise, the first dedicated block with enough space is rewritten
+         * if no dedicated block has been chosen yet.
+         */
+        if ((lblock == ITS_BLOCK_INVALID_ID) &&
+            (*dblock == ITS_BLOCK_INVALID_ID)) {
+            for (idx = ITS_LOGICAL_DBLOCK0 + 1;
+                 idx < its_flash_fs_num_active_dblocks(fs_ctx->cfg); idx++) {
+                err = its_flash_fs_mblock_read_block_metadata(fs_ctx, idx,
+                                                              &block_meta);
+                if (err != PSA_SUCCESS) {
+                    return err;
+                }
+
+                if (block_meta.free_size >= ops[i].finfo.size_max) {
+                    *dblock = idx;
+                    free_size[1] = block_meta.free_size;
+                    lblock = idx;
+                    break;
+                }
+            }
+        }
+
+        if (lblock == ITS_BLOCK_INVALID_ID) {
+            return PSA_ERROR_INSUFFICIENT_STORAGE;
+        }
+
+        ops[i].lblock = lblock;
+        free_size[lblock != ITS_LOGICAL_DBLOCK0] -= ops[i].finfo.size_max;
+    }
+
+    if (num_new == 0) {
+        return PSA_SUCCESS;
+    }
+
+    /* Reserve the metadata entries of the new files, leaving at least one
+     * entry free, like its_flash_fs_mblock_reserve_file() does.
+     */
+    for (idx = 0; (idx < fs_ctx->cfg->max_num_files) && (num_free <= num_new);
+         idx++) {
+        err = its_flash_fs_mblock_read_file_meta(fs_ctx, idx, &file_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if (its_utils_validate_fid(file_meta.id) == PSA_SUCCESS) {
+            continue;
+        }
+
+        if (num_free < num_new) {
+            for (i = 0; i < num_ops; i++) {
+                if (!ops[i].remove &&
+                    (ops[i].idx == ITS_METADATA_INVALID_INDEX)) {
+                    ops[i].idx = idx;
+                    break;
+                }
+            }
+        }
+
+        num_free++;
+    }
+
+    return (num_free > num_new) ? PSA_SUCCESS : PSA_ERROR_INSUFFICIENT_STORAGE;
+}
+
+/**
+ * \brief Writes the file metadata entry of a file in the scratch metadata
+ *        block, and its data in the scratch copy of its logical block. The
+ *        data of the files of logical block 0 and of the dedicated block is
+ *        packed from the start of the block in the order of the entries.
+ *
+ * \param[in,out] fs_ctx   Filesystem context
+ * \param[in]     ops      Array of file updates
+ * \param[in]     num_ops  Number of file updates
+ * \param[in]     idx      File metadata entry index
+ * \param[in]     dblock   Dedicated logical block to rewrite, or
+ *                         ITS_BLOCK_INVALID_ID if there is none
+ * \param[in]     src      Physical IDs of the current logical block 0 and
+ *                         dedicated block
+ * \param[in]     dst      Physical IDs of their scratch blocks
+ * \param[in,out] pos      Positions of the end of the data in the scratch
+ *                         blocks
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_batch_write_file(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      const struct its_flash_fs_file_op_t *ops,
+                                      uint32_t num_ops,
+                                      uint32_t idx,
+                                      uint32_t dblock,
+                                      const uint32_t src[2],
+                                      const uint32_t dst[2],
+                                      size_t pos[2])
+{
+    struct its_file_meta_t file_meta = {0};
+    const struct its_flash_fs_file_op_t *op = NULL;
+    psa_status_t err;
+    uint32_t b;
+    uint32_t i;
+
+    for (i = 0; i < num_ops; i++) {
+        if (ops[i].idx == idx) {
+            op = &ops[i];
+            break;
+        }
+    }
+
+    if (op == NULL) {
+        err = its_flash_fs_mblock_read_file_meta(fs_ctx, idx, &file_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        /* Move the data of the other files of the rewritten blocks. A file
+         * marked to be deleted is removed instead, as its block is compacted.
+         */
+        if ((its_utils_validate_fid(file_meta.id) == PSA_SUCCESS) &&
+            ((file_meta.lblock == ITS_LOGICAL_DBLOCK0) ||
+             (file_meta.lblock == dblock))) {
+            if (file_meta.flags & ITS_FLASH_FS_FLAG_DELETE) {
+                file_meta = (struct its_file_meta_t){0};
+            } else {
+                b = (file_meta.lblock != ITS_LOGICAL_DBLOCK0);
+                err = its_flash_fs_block_to_block_move(fs_ctx, dst[b], pos[b],
+                                                       src[b],
+                                                       file_meta.data_idx,
+                                                       file_meta.max_size);
+                if (err != PSA_SUCCESS) {
+                    return err;
+                }
+
+                file_meta.data_idx = pos[b];
+                pos[b] += file_meta.max_size;
+            }
+        }
+    } else if (!op->remove) {
+        (void)memcpy(file_meta.id, op->fid, ITS_FILE_ID_SIZE);
+        file_meta.lblock = op->lblock;
+        file_meta.data_idx = pos[op->lblock != ITS_LOGICAL_DBLOCK0];
+        file_meta.cur_size = op->finfo.size_current;
+        file_meta.max_size = op->finfo.size_max;
+        file_meta.flags = op->finfo.flags;
+#ifdef ITS_ENCRYPTION
+        memcpy(file_meta.nonce, op->finfo.nonce, sizeof(op->finfo.nonce));
+        memcpy(file_meta.tag, op->finfo.tag, sizeof(op->finfo.tag));
+#endif
+
+        b = (op->lblock != ITS_LOGICAL_DBLOCK0);
+        if (file_meta.max_size != 0) {
+            err = fs_ctx->ops->write(fs_ctx->cfg, dst[b], op->data, pos[b],
+                                     file_meta.max_size);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+
+        pos[b] += file_meta.max_size;
+    }
+
+    /* A deleted file leaves an empty entry */
+    return its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, idx,
+                                                        &file_meta);
+}
+
+/**
+ * \brief Applies a batch of file updates, as its_flash_fs_file_write_batch()
+ *        does, without reclaiming the space of the files marked to be deleted
+ *        outside of the rewritten blocks.
+ *
+ * \note PSA_ERROR_INSUFFICIENT_STORAGE is only returned before anything is
+ *       written to flash, so that the batch can be retried after compaction.
+ */
+static psa_status_t its_flash_fs_batch_update(
+                                            struct its_flash_fs_ctx_t *fs_ctx,
+                                            struct its_flash_fs_file_op_t *ops,
+                                            uint32_t num_ops)
+{
+    struct its_block_meta_t lb0_meta;
+    struct its_block_meta_t block_meta;
+    uint32_t dblock;
+    uint32_t src[2];
+    uint32_t dst[2];
+    size_t pos[2];
+    size_t free_size[2];
+    psa_status_t err;
+    uint32_t idx;
+
+    if ((ops == NULL) || (num_ops == 0)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    err = its_flash_fs_batch_resolve(fs_ctx, ops, num_ops, &dblock, free_size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The data of logical block 0 is always rewritten, as it is in the
+     * metadata block.
+     */
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, ITS_LOGICAL_DBLOCK0,
+                                                  &lb0_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+    free_size[0] += lb0_meta.free_size;
+
+    block_meta = (struct its_block_meta_t){0};
+    if (dblock != ITS_BLOCK_INVALID_ID) {
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, dblock,
+                                                      &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+        free_size[1] += block_meta.free_size;
+    }
+
+    /* Nothing is written to flash before all files have found a place */
+    err = its_flash_fs_batch_place(fs_ctx, ops, num_ops, &dblock, free_size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    src[0] = fs_ctx->active_metablock;
+    dst[0] = fs_ctx->scratch_metablock;
+    pos[0] = lb0_meta.data_start;
+    if (dblock != ITS_BLOCK_INVALID_ID) {
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, dblock,
+                                                      &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        src[1] = block_meta.phy_id;
+        dst[1] = its_flash_fs_mblock_cur_data_scratch_id(fs_ctx, dblock);
+        pos[1] = block_meta.data_start;
+    }
+
+    for (idx = 0; idx < fs_ctx->cfg->max_num_files; idx++) {
+        err = its_flash_fs_batch_write_file(fs_ctx, ops, num_ops, idx, dblock,
+                                            src, dst, pos);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+
+    lb0_meta.free_size = fs_ctx->cfg->block_size - pos[0];
+    if (dblock == ITS_BLOCK_INVALID_ID) {
+        err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx,
+                                                            ITS_LOGICAL_DBLOCK0,
+                                                            &lb0_meta);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    } else {
+        /* The scratch data block becomes the dedicated block */
+        block_meta.free_size = fs_ctx->cfg->block_size - pos[1];
+        block_meta.phy_id = dst[1];
+        its_flash_fs_mblock_set_data_scratch(fs_ctx, src[1], dblock);
+
+        /* Nothing to flush if no data was written in the block */
+        if (pos[1] != block_meta.data_start) {
+            err = fs_ctx->ops->flush(fs_ctx->cfg, dst[1]);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+
+        err = its_flash_fs_mblock_update_scratch_block_meta_lb0(fs_ctx, dblock,
+                                                                &block_meta,
+                                                                &lb0_meta);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+
+    /* Write metadata header, swap metadata blocks and erase scratch blocks */
+    err = its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    its_flash_fs_wear_level(fs_ctx);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_file_write_batch(struct its_flash_fs_ctx_t *fs_ctx,
+                                           struct its_flash_fs_file_op_t *ops,
+                                           uint32_t num_ops)
+{
+    psa_status_t err;
+
+    err = its_flash_fs_batch_update(fs_ctx, ops, num_ops);
+
+    /* Reclaim the space of the files marked to be deleted, one at a time,
+     * until the batch fits.
+     */
+    while (err == PSA_ERROR_INSUFFICIENT_STORAGE) {
+        err = its_flash_fs_compact_step(fs_ctx);
+        if (err == PSA_ERROR_DOES_NOT_EXIST) {
+            return PSA_ERROR_INSUFFICIENT_STORAGE;
+        } else if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        err = its_flash_fs_batch_update(fs_ctx, ops, num_ops);
+    }
+
+    return err;
+}
+
+psa_status_t its_flash_fs_get_wear_stats(struct its_flash_fs_ctx_t *fs_ctx,
+                                         struct its_flash_fs_wear_stats_t *stats)
+{
+    const uint32_t *erase_count = fs_ctx->cfg->erase_count;
+    uint32_t num_blocks = fs_ctx->cfg->num_blocks;
+    uint32_t i;
+
+    if (erase_count == NULL) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    *stats = (struct its_flash_fs_wear_stats_t){0};
+    stats->num_blocks = num_blocks;
+    stats->min_erase_count = UINT32_MAX;
+
+    for (i = 0; i < num_blocks; i++) {
+        stats->min_erase_count = ITS_UTILS_MIN(stats->min_erase_count,
+                                               erase_count[i]);
+        stats->max_erase_count = ITS_UTILS_MAX(stats->max_erase_count,
+                                               erase_count[i]);
+    }
+
+    /* Spread the bins evenly between the lowest and highest erase counts */
+    stats->bin_width = ((stats->max_erase_count - stats->min_erase_count)
+                        / ITS_FLASH_FS_WEAR_HIST_BINS) + 1;
+
+    for (i = 0; i < num_blocks; i++) {
+        stats->histogram[(erase_count[i] - stats->min_erase_count)
+                         / stats->bin_width]++;
+    }
+
+    return PSA_SUCCESS;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -17,10 +17,13 @@
 #ifndef __ITS_FLASH_FS_H__
 #define __ITS_FLASH_FS_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include "its_flash_fs_mblock.h"
+#include "its_utils.h"
+#include "flash/its_flash_cache.h"
 #include "psa/error.h"
 
 #ifdef __cplusplus
@@ -42,6 +45,54 @@ extern "C" {
 /* Invalid block index */
 #define ITS_BLOCK_INVALID_ID 0xFFFFFFFFU
 
+/**
+ * \struct its_flash_fs_index_t
+ *
+ * \brief Structure containing the RAM index of the file metadata table, used
+ *        when ITS_RAM_FILE_INDEX is enabled. It avoids scanning the metadata
+ *        table in flash to look up a file ID or to find a free entry.
+ *
+ * \note Use ITS_FLASH_FS_INDEX_DEFINE to allocate the index for a filesystem.
+ */
+struct its_flash_fs_index_t {
+    uint8_t  *active_fid;  /**< File IDs in the active metadata block */
+    uint8_t  *scratch_fid; /**< File IDs written to the scratch metadata block
+                            */
+    uint16_t *hash;        /**< Open addressing table of file metadata entry
+                            *   indexes plus one, 0 for an empty bucket
+                            */
+    uint32_t *free_map;    /**< Bitmap of free file metadata entries */
+};
+
+/* Number of hash table buckets, to keep the load factor at most 50% */
+#define ITS_FLASH_FS_INDEX_HASH_SIZE(num_files)   (2U * (num_files))
+
+/**
+ * \brief Allocates a RAM index for a filesystem of num_files files.
+ */
+#define ITS_FLASH_FS_INDEX_DEFINE(name, num_files)                             \
+    static uint8_t name##_active_fid[(num_files) * ITS_FILE_ID_SIZE];          \
+    static uint8_t name##_scratch_fid[(num_files) * ITS_FILE_ID_SIZE];         \
+    static uint16_t name##_hash[ITS_FLASH_FS_INDEX_HASH_SIZE(num_files)];      \
+    static uint32_t name##_free_map[((num_files) + 31) / 32];                  \
+    static struct its_flash_fs_index_t name = {                                \
+        .active_fid = name##_active_fid,                                       \
+        .scratch_fid = name##_scratch_fid,                                     \
+        .hash = name##_hash,                                                   \
+        .free_map = name##_free_map,                                           \
+    }
+
+/**
+ * \brief Allocates the erase counters of a filesystem of at most num_blocks
+ *        blocks, used when ITS_WEAR_LEVELING_THRESHOLD is not 0. The counters
+ *        are padded to the maximum flash program unit, as they are programmed
+ *        in the metadata block.
+ */
+#define ITS_FLASH_FS_ERASE_COUNT_DEFINE(name, num_blocks)                      \
+    static uint32_t name[ITS_UTILS_ALIGN((num_blocks) * sizeof(uint32_t),      \
+                                         ITS_FLASH_MAX_ALIGNMENT)              \
+                         / sizeof(uint32_t)]
+
 /**
  * \struct its_flash_fs_config_t
  *
@@ -61,6 +112,35 @@ struct its_flash_fs_config_t {
     uint16_t max_file_size;   /**< Maximum file size */
     uint16_t max_num_files;   /**< Maximum number of files */
     uint8_t erase_val;        /**< Value of a byte after erase (usually 0xFF) */
+    struct its_flash_fs_index_t *index; /**< RAM index of the file metadata,
+                                         *   NULL to scan the metadata table
+                                         */
+    uint32_t journal_size;    /**< Size of the metadata journal area after the
+                               *   metadata tables, 0 to disable it
+                               */
+    uint16_t *journal_map;    /**< Latest journal record plus one of each file
+                               *   metadata entry, max_num_files entries
+                               */
+    uint32_t *erase_count;    /**< Erase count of each physical block,
+                               *   allocated with
+                               *   ITS_FLASH_FS_ERASE_COUNT_DEFINE for at
+                               *   least num_blocks blocks, NULL to disable
+                               *   wear leveling
+                               */
+    uint32_t wear_threshold;  /**< Difference of erase counts above which the
+                               *   least worn data block is made the scratch
+                               *   data block
+                               */
+    bool deferred_compaction; /**< If true, a deleted file is only marked in
+                               *   its metadata entry, and its space is
+                               *   reclaimed by its_flash_fs_compact_step() or
+                               *   when the space is needed
+                               */
+    struct its_flash_cache_t *cache; /**< Cache of the flash back end,
+                                      *   allocated with
+                                      *   ITS_FLASH_CACHE_DEFINE, NULL to
+                                      *   disable caching
+                                      */
 };
 
 /**
@@ -134,6 +214,12 @@ struct its_flash_fs_ops_t {
      * \note It is permitted for write() to commit block updates immediately, in
      *       which case this function is a no-op.
      *
+     * \note write() may also hold back contiguous writes to combine them. They
+     *       must then be programmed in the order they were made, at the latest
+     *       when this function or erase() is called. The filesystem calls this
+     *       function before returning from any operation that wrote to flash,
+     *       and where a write must not be combined with the previous ones.
+     *
      * \return Returns PSA_SUCCESS if the function is executed correctly.
      *         Otherwise, it returns PSA_ERROR_STORAGE_FAILURE.
      */
@@ -187,6 +273,76 @@ struct its_flash_fs_file_info_t {
 #endif
 };
 
+/* Number of bins of the erase count histogram */
+#define ITS_FLASH_FS_WEAR_HIST_BINS  8
+
+/*!
+ * \struct its_flash_fs_wear_stats_t
+ *
+ * \brief Structure containing the erase statistics of the physical blocks.
+ *
+ * \details Bin i of the histogram counts the blocks erased between
+ *          min_erase_count + i * bin_width and
+ *          min_erase_count + (i + 1) * bin_width - 1 times.
+ */
+struct its_flash_fs_wear_stats_t {
+    uint32_t num_blocks;       /*!< Number of physical blocks */
+    uint32_t min_erase_count;  /*!< Lowest erase count of a block */
+    uint32_t max_erase_count;  /*!< Highest erase count of a block */
+    uint32_t bin_width;        /*!< Number of erase counts per bin */
+    uint32_t histogram[ITS_FLASH_FS_WEAR_HIST_BINS]; /*!< Number of blocks per
+                                                      *   erase count bin
+                                                      */
+};
+
+/**
+ * \brief Produces the next piece of the data of a streamed file write.
+ *
+ * \param[in,out] ctx   Context of the stream
+ * \param[out]    data  Set to the buffer of the piece. It must be readable up
+ *                      to the size of the piece aligned to the flash program
+ *                      unit, and stay valid until the next call.
+ * \param[out]    size  Set to the size of the piece in bytes. Every piece but
+ *                      the last one must be a multiple of the flash program
+ *                      unit.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+typedef psa_status_t (*its_flash_fs_stream_next_t)(void *ctx,
+                                                   const uint8_t **data,
+                                                   size_t *size);
+
+/*!
+ * \struct its_flash_fs_stream_t
+ *
+ * \brief Structure describing the source of a streamed file write.
+ */
+struct its_flash_fs_stream_t {
+    its_flash_fs_stream_next_t next; /*!< Produces the next piece of data */
+    void *ctx;                       /*!< Context passed to next */
+};
+
+/*!
+ * \struct its_flash_fs_file_op_t
+ *
+ * \brief Structure describing one file update of a batch.
+ *
+ * \details A write replaces the whole content of the file, which is created if
+ *          it does not exist. The size of the data is finfo.size_current and
+ *          the data buffer must be readable up to that size aligned to the
+ *          flash program unit. The other fields of finfo are the same as for
+ *          its_flash_fs_file_write(), except size_max, which is set by the
+ *          filesystem. The last two fields are internal to the filesystem.
+ */
+struct its_flash_fs_file_op_t {
+    const uint8_t *fid;                    /*!< File ID */
+    const uint8_t *data;                   /*!< Data to write in the file */
+    struct its_flash_fs_file_info_t finfo; /*!< Information of the new file */
+    bool remove;                           /*!< Deletes the file if true */
+    uint32_t idx;                          /*!< File metadata entry index */
+    uint32_t lblock;                       /*!< Logical block of the file */
+};
+
 /**
  * \brief Initialises the filesystem context. Must be called successfully before
  *        any other filesystem API is called.
@@ -258,6 +414,36 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
                                      size_t offset,
                                      const uint8_t *data);
 
+/**
+ * \brief Writes data to a file, appending the pieces produced by a stream.
+ *
+ * \details As its_flash_fs_file_write(), but the data does not have to be
+ *          held in a single buffer. The pieces are requested in order and
+ *          appended to the file data in the scratch data block, so the data
+ *          block is copied and swapped once for the whole write.
+ *
+ * \note The stream is only read once the file has been reserved, so it is not
+ *       read again when the write is retried after compaction.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     fid        File ID
+ * \param[in]     finfo      Pointer to \ref its_flash_fs_file_info_t
+ * \param[in]     data_size  Size of the incoming write data, the total size of
+ *                           the pieces produced by the stream
+ * \param[in]     offset     Offset in the file to write. Must be less than or
+ *                           equal to the current file size.
+ * \param[in]     stream     Stream producing the data to be written
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_file_write_stream(
+                                   struct its_flash_fs_ctx_t *fs_ctx,
+                                   const uint8_t *fid,
+                                   struct its_flash_fs_file_info_t *finfo,
+                                   size_t data_size,
+                                   size_t offset,
+                                   const struct its_flash_fs_stream_t *stream);
+
 /**
  * \brief Reads data from an existing file.
  *
@@ -278,6 +464,10 @@ psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
 /**
  * \brief Deletes file referenced by the file ID.
  *
+ * \note With deferred compaction, the file is only marked to be deleted in
+ *       its metadata entry. Its entry and its data are removed later by
+ *       its_flash_fs_compact_step().
+ *
  * \param[in,out] fs_ctx  Filesystem context
  * \param[in]     fid     File ID
  *
@@ -286,6 +476,53 @@ psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
 psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
                                       const uint8_t *fid);
 
+/**
+ * \brief Writes and deletes several files in a single update of the metadata
+ *        blocks, so that either all or none of the changes are visible after
+ *        a power failure.
+ *
+ * \note The files updated must be located in logical block 0 or in one
+ *       dedicated data block, as a single scratch data block is available.
+ *       New files are placed in these blocks if possible.
+ *
+ * \param[in,out] fs_ctx   Filesystem context
+ * \param[in,out] ops      Array of file updates, one per file ID
+ * \param[in]     num_ops  Number of file updates
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_file_write_batch(struct its_flash_fs_ctx_t *fs_ctx,
+                                           struct its_flash_fs_file_op_t *ops,
+                                           uint32_t num_ops);
+
+/**
+ * \brief Removes one file marked to be deleted from the filesystem, compacting
+ *        its data block. Each call does a bounded amount of work, so that it
+ *        can be called when the system is idle.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns PSA_ERROR_DOES_NOT_EXIST if no file is marked to be deleted.
+ *         Otherwise, returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_compact_step(struct its_flash_fs_ctx_t *fs_ctx);
+
+/**
+ * \brief Gets the erase statistics of the physical blocks of the filesystem.
+ *
+ * \note Erases are counted in RAM and saved in the metadata block at each
+ *       swap of metadata blocks, so the erases since the last swap are lost
+ *       on a reset.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[out]    stats   Pointer to the erase statistics
+ *
+ * \return Returns PSA_ERROR_NOT_SUPPORTED if the erases are not counted.
+ *         Otherwise, returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_get_wear_stats(struct its_flash_fs_ctx_t *fs_ctx,
+                                         struct its_flash_fs_wear_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -134,13 +134,62 @@ psa_status_t its_flash_fs_dblock_read_file(
     return fs_ctx->ops->read(fs_ctx->cfg, phys_block, buf, pos, size);
 }
 
+/**
+ * \brief Appends the pieces produced by a stream to the scratch data block.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     scratch_id  Scratch data block ID
+ * \param[in]     pos         Position in the block of the first piece
+ * \param[in]     size        Size of the data to write, aligned to the flash
+ *                            program unit
+ * \param[in]     stream      Stream producing the data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_dblock_write_stream(
+                                    struct its_flash_fs_ctx_t *fs_ctx,
+                                    uint32_t scratch_id,
+                                    size_t pos,
+                                    size_t size,
+                                    const struct its_flash_fs_stream_t *stream)
+{
+    psa_status_t err;
+    const uint8_t *piece;
+    size_t piece_size;
+
+    while (size > 0) {
+        err = stream->next(stream->ctx, &piece, &piece_size);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        /* Only the last piece may end within a program unit */
+        piece_size = ITS_UTILS_ALIGN(piece_size, fs_ctx->cfg->program_unit);
+        if ((piece_size == 0) || (piece_size > size)) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        err = fs_ctx->ops->write(fs_ctx->cfg, scratch_id, piece, pos,
+                                 piece_size);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        pos += piece_size;
+        size -= piece_size;
+    }
+
+    return PSA_SUCCESS;
+}
+
 psa_status_t its_flash_fs_dblock_write_file(
-                                      struct its_flash_fs_ctx_t *fs_ctx,
-                                      const struct its_block_meta_t *block_meta,
-                                      const struct its_file_meta_t *file_meta,
-                                      size_t offset,
-                                      size_t size,
-                                      const uint8_t *data)
+                                   struct its_flash_fs_ctx_t *fs_ctx,
+                                   const struct its_block_meta_t *block_meta,
+                                   const struct its_file_meta_t *file_meta,
+                                   size_t offset,
+                                   size_t size,
+                                   const uint8_t *data,
+                                   const struct its_flash_fs_stream_t *stream)
 {
     psa_status_t err;
     uint32_t scratch_id;
@@ -164,7 +213,11 @@ psa_status_t its_flash_fs_dblock_write_file(
     }
 
     /* Write the new file data */
-    err = fs_ctx->ops->write(fs_ctx->cfg, scratch_id, data, pos, size);
+    if (stream == NULL) {
+        err = fs_ctx->ops->write(fs_ctx->cfg, scratch_id, data, pos, size);
+    } else {
+        err = its_dblock_write_stream(fs_ctx, scratch_id, pos, size, stream);
+    }
     if (err != PSA_SUCCESS) {
         return err;
     }
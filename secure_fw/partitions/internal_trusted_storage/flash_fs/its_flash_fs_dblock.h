@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,6 +12,7 @@
 #include <stdint.h>
 
 #include "psa/error.h"
+#include "its_flash_fs.h"
 #include "its_flash_fs_mblock.h"
 
 #ifdef __cplusplus
@@ -69,17 +70,20 @@ psa_status_t its_flash_fs_dblock_read_file(
  *                            the copy of the incoming data
  * \param[in]     size        Size of the incoming data
  * \param[in]     data        Pointer to data buffer to copy in the scratch data
- *                            block
+ *                            block, unused with a stream
+ * \param[in]     stream      Stream producing the incoming data, NULL to copy
+ *                            the data buffer
  *
  * \return Returns error code as specified in \ref psa_status_t
  */
 psa_status_t its_flash_fs_dblock_write_file(
-                                      struct its_flash_fs_ctx_t *fs_ctx,
-                                      const struct its_block_meta_t *block_meta,
-                                      const struct its_file_meta_t *file_meta,
-                                      size_t offset,
-                                      size_t size,
-                                      const uint8_t *data);
+                                   struct its_flash_fs_ctx_t *fs_ctx,
+                                   const struct its_block_meta_t *block_meta,
+                                   const struct its_file_meta_t *file_meta,
+                                   size_t offset,
+                                   size_t size,
+                                   const uint8_t *data,
+                                   const struct its_flash_fs_stream_t *stream);
 
 #ifdef __cplusplus
 }
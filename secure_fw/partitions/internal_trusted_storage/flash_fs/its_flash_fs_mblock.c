@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -135,6 +135,135 @@ static size_t its_mblock_file_meta_offset(struct its_flash_fs_ctx_t *fs_ctx,
            + (idx * ITS_FILE_METADATA_SIZE);
 }
 
+/**
+ * \brief Checks whether the active metadata block has a metadata journal.
+ *
+ * \param[in] fs_ctx  Filesystem context
+ *
+ * \return Returns true if the metadata journal is in use
+ */
+__attribute__((always_inline))
+static inline bool its_mblock_journal_in_use(
+                                        const struct its_flash_fs_ctx_t *fs_ctx)
+{
+#if ITS_METADATA_JOURNAL_SIZE
+    return ITS_FS_VERSION(fs_ctx->meta_block_header.fs_version) ==
+           ITS_JOURNAL_VERSION;
+#else
+    (void)fs_ctx;
+    return false;
+#endif
+}
+
+/**
+ * \brief Gets the size of the erase count table in metadata block, which
+ *        follows the file metadata table if it is in use.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Return size of the erase count table, 0 if it is not in use
+ */
+static size_t its_mblock_wear_table_size(struct its_flash_fs_ctx_t *fs_ctx)
+{
+#if ITS_WEAR_LEVELING_THRESHOLD
+    if (fs_ctx->meta_block_header.fs_version & ITS_WEAR_TABLE_FLAG) {
+        return ITS_UTILS_ALIGN(fs_ctx->cfg->num_blocks * sizeof(uint32_t),
+                               fs_ctx->cfg->program_unit);
+    }
+#else
+    (void)fs_ctx;
+#endif
+
+    return 0;
+}
+
+/**
+ * \brief Gets offset of a metadata journal record in metadata block. The
+ *        journal area follows the file metadata table and the erase count
+ *        table.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     rec     Journal record number
+ *
+ * \return Return offset value in metadata block
+ */
+static size_t its_mblock_journal_rec_offset(struct its_flash_fs_ctx_t *fs_ctx,
+                                            uint32_t rec)
+{
+    return its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files)
+           + its_mblock_wear_table_size(fs_ctx)
+           + (rec * ITS_JOURNAL_RECORD_SIZE(its_num_active_dblocks(fs_ctx)));
+}
+
+/**
+ * \brief Gets offset of the data area of logical block 0 in metadata block,
+ *        which follows the metadata, the erase count table and the journal
+ *        area if they are in use.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Return offset value in metadata block
+ */
+static size_t its_mblock_lb0_data_start(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    size_t data_start = its_mblock_file_meta_offset(fs_ctx,
+                                                    fs_ctx->cfg->max_num_files)
+                        + its_mblock_wear_table_size(fs_ctx);
+
+    if (its_mblock_journal_in_use(fs_ctx)) {
+        data_start += fs_ctx->cfg->journal_size;
+    }
+
+    return data_start;
+}
+
+/**
+ * \brief Gets offset of the current version of a logical block's metadata in
+ *        the active metadata block, which is in the latest journal record if
+ *        there is one.
+ *
+ * \note The block metadata table is contiguous in both places.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     lblock  Logical block number
+ *
+ * \return Return offset value in metadata block
+ */
+static size_t its_mblock_block_meta_pos(struct its_flash_fs_ctx_t *fs_ctx,
+                                        uint32_t lblock)
+{
+    if (its_mblock_journal_in_use(fs_ctx) && (fs_ctx->journal_last != 0)) {
+        return its_mblock_journal_rec_offset(fs_ctx, fs_ctx->journal_last - 1)
+               + sizeof(struct its_journal_rec_hdr_t) + ITS_FILE_METADATA_SIZE
+               + (lblock * ITS_BLOCK_METADATA_SIZE);
+    }
+
+    return its_mblock_block_meta_offset(lblock);
+}
+
+/**
+ * \brief Gets offset of the current version of a file metadata in the active
+ *        metadata block, which is in a journal record if the file has been
+ *        updated since the last swap of metadata blocks.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     idx     File metadata entry index
+ *
+ * \return Return offset value in metadata block
+ */
+static size_t its_mblock_file_meta_pos(struct its_flash_fs_ctx_t *fs_ctx,
+                                       uint32_t idx)
+{
+    if (its_mblock_journal_in_use(fs_ctx) &&
+        (fs_ctx->cfg->journal_map[idx] != 0)) {
+        return its_mblock_journal_rec_offset(fs_ctx,
+                                             fs_ctx->cfg->journal_map[idx] - 1)
+               + sizeof(struct its_journal_rec_hdr_t);
+    }
+
+    return its_mblock_file_meta_offset(fs_ctx, idx);
+}
+
 /**
  * \brief Swaps metablocks. Scratch becomes active and active becomes scratch.
  *
@@ -255,9 +384,7 @@ static psa_status_t its_mblock_validate_file_meta(
 
         if (file_meta->lblock == ITS_LOGICAL_DBLOCK0) {
             /* In block 0, data index must be located after the metadata */
-            if (file_meta->data_idx <
-                its_mblock_file_meta_offset(fs_ctx,
-                                            fs_ctx->cfg->max_num_files)) {
+            if (file_meta->data_idx < its_mblock_lb0_data_start(fs_ctx)) {
                 return PSA_ERROR_DATA_CORRUPT;
             }
         }
@@ -310,10 +437,9 @@ static psa_status_t its_mblock_validate_block_meta(
         (block_meta->phy_id == ITS_METADATA_BLOCK1)) {
 
         /* For metadata + data block, data index must start after the
-         * metadata area.
+         * metadata area and the journal area.
          */
-        valid_data_start_value =
-            its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files);
+        valid_data_start_value = its_mblock_lb0_data_start(fs_ctx);
     }
 
     if (block_meta->data_start != valid_data_start_value) {
@@ -425,44 +551,647 @@ static psa_status_t its_mblock_calculate_metadata_xor(
             return err;
         }
 
-        /* Update the XOR value. */
-        for (j = 0; j < ITS_FILE_METADATA_SIZE; j++) {
-            xor_value_temp ^= metadata[j];
-        }
+        /* Update the XOR value. */
+        for (j = 0; j < ITS_FILE_METADATA_SIZE; j++) {
+            xor_value_temp ^= metadata[j];
+        }
+    }
+    *xor_value = xor_value_temp;
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Checks the validity of metadata XOR.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     h_meta      Pointer to metadata block header
+ *
+ * \param[in] block_id        Metadata block ID
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_validate_metadata_xor(
+                               struct its_flash_fs_ctx_t *fs_ctx,
+                               const struct its_metadata_block_header_t *h_meta,
+                               uint32_t block_id)
+{
+    psa_status_t err;
+    uint8_t xor_value;
+
+    err = its_mblock_calculate_metadata_xor(fs_ctx, block_id, &xor_value);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (xor_value != h_meta->metadata_xor) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+    return PSA_SUCCESS;
+}
+#endif /* ITS_VALIDATE_METADATA_FROM_FLASH */
+
+#if ITS_RAM_FILE_INDEX
+/**
+ * \brief Gets the hash table bucket of a file ID.
+ *
+ * \param[in] cfg  Filesystem configuration
+ * \param[in] fid  File ID
+ *
+ * \return Returns the bucket index
+ */
+static uint32_t its_index_hash(const struct its_flash_fs_config_t *cfg,
+                               const uint8_t *fid)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+    uint32_t i;
+
+    for (i = 0; i < ITS_FILE_ID_SIZE; i++) {
+        hash ^= fid[i];
+        hash *= 16777619U;
+    }
+
+    return hash % ITS_FLASH_FS_INDEX_HASH_SIZE(cfg->max_num_files);
+}
+
+/**
+ * \brief Rebuilds the hash table and the free entry bitmap from the file IDs
+ *        of the active metadata block.
+ *
+ * \note Entries are inserted in increasing index order, so a lookup returns
+ *       the lowest index with a matching file ID, as a scan of the metadata
+ *       table would.
+ *
+ * \param[in] cfg  Filesystem configuration
+ */
+static void its_index_rehash(const struct its_flash_fs_config_t *cfg)
+{
+    struct its_flash_fs_index_t *index = cfg->index;
+    uint32_t hash_size = ITS_FLASH_FS_INDEX_HASH_SIZE(cfg->max_num_files);
+    const uint8_t *fid;
+    uint32_t i, bucket;
+
+    (void)memset(index->hash, 0, hash_size * sizeof(index->hash[0]));
+    (void)memset(index->free_map, 0,
+                 ((cfg->max_num_files + 31) / 32) * sizeof(index->free_map[0]));
+
+    for (i = 0; i < cfg->max_num_files; i++) {
+        fid = &index->active_fid[i * ITS_FILE_ID_SIZE];
+
+        if (its_utils_validate_fid(fid) != PSA_SUCCESS) {
+            index->free_map[i / 32] |= (1U << (i % 32));
+            continue;
+        }
+
+        bucket = its_index_hash(cfg, fid);
+        while (index->hash[bucket] != 0) {
+            bucket = (bucket + 1) % hash_size;
+        }
+        index->hash[bucket] = (uint16_t)(i + 1);
+    }
+}
+
+/**
+ * \brief Builds the index from the file metadata of the active metadata block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_index_build(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_flash_fs_index_t *index = fs_ctx->cfg->index;
+    struct its_file_meta_t tmp_metadata;
+    psa_status_t err;
+    uint32_t i;
+
+    for (i = 0; i < fs_ctx->cfg->max_num_files; i++) {
+        err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        (void)memcpy(&index->active_fid[i * ITS_FILE_ID_SIZE], tmp_metadata.id,
+                     ITS_FILE_ID_SIZE);
+    }
+
+    its_index_rehash(fs_ctx->cfg);
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Makes the file IDs written to the scratch metadata block the active
+ *        ones. Called when the metadata blocks are swapped.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ */
+static void its_index_commit(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_flash_fs_index_t *index = fs_ctx->cfg->index;
+
+    if (index == NULL) {
+        return;
+    }
+
+    (void)memcpy(index->active_fid, index->scratch_fid,
+                 fs_ctx->cfg->max_num_files * ITS_FILE_ID_SIZE);
+
+    its_index_rehash(fs_ctx->cfg);
+}
+
+/**
+ * \brief Looks up a file ID in the index.
+ *
+ * \note A file ID is in more than one entry while a file marked to be deleted
+ *       has not been removed yet, so the lookup can be resumed to get the next
+ *       entry.
+ *
+ * \param[in]     cfg     Filesystem configuration
+ * \param[in]     fid     File ID
+ * \param[in,out] bucket  Bucket to start the lookup from, its_index_hash() of
+ *                        the file ID for the first lookup. It is set to the
+ *                        bucket to resume the lookup from.
+ *
+ * \return Returns the file metadata entry index, or ITS_METADATA_INVALID_INDEX
+ *         if the file does not exist
+ */
+static uint32_t its_index_find(const struct its_flash_fs_config_t *cfg,
+                               const uint8_t *fid, uint32_t *bucket)
+{
+    struct its_flash_fs_index_t *index = cfg->index;
+    uint32_t hash_size = ITS_FLASH_FS_INDEX_HASH_SIZE(cfg->max_num_files);
+    uint32_t idx;
+
+    while (index->hash[*bucket] != 0) {
+        idx = index->hash[*bucket] - 1U;
+        *bucket = (*bucket + 1) % hash_size;
+        if (!memcmp(&index->active_fid[idx * ITS_FILE_ID_SIZE], fid,
+                    ITS_FILE_ID_SIZE)) {
+            return idx;
+        }
+    }
+
+    return ITS_METADATA_INVALID_INDEX;
+}
+
+/**
+ * \brief Gets a free file metadata entry from the index.
+ *
+ * \param[in] cfg        Filesystem configuration
+ * \param[in] use_spare  If true then the spare file index will be used,
+ *                       otherwise at least one file index will be left free
+ *
+ * \return Return index of a free file meta entry
+ */
+static uint32_t its_index_get_free(const struct its_flash_fs_config_t *cfg,
+                                   bool use_spare)
+{
+    const uint32_t *free_map = cfg->index->free_map;
+    uint32_t i;
+
+    for (i = 0; i < cfg->max_num_files; i++) {
+        /* Skip a whole word of entries in use */
+        if (free_map[i / 32] == 0) {
+            i |= 31;
+            continue;
+        }
+
+        if (free_map[i / 32] & (1U << (i % 32))) {
+            if (!use_spare) {
+                /* Keep the first free file index as a spare */
+                use_spare = true;
+                continue;
+            }
+            return i;
+        }
+    }
+
+    return ITS_METADATA_INVALID_INDEX;
+}
+
+#if ITS_METADATA_JOURNAL_SIZE
+/**
+ * \brief Updates the file ID of an entry of the active metadata block.
+ *        Called when a file update is recorded in the metadata journal.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     idx     File metadata entry index
+ * \param[in]     fid     File ID
+ */
+static void its_index_update(struct its_flash_fs_ctx_t *fs_ctx, uint32_t idx,
+                             const uint8_t *fid)
+{
+    struct its_flash_fs_index_t *index = fs_ctx->cfg->index;
+
+    if (index == NULL) {
+        return;
+    }
+
+    (void)memcpy(&index->active_fid[idx * ITS_FILE_ID_SIZE], fid,
+                 ITS_FILE_ID_SIZE);
+
+    its_index_rehash(fs_ctx->cfg);
+}
+#endif /* ITS_METADATA_JOURNAL_SIZE */
+#else
+#define its_index_commit(fs_ctx)
+#define its_index_update(fs_ctx, idx, fid)
+#endif /* ITS_RAM_FILE_INDEX */
+
+#if ITS_METADATA_JOURNAL_SIZE || ITS_WEAR_LEVELING_THRESHOLD
+/**
+ * \brief Moves the data of logical block 0 up by a given size into the scratch
+ *        metadata block, to make room for a new area after the metadata, if
+ *        logical block 0 has enough free space. The block metadata and the
+ *        file metadata are written in the scratch metadata block accordingly.
+ *
+ * \param[in,out] fs_ctx   Filesystem context
+ * \param[in]     size     Size of the new area
+ * \param[out]    shifted  False if logical block 0 does not have enough free
+ *                         space, in which case nothing is written
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_lb0_data_shift(struct its_flash_fs_ctx_t *fs_ctx,
+                                              size_t size, bool *shifted)
+{
+    struct its_block_meta_t block_meta;
+    struct its_file_meta_t file_meta;
+    size_t data_size;
+    uint32_t idx;
+    psa_status_t err;
+
+    *shifted = false;
+
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, ITS_LOGICAL_DBLOCK0,
+                                                  &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (block_meta.free_size < size) {
+        return PSA_SUCCESS;
+    }
+
+    data_size = (fs_ctx->cfg->block_size - block_meta.data_start)
+                - block_meta.free_size;
+    err = its_flash_fs_block_to_block_move(fs_ctx, fs_ctx->scratch_metablock,
+                                           block_meta.data_start + size,
+                                           fs_ctx->active_metablock,
+                                           block_meta.data_start, data_size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    block_meta.data_start += size;
+    block_meta.free_size -= size;
+    err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx,
+                                                        ITS_LOGICAL_DBLOCK0,
+                                                        &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    for (idx = 0; idx < fs_ctx->cfg->max_num_files; idx++) {
+        err = its_flash_fs_mblock_read_file_meta(fs_ctx, idx, &file_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if ((its_utils_validate_fid(file_meta.id) == PSA_SUCCESS) &&
+            (file_meta.lblock == ITS_LOGICAL_DBLOCK0)) {
+            file_meta.data_idx += size;
+        }
+
+        err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, idx,
+                                                           &file_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    *shifted = true;
+    return PSA_SUCCESS;
+}
+#endif /* ITS_METADATA_JOURNAL_SIZE || ITS_WEAR_LEVELING_THRESHOLD */
+
+#if ITS_METADATA_JOURNAL_SIZE
+/**
+ * \brief Gets the number of records of the metadata journal.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns the number of records
+ */
+static uint32_t its_mblock_journal_num_recs(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    return fs_ctx->cfg->journal_size /
+           ITS_JOURNAL_RECORD_SIZE(its_num_active_dblocks(fs_ctx));
+}
+
+/**
+ * \brief Empties the RAM state of the metadata journal. Called when the
+ *        metadata blocks are swapped, as the journal area of the new active
+ *        metadata block is erased.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ */
+static void its_mblock_journal_reset(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    fs_ctx->journal_next = 0;
+    fs_ctx->journal_last = 0;
+
+    if (fs_ctx->cfg->journal_map != NULL) {
+        (void)memset(fs_ctx->cfg->journal_map, 0,
+                     fs_ctx->cfg->max_num_files *
+                     sizeof(fs_ctx->cfg->journal_map[0]));
+    }
+}
+
+/**
+ * \brief Reads a metadata journal record of the active metadata block to
+ *        calculate the XOR value of its content, and to check whether it has
+ *        never been programmed.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     rec        Journal record number
+ * \param[out]    xor_value  XOR value of the record, without the commit marker
+ * \param[out]    erased     True if the whole record is erased
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_journal_read_rec(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t rec,
+                                              uint8_t *xor_value,
+                                              bool *erased)
+{
+    size_t rec_size = ITS_JOURNAL_RECORD_SIZE(its_num_active_dblocks(fs_ctx));
+    size_t xor_size = rec_size - sizeof(struct its_journal_commit_t);
+    size_t offset = its_mblock_journal_rec_offset(fs_ctx, rec);
+    uint8_t buf[ITS_FILE_METADATA_SIZE];
+    size_t pos, len, i;
+    psa_status_t err;
+
+    *xor_value = 0;
+    *erased = true;
+
+    for (pos = 0; pos < rec_size; pos += len) {
+        len = ITS_UTILS_MIN(rec_size - pos, sizeof(buf));
+
+        err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock, buf,
+                                offset + pos, len);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        for (i = 0; i < len; i++) {
+            if (buf[i] != fs_ctx->cfg->erase_val) {
+                *erased = false;
+            }
+            if ((pos + i) < xor_size) {
+                *xor_value ^= buf[i];
+            }
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Replays the metadata journal of the active metadata block into the
+ *        RAM state, up to the first record which has never been programmed.
+ *
+ * \note A record interrupted by a power failure has no commit marker. It is
+ *       skipped, and its space is not reused until the next swap of metadata
+ *       blocks.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_journal_replay(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_journal_rec_hdr_t hdr;
+    struct its_journal_commit_t commit;
+    uint32_t num_recs, rec;
+    uint8_t xor_value;
+    bool erased;
+    size_t offset;
+    psa_status_t err;
+
+    its_mblock_journal_reset(fs_ctx);
+
+    if (!its_mblock_journal_in_use(fs_ctx)) {
+        return PSA_SUCCESS;
+    }
+
+    num_recs = its_mblock_journal_num_recs(fs_ctx);
+
+    for (rec = 0; rec < num_recs; rec++) {
+        err = its_mblock_journal_read_rec(fs_ctx, rec, &xor_value, &erased);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if (erased) {
+            /* End of the journal */
+            break;
+        }
+
+        fs_ctx->journal_next = rec + 1;
+
+        offset = its_mblock_journal_rec_offset(fs_ctx, rec + 1)
+                 - sizeof(struct its_journal_commit_t);
+        err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
+                                (uint8_t *)&commit, offset, sizeof(commit));
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if ((commit.commit != ITS_JOURNAL_COMMIT) ||
+            (commit.xor_value != xor_value)) {
+            /* Incomplete record */
+            continue;
+        }
+
+        err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
+                                (uint8_t *)&hdr,
+                                its_mblock_journal_rec_offset(fs_ctx, rec),
+                                sizeof(hdr));
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        /* The scratch data block can not be one of the metadata blocks, as
+         * there are dedicated data blocks when the journal is in use.
+         */
+        if ((hdr.file_idx >= fs_ctx->cfg->max_num_files) ||
+            (hdr.scratch_dblock < its_init_scratch_dblock(fs_ctx)) ||
+            (hdr.scratch_dblock >= fs_ctx->cfg->num_blocks)) {
+            return PSA_ERROR_DATA_CORRUPT;
+        }
+
+        fs_ctx->cfg->journal_map[hdr.file_idx] = (uint16_t)(rec + 1);
+        fs_ctx->journal_last = rec + 1;
+        fs_ctx->meta_block_header.scratch_dblock = hdr.scratch_dblock;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Converts a filesystem of ITS_SUPPORTED_VERSION to
+ *        ITS_JOURNAL_VERSION, if the journal is configured and logical block 0
+ *        has enough free space for the journal area. The data of logical
+ *        block 0 is moved up by the size of the journal area.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_journal_upgrade(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    bool shifted;
+    psa_status_t err;
+
+    if ((fs_ctx->cfg->journal_size == 0) ||
+        (ITS_FS_VERSION(fs_ctx->meta_block_header.fs_version) !=
+         ITS_SUPPORTED_VERSION)) {
+        return PSA_SUCCESS;
+    }
+
+    err = its_mblock_lb0_data_shift(fs_ctx, fs_ctx->cfg->journal_size,
+                                    &shifted);
+    if ((err != PSA_SUCCESS) || !shifted) {
+        /* Keep the filesystem without a journal if there is no space */
+        return err;
+    }
+
+    fs_ctx->meta_block_header.fs_version = ITS_JOURNAL_VERSION |
+            (fs_ctx->meta_block_header.fs_version & ITS_WEAR_TABLE_FLAG);
+    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+}
+#else
+#define its_mblock_journal_reset(fs_ctx)
+#endif /* ITS_METADATA_JOURNAL_SIZE */
+
+/**
+ * \brief Erases a block, and counts the erase if wear leveling is in use.
+ *
+ * \param[in,out] fs_ctx    Filesystem context
+ * \param[in]     block_id  Physical block ID
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_erase_block(struct its_flash_fs_ctx_t *fs_ctx,
+                                           uint32_t block_id)
+{
+#if ITS_WEAR_LEVELING_THRESHOLD
+    uint32_t *erase_count = fs_ctx->cfg->erase_count;
+
+    if ((erase_count != NULL) && (erase_count[block_id] != UINT32_MAX)) {
+        erase_count[block_id]++;
+    }
+#endif
+
+    return fs_ctx->ops->erase(fs_ctx->cfg, block_id);
+}
+
+#if ITS_WEAR_LEVELING_THRESHOLD
+/**
+ * \brief Loads the erase counts from the active metadata block into RAM, or
+ *        zeroes them if the active metadata block has no erase count table.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_wear_load(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    size_t size = fs_ctx->cfg->num_blocks * sizeof(uint32_t);
+
+    if (fs_ctx->cfg->erase_count == NULL) {
+        return PSA_SUCCESS;
+    }
+
+    if (its_mblock_wear_table_size(fs_ctx) == 0) {
+        (void)memset(fs_ctx->cfg->erase_count, 0, size);
+        return PSA_SUCCESS;
+    }
+
+    return fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
+                             (uint8_t *)fs_ctx->cfg->erase_count,
+                             its_mblock_file_meta_offset(fs_ctx,
+                                                  fs_ctx->cfg->max_num_files),
+                             size);
+}
+
+/**
+ * \brief Writes the erase counts into the scratch metadata block, if it has
+ *        an erase count table.
+ *
+ * \note The erase counts are not covered by the metadata XOR value. A
+ *       corrupted count only affects the choice of the blocks to level.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_wear_save(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    size_t size = its_mblock_wear_table_size(fs_ctx);
+
+    if (size == 0) {
+        return PSA_SUCCESS;
     }
-    *xor_value = xor_value_temp;
-    return PSA_SUCCESS;
+
+    /* The counters are padded to the flash program unit */
+    return fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->scratch_metablock,
+                              (const uint8_t *)fs_ctx->cfg->erase_count,
+                              its_mblock_file_meta_offset(fs_ctx,
+                                                  fs_ctx->cfg->max_num_files),
+                              size);
 }
 
 /**
- * \brief Checks the validity of metadata XOR.
- *
- * \param[in,out] fs_ctx      Filesystem context
- * \param[in]     h_meta      Pointer to metadata block header
+ * \brief Adds the erase count table to a filesystem without one, if wear
+ *        leveling is configured and logical block 0 has enough free space for
+ *        the table. The data of logical block 0 is moved up by the size of the
+ *        table.
  *
- * \param[in] block_id        Metadata block ID
+ * \param[in,out] fs_ctx  Filesystem context
  *
  * \return Returns error code as specified in \ref psa_status_t
  */
-static psa_status_t its_mblock_validate_metadata_xor(
-                               struct its_flash_fs_ctx_t *fs_ctx,
-                               const struct its_metadata_block_header_t *h_meta,
-                               uint32_t block_id)
+static psa_status_t its_mblock_wear_upgrade(struct its_flash_fs_ctx_t *fs_ctx)
 {
+    bool shifted;
     psa_status_t err;
-    uint8_t xor_value;
 
-    err = its_mblock_calculate_metadata_xor(fs_ctx, block_id, &xor_value);
-    if (err != PSA_SUCCESS) {
-        return err;
+    if ((fs_ctx->cfg->erase_count == NULL) ||
+        (fs_ctx->meta_block_header.fs_version & ITS_WEAR_TABLE_FLAG)) {
+        return PSA_SUCCESS;
     }
 
-    if (xor_value != h_meta->metadata_xor) {
-        return PSA_ERROR_STORAGE_FAILURE;
+    err = its_mblock_lb0_data_shift(fs_ctx,
+                                    ITS_UTILS_ALIGN(fs_ctx->cfg->num_blocks
+                                                    * sizeof(uint32_t),
+                                                    fs_ctx->cfg->program_unit),
+                                    &shifted);
+    if ((err != PSA_SUCCESS) || !shifted) {
+        /* Keep counting the erases in RAM only if there is no space */
+        return err;
     }
-    return PSA_SUCCESS;
+
+    fs_ctx->meta_block_header.fs_version |= ITS_WEAR_TABLE_FLAG;
+    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
 }
-#endif /* ITS_VALIDATE_METADATA_FROM_FLASH */
+#else
+#define its_mblock_wear_load(fs_ctx) PSA_SUCCESS
+#define its_mblock_wear_save(fs_ctx) PSA_SUCCESS
+#endif /* ITS_WEAR_LEVELING_THRESHOLD */
 
 /**
  * \brief Gets a free file metadata table entry.
@@ -480,6 +1209,12 @@ static uint32_t its_get_free_file_index(struct its_flash_fs_ctx_t *fs_ctx,
     uint32_t i;
     struct its_file_meta_t tmp_metadata;
 
+#if ITS_RAM_FILE_INDEX
+    if (fs_ctx->cfg->index != NULL) {
+        return its_index_get_free(fs_ctx->cfg, use_spare);
+    }
+#endif
+
     for (i = 0; i < fs_ctx->cfg->max_num_files; i++) {
         err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
         if (err != PSA_SUCCESS) {
@@ -522,7 +1257,7 @@ static psa_status_t its_mblock_erase_scratch_blocks(
      * and power-failure-safe operation, it is necessary that
      * metadata scratch block is erased before data block.
      */
-    err = fs_ctx->ops->erase(fs_ctx->cfg, fs_ctx->scratch_metablock);
+    err = its_mblock_erase_block(fs_ctx, fs_ctx->scratch_metablock);
     if (err != PSA_SUCCESS) {
         return err;
     }
@@ -536,7 +1271,7 @@ static psa_status_t its_mblock_erase_scratch_blocks(
         scratch_datablock =
             its_flash_fs_mblock_cur_data_scratch_id(fs_ctx,
                                                     (ITS_LOGICAL_DBLOCK0 + 1));
-        err = fs_ctx->ops->erase(fs_ctx->cfg, scratch_datablock);
+        err = its_mblock_erase_block(fs_ctx, scratch_datablock);
     }
 
     return err;
@@ -569,14 +1304,17 @@ static psa_status_t its_mblock_update_scratch_block_meta(
 /**
  * \brief Copies rest of the block metadata.
  *
- * \param[in,out] fs_ctx  Filesystem context
- * \param[in]     lblock  Logical block number to skip
+ * \param[in,out] fs_ctx    Filesystem context
+ * \param[in]     lblock    Logical block number to skip
+ * \param[in]     lb0_meta  Block metadata to write for logical block 0 if
+ *                          lblock is not 0, or NULL to copy it
  *
  * \return Returns error code as specified in \ref psa_status_t
  */
 static psa_status_t its_mblock_copy_remaining_block_meta(
-                                              struct its_flash_fs_ctx_t *fs_ctx,
-                                              uint32_t lblock)
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      uint32_t lblock,
+                                      const struct its_block_meta_t *lb0_meta)
 {
     struct its_block_meta_t block_meta;
     psa_status_t err;
@@ -597,11 +1335,15 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
          * the physical block ID has been updated while processing the file
          * data.
          */
-        err = its_flash_fs_mblock_read_block_metadata(fs_ctx,
-                                                      ITS_LOGICAL_DBLOCK0,
-                                                      &block_meta);
-        if (err != PSA_SUCCESS) {
-            return PSA_ERROR_GENERIC_ERROR;
+        if (lb0_meta != NULL) {
+            block_meta = *lb0_meta;
+        } else {
+            err = its_flash_fs_mblock_read_block_metadata(fs_ctx,
+                                                          ITS_LOGICAL_DBLOCK0,
+                                                          &block_meta);
+            if (err != PSA_SUCCESS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
         }
 
         /* Update physical ID for logical block 0 to match with the
@@ -625,7 +1367,10 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
             /* Copy rest of the block data from previous block */
             /* Data before updated content */
             err = its_flash_fs_block_to_block_move(fs_ctx, scratch_block, pos,
-                                                   meta_block, pos, size);
+                                 meta_block,
+                                 its_mblock_block_meta_pos(fs_ctx,
+                                                       ITS_LOGICAL_DBLOCK0 + 1),
+                                 size);
             if (err != PSA_SUCCESS) {
                 return err;
             }
@@ -638,7 +1383,9 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
     size = its_mblock_file_meta_offset(fs_ctx, 0) - pos;
 
     return its_flash_fs_block_to_block_move(fs_ctx, scratch_block, pos,
-                                            meta_block, pos, size);
+                                     meta_block,
+                                     its_mblock_block_meta_pos(fs_ctx, lblock + 1),
+                                     size);
 }
 
 /**
@@ -684,6 +1431,16 @@ __attribute__((always_inline))
 static inline psa_status_t its_mblock_validate_fs_version(uint8_t fs_version,
                                                           bool *backward_comp)
 {
+#if ITS_WEAR_LEVELING_THRESHOLD
+    /* The erase count table is only in the layout of ITS_SUPPORTED_VERSION */
+    if (fs_version & ITS_WEAR_TABLE_FLAG) {
+        fs_version = ITS_FS_VERSION(fs_version);
+        if (fs_version == ITS_BACKWARD_SUPPORTED_VERSION) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+#endif
+
     /* Looks for exact version number and the backward compatible version. */
     if (fs_version == ITS_BACKWARD_SUPPORTED_VERSION) {
         *backward_comp = true;
@@ -691,6 +1448,12 @@ static inline psa_status_t its_mblock_validate_fs_version(uint8_t fs_version,
     } else if (fs_version == ITS_SUPPORTED_VERSION) {
         *backward_comp = false;
         return PSA_SUCCESS;
+#if ITS_METADATA_JOURNAL_SIZE
+    } else if (fs_version == ITS_JOURNAL_VERSION) {
+        /* Same metadata block layout as ITS_SUPPORTED_VERSION */
+        *backward_comp = false;
+        return PSA_SUCCESS;
+#endif
     } else {
         return PSA_ERROR_GENERIC_ERROR;
     }
@@ -722,6 +1485,20 @@ static psa_status_t its_mblock_validate_header_meta(
         return err;
     }
 
+    /* The journal area must be configured to use a filesystem with a
+     * journal, and the erase counters to use a filesystem with an erase count
+     * table.
+     */
+    if ((ITS_FS_VERSION(h_meta->fs_version) == ITS_JOURNAL_VERSION) &&
+        (fs_ctx->cfg->journal_size == 0)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if ((h_meta->fs_version & ITS_WEAR_TABLE_FLAG) &&
+        (fs_ctx->cfg->erase_count == NULL)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
     if (backward_compatible) {
         err = its_mblock_validate_swap_count(fs_ctx,
         ((struct its_metadata_block_header_comp_t *)h_meta)->active_swap_count);
@@ -749,6 +1526,12 @@ static psa_status_t its_mblock_write_scratch_meta_header(
 {
     psa_status_t err;
 
+    /* Write the erase counts before the header, which is programmed last */
+    err = its_mblock_wear_save(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
     /* Increment the swap count */
     fs_ctx->meta_block_header.active_swap_count++;
 
@@ -880,16 +1663,25 @@ static psa_status_t its_mblock_reserve_file(struct its_flash_fs_ctx_t *fs_ctx,
 {
     psa_status_t err;
     uint32_t i;
+    uint32_t lblock;
 
     for (i = 0; i < its_num_active_dblocks(fs_ctx); i++) {
-        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, i, block_meta);
+        /* Updates of the files in logical block 0 can not be journaled, as
+         * the data is in the metadata block. So, when the journal is in use,
+         * logical block 0 is only used once the other blocks are full.
+         */
+        lblock = its_mblock_journal_in_use(fs_ctx) ?
+                 ((i + 1) % its_num_active_dblocks(fs_ctx)) : i;
+
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, lblock,
+                                                      block_meta);
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
         }
 
         if (block_meta->free_size >= size) {
             /* Set file metadata */
-            file_meta->lblock = i;
+            file_meta->lblock = lblock;
             file_meta->data_idx = fs_ctx->cfg->block_size
                                   - block_meta->free_size;
             file_meta->max_size = size;
@@ -973,6 +1765,53 @@ psa_status_t its_flash_fs_mblock_cp_file_meta(struct its_flash_fs_ctx_t *fs_ctx,
     /* Calculate the positions of the two indexes in the metadata block */
     size_t pos_start = its_mblock_file_meta_offset(fs_ctx, idx_start);
     size_t pos_end = its_mblock_file_meta_offset(fs_ctx, idx_end);
+#if ITS_METADATA_JOURNAL_SIZE
+    size_t src_pos;
+    psa_status_t err;
+    uint32_t i, n;
+#endif
+
+#if ITS_RAM_FILE_INDEX
+    struct its_flash_fs_index_t *index = fs_ctx->cfg->index;
+
+    if ((index != NULL) && (idx_end > idx_start)) {
+        (void)memcpy(&index->scratch_fid[idx_start * ITS_FILE_ID_SIZE],
+                     &index->active_fid[idx_start * ITS_FILE_ID_SIZE],
+                     (idx_end - idx_start) * ITS_FILE_ID_SIZE);
+    }
+#endif
+
+#if ITS_METADATA_JOURNAL_SIZE
+    if (its_mblock_journal_in_use(fs_ctx) && (fs_ctx->journal_next != 0)) {
+        /* Entries updated in the journal are copied from their latest record,
+         * the others from the metadata table, in runs of entries which are
+         * contiguous in the active metadata block.
+         */
+        i = idx_start;
+        while (i < idx_end) {
+            src_pos = its_mblock_file_meta_pos(fs_ctx, i);
+            for (n = 1; (i + n) < idx_end; n++) {
+                if (its_mblock_file_meta_pos(fs_ctx, i + n) !=
+                    (src_pos + (n * ITS_FILE_METADATA_SIZE))) {
+                    break;
+                }
+            }
+
+            err = its_flash_fs_block_to_block_move(fs_ctx,
+                                        fs_ctx->scratch_metablock,
+                                        its_mblock_file_meta_offset(fs_ctx, i),
+                                        fs_ctx->active_metablock, src_pos,
+                                        n * ITS_FILE_METADATA_SIZE);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+
+            i += n;
+        }
+
+        return PSA_SUCCESS;
+    }
+#endif
 
     /* Copy all data between the two positions from the scratch metadata block
      * to the active metadata block.
@@ -1003,14 +1842,44 @@ psa_status_t its_flash_fs_mblock_get_file_idx_meta(struct its_flash_fs_ctx_t *fs
     uint32_t i;
     struct its_file_meta_t tmp_metadata;
 
+#if ITS_RAM_FILE_INDEX
+    uint32_t bucket;
+
+    if (fs_ctx->cfg->index != NULL) {
+        bucket = its_index_hash(fs_ctx->cfg, fid);
+
+        /* The flags of the entry are checked in the metadata */
+        while ((i = its_index_find(fs_ctx->cfg, fid, &bucket))
+               != ITS_METADATA_INVALID_INDEX) {
+            err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
+            if (err != PSA_SUCCESS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+
+            if (!(tmp_metadata.flags & ITS_FLASH_FS_FLAG_DELETE)) {
+                *idx = i;
+                if (file_meta != NULL) {
+                    *file_meta = tmp_metadata;
+                }
+                return PSA_SUCCESS;
+            }
+        }
+
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+#endif
+
     for (i = 0; i < fs_ctx->cfg->max_num_files; i++) {
         err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
         }
 
-        /* ID with value 0x00 means end of file meta section */
-        if (!memcmp(tmp_metadata.id, fid, ITS_FILE_ID_SIZE)) {
+        /* A file marked to be deleted is skipped, the file ID may have been
+         * reused by a newer entry.
+         */
+        if (!memcmp(tmp_metadata.id, fid, ITS_FILE_ID_SIZE) &&
+            !(tmp_metadata.flags & ITS_FLASH_FS_FLAG_DELETE)) {
             /* Found */
             *idx = i;
             if (file_meta != NULL) {
@@ -1068,6 +1937,21 @@ psa_status_t its_flash_fs_mblock_init(struct its_flash_fs_ctx_t *fs_ctx)
         return PSA_ERROR_GENERIC_ERROR;
     }
 
+#if ITS_METADATA_JOURNAL_SIZE
+    /* Apply the journal before the scratch data block is erased, as the
+     * journal records the current scratch data block.
+     */
+    err = its_mblock_journal_replay(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+#endif
+
+    err = its_mblock_wear_load(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
     /* Erase the other scratch metadata block. It can be used in the later
      * step.
      */
@@ -1077,7 +1961,27 @@ psa_status_t its_flash_fs_mblock_init(struct its_flash_fs_ctx_t *fs_ctx)
     }
 
     /* Upgrade the metadata header if required. */
-    return its_mblock_upgrade_meta_header(fs_ctx);
+    err = its_mblock_upgrade_meta_header(fs_ctx);
+#if ITS_METADATA_JOURNAL_SIZE
+    if (err == PSA_SUCCESS) {
+        err = its_mblock_journal_upgrade(fs_ctx);
+    }
+#endif
+#if ITS_WEAR_LEVELING_THRESHOLD
+    if (err == PSA_SUCCESS) {
+        err = its_mblock_wear_upgrade(fs_ctx);
+    }
+#endif
+#if ITS_RAM_FILE_INDEX
+    if ((err == PSA_SUCCESS) && (fs_ctx->cfg->index != NULL)) {
+        /* Index the metadata block selected above, which may be the one
+         * recovered after a power failure.
+         */
+        err = its_index_build(fs_ctx);
+    }
+#endif
+
+    return err;
 }
 
 psa_status_t its_flash_fs_mblock_meta_update_finalize(
@@ -1099,11 +2003,241 @@ psa_status_t its_flash_fs_mblock_meta_update_finalize(
 
     /* Update the running context */
     its_mblock_swap_metablocks(fs_ctx);
+    its_mblock_journal_reset(fs_ctx);
+    its_index_commit(fs_ctx);
 
     /* Erase meta block and current scratch block */
     return its_mblock_erase_scratch_blocks(fs_ctx);
 }
 
+psa_status_t its_flash_fs_mblock_journal_update(
+                                     struct its_flash_fs_ctx_t *fs_ctx,
+                                     uint32_t idx,
+                                     const struct its_file_meta_t *file_meta,
+                                     const struct its_block_meta_t *block_meta)
+{
+#if ITS_METADATA_JOURNAL_SIZE
+    struct its_journal_rec_hdr_t hdr = {0};
+    struct its_journal_commit_t commit = {0};
+    struct its_block_meta_t cur_block_meta;
+    uint32_t lblock = file_meta->lblock;
+    uint32_t num_dblocks = its_num_active_dblocks(fs_ctx);
+    uint32_t rec;
+    size_t offset;
+    bool erased;
+    psa_status_t err;
+
+    if (!its_mblock_journal_in_use(fs_ctx) ||
+        (lblock == ITS_LOGICAL_DBLOCK0) ||
+        (fs_ctx->journal_next >= its_mblock_journal_num_recs(fs_ctx))) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, lblock,
+                                                  &cur_block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The record can not be programmed again once it has been started, so it
+     * is consumed even if an error occurs.
+     */
+    rec = fs_ctx->journal_next++;
+    offset = its_mblock_journal_rec_offset(fs_ctx, rec);
+
+    hdr.file_idx = idx;
+    hdr.scratch_dblock = fs_ctx->meta_block_header.scratch_dblock;
+    err = fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->active_metablock,
+                             (const uint8_t *)&hdr, offset, sizeof(hdr));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+    offset += sizeof(hdr);
+
+    err = fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->active_metablock,
+                             (const uint8_t *)file_meta, offset,
+                             ITS_FILE_METADATA_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+    offset += ITS_FILE_METADATA_SIZE;
+
+    /* Record the whole block metadata table, with the updated logical block.
+     * Logical block 0 is always before it.
+     */
+    err = its_flash_fs_block_to_block_move(fs_ctx, fs_ctx->active_metablock,
+                                 offset, fs_ctx->active_metablock,
+                                 its_mblock_block_meta_pos(fs_ctx,
+                                                           ITS_LOGICAL_DBLOCK0),
+                                 lblock * ITS_BLOCK_METADATA_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->active_metablock,
+                             (const uint8_t *)block_meta,
+                             offset + (lblock * ITS_BLOCK_METADATA_SIZE),
+                             ITS_BLOCK_METADATA_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_block_to_block_move(fs_ctx, fs_ctx->active_metablock,
+                           offset + ((lblock + 1) * ITS_BLOCK_METADATA_SIZE),
+                           fs_ctx->active_metablock,
+                           its_mblock_block_meta_pos(fs_ctx, lblock + 1),
+                           (num_dblocks - lblock - 1) * ITS_BLOCK_METADATA_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Program the record before the commit marker, so that a write back end
+     * can not combine them into a single program operation.
+     */
+    err = fs_ctx->ops->flush(fs_ctx->cfg, fs_ctx->active_metablock);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Program the commit marker last, with the XOR value of the record read
+     * back from flash.
+     */
+    err = its_mblock_journal_read_rec(fs_ctx, rec, &commit.xor_value, &erased);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    commit.commit = ITS_JOURNAL_COMMIT;
+    err = fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->active_metablock,
+                             (const uint8_t *)&commit,
+                             its_mblock_journal_rec_offset(fs_ctx, rec + 1)
+                             - sizeof(commit),
+                             sizeof(commit));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = fs_ctx->ops->flush(fs_ctx->cfg, fs_ctx->active_metablock);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Update the running context */
+    fs_ctx->cfg->journal_map[idx] = (uint16_t)(rec + 1);
+    fs_ctx->journal_last = rec + 1;
+    its_index_update(fs_ctx, idx, file_meta->id);
+
+    /* Erase the previous data block, which is now the scratch data block */
+    if (block_meta->phy_id != cur_block_meta.phy_id) {
+        err = its_mblock_erase_block(fs_ctx,
+                                     fs_ctx->meta_block_header.scratch_dblock);
+    }
+
+    return err;
+#else
+    (void)fs_ctx;
+    (void)idx;
+    (void)file_meta;
+    (void)block_meta;
+
+    return PSA_ERROR_INSUFFICIENT_STORAGE;
+#endif /* ITS_METADATA_JOURNAL_SIZE */
+}
+
+psa_status_t its_flash_fs_mblock_wear_level(struct its_flash_fs_ctx_t *fs_ctx)
+{
+#if ITS_WEAR_LEVELING_THRESHOLD
+    struct its_block_meta_t block_meta;
+    const uint32_t *erase_count = fs_ctx->cfg->erase_count;
+    uint32_t scratch_id = fs_ctx->meta_block_header.scratch_dblock;
+    uint32_t cold_lblock = ITS_LOGICAL_DBLOCK0;
+    uint32_t cold_count;
+    uint32_t lblock;
+    size_t data_size;
+    psa_status_t err;
+
+    if ((erase_count == NULL) || (its_num_dedicated_dblocks(fs_ctx) == 0)) {
+        return PSA_SUCCESS;
+    }
+
+    /* Find the logical block in the least worn dedicated data block */
+    cold_count = erase_count[scratch_id];
+    for (lblock = ITS_LOGICAL_DBLOCK0 + 1;
+         lblock < its_num_active_dblocks(fs_ctx); lblock++) {
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, lblock,
+                                                      &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if (erase_count[block_meta.phy_id] < cold_count) {
+            cold_count = erase_count[block_meta.phy_id];
+            cold_lblock = lblock;
+        }
+    }
+
+    if ((cold_lblock == ITS_LOGICAL_DBLOCK0) ||
+        ((erase_count[scratch_id] - cold_count) <=
+         fs_ctx->cfg->wear_threshold)) {
+        return PSA_SUCCESS;
+    }
+
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, cold_lblock,
+                                                  &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Move the data of the logical block to the scratch data block, which is
+     * erased. A dedicated data block has its data from the start of the block.
+     * An empty block has nothing to move, and nothing to flush as the NAND
+     * back end only flushes blocks with buffered data.
+     */
+    data_size = fs_ctx->cfg->block_size - block_meta.free_size;
+    if (data_size != 0) {
+        err = its_flash_fs_block_to_block_move(fs_ctx, scratch_id, 0,
+                                               block_meta.phy_id, 0,
+                                               data_size);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        err = fs_ctx->ops->flush(fs_ctx->cfg, scratch_id);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    /* The least worn block becomes the scratch data block, erased when the
+     * metadata blocks are swapped.
+     */
+    its_flash_fs_mblock_set_data_scratch(fs_ctx, block_meta.phy_id,
+                                         cold_lblock);
+    block_meta.phy_id = scratch_id;
+
+    err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx, cold_lblock,
+                                                        &block_meta);
+    if (err == PSA_SUCCESS) {
+        err = its_flash_fs_mblock_cp_file_meta(fs_ctx, 0,
+                                               fs_ctx->cfg->max_num_files);
+    }
+    if (err == PSA_SUCCESS) {
+        err = its_flash_fs_mblock_migrate_lb0_data_to_scratch(fs_ctx);
+    }
+    if (err != PSA_SUCCESS) {
+        /* Swap back the data block as there was an issue in the process */
+        its_flash_fs_mblock_set_data_scratch(fs_ctx, scratch_id, cold_lblock);
+        return err;
+    }
+
+    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+#else
+    (void)fs_ctx;
+
+    return PSA_SUCCESS;
+#endif /* ITS_WEAR_LEVELING_THRESHOLD */
+}
+
 psa_status_t its_flash_fs_mblock_migrate_lb0_data_to_scratch(
                                               struct its_flash_fs_ctx_t *fs_ctx)
 {
@@ -1135,7 +2269,7 @@ psa_status_t its_flash_fs_mblock_read_file_meta(
     psa_status_t err;
     size_t offset;
 
-    offset = its_mblock_file_meta_offset(fs_ctx, idx);
+    offset = its_mblock_file_meta_pos(fs_ctx, idx);
     err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
                             (uint8_t *)file_meta, offset,
                             ITS_FILE_METADATA_SIZE);
@@ -1157,7 +2291,7 @@ psa_status_t its_flash_fs_mblock_read_block_metadata(
     psa_status_t err;
     size_t pos;
 
-    pos = its_mblock_block_meta_offset(lblock);
+    pos = its_mblock_block_meta_pos(fs_ctx, lblock);
     err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
                             (uint8_t *)block_meta, pos,
                             ITS_BLOCK_METADATA_SIZE);
@@ -1234,15 +2368,20 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
      */
     if (its_init_get_active_metablock(fs_ctx) == PSA_SUCCESS) {
         metablock_to_erase_first = fs_ctx->scratch_metablock;
+
+        /* Keep the erase counts, as the wear of the blocks is not reset */
+        if (its_mblock_read_meta_header(fs_ctx) == PSA_SUCCESS) {
+            (void)its_mblock_wear_load(fs_ctx);
+        }
     }
 
-    err = fs_ctx->ops->erase(fs_ctx->cfg, metablock_to_erase_first);
+    err = its_mblock_erase_block(fs_ctx, metablock_to_erase_first);
     if (err != PSA_SUCCESS) {
         return err;
     }
 
-    err = fs_ctx->ops->erase(fs_ctx->cfg,
-                             ITS_OTHER_META_BLOCK(metablock_to_erase_first));
+    err = its_mblock_erase_block(fs_ctx,
+                                 ITS_OTHER_META_BLOCK(metablock_to_erase_first));
     if (err != PSA_SUCCESS) {
         return err;
     }
@@ -1251,17 +2390,27 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
                                     (fs_ctx->cfg->erase_val == 0x00U) ? 1U : 0U;
     fs_ctx->meta_block_header.scratch_dblock = its_init_scratch_dblock(fs_ctx);
     fs_ctx->meta_block_header.fs_version = ITS_SUPPORTED_VERSION;
+#if ITS_METADATA_JOURNAL_SIZE
+    if (fs_ctx->cfg->journal_size != 0) {
+        fs_ctx->meta_block_header.fs_version = ITS_JOURNAL_VERSION;
+    }
+#endif
+#if ITS_WEAR_LEVELING_THRESHOLD
+    if (fs_ctx->cfg->erase_count != NULL) {
+        fs_ctx->meta_block_header.fs_version |= ITS_WEAR_TABLE_FLAG;
+    }
+#endif
     fs_ctx->scratch_metablock = ITS_METADATA_BLOCK1;
     fs_ctx->active_metablock = ITS_METADATA_BLOCK0;
 
     /* Fill the block metadata for logical datablock 0, which is given the
      * physical ID of the current scratch metadata block so that it is in the
      * active metadata block after the metadata blocks are swapped. For this
-     * datablock, the space available for data is from the end of the metadata
-     * to the end of the block.
+     * datablock, the space available for data is from the end of the metadata,
+     * or of the erase count table and the journal area if they are in use, to
+     * the end of the block.
      */
-    block_meta.data_start =
-        its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files);
+    block_meta.data_start = its_mblock_lb0_data_start(fs_ctx);
     block_meta.free_size = fs_ctx->cfg->block_size - block_meta.data_start;
     block_meta.phy_id = fs_ctx->scratch_metablock;
     err = its_mblock_update_scratch_block_meta(fs_ctx, ITS_LOGICAL_DBLOCK0,
@@ -1281,8 +2430,8 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
         /* If a flash error is detected, the code erases the rest
          * of the blocks anyway to remove all data stored in them.
          */
-        err |= fs_ctx->ops->erase(fs_ctx->cfg,
-                                  i + its_init_dblock_start(fs_ctx));
+        err |= its_mblock_erase_block(fs_ctx,
+                                      i + its_init_dblock_start(fs_ctx));
     }
 
     /* If an error is detected while erasing the flash, then return a
@@ -1326,6 +2475,8 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
 
     /* Swap active and scratch metablocks */
     its_mblock_swap_metablocks(fs_ctx);
+    its_mblock_journal_reset(fs_ctx);
+    its_index_commit(fs_ctx);
 
     return PSA_SUCCESS;
 }
@@ -1358,7 +2509,23 @@ psa_status_t its_flash_fs_mblock_update_scratch_block_meta(
         return PSA_ERROR_GENERIC_ERROR;
     }
 
-    return its_mblock_copy_remaining_block_meta(fs_ctx, lblock);
+    return its_mblock_copy_remaining_block_meta(fs_ctx, lblock, NULL);
+}
+
+psa_status_t its_flash_fs_mblock_update_scratch_block_meta_lb0(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      uint32_t lblock,
+                                      const struct its_block_meta_t *block_meta,
+                                      const struct its_block_meta_t *lb0_meta)
+{
+    psa_status_t err;
+
+    err = its_mblock_update_scratch_block_meta(fs_ctx, lblock, block_meta);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return its_mblock_copy_remaining_block_meta(fs_ctx, lblock, lb0_meta);
 }
 
 psa_status_t its_flash_fs_mblock_update_scratch_file_meta(
@@ -1368,6 +2535,13 @@ psa_status_t its_flash_fs_mblock_update_scratch_file_meta(
 {
     size_t pos;
 
+#if ITS_RAM_FILE_INDEX
+    if (fs_ctx->cfg->index != NULL) {
+        (void)memcpy(&fs_ctx->cfg->index->scratch_fid[idx * ITS_FILE_ID_SIZE],
+                     file_meta->id, ITS_FILE_ID_SIZE);
+    }
+#endif
+
     /* Calculate the position */
     pos = its_mblock_file_meta_offset(fs_ctx, idx);
     return fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->scratch_metablock,
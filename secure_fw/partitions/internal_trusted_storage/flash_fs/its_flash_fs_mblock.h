@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -35,6 +35,38 @@ extern "C" {
  */
 #define ITS_BACKWARD_SUPPORTED_VERSION  0x01
 
+/*!
+ * \def ITS_JOURNAL_VERSION
+ *
+ * \brief Defines the version of a filesystem with a metadata journal. The
+ *        metadata block layout is the one of ITS_SUPPORTED_VERSION, with the
+ *        journal area at the end of the block.
+ */
+#define ITS_JOURNAL_VERSION  0x03
+
+/*!
+ * \def ITS_JOURNAL_COMMIT
+ *
+ * \brief Defines the value which marks a complete metadata journal record.
+ */
+#define ITS_JOURNAL_COMMIT  0xA5
+
+/*!
+ * \def ITS_WEAR_TABLE_FLAG
+ *
+ * \brief Flag set in the filesystem version when the metadata block holds the
+ *        erase count table of the physical blocks, after the file metadata
+ *        table.
+ */
+#define ITS_WEAR_TABLE_FLAG  0x80
+
+/*!
+ * \def ITS_FS_VERSION
+ *
+ * \brief Gets the filesystem version without the layout flags.
+ */
+#define ITS_FS_VERSION(fs_version)  ((fs_version) & ~ITS_WEAR_TABLE_FLAG)
+
 /*!
  * \def ITS_METADATA_INVALID_INDEX
  *
@@ -49,6 +81,15 @@ extern "C" {
  */
 #define ITS_LOGICAL_DBLOCK0  0
 
+/*!
+ * \def ITS_FLASH_FS_FLAG_DELETE
+ *
+ * \brief Filesystem-internal file flag which marks a file to be deleted. The
+ *        file can no longer be looked up, but its metadata entry and its data
+ *        are kept until it is removed from its data block.
+ */
+#define ITS_FLASH_FS_FLAG_DELETE  (1U << 24)
+
 /*!
  * \struct its_metadata_block_header_t
  *
@@ -179,6 +220,68 @@ struct its_file_meta_t {
 };
 #undef _T3
 
+/*!
+ * \struct its_journal_rec_hdr_t
+ *
+ * \brief Structure to store the header of a metadata journal record. It is
+ *        followed by the file metadata entry, the whole block metadata table
+ *        and a its_journal_commit_t.
+ *
+ * \note This structure is programmed to flash, so its size must be padded
+ *       to a multiple of the maximum required flash program unit.
+ */
+#define _T4 \
+    uint32_t file_idx;          /*!< File metadata entry index */ \
+    uint32_t scratch_dblock;    /*!< Physical block ID of the data \
+                                 *   section's scratch block \
+                                 */
+
+struct its_journal_rec_hdr_t {
+    _T4
+#if ((ITS_FLASH_MAX_ALIGNMENT) > 4)
+    uint8_t roundup[sizeof(struct __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT))) { _T4 }) -
+                    sizeof(struct { _T4 })];
+#endif
+};
+#undef _T4
+
+/*!
+ * \struct its_journal_commit_t
+ *
+ * \brief Structure to store the commit marker of a metadata journal record.
+ *
+ * \note The commit marker is programmed after the rest of the record, so a
+ *       record interrupted by a power failure is never applied.
+ *
+ * \note This structure is programmed to flash, so its size must be padded
+ *       to a multiple of the maximum required flash program unit.
+ */
+#define _T5 \
+    uint8_t xor_value;          /*!< XOR value of the rest of the record */ \
+    uint8_t commit;             /*!< ITS_JOURNAL_COMMIT once complete */ \
+    uint16_t reserved;          /*!< Reserved */
+
+struct its_journal_commit_t {
+    _T5
+#if ((ITS_FLASH_MAX_ALIGNMENT) > 4)
+    uint8_t roundup[sizeof(struct __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT))) { _T5 }) -
+                    sizeof(struct { _T5 })];
+#endif
+};
+#undef _T5
+
+/*!
+ * \def ITS_JOURNAL_RECORD_SIZE
+ *
+ * \brief Size of a metadata journal record for a given number of logical
+ *        data blocks.
+ */
+#define ITS_JOURNAL_RECORD_SIZE(num_dblocks)                \
+    (sizeof(struct its_journal_rec_hdr_t)                   \
+     + sizeof(struct its_file_meta_t)                       \
+     + ((num_dblocks) * sizeof(struct its_block_meta_t))    \
+     + sizeof(struct its_journal_commit_t))
+
 /**
  * \struct its_flash_fs_ctx_t
  *
@@ -192,6 +295,10 @@ struct its_flash_fs_ctx_t {
                                                            */
     uint32_t active_metablock;  /**< Active metadata block */
     uint32_t scratch_metablock; /**< Scratch metadata block */
+    uint32_t journal_next;      /**< Next free metadata journal record */
+    uint32_t journal_last;      /**< Latest metadata journal record plus one,
+                                 *   0 if the journal is empty
+                                 */
 };
 
 /**
@@ -233,6 +340,7 @@ uint32_t its_flash_fs_mblock_cur_data_scratch_id(
  * \brief Gets file metadata entry index and file metadata.
  *
  * \note  A NULL [file_meta] indicates ignoring file meta.
+ * \note  Files marked with ITS_FLASH_FS_FLAG_DELETE are not found.
  *
  * \param[in,out]       fs_ctx      Filesystem context
  * \param[in]           fid         ID of the file
@@ -271,6 +379,49 @@ psa_status_t its_flash_fs_mblock_get_file_idx_flag(
 psa_status_t its_flash_fs_mblock_meta_update_finalize(
                                              struct its_flash_fs_ctx_t *fs_ctx);
 
+/**
+ * \brief Records a file update in the metadata journal of the active metadata
+ *        block, instead of writing and swapping in the scratch metadata block.
+ *
+ * \note The file data, if any, must already be in its new data block. The
+ *       update is recorded with the file metadata entry, the logical block
+ *       metadata and the current scratch data block. The previous data block
+ *       is erased once the record is complete.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     idx         File metadata entry index
+ * \param[in]     file_meta   File metadata entry
+ * \param[in]     block_meta  Metadata of the logical block of the file
+ *
+ * \return Returns PSA_ERROR_INSUFFICIENT_STORAGE if the update can not be
+ *         journaled, because the journal is not in use or full, or because the
+ *         file is in logical block 0. The update must then be completed with
+ *         its_flash_fs_mblock_meta_update_finalize(). Otherwise, returns error
+ *         code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_journal_update(
+                                     struct its_flash_fs_ctx_t *fs_ctx,
+                                     uint32_t idx,
+                                     const struct its_file_meta_t *file_meta,
+                                     const struct its_block_meta_t *block_meta);
+
+/**
+ * \brief Levels the wear of the dedicated data blocks. If the scratch data
+ *        block has been erased more than the wear threshold times more than
+ *        the least worn data block, the data of the logical block in the least
+ *        worn block is moved into the scratch data block, and the least worn
+ *        block becomes the scratch data block. The next updates are then
+ *        written to it.
+ *
+ * \note The move is a complete update of the metadata block, so it is power
+ *       failure safe. At most one logical block is moved per call.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_wear_level(struct its_flash_fs_ctx_t *fs_ctx);
+
 /**
  * \brief Writes the files data area of logical block 0 into the scratch
  *        block.
@@ -390,6 +541,24 @@ psa_status_t its_flash_fs_mblock_update_scratch_block_meta(
                                            uint32_t lblock,
                                            struct its_block_meta_t *block_meta);
 
+/**
+ * \brief Puts the metadata of a logical block and of logical block 0 in
+ *        scratch metadata block, for an update which changes both blocks
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     lblock      Logical block number, other than logical block 0
+ * \param[in]     block_meta  Pointer to block's metadata
+ * \param[in]     lb0_meta    Pointer to logical block 0's metadata. Its
+ *                            physical ID is set to the scratch metadata block.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_update_scratch_block_meta_lb0(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      uint32_t lblock,
+                                      const struct its_block_meta_t *block_meta,
+                                      const struct its_block_meta_t *lb0_meta);
+
 /**
  * \brief Writes a file metadata entry into scratch metadata block.
  *
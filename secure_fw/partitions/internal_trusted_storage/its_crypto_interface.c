@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,6 +9,7 @@
 
 #include "flash_fs/its_flash_fs.h"
 #include "flash/its_flash.h"
+#include "its_crypto_interface.h"
 #include "its_utils.h"
 #include "psa_manifest/pid.h"
 #include "tfm_hal_its_encryption.h"
@@ -51,12 +52,15 @@ static psa_status_t tfm_its_fill_enc_add(uint8_t *add,
      */
     uint32_t user_flags = flags & ITS_FLASH_FS_USER_FLAGS_MASK;
 
+    /* The data size field has a fixed width, whatever the width of size_t */
+    uint32_t data_size_field = (uint32_t)data_size;
+
     /* The additional data consist of the file id, the flags and the
      * data size of the file.
      */
     size_t add_expected_size = ITS_FILE_ID_SIZE +
                                sizeof(user_flags) +
-                               sizeof(data_size);
+                               sizeof(data_size_field);
 
     if (add_size != add_expected_size || add == NULL || fid == NULL) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -65,8 +69,8 @@ static psa_status_t tfm_its_fill_enc_add(uint8_t *add,
     memcpy(add, fid, fid_size);
     memcpy(add + fid_size, &user_flags, sizeof(user_flags));
     memcpy(add + fid_size + sizeof(user_flags),
-               &data_size,
-               sizeof(data_size));
+               &data_size_field,
+               sizeof(data_size_field));
 
     return PSA_SUCCESS;
 }
@@ -164,3 +168,187 @@ psa_status_t tfm_its_crypt_file(struct its_flash_fs_file_info_t *finfo,
     return PSA_SUCCESS;
 }
 
+#if ITS_ENCRYPTION_CHUNK_SIZE
+psa_status_t tfm_its_crypt_chunk_data_size(size_t stored_size,
+                                           size_t *data_size)
+{
+    size_t num_full_chunks;
+    size_t last_size;
+
+    if (stored_size < ITS_ENC_FILE_HEADER_SIZE + ITS_ENC_CHUNK_OVERHEAD) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+    stored_size -= ITS_ENC_FILE_HEADER_SIZE;
+
+    /* All the chunks but the last one are full and padded */
+    num_full_chunks = (stored_size - 1) / ITS_ENC_CHUNK_STRIDE;
+    last_size = stored_size - (num_full_chunks * ITS_ENC_CHUNK_STRIDE)
+                - ITS_ENC_CHUNK_OVERHEAD;
+
+    /* Only an empty file has a chunk with no data */
+    if ((last_size > ITS_ENCRYPTION_CHUNK_SIZE) ||
+        ((last_size == 0) && (num_full_chunks != 0))) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    *data_size = (num_full_chunks * ITS_ENCRYPTION_CHUNK_SIZE) + last_size;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Sets the AEAD context of a chunk
+ *
+ * \details The additional data of a chunk are the ones of a whole file,
+ *          followed by the nonce of the write and the chunk index. The nonce
+ *          of the write binds the chunks of one write together, and the index
+ *          prevents them from being swapped.
+ *
+ * \param[out]  aead_ctx     AEAD context
+ * \param[out]  aad          Additional data buffer
+ * \param[in]   aad_size     Additional data buffer size in bytes
+ * \param[in]   fid          Identifier of the file
+ * \param[in]   fid_size     Identifier of the file size in bytes
+ * \param[in]   flags        Flags of the file
+ * \param[in]   file_size    Size of the data of the whole file in bytes
+ * \param[in]   write_nonce  Nonce of the write of the file
+ * \param[in]   chunk_idx    Index of the chunk in the file
+ * \param[in]   nonce        Nonce of the chunk
+ *
+ * \return PSA_SUCCESS on successful operation or a valid PSA error code
+ */
+static psa_status_t tfm_its_chunk_aead_ctx(
+                                    struct tfm_hal_its_auth_crypt_ctx *aead_ctx,
+                                    uint8_t *aad,
+                                    const size_t aad_size,
+                                    uint8_t *fid,
+                                    const size_t fid_size,
+                                    const uint32_t flags,
+                                    const size_t file_size,
+                                    const uint8_t *write_nonce,
+                                    const uint32_t chunk_idx,
+                                    uint8_t *nonce)
+{
+    size_t file_aad_size = aad_size - ITS_ENC_WRITE_NONCE_SIZE -
+                           sizeof(chunk_idx);
+    psa_status_t err;
+
+    err = tfm_its_fill_enc_add(aad,
+                               file_aad_size,
+                               fid,
+                               fid_size,
+                               flags,
+                               file_size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    memcpy(aad + file_aad_size, write_nonce, ITS_ENC_WRITE_NONCE_SIZE);
+    memcpy(aad + aad_size - sizeof(chunk_idx), &chunk_idx, sizeof(chunk_idx));
+
+    aead_ctx->nonce = nonce;
+    aead_ctx->nonce_size = TFM_ITS_ENC_NONCE_LENGTH;
+    aead_ctx->deriv_label = fid;
+    aead_ctx->deriv_label_size = fid_size;
+    aead_ctx->aad = aad;
+    aead_ctx->aad_size = aad_size;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_its_crypt_chunk_write_nonce(uint8_t *write_nonce)
+{
+    enum tfm_hal_status_t err;
+
+    err = tfm_hal_its_aead_generate_nonce(write_nonce,
+                                          ITS_ENC_WRITE_NONCE_SIZE);
+
+    return tfm_hal_to_psa_error(err);
+}
+
+psa_status_t tfm_its_crypt_chunk_encrypt(uint8_t *fid,
+                                         const size_t fid_size,
+                                         const uint32_t flags,
+                                         const size_t file_size,
+                                         const uint8_t *write_nonce,
+                                         const uint32_t chunk_idx,
+                                         const uint8_t *input,
+                                         const size_t input_size,
+                                         uint8_t *output,
+                                         const size_t output_size)
+{
+    struct tfm_hal_its_auth_crypt_ctx aead_ctx = {0};
+    uint8_t aad[ITS_FILE_ID_SIZE + ITS_FLAG_SIZE + ITS_DATA_SIZE_FIELD_SIZE +
+                ITS_ENC_WRITE_NONCE_SIZE + sizeof(chunk_idx)];
+    enum tfm_hal_status_t err;
+    psa_status_t status;
+
+    /* The HAL writes the tag after the encrypted data before copying it */
+    if (output_size < input_size + ITS_ENC_CHUNK_OVERHEAD +
+                      TFM_ITS_AUTH_TAG_LENGTH) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Each chunk has its own nonce, as it can be encrypted again on its own */
+    err = tfm_hal_its_aead_generate_nonce(output, TFM_ITS_ENC_NONCE_LENGTH);
+    if (err != TFM_HAL_SUCCESS) {
+        return tfm_hal_to_psa_error(err);
+    }
+
+    status = tfm_its_chunk_aead_ctx(&aead_ctx, aad, sizeof(aad), fid, fid_size,
+                                    flags, file_size, write_nonce, chunk_idx,
+                                    output);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    err = tfm_hal_its_aead_encrypt(&aead_ctx,
+                                   input,
+                                   input_size,
+                                   output + ITS_ENC_CHUNK_OVERHEAD,
+                                   output_size - ITS_ENC_CHUNK_OVERHEAD,
+                                   output + TFM_ITS_ENC_NONCE_LENGTH,
+                                   TFM_ITS_AUTH_TAG_LENGTH);
+
+    return tfm_hal_to_psa_error(err);
+}
+
+psa_status_t tfm_its_crypt_chunk_decrypt(uint8_t *fid,
+                                         const size_t fid_size,
+                                         const uint32_t flags,
+                                         const size_t file_size,
+                                         const uint8_t *write_nonce,
+                                         const uint32_t chunk_idx,
+                                         uint8_t *input,
+                                         const size_t input_size,
+                                         uint8_t *output,
+                                         const size_t output_size)
+{
+    struct tfm_hal_its_auth_crypt_ctx aead_ctx = {0};
+    uint8_t aad[ITS_FILE_ID_SIZE + ITS_FLAG_SIZE + ITS_DATA_SIZE_FIELD_SIZE +
+                ITS_ENC_WRITE_NONCE_SIZE + sizeof(chunk_idx)];
+    enum tfm_hal_status_t err;
+    psa_status_t status;
+
+    if (input_size < ITS_ENC_CHUNK_OVERHEAD) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = tfm_its_chunk_aead_ctx(&aead_ctx, aad, sizeof(aad), fid, fid_size,
+                                    flags, file_size, write_nonce, chunk_idx,
+                                    input);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    err = tfm_hal_its_aead_decrypt(&aead_ctx,
+                                   input + ITS_ENC_CHUNK_OVERHEAD,
+                                   input_size - ITS_ENC_CHUNK_OVERHEAD,
+                                   input + TFM_ITS_ENC_NONCE_LENGTH,
+                                   TFM_ITS_AUTH_TAG_LENGTH,
+                                   output,
+                                   output_size);
+
+    return tfm_hal_to_psa_error(err);
+}
+#endif /* ITS_ENCRYPTION_CHUNK_SIZE */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -41,3 +41,127 @@ psa_status_t tfm_its_crypt_file(struct its_flash_fs_file_info_t *finfo,
                                 const size_t output_size,
                                 const bool is_encrypt);
 
+#if ITS_ENCRYPTION_CHUNK_SIZE
+/* Size of the nonce of a write of the file. It is stored in the file header
+ * and authenticated with every chunk, so that the chunks of two writes of a
+ * file cannot be mixed.
+ */
+#define ITS_ENC_WRITE_NONCE_SIZE TFM_ITS_ENC_NONCE_LENGTH
+
+/* Size of the file header, padded so that the chunks start aligned */
+#define ITS_ENC_FILE_HEADER_SIZE ITS_UTILS_ALIGN(ITS_ENC_WRITE_NONCE_SIZE, \
+                                                 ITS_FLASH_ALIGNMENT)
+
+/* Size of the nonce and tag stored in front of the data of each chunk */
+#define ITS_ENC_CHUNK_OVERHEAD (TFM_ITS_ENC_NONCE_LENGTH + \
+                                TFM_ITS_AUTH_TAG_LENGTH)
+
+/* Offset between two chunks in storage. The chunks are padded to the flash
+ * program unit, so that each chunk starts at an aligned offset.
+ */
+#define ITS_ENC_CHUNK_STRIDE ITS_UTILS_ALIGN(ITS_ENCRYPTION_CHUNK_SIZE + \
+                                             ITS_ENC_CHUNK_OVERHEAD,     \
+                                             ITS_FLASH_ALIGNMENT)
+
+/* Offset in storage of the chunk of index i */
+#define ITS_ENC_CHUNK_OFFSET(i) \
+    (ITS_ENC_FILE_HEADER_SIZE + ((i) * ITS_ENC_CHUNK_STRIDE))
+
+/* Size in storage of an encrypted file of n bytes. An empty file has a chunk
+ * with no data, so that it is authenticated as well.
+ */
+#define ITS_ENC_STORED_SIZE(n) \
+    (ITS_ENC_FILE_HEADER_SIZE + \
+     (((n) == 0) ? ITS_ENC_CHUNK_OVERHEAD : \
+      ((((n) - 1) / ITS_ENCRYPTION_CHUNK_SIZE) * ITS_ENC_CHUNK_STRIDE + \
+       ((((n) - 1) % ITS_ENCRYPTION_CHUNK_SIZE) + 1) + \
+       ITS_ENC_CHUNK_OVERHEAD)))
+
+/**
+ * \brief Gets the size of the data of an encrypted file from its size in
+ *        storage.
+ *
+ * \param[in]  stored_size  Size of the file in storage in bytes
+ * \param[out] data_size    Size of the data of the file in bytes
+ *
+ * \retval PSA_SUCCESS                On success
+ * \retval PSA_ERROR_STORAGE_FAILURE  When the size in storage is not the one
+ *                                    of a file written in chunks
+ */
+psa_status_t tfm_its_crypt_chunk_data_size(size_t stored_size,
+                                           size_t *data_size);
+
+/**
+ * \brief Generates the nonce of a write of a file using the tfm_hal_its APIs
+ *
+ * \param[out] write_nonce  Buffer of \ref ITS_ENC_WRITE_NONCE_SIZE bytes
+ *
+ * \return PSA_SUCCESS on successful operation or a valid PSA error code
+ */
+psa_status_t tfm_its_crypt_chunk_write_nonce(uint8_t *write_nonce);
+
+/**
+ * \brief Encrypts one chunk of a file using the tfm_hal_its APIs
+ *
+ * \details The chunk is authenticated together with the file id, the file
+ *          flags, the size of the whole file, the nonce of the write and the
+ *          chunk index. The output holds the nonce, the tag and then the
+ *          encrypted data.
+ *
+ * \param[in]  fid          File identifier
+ * \param[in]  fid_size     File identifier size in bytes
+ * \param[in]  flags        Flags of the file
+ * \param[in]  file_size    Size of the data of the whole file in bytes
+ * \param[in]  write_nonce  Nonce of the write, of
+ *                          \ref ITS_ENC_WRITE_NONCE_SIZE bytes
+ * \param[in]  chunk_idx    Index of the chunk in the file
+ * \param[in]  input        Data of the chunk
+ * \param[in]  input_size   Size of the data of the chunk in bytes
+ * \param[out] output       Output buffer, which must have room for the
+ *                          encrypted chunk and one more tag
+ * \param[in]  output_size  Output size in bytes
+ *
+ * \return PSA_SUCCESS on successful operation or a valid PSA error code
+ */
+psa_status_t tfm_its_crypt_chunk_encrypt(uint8_t *fid,
+                                         const size_t fid_size,
+                                         const uint32_t flags,
+                                         const size_t file_size,
+                                         const uint8_t *write_nonce,
+                                         const uint32_t chunk_idx,
+                                         const uint8_t *input,
+                                         const size_t input_size,
+                                         uint8_t *output,
+                                         const size_t output_size);
+
+/**
+ * \brief Decrypts and authenticates one chunk of a file using the
+ *        tfm_hal_its APIs
+ *
+ * \param[in]     fid          File identifier
+ * \param[in]     fid_size     File identifier size in bytes
+ * \param[in]     flags        Flags of the file
+ * \param[in]     file_size    Size of the data of the whole file in bytes
+ * \param[in]     write_nonce  Nonce of the write, read from the file header
+ * \param[in]     chunk_idx    Index of the chunk in the file
+ * \param[in,out] input        Encrypted chunk, as written by
+ *                             \ref tfm_its_crypt_chunk_encrypt. The buffer
+ *                             must have room for one more tag after the chunk,
+ *                             which the HAL may use.
+ * \param[in]     input_size   Size of the encrypted chunk in bytes
+ * \param[out]    output       Output buffer
+ * \param[in]     output_size  Output size in bytes
+ *
+ * \return PSA_SUCCESS on successful operation or a valid PSA error code
+ */
+psa_status_t tfm_its_crypt_chunk_decrypt(uint8_t *fid,
+                                         const size_t fid_size,
+                                         const uint32_t flags,
+                                         const size_t file_size,
+                                         const uint8_t *write_nonce,
+                                         const uint32_t chunk_idx,
+                                         uint8_t *input,
+                                         const size_t input_size,
+                                         uint8_t *output,
+                                         const size_t output_size);
+#endif /* ITS_ENCRYPTION_CHUNK_SIZE */
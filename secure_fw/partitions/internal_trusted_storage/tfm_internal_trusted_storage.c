@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -8,10 +8,10 @@
  */
 #include <string.h>
 #include "psa/framework_feature.h"
-#if PSA_FRAMEWORK_HAS_MM_IOVEC != 1
+#include "config_tfm.h"
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) || ITS_TRANSACTION_MAX_OPS
 #include "cmsis_compiler.h"
 #endif
-#include "config_tfm.h"
 #include "tfm_internal_trusted_storage.h"
 #include "tfm_its_req_mngr.h"
 #include "tfm_hal_its.h"
@@ -46,7 +46,7 @@ static struct its_flash_fs_file_info_t g_file_info;
  * Note: size must be aligned to the max flash program unit to meet the
  * alignment requirement of the filesystem.
  */
-#ifndef ITS_ENCRYPTION
+#if !defined(ITS_ENCRYPTION) || ITS_ENCRYPTION_CHUNK_SIZE
 static uint8_t __ALIGNED(4) asset_data[ITS_UTILS_ALIGN(ITS_BUF_SIZE,
                                           ITS_FLASH_MAX_ALIGNMENT)];
 #else
@@ -55,24 +55,119 @@ static uint8_t __ALIGNED(4) asset_data[ITS_UTILS_ALIGN(ITS_MAX_ASSET_SIZE,
 #endif
 #endif
 
+#if ITS_TRANSACTION_MAX_OPS && defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
+/* Operations of an open transaction, staged in RAM until it is committed */
+struct its_txn_t {
+    bool active;
+    int32_t client_id;
+    uint32_t stamp;     /* Value of g_txn_clock at the last request */
+    uint32_t num_ops;
+    size_t data_used;
+    struct its_flash_fs_file_op_t ops[ITS_TRANSACTION_MAX_OPS];
+    uint8_t fid[ITS_TRANSACTION_MAX_OPS][ITS_FILE_ID_SIZE];
+};
+
+/* One transaction slot per client with an open transaction */
+static struct its_txn_t g_txn[ITS_TRANSACTION_NUM_SLOTS];
+
+/* Counts the transaction requests, to find the transactions left idle */
+static uint32_t g_txn_clock;
+
+/* Buffers to store the data written by the open transactions, one per slot.
+ * Note: the data of each operation starts at an offset aligned to the max
+ * flash program unit to meet the alignment requirement of the filesystem.
+ */
+static uint8_t __ALIGNED(4) txn_data[ITS_TRANSACTION_NUM_SLOTS]
+                                    [ITS_UTILS_ALIGN(ITS_TRANSACTION_BUF_SIZE,
+                                                     ITS_FLASH_MAX_ALIGNMENT)];
+#endif
+
 #ifdef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
 static struct its_flash_fs_ctx_t fs_ctx_its;
+#if ITS_RAM_FILE_INDEX
+ITS_FLASH_FS_INDEX_DEFINE(fs_index_its, ITS_NUM_ASSETS + 1);
+#endif
+#if ITS_METADATA_JOURNAL_SIZE
+static uint16_t fs_journal_map_its[ITS_NUM_ASSETS + 1];
+#endif
+#if ITS_WEAR_LEVELING_THRESHOLD
+ITS_FLASH_FS_ERASE_COUNT_DEFINE(fs_erase_count_its,
+                                ITS_WEAR_LEVELING_MAX_BLOCKS);
+#endif
+#if ITS_FLASH_CACHE_LINES && !ITS_RAM_FS
+ITS_FLASH_CACHE_DEFINE(fs_cache_its, ITS_FLASH_CACHE_LINES,
+                       ITS_FLASH_CACHE_LINE_SIZE);
+#endif
 static struct its_flash_fs_config_t fs_cfg_its = {
     .flash_dev = &ITS_FLASH_DEV,
     .program_unit = ITS_FLASH_ALIGNMENT,
+#if defined(ITS_ENCRYPTION) && ITS_ENCRYPTION_CHUNK_SIZE
+    /* An encrypted file also stores a header and the nonce and tag of each
+     * chunk
+     */
+    .max_file_size = ITS_UTILS_ALIGN(ITS_ENC_STORED_SIZE(ITS_MAX_ASSET_SIZE),
+                                     ITS_FLASH_ALIGNMENT),
+#else
     .max_file_size = ITS_UTILS_ALIGN(ITS_MAX_ASSET_SIZE, ITS_FLASH_ALIGNMENT),
+#endif
     .max_num_files = ITS_NUM_ASSETS + 1, /* Extra file for atomic replacement */
+#if ITS_RAM_FILE_INDEX
+    .index = &fs_index_its,
+#endif
+    .deferred_compaction = ITS_DEFERRED_COMPACTION,
+#if ITS_FLASH_CACHE_LINES && !ITS_RAM_FS
+    .cache = &fs_cache_its,
+#endif
 };
 #endif /* TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
 
 #ifdef TFM_PARTITION_PROTECTED_STORAGE
 static struct its_flash_fs_ctx_t fs_ctx_ps;
+#if ITS_RAM_FILE_INDEX
+ITS_FLASH_FS_INDEX_DEFINE(fs_index_ps, PS_MAX_NUM_OBJECTS);
+#endif
+#if ITS_METADATA_JOURNAL_SIZE
+static uint16_t fs_journal_map_ps[PS_MAX_NUM_OBJECTS];
+#endif
+#if ITS_WEAR_LEVELING_THRESHOLD
+ITS_FLASH_FS_ERASE_COUNT_DEFINE(fs_erase_count_ps,
+                                ITS_WEAR_LEVELING_MAX_BLOCKS);
+#endif
+#if ITS_FLASH_CACHE_LINES && !PS_RAM_FS
+ITS_FLASH_CACHE_DEFINE(fs_cache_ps, ITS_FLASH_CACHE_LINES,
+                       ITS_FLASH_CACHE_LINE_SIZE);
+#endif
 static struct its_flash_fs_config_t fs_cfg_ps = {
     .flash_dev = &PS_FLASH_DEV,
     .program_unit = PS_FLASH_ALIGNMENT,
     .max_file_size = ITS_UTILS_ALIGN(PS_MAX_OBJECT_SIZE, PS_FLASH_ALIGNMENT),
     .max_num_files = PS_MAX_NUM_OBJECTS,
+#if ITS_RAM_FILE_INDEX
+    .index = &fs_index_ps,
+#endif
+    .deferred_compaction = ITS_DEFERRED_COMPACTION,
+#if ITS_FLASH_CACHE_LINES && !PS_RAM_FS
+    .cache = &fs_cache_ps,
+#endif
 };
+
+#if PS_RAM_FS
+#define PS_FS_AREA_SIZE PS_RAM_FS_SIZE
+#elif defined(TFM_HAL_PS_FLASH_AREA_SIZE)
+#define PS_FS_AREA_SIZE TFM_HAL_PS_FLASH_AREA_SIZE
+#endif
+
+#ifdef PS_FS_AREA_SIZE
+/* The metadata block holds an entry for each of the PS_MAX_NUM_OBJECTS files,
+ * and a block is at most half of the PS area. With segmented objects, each
+ * segment takes two entries.
+ */
+typedef char PS_ERROR_METADATA_LARGER_THAN_BLOCK[
+    ((sizeof(struct its_metadata_block_header_t) +
+      sizeof(struct its_block_meta_t) +
+      (PS_MAX_NUM_OBJECTS * sizeof(struct its_file_meta_t))) <=
+     (PS_FS_AREA_SIZE / 2)) ? 1 : -1];
+#endif
 #endif
 
 static struct its_flash_fs_ctx_t *get_fs_ctx(int32_t client_id)
@@ -91,6 +186,299 @@ static struct its_flash_fs_ctx_t *get_fs_ctx(int32_t client_id)
 }
 
 #ifdef ITS_ENCRYPTION
+#if ITS_ENCRYPTION_CHUNK_SIZE
+/* Buffer to store an encrypted chunk, and room for the HAL to place the
+ * authentication tag after the encrypted data.
+ */
+static uint8_t __ALIGNED(4) enc_asset_data[ITS_UTILS_ALIGN(ITS_ENC_CHUNK_STRIDE +
+                                           TFM_ITS_AUTH_TAG_LENGTH,
+                                           ITS_FLASH_MAX_ALIGNMENT)];
+
+/* Buffer to store the data of a chunk before encryption or after decryption */
+static uint8_t __ALIGNED(4) chunk_data[ITS_ENCRYPTION_CHUNK_SIZE];
+
+/* Source of the stored content of an encrypted file: the file header, then
+ * the chunks encrypted one at a time in enc_asset_data.
+ */
+struct tfm_its_enc_stream_t {
+    /* File header, first to be aligned as the file data buffers */
+    uint8_t header[ITS_UTILS_ALIGN(ITS_ENC_FILE_HEADER_SIZE,
+                                   ITS_FLASH_MAX_ALIGNMENT)];
+    size_t data_length;     /* Size of the data from the caller in bytes */
+    uint32_t chunk_idx;     /* Index of the next chunk to encrypt */
+    bool header_done;       /* Whether the header has been produced */
+};
+
+/**
+ * \brief Checks whether the files of the client are encrypted.
+ *
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ *
+ * \return true if the files are encrypted, false otherwise
+ */
+static bool tfm_its_is_encrypted(int32_t client_id)
+{
+/* With protected storage no encryption is used */
+#ifdef TFM_PARTITION_PROTECTED_STORAGE
+    return client_id != TFM_SP_PS;
+#else
+    (void)client_id;
+    return true;
+#endif /* TFM_PARTITION_PROTECTED_STORAGE */
+}
+
+static psa_status_t buffer_size_check(int32_t client_id, size_t buffer_size)
+{
+    /* The chunks are encrypted one at a time, only the asset size is limited */
+    if (tfm_its_is_encrypted(client_id) && (buffer_size > ITS_MAX_ASSET_SIZE)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Reads a chunk of the data from the caller and encrypts it in
+ *        enc_asset_data, in the format of the chunk in storage.
+ *
+ * \param[in]  data_length  Size of the whole data from the caller in bytes
+ * \param[in]  write_nonce  Nonce of the write of the file
+ * \param[in]  chunk_idx    Index of the chunk. The chunks must be read in
+ *                          order.
+ * \param[out] p_size       Size of the encrypted chunk in storage, including
+ *                          the padding up to the next chunk
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_read_enc_chunk(size_t data_length,
+                                           const uint8_t *write_nonce,
+                                           uint32_t chunk_idx,
+                                           size_t *p_size)
+{
+    size_t offset = chunk_idx * ITS_ENCRYPTION_CHUNK_SIZE;
+    size_t chunk_size = ITS_UTILS_MIN(data_length - offset,
+                                      ITS_ENCRYPTION_CHUNK_SIZE);
+    const uint8_t *input;
+    psa_status_t status;
+
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    input = (const uint8_t *)its_req_mngr_get_vec_base() + offset;
+#else
+    (void)its_req_mngr_read(chunk_data, chunk_size);
+    input = chunk_data;
+#endif
+
+    status = tfm_its_crypt_chunk_encrypt(g_fid,
+                                         sizeof(g_fid),
+                                         g_file_info.flags,
+                                         data_length,
+                                         write_nonce,
+                                         chunk_idx,
+                                         input,
+                                         chunk_size,
+                                         enc_asset_data,
+                                         sizeof(enc_asset_data));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if ((offset + chunk_size) < data_length) {
+        *p_size = ITS_ENC_CHUNK_STRIDE;
+    } else {
+        *p_size = chunk_size + ITS_ENC_CHUNK_OVERHEAD;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Starts the stream of an encrypted file, with a new nonce of the write
+ *        in its header.
+ *
+ * \param[out] p_stream     Stream to start
+ * \param[in]  data_length  Size of the data from the caller in bytes
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_enc_stream_start(
+                                        struct tfm_its_enc_stream_t *p_stream,
+                                        size_t data_length)
+{
+    p_stream->data_length = data_length;
+    p_stream->chunk_idx = 0;
+    p_stream->header_done = false;
+    memset(p_stream->header, 0, sizeof(p_stream->header));
+
+    /* Each write has its own nonce, authenticated with all its chunks */
+    return tfm_its_crypt_chunk_write_nonce(p_stream->header);
+}
+
+/**
+ * \brief Produces the next piece of an encrypted file, as an
+ *        \ref its_flash_fs_stream_next_t. The chunks are read from the caller
+ *        and encrypted one at a time.
+ */
+static psa_status_t tfm_its_enc_stream_next(void *ctx, const uint8_t **data,
+                                            size_t *size)
+{
+    struct tfm_its_enc_stream_t *p_stream = ctx;
+    psa_status_t status;
+
+    if (!p_stream->header_done) {
+        p_stream->header_done = true;
+        *data = p_stream->header;
+        *size = ITS_ENC_FILE_HEADER_SIZE;
+        return PSA_SUCCESS;
+    }
+
+    status = tfm_its_read_enc_chunk(p_stream->data_length, p_stream->header,
+                                    p_stream->chunk_idx, size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    p_stream->chunk_idx++;
+    *data = enc_asset_data;
+
+    return PSA_SUCCESS;
+}
+
+#if ITS_TRANSACTION_MAX_OPS
+/**
+ * \brief Reads the data from the caller and encrypts it in the format of the
+ *        file in storage, to stage it in a transaction.
+ *
+ * \param[in]  data_length  Size of the data from the caller in bytes
+ * \param[out] dst          Buffer of ITS_ENC_STORED_SIZE(data_length) bytes
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_read_enc_file(size_t data_length, uint8_t *dst)
+{
+    struct tfm_its_enc_stream_t enc_stream;
+    psa_status_t status;
+    size_t stored_size = ITS_ENC_STORED_SIZE(data_length);
+    size_t offset = 0;
+    const uint8_t *piece;
+    size_t piece_size;
+
+    status = tfm_its_enc_stream_start(&enc_stream, data_length);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    do {
+        status = tfm_its_enc_stream_next(&enc_stream, &piece, &piece_size);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        memcpy(dst + offset, piece, piece_size);
+        offset += piece_size;
+    } while (offset < stored_size);
+
+    return PSA_SUCCESS;
+}
+#endif /* ITS_TRANSACTION_MAX_OPS */
+
+static psa_status_t tfm_its_set_encrypted(int32_t client_id,
+                                          size_t data_length)
+{
+    struct tfm_its_enc_stream_t enc_stream;
+    const struct its_flash_fs_stream_t stream = {
+        .next = tfm_its_enc_stream_next,
+        .ctx = &enc_stream,
+    };
+    psa_status_t status;
+    size_t stored_size = ITS_ENC_STORED_SIZE(data_length);
+
+    g_file_info.size_max = stored_size;
+
+    status = tfm_its_enc_stream_start(&enc_stream, data_length);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* The chunks are encrypted as the filesystem appends them to the scratch
+     * data block, so that the file is written once and atomically.
+     */
+    return its_flash_fs_file_write_stream(get_fs_ctx(client_id), g_fid,
+                                          &g_file_info, stored_size, 0,
+                                          &stream);
+}
+
+static psa_status_t tfm_its_get_encrypted(int32_t client_id,
+                         size_t data_offset,
+                         size_t data_size,
+                         size_t *p_data_length)
+{
+    psa_status_t status;
+    size_t file_size = g_file_info.size_current;
+    uint32_t chunk_idx = data_offset / ITS_ENCRYPTION_CHUNK_SIZE;
+    size_t chunk_offset = data_offset % ITS_ENCRYPTION_CHUNK_SIZE;
+    size_t chunk_size;
+    size_t copy_size;
+    uint8_t write_nonce[ITS_ENC_WRITE_NONCE_SIZE];
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC == 1)
+    uint8_t *p_dest = its_req_mngr_get_vec_base();
+#endif
+
+    if (data_size > 0) {
+        status = its_flash_fs_file_read(get_fs_ctx(client_id), g_fid,
+                                        sizeof(write_nonce), 0, write_nonce);
+        if (status != PSA_SUCCESS) {
+            *p_data_length = 0;
+            return status;
+        }
+    }
+
+    /* Only the chunks covered by the request are read and decrypted */
+    while (data_size > 0) {
+        chunk_size = ITS_UTILS_MIN(file_size -
+                                   (chunk_idx * ITS_ENCRYPTION_CHUNK_SIZE),
+                                   ITS_ENCRYPTION_CHUNK_SIZE);
+
+        status = its_flash_fs_file_read(get_fs_ctx(client_id),
+                                        g_fid,
+                                        chunk_size + ITS_ENC_CHUNK_OVERHEAD,
+                                        ITS_ENC_CHUNK_OFFSET(chunk_idx),
+                                        enc_asset_data);
+        if (status != PSA_SUCCESS) {
+            *p_data_length = 0;
+            return status;
+        }
+
+        status = tfm_its_crypt_chunk_decrypt(g_fid,
+                                             sizeof(g_fid),
+                                             g_file_info.flags,
+                                             file_size,
+                                             write_nonce,
+                                             chunk_idx,
+                                             enc_asset_data,
+                                             chunk_size + ITS_ENC_CHUNK_OVERHEAD,
+                                             chunk_data,
+                                             sizeof(chunk_data));
+        if (status != PSA_SUCCESS) {
+            *p_data_length = 0;
+            return status;
+        }
+
+        copy_size = ITS_UTILS_MIN(data_size, chunk_size - chunk_offset);
+
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC == 1)
+        memcpy(p_dest, chunk_data + chunk_offset, copy_size);
+        p_dest += copy_size;
+#else
+        its_req_mngr_write(chunk_data + chunk_offset, copy_size);
+#endif
+
+        data_size -= copy_size;
+        chunk_offset = 0;
+        chunk_idx++;
+    }
+
+    return PSA_SUCCESS;
+}
+#else
 /* Buffer to store the encrypted asset data and the authentication tag before it
  * is stored in the filesystem.
  */
@@ -195,6 +583,7 @@ static psa_status_t tfm_its_get_encrypted(int32_t client_id,
 
     return PSA_SUCCESS;
 }
+#endif /* ITS_ENCRYPTION_CHUNK_SIZE */
 #endif /* ITS_ENCRYPTION */
 
 /**
@@ -244,6 +633,23 @@ static psa_status_t init_its_fs_cfg(void)
                             * its_fs_info.sectors_per_block;
     fs_cfg_its.num_blocks = its_fs_info.flash_area_size / fs_cfg_its.block_size;
 
+#if ITS_METADATA_JOURNAL_SIZE
+    /* The journal records updates of files in dedicated data blocks */
+    if (ITS_FLASH_APPENDABLE && (fs_cfg_its.num_blocks > 2)) {
+        fs_cfg_its.journal_size = ITS_METADATA_JOURNAL_SIZE;
+        fs_cfg_its.journal_map = fs_journal_map_its;
+    }
+#endif
+
+#if ITS_WEAR_LEVELING_THRESHOLD
+    /* The erase counters must cover all the blocks */
+    if (fs_cfg_its.num_blocks > ITS_WEAR_LEVELING_MAX_BLOCKS) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+    fs_cfg_its.erase_count = fs_erase_count_its;
+    fs_cfg_its.wear_threshold = ITS_WEAR_LEVELING_THRESHOLD;
+#endif
+
     return PSA_SUCCESS;
 }
 #endif /* TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
@@ -279,6 +685,23 @@ static psa_status_t init_ps_fs_cfg(void)
     fs_cfg_ps.block_size = fs_cfg_ps.sector_size * ps_fs_info.sectors_per_block;
     fs_cfg_ps.num_blocks = ps_fs_info.flash_area_size / fs_cfg_ps.block_size;
 
+#if ITS_METADATA_JOURNAL_SIZE
+    /* The journal records updates of files in dedicated data blocks */
+    if (PS_FLASH_APPENDABLE && (fs_cfg_ps.num_blocks > 2)) {
+        fs_cfg_ps.journal_size = ITS_METADATA_JOURNAL_SIZE;
+        fs_cfg_ps.journal_map = fs_journal_map_ps;
+    }
+#endif
+
+#if ITS_WEAR_LEVELING_THRESHOLD
+    /* The erase counters must cover all the blocks */
+    if (fs_cfg_ps.num_blocks > ITS_WEAR_LEVELING_MAX_BLOCKS) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+    fs_cfg_ps.erase_count = fs_erase_count_ps;
+    fs_cfg_ps.wear_threshold = ITS_WEAR_LEVELING_THRESHOLD;
+#endif
+
     return PSA_SUCCESS;
 }
 #endif /* TFM_PARTITION_PROTECTED_STORAGE */
@@ -381,6 +804,8 @@ psa_status_t tfm_its_init(void)
 
 static psa_status_t get_file_info(psa_storage_uid_t uid, int32_t client_id)
 {
+    psa_status_t status;
+
     /* Check that the UID is valid */
     if (uid == TFM_ITS_INVALID_UID) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -390,8 +815,20 @@ static psa_status_t get_file_info(psa_storage_uid_t uid, int32_t client_id)
     tfm_its_get_fid(client_id, uid, g_fid);
 
     /* Read file info */
-    return its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
-                                      &g_file_info);
+    status = its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
+                                        &g_file_info);
+
+#if defined(ITS_ENCRYPTION) && ITS_ENCRYPTION_CHUNK_SIZE
+    /* Report the size of the data, without the nonces and tags of the
+     * chunks.
+     */
+    if ((status == PSA_SUCCESS) && tfm_its_is_encrypted(client_id)) {
+        status = tfm_its_crypt_chunk_data_size(g_file_info.size_current,
+                                               &g_file_info.size_current);
+    }
+#endif
+
+    return status;
 }
 
 
@@ -404,12 +841,12 @@ static psa_status_t tfm_its_write_data_to_fs(const int32_t client_id,
 {
     psa_status_t status;
     uint8_t *buffer_ptr = data;
-#ifdef ITS_ENCRYPTION /* ITS_ENCRYPTION */
+#if defined(ITS_ENCRYPTION) && !ITS_ENCRYPTION_CHUNK_SIZE
     status = tfm_its_crypt_data(client_id, &buffer_ptr, data_size, offset);
     if (status != PSA_SUCCESS) {
         return status;
     }
-#endif /* ITS_ENCRYPTION */
+#endif /* ITS_ENCRYPTION && !ITS_ENCRYPTION_CHUNK_SIZE */
     status = its_flash_fs_file_write(get_fs_ctx(client_id),
                                         fid,
                                         &g_file_info,
@@ -471,6 +908,12 @@ psa_status_t tfm_its_set(int32_t client_id,
     g_file_info.flags = (uint32_t)create_flags |
                         ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE;
 
+#if defined ITS_ENCRYPTION && ITS_ENCRYPTION_CHUNK_SIZE && \
+    defined TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+    if (tfm_its_is_encrypted(client_id)) {
+        return tfm_its_set_encrypted(client_id, data_length);
+    }
+#endif /* ITS_ENCRYPTION && ITS_ENCRYPTION_CHUNK_SIZE && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
 
 #ifndef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
     /* Write to the file in the file system
@@ -594,12 +1037,13 @@ psa_status_t tfm_its_get(int32_t client_id,
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-#if defined ITS_ENCRYPTION && defined TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+#if defined ITS_ENCRYPTION && !ITS_ENCRYPTION_CHUNK_SIZE && \
+    defined TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
     status = buffer_size_check(client_id, data_offset + data_size);
     if (status != PSA_SUCCESS) {
         return status;
     }
-#endif /* ITS_ENCRYPTION && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
+#endif /* ITS_ENCRYPTION && !ITS_ENCRYPTION_CHUNK_SIZE && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
 
     /* Read file info */
     status = get_file_info(uid, client_id);
@@ -684,3 +1128,349 @@ psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid)
     /* Delete old file from the persistent area */
     return its_flash_fs_file_delete(get_fs_ctx(client_id), g_fid);
 }
+
+#if ITS_DEFERRED_COMPACTION
+psa_status_t tfm_its_compact(void)
+{
+    psa_status_t status = PSA_ERROR_DOES_NOT_EXIST;
+
+#ifdef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+    status = its_flash_fs_compact_step(&fs_ctx_its);
+#endif
+
+#ifdef TFM_PARTITION_PROTECTED_STORAGE
+    /* The PS filesystem is compacted once the ITS one has been */
+    if (status == PSA_ERROR_DOES_NOT_EXIST) {
+        status = its_flash_fs_compact_step(&fs_ctx_ps);
+    }
+#endif
+
+    return status;
+}
+#endif /* ITS_DEFERRED_COMPACTION */
+
+#if ITS_WEAR_LEVELING_THRESHOLD
+#if (ITS_FLASH_FS_WEAR_HIST_BINS != TFM_ITS_WEAR_HIST_BINS)
+#error "The histograms of the filesystem and of the service must match"
+#endif
+
+psa_status_t tfm_its_wear_stats(int32_t client_id,
+                                struct tfm_its_wear_stats_t *p_stats)
+{
+    struct its_flash_fs_wear_stats_t stats;
+    psa_status_t status;
+
+    status = its_flash_fs_get_wear_stats(get_fs_ctx(client_id), &stats);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Copy the filesystem statistics to the service statistics struct */
+    p_stats->num_blocks = stats.num_blocks;
+    p_stats->min_erase_count = stats.min_erase_count;
+    p_stats->max_erase_count = stats.max_erase_count;
+    p_stats->bin_width = stats.bin_width;
+    (void)memcpy(p_stats->histogram, stats.histogram,
+                 sizeof(p_stats->histogram));
+
+    return PSA_SUCCESS;
+}
+#endif /* ITS_WEAR_LEVELING_THRESHOLD */
+
+#if ITS_TRANSACTION_MAX_OPS && defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
+/**
+ * \brief Gets the open transaction of the client, and records the request in
+ *        it so that it is not reclaimed as idle.
+ *
+ * \param[in] client_id  Identifier of the client
+ *
+ * \return Pointer to the transaction, or NULL if the client has none
+ */
+static struct its_txn_t *tfm_its_txn_get(int32_t client_id)
+{
+    uint32_t i;
+
+    g_txn_clock++;
+
+    for (i = 0; i < ITS_TRANSACTION_NUM_SLOTS; i++) {
+        if (g_txn[i].active && (g_txn[i].client_id == client_id)) {
+            g_txn[i].stamp = g_txn_clock;
+            return &g_txn[i];
+        }
+    }
+
+    return NULL;
+}
+
+psa_status_t tfm_its_txn_begin(int32_t client_id)
+{
+    struct its_txn_t *txn = NULL;
+    struct its_txn_t *idlest = NULL;
+    uint32_t i;
+
+    /* A client has a single open transaction */
+    if (tfm_its_txn_get(client_id) != NULL) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    for (i = 0; i < ITS_TRANSACTION_NUM_SLOTS; i++) {
+        if (!g_txn[i].active) {
+            txn = &g_txn[i];
+            break;
+        }
+
+        if ((idlest == NULL) ||
+            ((g_txn_clock - g_txn[i].stamp) > (g_txn_clock - idlest->stamp))) {
+            idlest = &g_txn[i];
+        }
+    }
+
+    /* When all the slots are in use, the transaction left idle the longest
+     * is aborted if its client has sent no request for a while, so that a
+     * client which never commits does not lock the other ones out.
+     */
+    if (txn == NULL) {
+        if ((ITS_TRANSACTION_TIMEOUT == 0) ||
+            ((g_txn_clock - idlest->stamp) < ITS_TRANSACTION_TIMEOUT)) {
+            return PSA_ERROR_BAD_STATE;
+        }
+        txn = idlest;
+    }
+
+    txn->active = true;
+    txn->client_id = client_id;
+    txn->stamp = g_txn_clock;
+    txn->num_ops = 0;
+    txn->data_used = 0;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Gets the open transaction of the client and sets the file id of the
+ *        uid in g_fid.
+ *
+ * \param[in]  client_id  Identifier of the asset's owner (client)
+ * \param[in]  uid        Identifier for the data
+ * \param[out] p_txn      Set to the open transaction of the client
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_txn_check(int32_t client_id, psa_storage_uid_t uid,
+                                      struct its_txn_t **p_txn)
+{
+    *p_txn = tfm_its_txn_get(client_id);
+    if (*p_txn == NULL) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    /* Check that the UID is valid */
+    if (uid == TFM_ITS_INVALID_UID) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    tfm_its_get_fid(client_id, uid, g_fid);
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Gets the operation of the transaction for the file id in g_fid.
+ *        A new operation replaces the one staged before for the same file.
+ *
+ * \param[in,out] txn  The transaction
+ *
+ * \return Pointer to the operation, or NULL if the transaction is full
+ */
+static struct its_flash_fs_file_op_t *tfm_its_txn_add_op(struct its_txn_t *txn)
+{
+    uint32_t i;
+
+    for (i = 0; i < txn->num_ops; i++) {
+        if (memcmp(txn->fid[i], g_fid, ITS_FILE_ID_SIZE) == 0) {
+            break;
+        }
+    }
+
+    if (i == ITS_TRANSACTION_MAX_OPS) {
+        return NULL;
+    }
+
+    if (i == txn->num_ops) {
+        memcpy(txn->fid[i], g_fid, ITS_FILE_ID_SIZE);
+        txn->num_ops++;
+    }
+
+    txn->ops[i] = (struct its_flash_fs_file_op_t){ .fid = txn->fid[i] };
+
+    return &txn->ops[i];
+}
+
+psa_status_t tfm_its_txn_set(int32_t client_id,
+                             psa_storage_uid_t uid,
+                             size_t data_length,
+                             psa_storage_create_flags_t create_flags)
+{
+    struct its_flash_fs_file_op_t *op;
+    struct its_txn_t *txn;
+    uint8_t *data;
+    size_t stored_size = data_length;
+    psa_status_t status;
+
+    status = tfm_its_txn_check(client_id, uid, &txn);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    data = &txn_data[txn - g_txn][txn->data_used];
+
+    /* Check that the create_flags does not contain any unsupported flags */
+    if (create_flags & ~(PSA_STORAGE_FLAG_WRITE_ONCE |
+                         PSA_STORAGE_FLAG_NO_CONFIDENTIALITY |
+                         PSA_STORAGE_FLAG_NO_REPLAY_PROTECTION)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+#ifdef ITS_ENCRYPTION
+    status = buffer_size_check(client_id, data_length);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+#if defined(ITS_ENCRYPTION) && ITS_ENCRYPTION_CHUNK_SIZE
+    /* An encrypted file also stores a header and the nonce and tag of each
+     * chunk
+     */
+    if (tfm_its_is_encrypted(client_id)) {
+        stored_size = ITS_ENC_STORED_SIZE(data_length);
+    }
+#endif
+
+    if (stored_size > (sizeof(txn_data[0]) - txn->data_used)) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    g_file_info = (struct its_flash_fs_file_info_t){0};
+    g_file_info.size_current = stored_size;
+    g_file_info.flags = (uint32_t)create_flags |
+                        ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE;
+
+#if defined(ITS_ENCRYPTION) && ITS_ENCRYPTION_CHUNK_SIZE
+    if (tfm_its_is_encrypted(client_id)) {
+        status = tfm_its_read_enc_file(data_length, data);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    } else
+#endif
+    {
+        /* Read asset data from the caller */
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+        if (data_length != 0) {
+            memcpy(data, its_req_mngr_get_vec_base(), data_length);
+        }
+#else
+        (void)its_req_mngr_read(data, data_length);
+#endif
+
+#if defined(ITS_ENCRYPTION) && !ITS_ENCRYPTION_CHUNK_SIZE
+        {
+            uint8_t *buffer_ptr = data;
+
+            status = tfm_its_crypt_data(client_id, &buffer_ptr, data_length,
+                                        0);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+
+            if (buffer_ptr != data) {
+                memcpy(data, buffer_ptr, data_length);
+            }
+        }
+#endif
+    }
+
+    op = tfm_its_txn_add_op(txn);
+    if (op == NULL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    op->data = data;
+    op->finfo = g_file_info;
+    txn->data_used += ITS_UTILS_ALIGN(stored_size, ITS_FLASH_MAX_ALIGNMENT);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_its_txn_remove(int32_t client_id, psa_storage_uid_t uid)
+{
+    struct its_flash_fs_file_op_t *op;
+    struct its_txn_t *txn;
+    psa_status_t status;
+
+    status = tfm_its_txn_check(client_id, uid, &txn);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    op = tfm_its_txn_add_op(txn);
+    if (op == NULL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    op->remove = true;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_its_txn_commit(int32_t client_id)
+{
+    struct its_txn_t *txn = tfm_its_txn_get(client_id);
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t i;
+
+    if (txn == NULL) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    /* The transaction is closed whatever the result of the commit */
+    txn->active = false;
+
+    /* Objects created with the write once flag cannot be modified or
+     * deleted.
+     */
+    for (i = 0; i < txn->num_ops; i++) {
+        status = its_flash_fs_file_get_info(get_fs_ctx(client_id),
+                                            txn->fid[i], &g_file_info);
+        if (status == PSA_SUCCESS) {
+            if (g_file_info.flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+                return PSA_ERROR_NOT_PERMITTED;
+            }
+        } else if (status != PSA_ERROR_DOES_NOT_EXIST) {
+            return status;
+        }
+    }
+
+    if (txn->num_ops == 0) {
+        return PSA_SUCCESS;
+    }
+
+    /* All the changes are applied with a single update of the metadata */
+    return its_flash_fs_file_write_batch(get_fs_ctx(client_id), txn->ops,
+                                         txn->num_ops);
+}
+
+psa_status_t tfm_its_txn_abort(int32_t client_id)
+{
+    struct its_txn_t *txn = tfm_its_txn_get(client_id);
+
+    if (txn == NULL) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    txn->active = false;
+
+    return PSA_SUCCESS;
+}
+#endif /* ITS_TRANSACTION_MAX_OPS && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
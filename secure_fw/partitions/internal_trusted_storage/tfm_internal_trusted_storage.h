@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,11 +12,13 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "config_tfm.h"
 #include "psa/error.h"
 #include "psa/storage_common.h"
 
 #include "flash_fs/its_flash_fs.h"
 #include "its_utils.h"
+#include "tfm_its_wear_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -163,6 +165,142 @@ psa_status_t tfm_its_get_info(int32_t client_id, psa_storage_uid_t uid,
  */
 psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid);
 
+#if ITS_WEAR_LEVELING_THRESHOLD
+/**
+ * \brief Gets the erase statistics of the blocks of the filesystem which
+ *        stores the client's data
+ *
+ * \param[in]  client_id  Identifier of the client
+ * \param[out] p_stats    A pointer to the erase statistics
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS              The operation completed successfully
+ * \retval PSA_ERROR_NOT_SUPPORTED  The erases of the blocks are not counted
+ */
+psa_status_t tfm_its_wear_stats(int32_t client_id,
+                                struct tfm_its_wear_stats_t *p_stats);
+#endif
+
+#if ITS_DEFERRED_COMPACTION
+/**
+ * \brief Removes one deleted file from the ITS filesystem, or from the PS
+ *        filesystem once the ITS one has none left, compacting its data block
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS               A deleted file has been removed
+ * \retval PSA_ERROR_DOES_NOT_EXIST  There is no deleted file left to remove
+ */
+psa_status_t tfm_its_compact(void);
+#endif
+
+#if ITS_TRANSACTION_MAX_OPS
+/**
+ * \brief Opens a transaction for the client
+ *
+ * The changes staged with \ref tfm_its_txn_set and \ref tfm_its_txn_remove
+ * are only applied by \ref tfm_its_txn_commit, all together. Each client can
+ * have one open transaction, in one of ITS_TRANSACTION_NUM_SLOTS slots. When
+ * all the slots are in use, the transaction whose client has sent no
+ * transaction request for ITS_TRANSACTION_TIMEOUT requests is aborted.
+ *
+ * \param[in] client_id  Identifier of the client
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS          The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE  The operation failed because the client has a
+ *                              transaction open already, or no slot is free
+ */
+psa_status_t tfm_its_txn_begin(int32_t client_id);
+
+/**
+ * \brief Stages the creation or modification of a uid/value pair in the open
+ *        transaction of the client
+ *
+ * The data is copied when the change is staged. A change staged for a uid
+ * replaces the change staged before for the same uid.
+ *
+ * \param[in] client_id     Identifier of the asset's owner (client)
+ * \param[in] uid           The identifier for the data
+ * \param[in] data_length   The size in bytes of the data in `p_data`
+ * \param[in] create_flags  The flags that the data will be stored with
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                    The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE            The client has no open transaction
+ * \retval PSA_ERROR_NOT_SUPPORTED        One or more of the flags provided in
+ *                                        `create_flags` is not supported or
+ *                                        is not valid
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The transaction has no room left for
+ *                                        the change
+ * \retval PSA_ERROR_INVALID_ARGUMENT     One of the arguments is invalid
+ */
+psa_status_t tfm_its_txn_set(int32_t client_id,
+                             psa_storage_uid_t uid,
+                             size_t data_length,
+                             psa_storage_create_flags_t create_flags);
+
+/**
+ * \brief Stages the removal of a uid and its associated data in the open
+ *        transaction of the client
+ *
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ * \param[in] uid        The `uid` value
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                    The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE            The client has no open transaction
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  The transaction has no room left for
+ *                                        the change
+ * \retval PSA_ERROR_INVALID_ARGUMENT     The `uid` value is invalid
+ */
+psa_status_t tfm_its_txn_remove(int32_t client_id, psa_storage_uid_t uid);
+
+/**
+ * \brief Applies all the changes of the open transaction of the client with a
+ *        single update of the filesystem metadata, and closes the transaction
+ *
+ * Either all or none of the changes are applied, including after a power
+ * failure. The transaction is closed whatever the result.
+ *
+ * \param[in] client_id  Identifier of the client
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                     The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE             The client has no open transaction
+ * \retval PSA_ERROR_DOES_NOT_EXIST        A uid to remove was not found in the
+ *                                         storage
+ * \retval PSA_ERROR_NOT_PERMITTED         A uid to modify or remove was
+ *                                         created with
+ *                                         PSA_STORAGE_FLAG_WRITE_ONCE
+ * \retval PSA_ERROR_INSUFFICIENT_STORAGE  There was insufficient space on the
+ *                                         storage medium, or the changes
+ *                                         touch more data blocks than can be
+ *                                         updated at once
+ * \retval PSA_ERROR_STORAGE_FAILURE       The physical storage has failed
+ *                                         (Fatal error)
+ */
+psa_status_t tfm_its_txn_commit(int32_t client_id);
+
+/**
+ * \brief Discards the changes of the open transaction of the client and
+ *        closes it
+ *
+ * \param[in] client_id  Identifier of the client
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS          The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE  The client has no open transaction
+ */
+psa_status_t tfm_its_txn_abort(int32_t client_id);
+#endif /* ITS_TRANSACTION_MAX_OPS */
+
 #ifdef __cplusplus
 }
 #endif
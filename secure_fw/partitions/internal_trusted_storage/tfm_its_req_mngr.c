@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -25,31 +25,29 @@ static uint8_t *p_data;
 static psa_handle_t handle;
 #endif
 
-static psa_status_t tfm_its_set_req(const psa_msg_t *msg)
+static psa_status_t tfm_its_read_set_args(const psa_msg_t *msg,
+                                          psa_storage_uid_t *uid,
+                                          psa_storage_create_flags_t *create_flags)
 {
-    psa_storage_uid_t uid;
-    psa_storage_create_flags_t create_flags;
     size_t num;
-    size_t data_length;
 
-    if ((msg->in_size[0] != sizeof(uid)) ||
-        (msg->in_size[2] != sizeof(create_flags))) {
+    if ((msg->in_size[0] != sizeof(*uid)) ||
+        (msg->in_size[2] != sizeof(*create_flags))) {
         /* The size of one of the arguments is incorrect */
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    num = psa_read(msg->handle, 0, &uid, sizeof(uid));
-    if (num != sizeof(uid)) {
+    num = psa_read(msg->handle, 0, uid, sizeof(*uid));
+    if (num != sizeof(*uid)) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    num = psa_read(msg->handle, 2, &create_flags, sizeof(create_flags));
-    if (num != sizeof(create_flags)) {
+    num = psa_read(msg->handle, 2, create_flags, sizeof(*create_flags));
+    if (num != sizeof(*create_flags)) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
-    data_length = msg->in_size[1];
 #if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
-    if (data_length) {
+    if (msg->in_size[1]) {
         p_data = (uint8_t *)psa_map_invec(msg->handle, 1);
     } else {
         p_data = NULL;
@@ -57,7 +55,21 @@ static psa_status_t tfm_its_set_req(const psa_msg_t *msg)
 #else
     handle = msg->handle;
 #endif
-    return tfm_its_set(msg->client_id, uid, data_length, create_flags);
+    return PSA_SUCCESS;
+}
+
+static psa_status_t tfm_its_set_req(const psa_msg_t *msg)
+{
+    psa_storage_uid_t uid;
+    psa_storage_create_flags_t create_flags;
+    psa_status_t status;
+
+    status = tfm_its_read_set_args(msg, &uid, &create_flags);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    return tfm_its_set(msg->client_id, uid, msg->in_size[1], create_flags);
 }
 
 static psa_status_t tfm_its_get_req(const psa_msg_t *msg)
@@ -147,6 +159,60 @@ static psa_status_t tfm_its_remove_req(const psa_msg_t *msg)
     return tfm_its_remove(msg->client_id, uid);
 }
 
+#if ITS_TRANSACTION_MAX_OPS
+static psa_status_t tfm_its_txn_set_req(const psa_msg_t *msg)
+{
+    psa_storage_uid_t uid;
+    psa_storage_create_flags_t create_flags;
+    psa_status_t status;
+
+    status = tfm_its_read_set_args(msg, &uid, &create_flags);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    return tfm_its_txn_set(msg->client_id, uid, msg->in_size[1], create_flags);
+}
+
+static psa_status_t tfm_its_txn_remove_req(const psa_msg_t *msg)
+{
+    psa_storage_uid_t uid;
+    size_t num;
+
+    if (msg->in_size[0] != sizeof(uid)) {
+        /* The input argument size is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg->handle, 0, &uid, sizeof(uid));
+    if (num != sizeof(uid)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return tfm_its_txn_remove(msg->client_id, uid);
+}
+#endif /* ITS_TRANSACTION_MAX_OPS */
+
+#if ITS_WEAR_LEVELING_THRESHOLD
+static psa_status_t tfm_its_wear_stats_req(const psa_msg_t *msg)
+{
+    struct tfm_its_wear_stats_t stats;
+    psa_status_t status;
+
+    if (msg->out_size[0] != sizeof(stats)) {
+        /* The output argument size is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    status = tfm_its_wear_stats(msg->client_id, &stats);
+    if (status == PSA_SUCCESS) {
+        psa_write(msg->handle, 0, &stats, sizeof(stats));
+    }
+
+    return status;
+}
+#endif /* ITS_WEAR_LEVELING_THRESHOLD */
+
 psa_status_t tfm_its_entry(void)
 {
     return tfm_its_init();
@@ -163,6 +229,26 @@ psa_status_t tfm_internal_trusted_storage_service_sfn(const psa_msg_t *msg)
         return tfm_its_get_info_req(msg);
     case TFM_ITS_REMOVE:
         return tfm_its_remove_req(msg);
+#if ITS_TRANSACTION_MAX_OPS
+    case TFM_ITS_TRANSACTION_BEGIN:
+        return tfm_its_txn_begin(msg->client_id);
+    case TFM_ITS_TRANSACTION_SET:
+        return tfm_its_txn_set_req(msg);
+    case TFM_ITS_TRANSACTION_REMOVE:
+        return tfm_its_txn_remove_req(msg);
+    case TFM_ITS_TRANSACTION_COMMIT:
+        return tfm_its_txn_commit(msg->client_id);
+    case TFM_ITS_TRANSACTION_ABORT:
+        return tfm_its_txn_abort(msg->client_id);
+#endif
+#if ITS_WEAR_LEVELING_THRESHOLD
+    case TFM_ITS_WEAR_STATS:
+        return tfm_its_wear_stats_req(msg);
+#endif
+#if ITS_DEFERRED_COMPACTION
+    case TFM_ITS_COMPACT_STEP:
+        return tfm_its_compact();
+#endif
     default:
         return PSA_ERROR_NOT_SUPPORTED;
     }
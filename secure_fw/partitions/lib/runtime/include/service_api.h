@@ -8,6 +8,7 @@
 #define __SERVICE_API_H__
 
 #include <stdint.h>
+#include "config_tfm.h"
 #include "tfm_boot_status.h"
 #include "psa/error.h"
 
@@ -23,4 +24,19 @@ psa_status_t tfm_core_get_boot_data(uint8_t major_type,
                                     struct tfm_boot_data *boot_data,
                                     uint32_t len);
 
+#if CONFIG_TFM_SPM_TRACE == 1
+/**
+ * \brief Move the pending SPM trace records to a partition buffer.
+ *
+ * \note Only PSA RoT partitions are allowed to drain the trace.
+ *
+ * \param[out] buf         Buffer receiving the records.
+ * \param[in]  len         Size of the buffer in bytes.
+ *
+ * \retval >=0             Number of bytes written to the buffer.
+ * \retval <0              The caller is not allowed to drain the trace.
+ */
+int32_t tfm_spm_trace_drain(void *buf, uint32_t len);
+#endif
+
 #endif /* __SERVICE_API_H__ */
@@ -6,6 +6,7 @@
  */
 
 #include "cmsis_compiler.h"
+#include "config_tfm.h"
 #include "service_api.h"
 #include "psa/service.h"
 #include "svc_num.h"
@@ -22,6 +23,17 @@ psa_status_t tfm_core_get_boot_data(uint8_t major_type,
         );
 }
 
+#if CONFIG_TFM_SPM_TRACE == 1
+__attribute__((naked))
+int32_t tfm_spm_trace_drain(void *buf, uint32_t len)
+{
+    __ASM volatile(
+        "SVC    "M2S(TFM_SVC_GET_SPM_TRACE)"               \n"
+        "BX     lr                                         \n"
+        );
+}
+#endif /* CONFIG_TFM_SPM_TRACE == 1 */
+
 #if TFM_ISOLATION_LEVEL != 1
 /* Entry point when Partition FLIH functions return */
 __attribute__((naked))
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2021-2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -52,33 +52,120 @@ struct vectors {
     size_t out_len;
     bool in_use;
 };
-static struct vectors vectors[NUM_MAILBOX_QUEUE_SLOT] = {0};
+static struct vectors vectors[NUM_SPE_MAILBOX_QUEUE_SLOT] = {0};
+
+/*
+ * Set when a pending NSPE message is left unhandled because all the SPE slots
+ * are in use. The message is handled again once an SPE slot is freed.
+ */
+static bool mailbox_msg_deferred;
 
 
 __STATIC_INLINE void set_spe_queue_empty_status(uint8_t idx)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        spe_mailbox_queue.empty_slots |= (1 << idx);
+    if (idx < NUM_SPE_MAILBOX_QUEUE_SLOT) {
+        spe_mailbox_queue.empty_slots[idx / 32] |= (1UL << (idx % 32));
     }
 }
 
 __STATIC_INLINE void clear_spe_queue_empty_status(uint8_t idx)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        spe_mailbox_queue.empty_slots &= ~(1 << idx);
+    if (idx < NUM_SPE_MAILBOX_QUEUE_SLOT) {
+        spe_mailbox_queue.empty_slots[idx / 32] &= ~(1UL << (idx % 32));
     }
 }
 
 __STATIC_INLINE bool get_spe_queue_empty_status(uint8_t idx)
 {
-    if ((idx < NUM_MAILBOX_QUEUE_SLOT) &&
-        (spe_mailbox_queue.empty_slots & (1 << idx))) {
+    if ((idx < NUM_SPE_MAILBOX_QUEUE_SLOT) &&
+        (spe_mailbox_queue.empty_slots[idx / 32] & (1UL << (idx % 32)))) {
         return true;
     }
 
     return false;
 }
 
+/*
+ * Allocate the lowest empty SPE mailbox queue slot.
+ * Return NUM_SPE_MAILBOX_QUEUE_SLOT if all the slots are in use.
+ */
+__STATIC_INLINE uint8_t alloc_spe_queue_slot(void)
+{
+    mailbox_queue_status_t empty;
+    uint8_t idx;
+    uint32_t i;
+
+    for (i = 0; i < MAILBOX_EMPTY_STATUS_WORDS; i++) {
+        empty = spe_mailbox_queue.empty_slots[i];
+        if (empty) {
+            idx = (uint8_t)(i * 32 + __CLZ(__RBIT(empty)));
+            clear_spe_queue_empty_status(idx);
+            return idx;
+        }
+    }
+
+    return NUM_SPE_MAILBOX_QUEUE_SLOT;
+}
+
+#ifdef MAILBOX_RING_TRANSPORT
+__STATIC_INLINE uint32_t get_nspe_req_head(
+                                    const struct mailbox_status_t *ns_status)
+{
+    uint32_t head;
+
+    MAILBOX_INVALIDATE_CACHE(&ns_status->req_head, sizeof(ns_status->req_head));
+    head = ns_status->req_head.val;
+
+    /* Request entries are read only after the head index is observed */
+    __DMB();
+
+    return head;
+}
+
+__STATIC_INLINE uint8_t get_nspe_req_entry(
+                                    const struct mailbox_status_t *ns_status,
+                                    uint32_t pos)
+{
+    const uint8_t *entry = &ns_status->req[MAILBOX_RING_ENTRY(pos)];
+
+    MAILBOX_INVALIDATE_CACHE(entry, sizeof(*entry));
+    return *entry;
+}
+
+__STATIC_INLINE void set_nspe_req_tail(struct mailbox_status_t *ns_status,
+                                       uint32_t tail)
+{
+    ns_status->req_tail.val = tail;
+    MAILBOX_CLEAN_CACHE(&ns_status->req_tail, sizeof(ns_status->req_tail));
+}
+
+/*
+ * Write a completion entry. NSPE cannot observe it until the head index is
+ * published by publish_nspe_cpl_head().
+ * An NSPE slot has at most one request or completion entry in flight, so the
+ * completion ring cannot be overrun by a well-behaved NSPE. A misbehaving
+ * NSPE can only lose its own replies.
+ */
+__STATIC_INLINE void push_nspe_cpl_entry(struct mailbox_status_t *ns_status,
+                                         uint8_t idx)
+{
+    uint8_t *entry = &ns_status->cpl[MAILBOX_RING_ENTRY(
+                                                spe_mailbox_queue.cpl_head)];
+
+    *entry = idx;
+    MAILBOX_CLEAN_CACHE(entry, sizeof(*entry));
+    spe_mailbox_queue.cpl_head = MAILBOX_RING_NEXT(spe_mailbox_queue.cpl_head);
+}
+
+__STATIC_INLINE void publish_nspe_cpl_head(struct mailbox_status_t *ns_status)
+{
+    /* Completion entries must be visible before the head index */
+    __DMB();
+
+    ns_status->cpl_head.val = spe_mailbox_queue.cpl_head;
+    MAILBOX_CLEAN_CACHE(&ns_status->cpl_head, sizeof(ns_status->cpl_head));
+}
+#else /* MAILBOX_RING_TRANSPORT */
 __STATIC_INLINE mailbox_queue_status_t get_nspe_queue_pend_status(
                                     const struct mailbox_status_t *ns_status)
 {
@@ -103,11 +190,27 @@ __STATIC_INLINE void clear_nspe_queue_pend_status(
     ns_status->pend_slots &= ~mask;
     MAILBOX_CLEAN_CACHE(ns_status, sizeof(*ns_status));
 }
+#endif /* MAILBOX_RING_TRANSPORT */
+
+/*
+ * Record a synchronous reply in reply_slots. NSPE is notified once, after
+ * all the pending mailbox messages are handled.
+ */
+__STATIC_INLINE void mark_nspe_slot_replied(mailbox_queue_status_t *reply_slots,
+                                            uint8_t idx)
+{
+#ifdef MAILBOX_RING_TRANSPORT
+    push_nspe_cpl_entry(spe_mailbox_queue.ns_status, idx);
+    *reply_slots = 1;
+#else
+    *reply_slots |= (1 << idx);
+#endif
+}
 
 __STATIC_INLINE int32_t get_spe_mailbox_msg_handle(uint8_t idx,
                                                    mailbox_msg_handle_t *handle)
 {
-    if ((idx >= NUM_MAILBOX_QUEUE_SLOT) || !handle) {
+    if ((idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) || !handle) {
         return MAILBOX_INVAL_PARAMS;
     }
 
@@ -130,7 +233,7 @@ __STATIC_INLINE int32_t get_spe_mailbox_msg_idx(mailbox_msg_handle_t handle,
 
 static void mailbox_clean_queue_slot(uint8_t idx)
 {
-    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+    if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
         return;
     }
 
@@ -143,7 +246,7 @@ __STATIC_INLINE struct mailbox_reply_t *get_nspe_reply_addr(uint8_t idx)
 {
     uint8_t ns_slot_idx;
 
-    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+    if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
         psa_panic();
     }
 
@@ -242,7 +345,8 @@ static int local_copy_vects(const struct psa_client_params_t *params,
 }
 
 /* Passes the request from the mailbox message into SPM.
- * idx indicates the slot used to use for any immediate reply.
+ * idx indicates the SPE slot holding the message. Any immediate reply goes to
+ * the NSPE slot it was copied from.
  * If it queues the reply immediately, updates reply_slots accordingly.
  */
 static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
@@ -255,6 +359,7 @@ static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
                                   params->psa_call_params.in_len,
                                   params->psa_call_params.out_len);
     int32_t client_id;
+    uint8_t ns_slot_idx = spe_mailbox_queue.queue[idx].ns_slot_idx;
     psa_status_t psa_ret = PSA_ERROR_GENERIC_ERROR;
     mailbox_msg_handle_t *mb_msg_handle =
         &spe_mailbox_queue.queue[idx].msg_handle;
@@ -346,23 +451,121 @@ static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
 
     /* Any synchronous result should be returned immediately */
     if (sync) {
-        *reply_slots |= (1 << idx);
         mailbox_direct_reply(idx, (uint32_t)psa_ret);
+        mark_nspe_slot_replied(reply_slots, ns_slot_idx);
     }
 
     return MAILBOX_SUCCESS;
 }
 
+/*
+ * Copy the mailbox message in NSPE slot ns_slot_idx into an empty SPE slot and
+ * pass it into SPM.
+ * Return false if all the SPE slots are in use. The message is left pending.
+ */
+static bool mailbox_handle_slot(uint8_t ns_slot_idx,
+                                mailbox_queue_status_t *reply_slots)
+{
+    struct mailbox_msg_t *msg_ptr;
+    uint8_t idx;
+
+    idx = alloc_spe_queue_slot();
+    if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
+        mailbox_msg_deferred = true;
+        return false;
+    }
+
+    spe_mailbox_queue.queue[idx].ns_slot_idx = ns_slot_idx;
+
+    msg_ptr = &spe_mailbox_queue.queue[idx].msg;
+    MAILBOX_INVALIDATE_CACHE(&spe_mailbox_queue.ns_slots[ns_slot_idx].msg,
+                             sizeof(*msg_ptr));
+    spm_memcpy(msg_ptr, &spe_mailbox_queue.ns_slots[ns_slot_idx].msg,
+               sizeof(*msg_ptr));
+
+    if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return true;
+    }
+
+    get_spe_mailbox_msg_handle(idx,
+                               &spe_mailbox_queue.queue[idx].msg_handle);
+
+    if (tfm_mailbox_dispatch(msg_ptr, idx, reply_slots) != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+    }
+
+    return true;
+}
+
+#ifdef MAILBOX_RING_TRANSPORT
+int32_t tfm_mailbox_handle_msg(void)
+{
+    uint8_t idx;
+    uint32_t head, tail;
+    mailbox_queue_status_t reply_slots = 0;
+    struct mailbox_status_t *ns_status = spe_mailbox_queue.ns_status;
+
+    SPM_ASSERT(ns_status != NULL);
+
+    mailbox_msg_deferred = false;
+
+    head = get_nspe_req_head(ns_status);
+    tail = spe_mailbox_queue.req_tail;
+
+    /* Check if NSPE mailbox did assert a PSA client call request */
+    if (head == tail) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
+    /* NSPE cannot have more requests in flight than it has slots */
+    if ((head >= MAILBOX_RING_IDX_WRAP) ||
+        (MAILBOX_RING_COUNT(head, tail) > spe_mailbox_queue.ns_slot_count)) {
+        spe_mailbox_queue.req_tail = head;
+        set_nspe_req_tail(ns_status, head);
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    for (; tail != head; tail = MAILBOX_RING_NEXT(tail)) {
+        idx = get_nspe_req_entry(ns_status, tail);
+
+        /* Skip invalid slots */
+        if ((idx >= NUM_MAILBOX_QUEUE_SLOT) ||
+            (idx >= spe_mailbox_queue.ns_slot_count)) {
+            continue;
+        }
+
+        /* Stop at the first message which cannot be handled yet */
+        if (!mailbox_handle_slot(idx, &reply_slots)) {
+            break;
+        }
+    }
+
+    /* Return the consumed request entries to NSPE */
+    spe_mailbox_queue.req_tail = tail;
+    set_nspe_req_tail(ns_status, tail);
+
+    /* A single notification for all the synchronous replies */
+    if (reply_slots) {
+        publish_nspe_cpl_head(ns_status);
+        tfm_mailbox_hal_notify_peer();
+    }
+
+    return MAILBOX_SUCCESS;
+}
+#else /* MAILBOX_RING_TRANSPORT */
 int32_t tfm_mailbox_handle_msg(void)
 {
     uint8_t idx;
     mailbox_queue_status_t mask_bits, pend_slots, reply_slots = 0;
+    mailbox_queue_status_t handled_slots = 0;
     struct mailbox_status_t *ns_status = spe_mailbox_queue.ns_status;
-    struct mailbox_msg_t *msg_ptr;
     uint32_t critical_section;
 
     SPM_ASSERT(ns_status != NULL);
 
+    mailbox_msg_deferred = false;
+
     critical_section = tfm_mailbox_hal_enter_critical();
 
     pend_slots = get_nspe_queue_pend_status(ns_status);
@@ -381,38 +584,18 @@ int32_t tfm_mailbox_handle_msg(void)
             continue;
         }
 
-        /*
-         * TODO
-         * The operations are simplified here. Use the SPE mailbox queue
-         * slot with the same idx as that of the NSPE mailbox queue slot.
-         * A more general implementation should dynamically search and
-         * select an empty SPE mailbox queue slot.
-         */
-        clear_spe_queue_empty_status(idx);
-        spe_mailbox_queue.queue[idx].ns_slot_idx = idx;
-
-        msg_ptr = &spe_mailbox_queue.queue[idx].msg;
-        MAILBOX_INVALIDATE_CACHE(&spe_mailbox_queue.ns_slots[idx].msg, sizeof(*msg_ptr));
-        spm_memcpy(msg_ptr, &spe_mailbox_queue.ns_slots[idx].msg, sizeof(*msg_ptr));
-
-        if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
+        /* Leave the remaining messages pending if no SPE slot is left */
+        if (!mailbox_handle_slot(idx, &reply_slots)) {
+            break;
         }
 
-        get_spe_mailbox_msg_handle(idx,
-                                   &spe_mailbox_queue.queue[idx].msg_handle);
-
-        if (tfm_mailbox_dispatch(msg_ptr, idx, &reply_slots) != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
-        }
+        handled_slots |= mask_bits;
     }
 
     critical_section = tfm_mailbox_hal_enter_critical();
 
-    /* Clean the NSPE mailbox pending status. */
-    clear_nspe_queue_pend_status(ns_status, pend_slots);
+    /* Clean the NSPE mailbox pending status of the handled messages. */
+    clear_nspe_queue_pend_status(ns_status, handled_slots);
 
     /* Set the NSPE mailbox replied status */
     set_nspe_queue_replied_status(ns_status, reply_slots);
@@ -425,12 +608,15 @@ int32_t tfm_mailbox_handle_msg(void)
 
     return MAILBOX_SUCCESS;
 }
+#endif /* MAILBOX_RING_TRANSPORT */
 
 int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
 {
-    uint8_t idx;
+    uint8_t idx, ns_slot_idx;
     int32_t ret;
+#ifndef MAILBOX_RING_TRANSPORT
     uint32_t critical_section;
+#endif
     struct mailbox_status_t *ns_status = spe_mailbox_queue.ns_status;
 
     SPM_ASSERT(ns_status != NULL);
@@ -454,17 +640,33 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
         return MAILBOX_NO_PEND_EVENT;
     }
 
+    ns_slot_idx = spe_mailbox_queue.queue[idx].ns_slot_idx;
+
     mailbox_direct_reply(idx, (uint32_t)reply);
 
+#ifdef MAILBOX_RING_TRANSPORT
+    /*
+     * Requests are handled and replied in the mailbox agent thread only, so
+     * SPE is the single producer of the completion ring.
+     */
+    push_nspe_cpl_entry(ns_status, ns_slot_idx);
+    publish_nspe_cpl_head(ns_status);
+#else
     critical_section = tfm_mailbox_hal_enter_critical();
 
     /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_status, (1 << idx));
+    set_nspe_queue_replied_status(ns_status, (1 << ns_slot_idx));
 
     tfm_mailbox_hal_exit_critical(critical_section);
+#endif
 
     tfm_mailbox_hal_notify_peer();
 
+    /* An SPE slot is freed. Handle the messages left pending. */
+    if (mailbox_msg_deferred) {
+        (void)tfm_mailbox_handle_msg();
+    }
+
     return MAILBOX_SUCCESS;
 }
 
@@ -496,13 +698,13 @@ static const struct tfm_rpc_ops_t mailbox_rpc_ops = {
 static int32_t tfm_mailbox_init(void)
 {
     int32_t ret;
+    uint8_t idx;
 
     spm_memset(&spe_mailbox_queue, 0, sizeof(spe_mailbox_queue));
 
-    spe_mailbox_queue.empty_slots =
-            (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
-    spe_mailbox_queue.empty_slots +=
-            (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+    for (idx = 0; idx < NUM_SPE_MAILBOX_QUEUE_SLOT; idx++) {
+        set_spe_queue_empty_status(idx);
+    }
 
     /* Register RPC callbacks */
     ret = tfm_rpc_register_ops(&mailbox_rpc_ops);
@@ -10,6 +10,7 @@
 #include "config_impl.h"
 #include "security_defs.h"
 #include "tfm_arch.h"
+#include "tfm_psa_call_batch.h"
 #include "tfm_psa_call_pack.h"
 
 #include "psa/client.h"
@@ -70,6 +71,24 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
     return ret;
 }
 
+psa_status_t tfm_psa_call_batch_ns(struct tfm_psa_call_desc_t *descs,
+                                   uint32_t num);
+
+__tz_c_veneer
+psa_status_t tfm_psa_call_batch_veneer(struct tfm_psa_call_desc_t *descs,
+                                       uint32_t num)
+{
+    psa_status_t ret;
+#if CONFIG_TFM_SECURE_THREAD_MASK_NS_INTERRUPT == 1
+    __set_BASEPRI(SECURE_THREAD_EXECUTION_PRIORITY);
+#endif
+    ret = tfm_psa_call_batch_ns(descs, num);
+#if CONFIG_TFM_SECURE_THREAD_MASK_NS_INTERRUPT == 1
+    __set_BASEPRI(0);
+#endif
+    return ret;
+}
+
 /* Following veneers are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
 __tz_c_veneer
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,6 +12,7 @@
 #include "config_impl.h"
 #include "security_defs.h"
 #include "svc_num.h"
+#include "tfm_psa_call_batch.h"
 #include "tfm_psa_call_pack.h"
 #include "utilities.h"
 #include "psa/client.h"
@@ -34,12 +35,17 @@
  *   explicitly clean up the context.
  */
 
+/* Processes the requests of tfm_psa_call_batch_veneer() */
+psa_status_t tfm_psa_call_batch_ns(struct tfm_psa_call_desc_t *descs,
+                                   uint32_t num);
+
 #if defined(__ICCARM__)
 
 #pragma required = psa_framework_version
 #pragma required = psa_panic
 #pragma required = psa_version
 #pragma required = tfm_psa_call_pack
+#pragma required = tfm_psa_call_batch_ns
 /* Following PSA APIs are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
 #pragma required = psa_connect
@@ -179,6 +185,37 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
     );
 }
 
+__tz_naked_veneer
+psa_status_t tfm_psa_call_batch_veneer(struct tfm_psa_call_desc_t *descs,
+                                       uint32_t num)
+{
+    __ASM volatile(
+        SYNTAX_UNIFIED
+#if CONFIG_TFM_SECURE_THREAD_MASK_NS_INTERRUPT == 1
+        "   ldr    r2, ="M2S(SECURE_THREAD_EXECUTION_PRIORITY)"\n"
+        "   msr    basepri, r2                                \n"
+#endif
+        "   ldr    r2, [sp]                                   \n"
+        "   ldr    r3, ="M2S(STACK_SEAL_PATTERN)"             \n"
+        "   cmp    r2, r3                                     \n"
+        "   bne    reent_panic6                               \n"
+        "   push   {r4, lr}                                   \n"
+        "   bl     "M2S(tfm_psa_call_batch_ns)"               \n"
+        "   bl     clear_caller_context                       \n"
+        "   pop    {r1, r2}                                   \n"
+        "   mov    lr, r2                                     \n"
+        "   mov    r4, r1                                     \n"
+#if CONFIG_TFM_SECURE_THREAD_MASK_NS_INTERRUPT == 1
+        "   ldr    r1, =0x00                                  \n"
+        "   msr    basepri, r1                                \n"
+#endif
+        "   bxns   lr                                         \n"
+
+        "reent_panic6:                                        \n"
+        "   bl     psa_panic                                  \n"
+    );
+}
+
 /* Following veneers are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
 
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <arm_cmse.h>
+#include <stdint.h>
+
+#include "compiler_ext_defs.h"
+#include "tfm_arch.h"
+#include "tfm_psa_call_batch.h"
+#include "tfm_psa_call_pack.h"
+
+#include "psa/client.h"
+
+/*
+ * Process a batch of Non-secure psa_call() requests on behalf of
+ * tfm_psa_call_batch_veneer(). The veneer crossing is paid once, each request
+ * then enters SPM through tfm_psa_call_pack() as a regular call would.
+ */
+__used psa_status_t tfm_psa_call_batch_ns(struct tfm_psa_call_desc_t *descs,
+                                          uint32_t num)
+{
+    struct tfm_psa_call_desc_t desc;
+    CONTROL_Type ctrl;
+    int flags = CMSE_NONSECURE | CMSE_MPU_READWRITE;
+    uint32_t i;
+
+    if ((num == 0) || (num > TFM_PSA_CALL_BATCH_MAX_NUM)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* Check the descriptors with the privilege of the Non-secure caller */
+    ctrl.w = __TZ_get_CONTROL_NS();
+    if (ctrl.b.nPRIV == 1) {
+        flags |= CMSE_MPU_UNPRIV;
+    }
+
+    if (cmse_check_address_range((void *)descs, num * sizeof(*descs),
+                                 flags) == NULL) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    for (i = 0; i < num; i++) {
+        /* Work on a Secure copy, Non-secure code may change the original. */
+        desc = descs[i];
+
+        if ((desc.type    > PSA_CALL_TYPE_MAX) ||
+            (desc.type    < PSA_CALL_TYPE_MIN) ||
+            (desc.in_len  > PSA_MAX_IOVEC)     ||
+            (desc.out_len > PSA_MAX_IOVEC)) {
+            descs[i].status = PSA_ERROR_PROGRAMMER_ERROR;
+            continue;
+        }
+
+        descs[i].status = tfm_psa_call_pack(desc.handle,
+                                            PARAM_SET_NS_VEC(
+                                                PARAM_PACK(desc.type,
+                                                           desc.in_len,
+                                                           desc.out_len)),
+                                            desc.in_vec, desc.out_vec);
+    }
+
+    return PSA_SUCCESS;
+}
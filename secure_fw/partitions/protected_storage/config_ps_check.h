@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -24,6 +24,14 @@
 #error "Invalid config: NOT PS_ROLLBACK_PROTECTION and PS_ENCRYPTION and PSA_ALG_GCM or PSA_ALG_CCM!"
 #endif
 
+#if PS_OBJECT_SEGMENT_SIZE && (!defined(PS_ENCRYPTION))
+#error "Invalid config: PS_OBJECT_SEGMENT_SIZE and NOT PS_ENCRYPTION!"
+#endif
+
+#if PS_OBJECT_SEGMENT_SIZE && (PS_AES_KEY_USAGE_LIMIT != 0)
+#error "Invalid config: PS_OBJECT_SEGMENT_SIZE and PS_AES_KEY_USAGE_LIMIT!"
+#endif
+
 /*
  * ITS_VALIDATE_METADATA_FROM_FLASH shall be enabled when PS_VALIDATE_METADATA_FROM_FLASH is
  * enabled
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -30,6 +30,31 @@ struct ps_object_info_t {
     psa_storage_create_flags_t create_flags; /*!< Object creation flags */
 };
 
+#if PS_OBJECT_SEGMENT_SIZE
+/*!
+ * \def PS_OBJECT_MAX_SEGMENTS
+ *
+ * \brief Number of segments of the largest object. Each segment is encrypted
+ *        and stored separately, so that partial reads and writes only process
+ *        the segments they cover.
+ */
+#define PS_OBJECT_MAX_SEGMENTS ((PS_MAX_ASSET_SIZE + PS_OBJECT_SEGMENT_SIZE - 1) \
+                                / PS_OBJECT_SEGMENT_SIZE)
+
+/* Number of words of the bitmap of segment copies */
+#define PS_OBJECT_SLOT_WORDS   ((PS_OBJECT_MAX_SEGMENTS + 31) / 32)
+
+/*!
+ * \struct ps_obj_segment_t
+ *
+ * \brief Crypto metadata of an object segment.
+ */
+struct ps_obj_segment_t {
+    uint8_t iv[PS_IV_LEN_BYTES];   /*!< IV value of the segment */
+    uint8_t tag[PS_TAG_LEN_BYTES]; /*!< MAC value of the segment */
+};
+#endif /* PS_OBJECT_SEGMENT_SIZE */
+
 /*!
  * \struct ps_obj_header_t
  *
@@ -41,12 +66,27 @@ struct ps_obj_header_t {
 #else
     uint32_t version;              /*!< Object version */
     uint32_t fid;                  /*!< File ID */
+#endif
+#if PS_OBJECT_SEGMENT_SIZE
+    uint32_t slots[PS_OBJECT_SLOT_WORDS]; /*!< Bitmap of the copy in use of
+                                           *   each segment
+                                           */
 #endif
     struct ps_object_info_t info; /*!< Object information */
+#if PS_OBJECT_SEGMENT_SIZE
+    struct ps_obj_segment_t segments[PS_OBJECT_MAX_SEGMENTS]; /*!< Segments
+                                                               *   metadata
+                                                               */
+#endif
 };
 
 
+#if PS_OBJECT_SEGMENT_SIZE
+/* The object data is processed one segment at a time */
+#define PS_MAX_OBJECT_DATA_SIZE  PS_OBJECT_SEGMENT_SIZE
+#else
 #define PS_MAX_OBJECT_DATA_SIZE  PS_MAX_ASSET_SIZE
+#endif
 
 #ifdef PS_ENCRYPTION
 #define PS_OBJECT_BUF_SIZE (PS_MAX_OBJECT_DATA_SIZE + PS_TAG_LEN_BYTES)
@@ -70,6 +110,17 @@ struct ps_object_t {
 #define PS_OBJECT_HEADER_SIZE    sizeof(struct ps_obj_header_t)
 #define PS_MAX_OBJECT_SIZE       sizeof(struct ps_object_t)
 
+#if PS_OBJECT_SEGMENT_SIZE
+/*!
+ * \def PS_MAX_NUM_OBJECTS
+ *
+ * \brief Specifies the maximum number of files in the system, which is the
+ *        2 object tables plus, for each entry of the object table, 2 copies of
+ *        the object head and of each of its segments.
+ */
+#define PS_MAX_NUM_OBJECTS (((PS_NUM_ASSETS + 1) * 2 * \
+                             (PS_OBJECT_MAX_SEGMENTS + 1)) + 2)
+#else
 /*!
  * \def PS_MAX_NUM_OBJECTS
  *
@@ -78,5 +129,11 @@ struct ps_object_t {
  *        store the temporary object table and temporary updated object.
  */
 #define PS_MAX_NUM_OBJECTS (PS_NUM_ASSETS + 3)
+#endif /* PS_OBJECT_SEGMENT_SIZE */
+
+/* The filesystem indexes its files with 16 bits, 0xFFFF being invalid */
+#if (PS_MAX_NUM_OBJECTS >= 0xFFFF)
+#error "Invalid config: PS_NUM_ASSETS and PS_OBJECT_SEGMENT_SIZE need more files than the filesystem has!"
+#endif
 
 #endif /* __PS_OBJECT_DEFS_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -25,6 +25,9 @@
 #include "tfm_sp_log.h"
 #include "utilities.h"
 
+/* Objects split in segments are handled by ps_segmented_object.c */
+#if !PS_OBJECT_SEGMENT_SIZE
+
 #ifndef PS_ENCRYPTION
 /* Gets the size of object written to the object system below */
 #define PS_OBJECT_SIZE(max_size) (PS_OBJECT_HEADER_SIZE + (max_size))
@@ -758,3 +761,5 @@ psa_status_t ps_system_wipe_all(void)
      */
     return ps_object_table_create();
 }
+
+#endif /* !PS_OBJECT_SEGMENT_SIZE */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -18,6 +18,7 @@
 #include "psa_manifest/pid.h"
 #include "nv_counters/ps_nv_counters.h"
 #include "psa/internal_trusted_storage.h"
+#include "ps_object_defs.h"
 #include "ps_utils.h"
 #include "tfm_ps_defs.h"
 #include "utilities.h"
@@ -43,6 +44,9 @@ struct ps_obj_table_entry_t {
 #if PS_AES_KEY_USAGE_LIMIT != 0
     uint32_t num_blocks;            /*!< blocks encrypted/decrypted with current key */
 #endif
+#if PS_OBJECT_SEGMENT_SIZE
+    uint32_t slot;                  /*!< Copy of the object head in use */
+#endif
 #else
     uint32_t version;               /*!< File version */
 #endif
@@ -146,6 +150,35 @@ struct ps_obj_table_ctx_t {
 /* Object table context */
 static struct ps_obj_table_ctx_t ps_obj_table_ctx;
 
+#if PS_RAM_OBJECT_INDEX
+/* Number of hash table buckets, to keep the load factor at most 50% */
+#define PS_OBJ_INDEX_HASH_SIZE  (2U * PS_OBJ_TABLE_ENTRIES)
+
+/* Number of words of the free entry bitmap */
+#define PS_OBJ_INDEX_FREE_WORDS ((PS_OBJ_TABLE_ENTRIES + 31U) / 32U)
+
+/*!
+ * \struct ps_obj_table_index_t
+ *
+ * \brief RAM index of the object table entries.
+ */
+struct ps_obj_table_index_t {
+    uint16_t hash[PS_OBJ_INDEX_HASH_SIZE];      /*!< Open addressing table of
+                                                 *   entry indexes plus one, 0
+                                                 *   for an empty bucket
+                                                 */
+    uint32_t free_map[PS_OBJ_INDEX_FREE_WORDS]; /*!< Bitmap of free entries */
+    uint32_t num_free;                          /*!< Number of free entries */
+};
+
+/* Object table index */
+static struct ps_obj_table_index_t ps_obj_table_index;
+
+/* Check at compilation time that entry indexes fit in the hash table */
+PS_UTILS_BOUND_CHECK(OBJ_TABLE_TOO_LARGE_FOR_INDEX,
+                     PS_OBJ_TABLE_ENTRIES, (UINT16_MAX - 1));
+#endif /* PS_RAM_OBJECT_INDEX */
+
 /* Object table size */
 #define PS_OBJ_TABLE_SIZE            sizeof(struct ps_obj_table_t)
 
@@ -192,9 +225,17 @@ struct ps_crypto_assoc_data_t {
  * big enough, at compile time
  */
 
+#if PS_OBJECT_SEGMENT_SIZE
+/* Check at compilation time if metadata fits in g_ps_object, as the data
+ * buffer only holds a segment
+ */
+PS_UTILS_BOUND_CHECK(OBJ_TABLE_NOT_FIT_IN_STATIC_OBJ_BUF,
+                     PS_OBJ_TABLE_SIZE, PS_MAX_OBJECT_SIZE);
+#else
 /* Check at compilation time if metadata fits in g_ps_object.data */
 PS_UTILS_BOUND_CHECK(OBJ_TABLE_NOT_FIT_IN_STATIC_OBJ_DATA_BUF,
                      PS_OBJ_TABLE_SIZE, PS_MAX_ASSET_SIZE);
+#endif
 
 enum ps_obj_table_state {
     PS_OBJ_TABLE_VALID = 0,   /*!< Table content is valid */
@@ -764,6 +805,127 @@ static psa_status_t ps_set_active_object_table(
     return PSA_SUCCESS;
 }
 
+#if PS_RAM_OBJECT_INDEX
+/**
+ * \brief Gets the hash table bucket of an object.
+ *
+ * \param[in] uid        Object UID
+ * \param[in] client_id  Client UID
+ *
+ * \return Returns the bucket index
+ */
+static uint32_t ps_index_hash(psa_storage_uid_t uid, int32_t client_id)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(uid); i++) {
+        hash ^= (uint8_t)(uid >> (8U * i));
+        hash *= 16777619U;
+    }
+
+    for (i = 0; i < sizeof(client_id); i++) {
+        hash ^= (uint8_t)((uint32_t)client_id >> (8U * i));
+        hash *= 16777619U;
+    }
+
+    return hash % PS_OBJ_INDEX_HASH_SIZE;
+}
+
+/**
+ * \brief Adds a table entry in use to the index.
+ *
+ * \param[in] idx  Entry index
+ */
+static void ps_index_insert(uint32_t idx)
+{
+    struct ps_obj_table_index_t *index = &ps_obj_table_index;
+    const struct ps_obj_table_entry_t *entry =
+                                        &ps_obj_table_ctx.obj_table.obj_db[idx];
+    uint32_t bucket;
+
+    bucket = ps_index_hash(entry->uid, entry->client_id);
+    while (index->hash[bucket] != 0) {
+        bucket = (bucket + 1) % PS_OBJ_INDEX_HASH_SIZE;
+    }
+    index->hash[bucket] = (uint16_t)(idx + 1);
+
+    index->free_map[idx / 32] &= ~(1U << (idx % 32));
+    index->num_free--;
+}
+
+/**
+ * \brief Removes a table entry in use from the index. Must be called before
+ *        the entry is cleared.
+ *
+ * \param[in] idx  Entry index
+ */
+static void ps_index_remove(uint32_t idx)
+{
+    struct ps_obj_table_index_t *index = &ps_obj_table_index;
+    const struct ps_obj_table_entry_t *entry =
+                                        &ps_obj_table_ctx.obj_table.obj_db[idx];
+    uint32_t bucket, next, home;
+
+    bucket = ps_index_hash(entry->uid, entry->client_id);
+    while (index->hash[bucket] != (uint16_t)(idx + 1)) {
+        bucket = (bucket + 1) % PS_OBJ_INDEX_HASH_SIZE;
+    }
+    index->hash[bucket] = 0;
+
+    /* Shift back the following entries of the probe sequence which can no
+     * longer be reached from their home bucket, as the lookup stops at the
+     * first empty bucket.
+     */
+    next = (bucket + 1) % PS_OBJ_INDEX_HASH_SIZE;
+    while (index->hash[next] != 0) {
+        entry = &ps_obj_table_ctx.obj_table.obj_db[index->hash[next] - 1U];
+        home = ps_index_hash(entry->uid, entry->client_id);
+
+        if (((next + PS_OBJ_INDEX_HASH_SIZE - home) % PS_OBJ_INDEX_HASH_SIZE) >=
+            ((next + PS_OBJ_INDEX_HASH_SIZE - bucket) % PS_OBJ_INDEX_HASH_SIZE)) {
+            index->hash[bucket] = index->hash[next];
+            index->hash[next] = 0;
+            bucket = next;
+        }
+
+        next = (next + 1) % PS_OBJ_INDEX_HASH_SIZE;
+    }
+
+    index->free_map[idx / 32] |= (1U << (idx % 32));
+    index->num_free++;
+}
+
+/**
+ * \brief Rebuilds the index from the object table.
+ */
+static void ps_index_build(void)
+{
+    struct ps_obj_table_index_t *index = &ps_obj_table_index;
+    uint32_t i;
+
+    (void)memset(index->hash, 0, sizeof(index->hash));
+    (void)memset(index->free_map, 0, sizeof(index->free_map));
+    index->num_free = PS_OBJ_TABLE_ENTRIES;
+
+    for (i = 0; i < PS_OBJ_TABLE_ENTRIES; i++) {
+        index->free_map[i / 32] |= (1U << (i % 32));
+    }
+
+    for (i = 0; i < PS_OBJ_TABLE_ENTRIES; i++) {
+        if (ps_obj_table_ctx.obj_table.obj_db[i].uid != TFM_PS_INVALID_UID) {
+            ps_index_insert(i);
+        }
+    }
+}
+
+#else
+#define ps_index_insert(idx)
+#define ps_index_remove(idx)
+#define ps_index_build()
+#endif /* PS_RAM_OBJECT_INDEX */
+
 /**
  * \brief Gets table's entry index based on the given object UID and client ID.
  *
@@ -780,7 +942,21 @@ static psa_status_t ps_get_object_entry_idx(psa_storage_uid_t uid,
 {
     uint32_t i;
     struct ps_obj_table_t *p_table = &ps_obj_table_ctx.obj_table;
+#if PS_RAM_OBJECT_INDEX
+    const struct ps_obj_table_index_t *index = &ps_obj_table_index;
+    uint32_t bucket;
 
+    bucket = ps_index_hash(uid, client_id);
+    while (index->hash[bucket] != 0) {
+        i = index->hash[bucket] - 1U;
+        if (p_table->obj_db[i].uid == uid
+            && p_table->obj_db[i].client_id == client_id) {
+            *idx = i;
+            return PSA_SUCCESS;
+        }
+        bucket = (bucket + 1) % PS_OBJ_INDEX_HASH_SIZE;
+    }
+#else
     for (i = 0; i < PS_OBJ_TABLE_ENTRIES; i++) {
         if (p_table->obj_db[i].uid == uid
             && p_table->obj_db[i].client_id == client_id) {
@@ -788,6 +964,7 @@ static psa_status_t ps_get_object_entry_idx(psa_storage_uid_t uid,
             return PSA_SUCCESS;
         }
     }
+#endif /* PS_RAM_OBJECT_INDEX */
 
     return PSA_ERROR_DOES_NOT_EXIST;
 }
@@ -811,6 +988,33 @@ __STATIC_INLINE psa_status_t ps_table_free_idx(uint32_t idx_num,
                                                uint32_t *idx)
 {
     uint32_t i;
+#if PS_RAM_OBJECT_INDEX
+    const struct ps_obj_table_index_t *index = &ps_obj_table_index;
+
+    if (idx_num == 0) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (index->num_free < idx_num) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    /* Return the lowest free entry */
+    for (i = 0; i < PS_OBJ_TABLE_ENTRIES; i++) {
+        /* Skip a whole word of entries in use */
+        if (index->free_map[i / 32] == 0) {
+            i |= 31;
+            continue;
+        }
+
+        if (index->free_map[i / 32] & (1U << (i % 32))) {
+            *idx = i;
+            return PSA_SUCCESS;
+        }
+    }
+
+    return PSA_ERROR_INSUFFICIENT_STORAGE;
+#else
     uint32_t last_free = 0;
     struct ps_obj_table_t *p_table = &ps_obj_table_ctx.obj_table;
 
@@ -831,6 +1035,7 @@ __STATIC_INLINE psa_status_t ps_table_free_idx(uint32_t idx_num,
         *idx = last_free;
         return PSA_SUCCESS;
     }
+#endif /* PS_RAM_OBJECT_INDEX */
 }
 
 /**
@@ -841,6 +1046,8 @@ __STATIC_INLINE psa_status_t ps_table_free_idx(uint32_t idx_num,
  */
 static void ps_table_delete_entry(uint32_t idx)
 {
+    ps_index_remove(idx);
+
     /* Initialise object table entry structure */
     (void)memset(&ps_obj_table_ctx.obj_table.obj_db[idx],
                  PS_DEFAULT_EMPTY_BUFF_VAL, PS_OBJECTS_TABLE_ENTRY_SIZE);
@@ -870,6 +1077,8 @@ psa_status_t ps_object_table_create(void)
 
     p_table->version = PS_OBJECT_SYSTEM_VERSION;
 
+    ps_index_build();
+
     /* Save object table contents */
     return ps_object_table_save_table(p_table);
 }
@@ -934,6 +1143,8 @@ psa_status_t ps_object_table_init(uint8_t *obj_data)
     ps_crypto_set_iv(&ps_obj_table_ctx.obj_table.crypto);
 #endif
 
+    ps_index_build();
+
     return PSA_SUCCESS;
 }
 
@@ -1030,6 +1241,7 @@ psa_status_t ps_object_table_set_obj_tbl_info(psa_storage_uid_t uid,
     idx = PS_OBJECT_FS_ID_TO_IDX(obj_tbl_info->fid);
     p_table->obj_db[idx].uid = uid;
     p_table->obj_db[idx].client_id = client_id;
+    ps_index_insert(idx);
 
     /* Add new object information */
 #ifdef PS_ENCRYPTION
@@ -1038,19 +1250,26 @@ psa_status_t ps_object_table_set_obj_tbl_info(psa_storage_uid_t uid,
 #if PS_AES_KEY_USAGE_LIMIT != 0
     p_table->obj_db[idx].num_blocks = obj_tbl_info->num_blocks;
 #endif
+#if PS_OBJECT_SEGMENT_SIZE
+    p_table->obj_db[idx].slot = obj_tbl_info->slot;
+#endif
 #else
     p_table->obj_db[idx].version = obj_tbl_info->version;
 #endif
 
     err = ps_object_table_save_table(p_table);
     if (err != PSA_SUCCESS) {
+        /* Delete the new entry first, as it is the entry of the backup when
+         * the object is updated in place.
+         */
+        ps_table_delete_entry(idx);
+
         if (backup_entry.uid != TFM_PS_INVALID_UID) {
             /* Rollback the change in the table */
             (void)memcpy(&p_table->obj_db[backup_idx], &backup_entry,
                          PS_OBJECTS_TABLE_ENTRY_SIZE);
+            ps_index_insert(backup_idx);
         }
-
-        ps_table_delete_entry(idx);
     }
 
     return err;
@@ -1077,6 +1296,9 @@ psa_status_t ps_object_table_get_obj_tbl_info(psa_storage_uid_t uid,
 #if PS_AES_KEY_USAGE_LIMIT != 0
     obj_tbl_info->num_blocks = p_table->obj_db[idx].num_blocks;
 #endif
+#if PS_OBJECT_SEGMENT_SIZE
+    obj_tbl_info->slot = p_table->obj_db[idx].slot;
+#endif
 #else
     obj_tbl_info->version = p_table->obj_db[idx].version;
 #endif
@@ -1115,6 +1337,7 @@ psa_status_t ps_object_table_delete_object(psa_storage_uid_t uid,
        /* Rollback the change in the table */
        (void)memcpy(&p_table->obj_db[backup_idx], &backup_entry,
                     PS_OBJECTS_TABLE_ENTRY_SIZE);
+       ps_index_insert(backup_idx);
     }
 
     return err;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include "config_tfm.h"
 #include "psa/protected_storage.h"
 
 #ifdef __cplusplus
@@ -30,6 +31,9 @@ struct ps_obj_table_info_t {
 #if PS_AES_KEY_USAGE_LIMIT != 0
     uint32_t num_blocks; /*!< blocks encrypted/decrypted with current key */
 #endif
+#if PS_OBJECT_SEGMENT_SIZE
+    uint32_t slot;       /*!< Copy of the object head in use */
+#endif
 #else
     uint32_t version;  /*!< Object version */
 #endif
@@ -0,0 +1,922 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Object system storing each object as an encrypted head, holding the object
+ * information and the IV and tag of each segment, and one file per segment of
+ * PS_OBJECT_SEGMENT_SIZE bytes of data, encrypted on its own. The tag of the
+ * head is kept in the object table, so the whole object stays authenticated
+ * against it, while reads and writes only decrypt and encrypt the segments
+ * they cover.
+ *
+ * Each part of an object (the head and every segment) has two copies in the
+ * filesystem. An update writes the parts it changes in the copies not in use,
+ * then switches to them by updating the object table, which keeps the object
+ * in the same entry of the table. The copies not in use are only ever
+ * overwritten, so nothing needs to be removed when an update fails.
+ */
+
+#include "ps_object_system.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cmsis_compiler.h"
+#include "crypto/ps_crypto_interface.h"
+#include "psa/internal_trusted_storage.h"
+#include "ps_object_defs.h"
+#include "ps_object_table.h"
+#include "ps_utils.h"
+#include "tfm_ps_req_mngr.h"
+
+#if PS_OBJECT_SEGMENT_SIZE
+
+/* Parts of an object stored in the file system */
+#define PS_OBJECT_HEAD_PART          0
+#define PS_OBJECT_SEGMENT_PART(seg)  ((seg) + 1)
+
+/* File ID of one copy of a part of an object. The copy 0 of the head uses the
+ * file ID of the object, which is removed when the file ID is allocated.
+ */
+#define PS_OBJECT_PART_FS_ID(fid, part, slot) \
+    ((psa_storage_uid_t)(fid) | ((psa_storage_uid_t)(part) << 32) | \
+     ((psa_storage_uid_t)(slot) << 48))
+
+/* Number of segments of an object of the given size */
+#define PS_OBJECT_NUM_SEGMENTS(size) (((size) + PS_OBJECT_SEGMENT_SIZE - 1) \
+                                      / PS_OBJECT_SEGMENT_SIZE)
+
+/* Size (in bytes) of the data stored in the clear before the encrypted head,
+ * which is the IV and the segment copies bitmap, including any padding
+ */
+#define STORED_HEADER_DATA_SIZE (offsetof(struct ps_object_t, header.info) \
+                                 - offsetof(struct ps_object_t, header.crypto.ref.iv))
+
+/* Gets the size of the head data to encrypt */
+#define PS_HEAD_ENCRYPT_SIZE(num_segments) \
+    (offsetof(struct ps_object_t, header.segments) \
+     - offsetof(struct ps_object_t, header.info) \
+     + ((num_segments) * sizeof(struct ps_obj_segment_t)))
+
+/* Size of the buffer available to the crypto layer from the head data */
+#define PS_HEAD_CRYPTO_BUF_LEN (sizeof(struct ps_object_t) \
+                                - offsetof(struct ps_object_t, header.info))
+
+/* Check at compilation time that the tag appended by the crypto layer to the
+ * largest head fits in g_ps_object
+ */
+PS_UTILS_BOUND_CHECK(HEAD_NOT_FIT_IN_STATIC_OBJ_BUF,
+                     PS_HEAD_ENCRYPT_SIZE(PS_OBJECT_MAX_SEGMENTS)
+                     + PS_TAG_LEN_BYTES, PS_HEAD_CRYPTO_BUF_LEN);
+
+__PACKED_STRUCT head_auth_data_t {
+    uint32_t fid;
+    uint32_t slots[PS_OBJECT_SLOT_WORDS];
+};
+
+__PACKED_STRUCT segment_auth_data_t {
+    uint32_t fid;
+    uint32_t seg;
+};
+
+/* Allocate static variables to process objects */
+static struct ps_object_t g_ps_object;
+static struct ps_obj_table_info_t g_obj_tbl_info;
+
+/**
+ * \brief Gets the copy in use of a segment of g_ps_object.
+ *
+ * \param[in] seg  Segment number
+ *
+ * \return Returns the slot of the copy, 0 or 1
+ */
+static uint32_t ps_segment_slot(uint32_t seg)
+{
+    return (g_ps_object.header.slots[seg / 32] >> (seg % 32)) & 1U;
+}
+
+/**
+ * \brief Switches a segment of g_ps_object to its other copy.
+ *
+ * \param[in] seg  Segment number
+ */
+static void ps_segment_switch_slot(uint32_t seg)
+{
+    g_ps_object.header.slots[seg / 32] ^= (1U << (seg % 32));
+}
+
+/**
+ * \brief Gets the size of a segment of an object.
+ *
+ * \param[in] seg   Segment number
+ * \param[in] size  Size of the object data
+ *
+ * \return Returns the size of the segment
+ */
+static uint32_t ps_segment_size(uint32_t seg, uint32_t size)
+{
+    return PS_UTILS_MIN(PS_OBJECT_SEGMENT_SIZE,
+                        size - (seg * PS_OBJECT_SEGMENT_SIZE));
+}
+
+/**
+ * \brief Reads and authenticates the head of an object into
+ *        g_ps_object.header, based on its object table info stored in
+ *        g_obj_tbl_info.
+ *
+ * \param[in] uid        Unique identifier for the data
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_read_head(psa_storage_uid_t uid, int32_t client_id)
+{
+    psa_status_t err;
+    struct head_auth_data_t auth_data;
+    uint8_t *p_head_data = (uint8_t *)&g_ps_object.header.info;
+    uint32_t decrypt_size;
+    size_t data_length;
+    size_t out_len;
+
+    g_ps_object.header.crypto.ref.uid = uid;
+    g_ps_object.header.crypto.ref.client_id = client_id;
+
+    /* The tag is the one stored in the object table, it is not overwritten as
+     * the stored data starts at the IV.
+     */
+    err = psa_its_get(PS_OBJECT_PART_FS_ID(g_obj_tbl_info.fid,
+                                           PS_OBJECT_HEAD_PART,
+                                           g_obj_tbl_info.slot),
+                      0,
+                      STORED_HEADER_DATA_SIZE
+                      + PS_HEAD_ENCRYPT_SIZE(PS_OBJECT_MAX_SEGMENTS),
+                      (void *)g_ps_object.header.crypto.ref.iv,
+                      &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (data_length < STORED_HEADER_DATA_SIZE + PS_HEAD_ENCRYPT_SIZE(0)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    decrypt_size = data_length - STORED_HEADER_DATA_SIZE;
+
+    /* The copies in use of the segments are stored in the clear, so that they
+     * are still known once the head has been encrypted again, but they are
+     * authenticated together with the File ID.
+     */
+    auth_data.fid = g_obj_tbl_info.fid;
+    (void)memcpy(auth_data.slots, g_ps_object.header.slots,
+                 sizeof(auth_data.slots));
+
+    err = ps_crypto_auth_and_decrypt(&g_ps_object.header.crypto,
+                                     (const uint8_t *)&auth_data,
+                                     sizeof(auth_data),
+                                     p_head_data,
+                                     decrypt_size,
+                                     p_head_data,
+                                     PS_HEAD_CRYPTO_BUF_LEN,
+                                     &out_len);
+    if (err != PSA_SUCCESS || out_len != decrypt_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if (decrypt_size != PS_HEAD_ENCRYPT_SIZE(PS_OBJECT_NUM_SEGMENTS(
+                                   g_ps_object.header.info.current_size))) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Encrypts g_ps_object.header and writes it in the copy of the head
+ *        given by g_obj_tbl_info. The tag is left in the header, for the
+ *        object table.
+ *
+ * \note The head data in g_ps_object.header is encrypted in place.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_write_head(void)
+{
+    psa_status_t err;
+    struct head_auth_data_t auth_data;
+    uint8_t *p_head_data = (uint8_t *)&g_ps_object.header.info;
+    uint32_t encrypt_size;
+    size_t out_len;
+
+    encrypt_size = PS_HEAD_ENCRYPT_SIZE(PS_OBJECT_NUM_SEGMENTS(
+                                        g_ps_object.header.info.current_size));
+
+    auth_data.fid = g_obj_tbl_info.fid;
+    (void)memcpy(auth_data.slots, g_ps_object.header.slots,
+                 sizeof(auth_data.slots));
+
+    /* Get a new IV for each encryption */
+    err = ps_crypto_get_iv(&g_ps_object.header.crypto);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = ps_crypto_encrypt_and_tag(&g_ps_object.header.crypto,
+                                    (const uint8_t *)&auth_data,
+                                    sizeof(auth_data),
+                                    p_head_data,
+                                    encrypt_size,
+                                    p_head_data,
+                                    PS_HEAD_CRYPTO_BUF_LEN,
+                                    &out_len);
+    if (err != PSA_SUCCESS || out_len != encrypt_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return psa_its_set(PS_OBJECT_PART_FS_ID(g_obj_tbl_info.fid,
+                                            PS_OBJECT_HEAD_PART,
+                                            g_obj_tbl_info.slot),
+                       STORED_HEADER_DATA_SIZE + encrypt_size,
+                       (const void *)g_ps_object.header.crypto.ref.iv,
+                       PSA_STORAGE_FLAG_NONE);
+}
+
+/**
+ * \brief Reads and decrypts a segment of the object in g_ps_object.header
+ *        into g_ps_object.data.
+ *
+ * \note The crypto metadata of the head in g_ps_object.header is overwritten.
+ *
+ * \param[in] seg       Segment number
+ * \param[in] seg_size  Size of the segment
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_read_segment(uint32_t seg, uint32_t seg_size)
+{
+    psa_status_t err;
+    const struct segment_auth_data_t auth_data = {
+        .fid = g_obj_tbl_info.fid,
+        .seg = seg,
+    };
+    union ps_crypto_t *crypto = &g_ps_object.header.crypto;
+    size_t data_length;
+    size_t out_len;
+
+    err = psa_its_get(PS_OBJECT_PART_FS_ID(g_obj_tbl_info.fid,
+                                           PS_OBJECT_SEGMENT_PART(seg),
+                                           ps_segment_slot(seg)),
+                      0, seg_size, (void *)g_ps_object.data, &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (data_length != seg_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    (void)memcpy(crypto->ref.iv, g_ps_object.header.segments[seg].iv,
+                 PS_IV_LEN_BYTES);
+    (void)memcpy(crypto->ref.tag, g_ps_object.header.segments[seg].tag,
+                 PS_TAG_LEN_BYTES);
+
+    err = ps_crypto_auth_and_decrypt(crypto,
+                                     (const uint8_t *)&auth_data,
+                                     sizeof(auth_data),
+                                     g_ps_object.data,
+                                     seg_size,
+                                     g_ps_object.data,
+                                     sizeof(g_ps_object.data),
+                                     &out_len);
+    if (err != PSA_SUCCESS || out_len != seg_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Encrypts g_ps_object.data and writes it in the copy not in use of a
+ *        segment of the object in g_ps_object.header, which becomes the copy
+ *        in use.
+ *
+ * \note The crypto metadata of the head in g_ps_object.header is overwritten.
+ *
+ * \param[in] seg       Segment number
+ * \param[in] seg_size  Size of the segment
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_write_segment(uint32_t seg, uint32_t seg_size)
+{
+    psa_status_t err;
+    const struct segment_auth_data_t auth_data = {
+        .fid = g_obj_tbl_info.fid,
+        .seg = seg,
+    };
+    union ps_crypto_t *crypto = &g_ps_object.header.crypto;
+    size_t out_len;
+
+    /* Get a new IV for each encryption */
+    err = ps_crypto_get_iv(crypto);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = ps_crypto_encrypt_and_tag(crypto,
+                                    (const uint8_t *)&auth_data,
+                                    sizeof(auth_data),
+                                    g_ps_object.data,
+                                    seg_size,
+                                    g_ps_object.data,
+                                    sizeof(g_ps_object.data),
+                                    &out_len);
+    if (err != PSA_SUCCESS || out_len != seg_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    (void)memcpy(g_ps_object.header.segments[seg].iv, crypto->ref.iv,
+                 PS_IV_LEN_BYTES);
+    (void)memcpy(g_ps_object.header.segments[seg].tag, crypto->ref.tag,
+                 PS_TAG_LEN_BYTES);
+
+    ps_segment_switch_slot(seg);
+
+    return psa_its_set(PS_OBJECT_PART_FS_ID(g_obj_tbl_info.fid,
+                                            PS_OBJECT_SEGMENT_PART(seg),
+                                            ps_segment_slot(seg)),
+                       seg_size, (const void *)g_ps_object.data,
+                       PSA_STORAGE_FLAG_NONE);
+}
+
+/**
+ * \brief Removes a copy of a part of an object, if it exists.
+ *
+ * \param[in] fid   File ID of the object
+ * \param[in] part  Part of the object
+ * \param[in] slot  Copy of the part
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_remove_part(uint32_t fid, uint32_t part, uint32_t slot)
+{
+    psa_status_t err;
+
+    err = psa_its_remove(PS_OBJECT_PART_FS_ID(fid, part, slot));
+    if (err == PSA_ERROR_DOES_NOT_EXIST) {
+        return PSA_SUCCESS;
+    }
+
+    return err;
+}
+
+/**
+ * \brief Checks if a copy of a part of an object exists.
+ *
+ * \param[in] fid   File ID of the object
+ * \param[in] part  Part of the object
+ * \param[in] slot  Copy of the part
+ *
+ * \return Returns true if the copy exists
+ */
+static bool ps_part_exists(uint32_t fid, uint32_t part, uint32_t slot)
+{
+    struct psa_storage_info_t info;
+
+    return psa_its_get_info(PS_OBJECT_PART_FS_ID(fid, part, slot),
+                            &info) == PSA_SUCCESS;
+}
+
+/**
+ * \brief Gets the number of segments of which copies may exist for an object.
+ *
+ * \details The copies of the segments are removed before the copies of the
+ *          head which describes them, so they are all below the number of
+ *          segments of one of the copies of the head left. That number is read
+ *          from the size of the head, which is stored in the clear. A create
+ *          which does not complete can also leave copies of the segments which
+ *          follow, as it writes the segments in order.
+ *
+ * \param[in] fid           File ID of the object
+ * \param[in] num_segments  Number of segments known to the caller
+ *
+ * \return Returns the number of segments
+ */
+static uint32_t ps_num_segments_left(uint32_t fid, uint32_t num_segments)
+{
+    struct psa_storage_info_t info;
+    uint32_t head_segments;
+    uint32_t slot;
+
+    for (slot = 0; slot < 2; slot++) {
+        if (psa_its_get_info(PS_OBJECT_PART_FS_ID(fid, PS_OBJECT_HEAD_PART,
+                                                  slot),
+                             &info) != PSA_SUCCESS) {
+            continue;
+        }
+
+        if (info.size < STORED_HEADER_DATA_SIZE + PS_HEAD_ENCRYPT_SIZE(0)) {
+            continue;
+        }
+
+        head_segments = (info.size - STORED_HEADER_DATA_SIZE
+                         - PS_HEAD_ENCRYPT_SIZE(0))
+                        / sizeof(struct ps_obj_segment_t);
+        num_segments = PS_UTILS_MAX(num_segments, head_segments);
+    }
+
+    num_segments = PS_UTILS_MIN(num_segments, PS_OBJECT_MAX_SEGMENTS);
+
+    while ((num_segments < PS_OBJECT_MAX_SEGMENTS) &&
+           (ps_part_exists(fid, PS_OBJECT_SEGMENT_PART(num_segments), 0) ||
+            ps_part_exists(fid, PS_OBJECT_SEGMENT_PART(num_segments), 1))) {
+        num_segments++;
+    }
+
+    return num_segments;
+}
+
+/**
+ * \brief Removes all the copies of all the parts of the object with the given
+ *        file ID. That clears the files left when the system is rebooted
+ *        (e.g. power cut, ...) in the middle of an operation.
+ *
+ * \note Only the segments below the number given by
+ *       \ref ps_num_segments_left are looked for. They are removed from the
+ *       last one, and the head last, so that the copies left if the removal is
+ *       interrupted are still found.
+ *
+ * \param[in] fid  File ID of the object
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_remove_all_parts(uint32_t fid)
+{
+    psa_status_t err;
+    uint32_t part;
+    uint32_t slot;
+
+    for (part = PS_OBJECT_SEGMENT_PART(ps_num_segments_left(fid, 0));
+         part > PS_OBJECT_HEAD_PART; part--) {
+        for (slot = 0; slot < 2; slot++) {
+            err = ps_remove_part(fid, part - 1, slot);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Updates the object table for the specified object with the content
+ *        of g_obj_tbl_info. Also removes the old object table.
+ *
+ * \param[in] uid         Unique identifier for the data
+ * \param[in] client_id   Identifier of the asset's owner (client)
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_update_table(psa_storage_uid_t uid, int32_t client_id)
+{
+    psa_status_t err;
+
+    err = ps_object_table_set_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Delete old object table from the persistent area */
+    return ps_object_table_delete_old_table();
+}
+
+psa_status_t ps_system_prepare(void)
+{
+    psa_status_t err;
+
+    /* Reuse the allocated g_ps_object to store a temporary object table data
+     * to be validate inside the function. The data buffer only holds a
+     * segment, so the whole object is used.
+     */
+    err = ps_object_table_init((uint8_t *)&g_ps_object);
+
+    (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL, PS_MAX_OBJECT_SIZE);
+
+    g_obj_tbl_info.tag = g_ps_object.header.crypto.ref.tag;
+
+    return err;
+}
+
+psa_status_t ps_object_read(psa_storage_uid_t uid, int32_t client_id,
+                            uint32_t offset, uint32_t size,
+                            size_t *p_data_length)
+{
+    psa_status_t err;
+    uint32_t current_size;
+    uint32_t data_length;
+    uint32_t seg;
+    uint32_t seg_offset;
+    uint32_t chunk;
+
+    /* Retrieve the object information from the object table if the object
+     * exists.
+     */
+    err = ps_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = ps_read_head(uid, client_id);
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    current_size = g_ps_object.header.info.current_size;
+
+    /* Boundary check the incoming request */
+    if (offset > current_size) {
+        err = PSA_ERROR_INVALID_ARGUMENT;
+        goto clear_and_return;
+    }
+
+    size = PS_UTILS_MIN(size, current_size - offset);
+    data_length = size;
+
+    /* Only decrypt the segments covered by the request */
+    while (size > 0) {
+        seg = offset / PS_OBJECT_SEGMENT_SIZE;
+        seg_offset = offset % PS_OBJECT_SEGMENT_SIZE;
+        chunk = PS_UTILS_MIN(size, PS_OBJECT_SEGMENT_SIZE - seg_offset);
+
+        err = ps_read_segment(seg, ps_segment_size(seg, current_size));
+        if (err != PSA_SUCCESS) {
+            goto clear_and_return;
+        }
+
+        /* Copy the decrypted object data to the output buffer */
+        ps_req_mngr_write_asset_data(g_ps_object.data + seg_offset, chunk);
+
+        offset += chunk;
+        size -= chunk;
+    }
+
+    *p_data_length = data_length;
+
+clear_and_return:
+    /* Remove data stored in the object before leaving the function */
+    (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL,
+                 PS_MAX_OBJECT_SIZE);
+
+    return err;
+}
+
+psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
+                              psa_storage_create_flags_t create_flags,
+                              uint32_t size)
+{
+    psa_status_t err;
+    bool object_exists = false;
+    uint32_t old_num_segments = 0;
+    uint32_t num_segments;
+    uint32_t seg_size;
+    uint32_t seg;
+
+    /* Boundary check the incoming request */
+    if (size > PS_MAX_ASSET_SIZE) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Retrieve the object information from the object table if the object
+     * exists.
+     */
+    err = ps_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
+    if (err == PSA_SUCCESS) {
+        err = ps_read_head(uid, client_id);
+        if (err != PSA_SUCCESS) {
+            goto clear_and_return;
+        }
+
+        /* If the object exists and has the write once flag set, then it cannot
+         * be modified.
+         */
+        if (g_ps_object.header.info.create_flags
+            & PSA_STORAGE_FLAG_WRITE_ONCE) {
+            err = PSA_ERROR_NOT_PERMITTED;
+            goto clear_and_return;
+        }
+
+        object_exists = true;
+        old_num_segments = PS_OBJECT_NUM_SEGMENTS(
+                                         g_ps_object.header.info.current_size);
+    } else if (err == PSA_ERROR_DOES_NOT_EXIST) {
+        /* Get a file ID for the new object. Requests 2 file IDs to prevent
+         * exhaustion.
+         */
+        err = ps_object_table_get_free_fid(2, &g_obj_tbl_info.fid);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        err = ps_remove_all_parts(g_obj_tbl_info.fid);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        g_ps_object.header.crypto.ref.uid = uid;
+        g_ps_object.header.crypto.ref.client_id = client_id;
+        g_obj_tbl_info.slot = 1;
+    } else {
+        return err;
+    }
+
+    /* Set object header based on input parameters */
+    g_ps_object.header.info.max_size = size;
+    g_ps_object.header.info.create_flags = create_flags;
+    g_ps_object.header.info.current_size = size;
+
+    /* Write the new data to the copies not in use of its segments */
+    num_segments = PS_OBJECT_NUM_SEGMENTS(size);
+    for (seg = 0; seg < num_segments; seg++) {
+        seg_size = ps_segment_size(seg, size);
+
+        err = ps_req_mngr_read_asset_data(g_ps_object.data, seg_size);
+        if (err != PSA_SUCCESS) {
+            goto clear_and_return;
+        }
+
+        err = ps_write_segment(seg, seg_size);
+        if (err != PSA_SUCCESS) {
+            goto clear_and_return;
+        }
+    }
+
+    g_obj_tbl_info.slot ^= 1U;
+
+    err = ps_write_head();
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    err = ps_update_table(uid, client_id);
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    /* Remove the old copies of the segments, from the last one, then the old
+     * copy of the head, which bounds them until then. Both copies of the
+     * segments beyond the new size are removed, with the ones left by an
+     * interrupted create growing the object.
+     */
+    if (object_exists) {
+        old_num_segments = ps_num_segments_left(g_obj_tbl_info.fid,
+                                                old_num_segments);
+    }
+
+    for (seg = old_num_segments; (seg > 0) && (err == PSA_SUCCESS); seg--) {
+        if (seg - 1 < num_segments) {
+            err = ps_remove_part(g_obj_tbl_info.fid,
+                                 PS_OBJECT_SEGMENT_PART(seg - 1),
+                                 ps_segment_slot(seg - 1) ^ 1U);
+            continue;
+        }
+
+        err = ps_remove_part(g_obj_tbl_info.fid,
+                             PS_OBJECT_SEGMENT_PART(seg - 1), 0);
+        if (err == PSA_SUCCESS) {
+            err = ps_remove_part(g_obj_tbl_info.fid,
+                                 PS_OBJECT_SEGMENT_PART(seg - 1), 1);
+        }
+    }
+
+    if (object_exists && (err == PSA_SUCCESS)) {
+        err = ps_remove_part(g_obj_tbl_info.fid, PS_OBJECT_HEAD_PART,
+                             g_obj_tbl_info.slot ^ 1U);
+    }
+
+clear_and_return:
+    /* Remove data stored in the object before leaving the function */
+    (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL, PS_MAX_OBJECT_SIZE);
+
+    return err;
+}
+
+psa_status_t ps_object_write(psa_storage_uid_t uid, int32_t client_id,
+                             uint32_t offset, uint32_t size)
+{
+    psa_status_t err;
+    uint32_t old_size;
+    uint32_t new_size;
+    uint32_t first_seg;
+    uint32_t last_seg;
+    uint32_t seg;
+    uint32_t seg_start;
+    uint32_t wrt_start;
+    uint32_t wrt_end;
+
+    /* Retrieve the object information from the object table if the object
+     * exists.
+     */
+    err = ps_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = ps_read_head(uid, client_id);
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    /* If the object has the write once flag set, then it cannot be modified. */
+    if (g_ps_object.header.info.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+        err = PSA_ERROR_NOT_PERMITTED;
+        goto clear_and_return;
+    }
+
+    old_size = g_ps_object.header.info.current_size;
+
+    /* Offset must not be larger than the object's current size to prevent gaps
+     * being created in the object data.
+     */
+    if (offset > old_size) {
+        err = PSA_ERROR_INVALID_ARGUMENT;
+        goto clear_and_return;
+    }
+
+    /* Boundary check the incoming request */
+    err = ps_utils_check_contained_in(g_ps_object.header.info.max_size,
+                                      offset, size);
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    /* Nothing to write */
+    if (size == 0) {
+        goto clear_and_return;
+    }
+
+    /* Update the current object size if necessary */
+    new_size = PS_UTILS_MAX(old_size, offset + size);
+
+    /* Only the segments covered by the request are rewritten. As the offset
+     * is not beyond the current size, the data of each of them either exists
+     * or is written.
+     */
+    first_seg = offset / PS_OBJECT_SEGMENT_SIZE;
+    last_seg = (offset + size - 1) / PS_OBJECT_SEGMENT_SIZE;
+    for (seg = first_seg; seg <= last_seg; seg++) {
+        seg_start = seg * PS_OBJECT_SEGMENT_SIZE;
+
+        if (seg_start < old_size) {
+            err = ps_read_segment(seg, ps_segment_size(seg, old_size));
+            if (err != PSA_SUCCESS) {
+                goto clear_and_return;
+            }
+        }
+
+        /* Update the object data */
+        wrt_start = PS_UTILS_MAX(offset, seg_start);
+        wrt_end = PS_UTILS_MIN(offset + size,
+                               seg_start + PS_OBJECT_SEGMENT_SIZE);
+        err = ps_req_mngr_read_asset_data(g_ps_object.data
+                                          + (wrt_start - seg_start),
+                                          wrt_end - wrt_start);
+        if (err != PSA_SUCCESS) {
+            goto clear_and_return;
+        }
+
+        err = ps_write_segment(seg, ps_segment_size(seg, new_size));
+        if (err != PSA_SUCCESS) {
+            goto clear_and_return;
+        }
+    }
+
+    g_ps_object.header.info.current_size = new_size;
+
+    g_obj_tbl_info.slot ^= 1U;
+
+    err = ps_write_head();
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    err = ps_update_table(uid, client_id);
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    /* Remove the old copies of the head and of the rewritten segments */
+    err = ps_remove_part(g_obj_tbl_info.fid, PS_OBJECT_HEAD_PART,
+                         g_obj_tbl_info.slot ^ 1U);
+
+    for (seg = first_seg;
+         (seg <= last_seg) && (seg * PS_OBJECT_SEGMENT_SIZE < old_size) &&
+         (err == PSA_SUCCESS); seg++) {
+        err = ps_remove_part(g_obj_tbl_info.fid, PS_OBJECT_SEGMENT_PART(seg),
+                             ps_segment_slot(seg) ^ 1U);
+    }
+
+clear_and_return:
+    /* Remove data stored in the object before leaving the function */
+    (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL,
+                 PS_MAX_OBJECT_SIZE);
+
+    return err;
+}
+
+psa_status_t ps_object_get_info(psa_storage_uid_t uid, int32_t client_id,
+                                struct psa_storage_info_t *info)
+{
+    psa_status_t err;
+
+    /* Retrieve the object information from the object table if the object
+     * exists.
+     */
+    err = ps_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The object information is in the head, no segment is read */
+    err = ps_read_head(uid, client_id);
+    if (err == PSA_SUCCESS) {
+        /* Copy PS object info to the PSA PS info struct */
+        info->size = g_ps_object.header.info.current_size;
+        info->capacity = g_ps_object.header.info.max_size;
+        info->flags = g_ps_object.header.info.create_flags;
+    }
+
+    /* Remove data stored in the object before leaving the function */
+    (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL,
+                 PS_MAX_OBJECT_SIZE);
+
+    return err;
+}
+
+psa_status_t ps_object_delete(psa_storage_uid_t uid, int32_t client_id)
+{
+    psa_status_t err;
+
+    /* Retrieve the object information from the object table if the object
+     * exists.
+     */
+    err = ps_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = ps_read_head(uid, client_id);
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    /* Check that the write once flag is not set */
+    if (g_ps_object.header.info.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+        err = PSA_ERROR_NOT_PERMITTED;
+        goto clear_and_return;
+    }
+
+    /* Delete object from the table and stores the table in the persistent
+     * area.
+     */
+    err = ps_object_table_delete_object(uid, client_id);
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    /* Delete old object table from the persistent area */
+    err = ps_object_table_delete_old_table();
+    if (err != PSA_SUCCESS) {
+        goto clear_and_return;
+    }
+
+    /* Remove both copies of the head and of the segments, including the ones
+     * left by interrupted updates. If this is interrupted, the copies left
+     * are removed when the file ID is allocated again.
+     */
+    err = ps_remove_all_parts(g_obj_tbl_info.fid);
+
+clear_and_return:
+    /* Remove data stored in the object before leaving the function */
+    (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL,
+                 PS_MAX_OBJECT_SIZE);
+
+    return err;
+}
+
+psa_status_t ps_system_wipe_all(void)
+{
+    /* This function may get called as a corrective action
+     * if a system level security violation is detected.
+     * This could be asynchronous to normal system operation
+     * and state of the ps system lock is unknown. Hence
+     * this function doesn't block on the lock and directly
+     * moves to erasing the flash instead.
+     */
+    return ps_object_table_create();
+}
+
+#endif /* PS_OBJECT_SEGMENT_SIZE */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -40,6 +40,11 @@ typedef char err_msg[(data_size <= data_buf_size)*2 - 1]
  */
 #define PS_UTILS_MIN(x, y) (((x) < (y)) ? (x) : (y))
 
+/**
+ * \brief Evaluates to the maximum of the two parameters.
+ */
+#define PS_UTILS_MAX(x, y) (((x) > (y)) ? (x) : (y))
+
 /**
  * \brief Checks if a subset region is fully contained within a superset region.
  *
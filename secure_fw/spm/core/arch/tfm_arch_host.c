@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <ucontext.h>
+#include "config_impl.h"
+#include "spm.h"
+#include "thread.h"
+#include "ffm/backend_ipc.h"
+#include "tfm_arch.h"
+#include "utilities.h"
+
+#if !defined(TFM_ARCH_HOST)
+#error "This file is for the host architecture only."
+#endif
+
+#if CONFIG_TFM_SPM_BACKEND_IPC != 1
+#error "The host architecture supports the IPC backend only."
+#endif
+
+#if TFM_ISOLATION_LEVEL != 1
+#error "The host architecture supports isolation level 1 only."
+#endif
+
+/* Simulated PRIMASK and IPSR */
+uint32_t host_irq_masked;
+uint32_t host_exc_num = EXC_NUM_THREAD_MODE;
+
+/* Declaration flag to control the scheduling logic, as on the target. */
+uint32_t scheduler_lock = SCHEDULER_UNLOCKED;
+
+/* Simulated PendSV pending bit */
+static uint32_t host_pendsv_pending;
+
+/* Context running on the host, NULL before the scheduler is started. */
+static struct context_ctrl_t *p_host_running_ctx;
+
+/*
+ * Simulated PendSV. ipc_schedule() decides the next thread exactly as on the
+ * target, then the host contexts are swapped. The current thread continues
+ * from here when it is scheduled again.
+ *
+ * The context pointers returned by ipc_schedule() are 32-bit values, so the
+ * contexts are taken from the running context and CURRENT_THREAD instead.
+ */
+static void host_pendsv(void)
+{
+    struct context_ctrl_t *p_curr, *p_next;
+
+    if (p_host_running_ctx == NULL) {
+        return;
+    }
+
+    host_pendsv_pending = 0;
+    p_curr = p_host_running_ctx;
+
+    host_exc_num = EXC_NUM_PENDSV;
+    (void)ipc_schedule(EXC_RETURN_THREAD_PSP);
+    host_exc_num = EXC_NUM_THREAD_MODE;
+
+    p_next = CURRENT_THREAD->p_context_ctrl;
+
+    if (p_curr == p_next) {
+        return;
+    }
+
+    p_host_running_ctx = p_next;
+    if (swapcontext(&p_curr->uctx, &p_next->uctx) != 0) {
+        tfm_core_panic();
+    }
+}
+
+/* Thread entry, the host counterpart of the exception return pattern. */
+static void host_thread_entry(void)
+{
+    const struct context_ctrl_t *p_ctx = p_host_running_ctx;
+
+    /* The scheduling requested before the first thread starts runs first. */
+    tfm_arch_host_irq_unmasked();
+
+    ((void (*)(void *))p_ctx->pfn)((void *)p_ctx->param);
+
+    /* THRD_GENERAL_EXIT is not a callable address, as on the target. */
+    if (p_ctx->pfnlr != (uintptr_t)THRD_GENERAL_EXIT) {
+        ((void (*)(void))p_ctx->pfnlr)();
+    }
+
+    tfm_core_panic();
+}
+
+void tfm_arch_host_irq_unmasked(void)
+{
+    if (host_pendsv_pending && (host_exc_num == EXC_NUM_THREAD_MODE)) {
+        host_pendsv();
+    }
+}
+
+void tfm_arch_set_secure_exception_priorities(void)
+{
+}
+
+#ifdef TFM_FIH_PROFILE_ON
+FIH_RET_TYPE(int32_t) tfm_arch_verify_secure_exception_priorities(void)
+{
+    FIH_RET(fih_int_encode(0));
+}
+#endif
+
+void tfm_arch_config_extensions(void)
+{
+}
+
+void tfm_arch_free_msp_and_exc_ret(uint32_t msp_base, uint32_t exc_return)
+{
+    (void)msp_base;
+    (void)exc_return;
+
+    if (p_host_running_ctx == NULL) {
+        tfm_core_panic();
+    }
+
+    /* Enter the first thread, the boot stack is never used again. */
+    (void)setcontext(&p_host_running_ctx->uctx);
+
+    tfm_core_panic();
+}
+
+void tfm_arch_set_context_ret_code(const struct context_ctrl_t *p_ctx_ctrl, uint32_t ret_code)
+{
+    ((struct context_ctrl_t *)p_ctx_ctrl)->ret_code = ret_code;
+}
+
+void tfm_arch_init_context(struct context_ctrl_t *p_ctx_ctrl,
+                           uintptr_t pfn, void *param, uintptr_t pfnlr)
+{
+    uintptr_t sp = arch_seal_thread_stack(p_ctx_ctrl->sp);
+
+    if (sp <= p_ctx_ctrl->sp_limit) {
+        tfm_core_panic();
+    }
+
+    if (getcontext(&p_ctx_ctrl->uctx) != 0) {
+        tfm_core_panic();
+    }
+
+    p_ctx_ctrl->uctx.uc_stack.ss_sp   = (void *)p_ctx_ctrl->sp_limit;
+    p_ctx_ctrl->uctx.uc_stack.ss_size = sp - p_ctx_ctrl->sp_limit;
+    p_ctx_ctrl->uctx.uc_link          = NULL;
+
+    /* makecontext() only passes int arguments, keep the entry in the context */
+    makecontext(&p_ctx_ctrl->uctx, host_thread_entry, 0);
+
+    p_ctx_ctrl->pfn      = pfn;
+    p_ctx_ctrl->param    = (uintptr_t)param;
+    p_ctx_ctrl->pfnlr    = pfnlr;
+    p_ctx_ctrl->ret_code = 0;
+    p_ctx_ctrl->exc_ret  = EXC_RETURN_THREAD_PSP;
+    p_ctx_ctrl->sp       = sp;
+}
+
+uint32_t tfm_arch_refresh_hardware_context(const struct context_ctrl_t *p_ctx_ctrl)
+{
+    p_host_running_ctx = (struct context_ctrl_t *)p_ctx_ctrl;
+
+    return p_ctx_ctrl->exc_ret;
+}
+
+void arch_acquire_sched_lock(void)
+{
+    scheduler_lock = SCHEDULER_LOCKED;
+}
+
+uint32_t arch_release_sched_lock(void)
+{
+    uint32_t attempted = scheduler_lock;
+
+    scheduler_lock = SCHEDULER_UNLOCKED;
+
+    return attempted;
+}
+
+uint32_t arch_attempt_schedule(void)
+{
+    if (scheduler_lock != SCHEDULER_UNLOCKED) {
+        scheduler_lock = SCHEDULER_ATTEMPTED;
+        return 0;
+    }
+
+    host_pendsv_pending = 1;
+    if (!host_irq_masked) {
+        tfm_arch_host_irq_unmasked();
+    }
+
+    return 0;
+}
+
+void tfm_arch_host_enter_spm(void)
+{
+    /* The return value only matters to the stack switch on the target. */
+    (void)backend_abi_entering_spm();
+}
+
+uint32_t tfm_arch_host_leave_spm(uint32_t result)
+{
+    struct context_ctrl_t *p_ctx = p_host_running_ctx;
+
+    /* Written back by tfm_arch_set_context_ret_code() if the thread blocks */
+    p_ctx->ret_code = result;
+
+    (void)backend_abi_leaving_spm(result);
+
+    return p_ctx->ret_code;
+}
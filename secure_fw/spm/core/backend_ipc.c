@@ -20,6 +20,7 @@
 #include "runtime_defs.h"
 #include "stack_watermark.h"
 #include "spm.h"
+#include "spm_trace.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_hal_platform.h"
 #include "tfm_nspm.h"
@@ -201,6 +202,8 @@ psa_status_t backend_messaging(struct connection_t *p_connection)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    SPM_TRACE_CONN(SPM_TRACE_MESSAGING, p_connection);
+
     p_owner = p_connection->service->partition;
     signal = p_connection->service->p_ldinf->signal;
 
@@ -229,6 +232,8 @@ psa_status_t backend_replying(struct connection_t *handle, int32_t status)
 {
     struct partition_t *client = handle->p_client;
 
+    SPM_TRACE_CONN(SPM_TRACE_REPLYING, handle);
+
     /* Prepare the replied handle. */
     handle->replied_value = (uintptr_t)status;
 
@@ -392,6 +397,7 @@ psa_signal_t backend_wait_signals(struct partition_t *p_pt, psa_signal_t signals
     ret = p_pt->signals_asserted & signals;
     if (ret == (psa_signal_t)0) {
         p_pt->signals_waiting = signals;
+        THRD_MARK_BLOCKED(&p_pt->thrd);
     }
 
     CRITICAL_SECTION_LEAVE(cs_signal);
@@ -412,6 +418,7 @@ psa_status_t backend_assert_signal(struct partition_t *p_pt, psa_signal_t signal
     p_pt->signals_asserted |= signal;
 
     if (p_pt->signals_asserted & p_pt->signals_waiting) {
+        THRD_MARK_READY(&p_pt->thrd);
         ret = STATUS_NEED_SCHEDULE;
     }
     CRITICAL_SECTION_LEAVE(cs_signal);
@@ -513,6 +520,8 @@ uint64_t ipc_schedule(uint32_t exc_return)
     p_part_next = GET_THRD_OWNER(pth_next);
 
     if ((pth_next != NULL) && (p_part_curr != p_part_next)) {
+        SPM_TRACE(SPM_TRACE_SCHEDULE, p_part_next->p_ldinf->pid, 0);
+
         /* Check if there is enough room on stack to save more context */
         if ((p_curr_ctx->sp_limit +
                 sizeof(struct tfm_additional_context_t)) > __get_PSP()) {
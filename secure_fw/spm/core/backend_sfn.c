@@ -22,6 +22,7 @@
 #include "psa/error.h"
 #include "psa/service.h"
 #include "spm.h"
+#include "spm_trace.h"
 #include "memory_symbols.h"
 #include "private/assert.h"
 
@@ -50,6 +51,8 @@ psa_status_t backend_messaging(struct connection_t *p_connection)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    SPM_TRACE_CONN(SPM_TRACE_MESSAGING, p_connection);
+
     p_target = p_connection->service->partition;
     p_target->p_reqs = p_connection;
 
@@ -73,6 +76,8 @@ psa_status_t backend_messaging(struct connection_t *p_connection)
 
 psa_status_t backend_replying(struct connection_t *handle, int32_t status)
 {
+    SPM_TRACE_CONN(SPM_TRACE_REPLYING, handle);
+
     SET_CURRENT_COMPONENT(handle->p_client);
 
     /*
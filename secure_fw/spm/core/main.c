@@ -11,6 +11,7 @@
 #include "tfm_boot_data.h"
 #include "memory_symbols.h"
 #include "spm.h"
+#include "spm_trace.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_hal_platform.h"
 #include "tfm_spm_log.h"
@@ -50,6 +51,10 @@ static fih_int tfm_core_init(void)
         FIH_RET(fih_int_encode(SPM_ERROR_GENERIC));
     }
 
+#if CONFIG_TFM_SPM_TRACE == 1
+    spm_trace_init();
+#endif
+
     /*
      * Print the TF-M version now that the platform has initialized
      * the logging backend.
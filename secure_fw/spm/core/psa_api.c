@@ -18,6 +18,7 @@
 #include "psa/lifecycle.h"
 #include "psa/service.h"
 #include "spm.h"
+#include "spm_trace.h"
 #include "tfm_arch.h"
 #include "load/partition_defs.h"
 #include "load/service_defs.h"
@@ -173,6 +174,8 @@ psa_status_t tfm_spm_partition_psa_get(psa_signal_t signal, psa_msg_t *msg)
             return PSA_ERROR_DOES_NOT_EXIST;
         }
 
+        SPM_TRACE_CONN(SPM_TRACE_PSA_GET, handle);
+
         spm_memcpy(msg, &handle->msg, sizeof(psa_msg_t));
     }
 
@@ -205,6 +208,8 @@ psa_status_t tfm_spm_partition_psa_reply(psa_handle_t msg_handle,
         tfm_core_panic();
     }
 
+    SPM_TRACE_CONN(SPM_TRACE_PSA_REPLY, handle);
+
     switch (handle->msg.type) {
     case PSA_IPC_CONNECT:
         /*
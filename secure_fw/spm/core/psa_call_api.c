@@ -12,6 +12,7 @@
 #include "critical_section.h"
 #include "ffm/backend.h"
 #include "ffm/psa_api.h"
+#include "spm_trace.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_psa_call_pack.h"
 #include "utilities.h"
@@ -31,6 +32,8 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
     const struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
     int32_t type = PARAM_UNPACK_TYPE(ctrl_param);
 
+    SPM_TRACE_CONN(SPM_TRACE_CALL_PARAMS, p_connection);
+
     /* The request type must be zero or positive. */
     if (type < 0) {
         return PSA_ERROR_PROGRAMMER_ERROR;
@@ -165,6 +168,8 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
 
     client_id = tfm_spm_get_client_id(ns_caller);
 
+    SPM_TRACE(SPM_TRACE_PSA_CALL, client_id, 0);
+
     status = spm_get_idle_connection(&p_connection, handle, client_id);
     if (status != PSA_SUCCESS) {
         return status;
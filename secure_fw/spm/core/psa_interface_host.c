@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "config_spm.h"
+#include "ffm/psa_api.h"
+#include "spm.h"
+#include "tfm_psa_call_pack.h"
+#include "psa/client.h"
+#include "psa/lifecycle.h"
+#include "psa/service.h"
+#include "runtime_defs.h"
+#include "tfm_arch.h"
+
+/*
+ * Host counterpart of psa_interface_thread_fn_call.c. The PSA API bodies run
+ * on the caller's host stack between the SPM entering and leaving actions.
+ */
+#define HOST_FN_CALL(call)                                                  \
+    (tfm_arch_host_enter_spm(), tfm_arch_host_leave_spm((uint32_t)(call)))
+
+static uint32_t psa_framework_version_host(void)
+{
+    return HOST_FN_CALL(tfm_spm_client_psa_framework_version());
+}
+
+static uint32_t psa_version_host(uint32_t sid)
+{
+    return HOST_FN_CALL(tfm_spm_client_psa_version(sid));
+}
+
+static psa_status_t tfm_psa_call_pack_host(psa_handle_t handle,
+                                           uint32_t ctrl_param,
+                                           const psa_invec *in_vec,
+                                           psa_outvec *out_vec)
+{
+    return (psa_status_t)HOST_FN_CALL(tfm_spm_client_psa_call(handle,
+                                                              ctrl_param,
+                                                              in_vec,
+                                                              out_vec));
+}
+
+static psa_signal_t psa_wait_host(psa_signal_t signal_mask, uint32_t timeout)
+{
+    return (psa_signal_t)HOST_FN_CALL(tfm_spm_partition_psa_wait(signal_mask,
+                                                                 timeout));
+}
+
+static psa_status_t psa_get_host(psa_signal_t signal, psa_msg_t *msg)
+{
+    return (psa_status_t)HOST_FN_CALL(tfm_spm_partition_psa_get(signal, msg));
+}
+
+static size_t psa_read_host(psa_handle_t msg_handle, uint32_t invec_idx,
+                            void *buffer, size_t num_bytes)
+{
+    return (size_t)HOST_FN_CALL(tfm_spm_partition_psa_read(msg_handle,
+                                                           invec_idx,
+                                                           buffer,
+                                                           num_bytes));
+}
+
+static size_t psa_skip_host(psa_handle_t msg_handle,
+                            uint32_t invec_idx, size_t num_bytes)
+{
+    return (size_t)HOST_FN_CALL(tfm_spm_partition_psa_skip(msg_handle,
+                                                           invec_idx,
+                                                           num_bytes));
+}
+
+static void psa_write_host(psa_handle_t msg_handle, uint32_t outvec_idx,
+                           const void *buffer, size_t num_bytes)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_write(msg_handle, outvec_idx,
+                                                   buffer, num_bytes));
+}
+
+static void psa_reply_host(psa_handle_t msg_handle, psa_status_t status)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_reply(msg_handle, status));
+}
+
+#if CONFIG_TFM_DOORBELL_API == 1
+static void psa_notify_host(int32_t partition_id)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_notify(partition_id));
+}
+
+static void psa_clear_host(void)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_clear());
+}
+#endif /* CONFIG_TFM_DOORBELL_API == 1 */
+
+static void psa_panic_host(void)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_panic());
+}
+
+static uint32_t psa_rot_lifecycle_state_host(void)
+{
+    return HOST_FN_CALL(tfm_spm_get_lifecycle_state());
+}
+
+/* Following PSA APIs are only needed by connection-based services */
+#if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
+
+static psa_handle_t psa_connect_host(uint32_t sid, uint32_t version)
+{
+    return (psa_handle_t)HOST_FN_CALL(tfm_spm_client_psa_connect(sid,
+                                                                 version));
+}
+
+static void psa_close_host(psa_handle_t handle)
+{
+    (void)HOST_FN_CALL(tfm_spm_client_psa_close(handle));
+}
+
+static void psa_set_rhandle_host(psa_handle_t msg_handle, void *rhandle)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_set_rhandle(msg_handle,
+                                                         rhandle));
+}
+
+#endif /* CONFIG_TFM_CONNECTION_BASED_SERVICE_API */
+
+#if (CONFIG_TFM_FLIH_API == 1) || (CONFIG_TFM_SLIH_API == 1)
+static void psa_irq_enable_host(psa_signal_t irq_signal)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_irq_enable(irq_signal));
+}
+
+static psa_irq_status_t psa_irq_disable_host(psa_signal_t irq_signal)
+{
+    return (psa_irq_status_t)HOST_FN_CALL(
+                            tfm_spm_partition_psa_irq_disable(irq_signal));
+}
+
+/* This API is only used for FLIH. */
+#if CONFIG_TFM_FLIH_API == 1
+static void psa_reset_signal_host(psa_signal_t irq_signal)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_reset_signal(irq_signal));
+}
+#endif /* CONFIG_TFM_FLIH_API == 1 */
+
+/* This API is only used for SLIH. */
+#if CONFIG_TFM_SLIH_API == 1
+static void psa_eoi_host(psa_signal_t irq_signal)
+{
+    (void)HOST_FN_CALL(tfm_spm_partition_psa_eoi(irq_signal));
+}
+#endif /* CONFIG_TFM_SLIH_API */
+#endif /* CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1 */
+
+#if PSA_FRAMEWORK_HAS_MM_IOVEC
+
+static const void *psa_map_invec_host(psa_handle_t msg_handle,
+                                      uint32_t invec_idx)
+{
+    return (const void *)HOST_FN_CALL(
+                    tfm_spm_partition_psa_map_invec(msg_handle, invec_idx));
+}
+
+static void psa_unmap_invec_host(psa_handle_t msg_handle, uint32_t invec_idx)
+{
+    tfm_arch_host_enter_spm();
+    tfm_spm_partition_psa_unmap_invec(msg_handle, invec_idx);
+    (void)tfm_arch_host_leave_spm(PSA_SUCCESS);
+}
+
+static void *psa_map_outvec_host(psa_handle_t msg_handle, uint32_t outvec_idx)
+{
+    return (void *)HOST_FN_CALL(
+                    tfm_spm_partition_psa_map_outvec(msg_handle, outvec_idx));
+}
+
+static void psa_unmap_outvec_host(psa_handle_t msg_handle, uint32_t outvec_idx,
+                                  size_t len)
+{
+    tfm_arch_host_enter_spm();
+    tfm_spm_partition_psa_unmap_outvec(msg_handle, outvec_idx, len);
+    (void)tfm_arch_host_leave_spm(PSA_SUCCESS);
+}
+
+#endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
+
+#ifdef TFM_PARTITION_NS_AGENT_MAILBOX
+static psa_status_t agent_psa_call_host(psa_handle_t handle,
+                                        uint32_t control,
+                                        const struct client_params_t *params,
+                                        const void *client_data_stateless)
+{
+    return (psa_status_t)HOST_FN_CALL(
+                    tfm_spm_agent_psa_call(handle, control, params,
+                                           client_data_stateless));
+}
+
+#if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
+static psa_handle_t agent_psa_connect_host(uint32_t sid, uint32_t version,
+                                           int32_t ns_client_id,
+                                           const void *client_data)
+{
+    return (psa_handle_t)HOST_FN_CALL(
+                    tfm_spm_agent_psa_connect(sid, version, ns_client_id,
+                                              client_data));
+}
+
+static psa_status_t agent_psa_close_host(psa_handle_t handle,
+                                         int32_t ns_client_id)
+{
+    return (psa_status_t)HOST_FN_CALL(
+                    tfm_spm_agent_psa_close(handle, ns_client_id));
+}
+#endif /* CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1 */
+#endif /* TFM_PARTITION_NS_AGENT_MAILBOX */
+
+const struct psa_api_tbl_t psa_api_thread_fn_call = {
+                                tfm_psa_call_pack_host,
+                                psa_version_host,
+                                psa_framework_version_host,
+                                psa_wait_host,
+                                psa_get_host,
+                                psa_read_host,
+                                psa_skip_host,
+                                psa_write_host,
+                                psa_reply_host,
+                                psa_panic_host,
+                                psa_rot_lifecycle_state_host,
+#if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
+                                psa_connect_host,
+                                psa_close_host,
+                                psa_set_rhandle_host,
+#endif /* CONFIG_TFM_CONNECTION_BASED_SERVICE_API */
+#if CONFIG_TFM_DOORBELL_API == 1
+                                psa_notify_host,
+                                psa_clear_host,
+#endif /* CONFIG_TFM_DOORBELL_API == 1 */
+#if (CONFIG_TFM_FLIH_API == 1) || (CONFIG_TFM_SLIH_API == 1)
+                                psa_irq_enable_host,
+                                psa_irq_disable_host,
+#if CONFIG_TFM_FLIH_API == 1
+                                psa_reset_signal_host,
+#endif /* CONFIG_TFM_FLIH_API == 1 */
+#if CONFIG_TFM_SLIH_API == 1
+                                psa_eoi_host,
+#endif /* CONFIG_TFM_SLIH_API == 1 */
+#endif /* CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1 */
+#if PSA_FRAMEWORK_HAS_MM_IOVEC
+                                psa_map_invec_host,
+                                psa_unmap_invec_host,
+                                psa_map_outvec_host,
+                                psa_unmap_outvec_host,
+#endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
+#ifdef TFM_PARTITION_NS_AGENT_MAILBOX
+                                agent_psa_call_host,
+#if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
+                                agent_psa_connect_host,
+                                agent_psa_close_host,
+#endif /* CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1 */
+#endif /* TFM_PARTITION_NS_AGENT_MAILBOX */
+                            };
@@ -13,6 +13,22 @@
 #include "utilities.h"
 #include "tfm_hal_isolation.h"
 
+/*
+ * The client vectors were checked against the client boundary when the call
+ * was made. If the service runs in the same boundary the check on mapping
+ * gives the same result and is skipped. This is always the case at isolation
+ * level 1. Only the check is skipped, the vectors are mapped as before.
+ */
+static bool iovec_checked_in_boundary(const struct connection_t *handle)
+{
+    FIH_RET_TYPE(bool) fih_bool;
+
+    FIH_CALL(tfm_hal_boundary_need_switch, fih_bool,
+             handle->p_client->boundary, handle->service->partition->boundary);
+
+    return fih_eq(fih_bool, fih_int_encode(false));
+}
+
 const void *tfm_spm_partition_psa_map_invec(psa_handle_t msg_handle,
                                             uint32_t invec_idx)
 {
@@ -77,11 +93,13 @@ const void *tfm_spm_partition_psa_map_invec(psa_handle_t msg_handle,
      * It is a fatal error if the memory reference for the wrap input vector is
      * invalid or not readable.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
-             partition->boundary, (uintptr_t)handle->invec_base[invec_idx],
-             handle->msg.in_size[invec_idx], TFM_HAL_ACCESS_READABLE);
-    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
-        tfm_core_panic();
+    if (!iovec_checked_in_boundary(handle)) {
+        FIH_CALL(tfm_hal_memory_check, fih_rc,
+                 partition->boundary, (uintptr_t)handle->invec_base[invec_idx],
+                 handle->msg.in_size[invec_idx], TFM_HAL_ACCESS_READABLE);
+        if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+            tfm_core_panic();
+        }
     }
 
     SET_IOVEC_MAPPED(handle, (invec_idx + INVEC_IDX_BASE));
@@ -206,11 +224,13 @@ void *tfm_spm_partition_psa_map_outvec(psa_handle_t msg_handle,
     /*
      * It is a fatal error if the output vector is invalid or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
-             partition->boundary, (uintptr_t)handle->outvec_base[outvec_idx],
-             handle->msg.out_size[outvec_idx], TFM_HAL_ACCESS_READWRITE);
-    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
-        tfm_core_panic();
+    if (!iovec_checked_in_boundary(handle)) {
+        FIH_CALL(tfm_hal_memory_check, fih_rc,
+                 partition->boundary, (uintptr_t)handle->outvec_base[outvec_idx],
+                 handle->msg.out_size[outvec_idx], TFM_HAL_ACCESS_READWRITE);
+        if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+            tfm_core_panic();
+        }
     }
     SET_IOVEC_MAPPED(handle, (outvec_idx + OUTVEC_IDX_BASE));
 
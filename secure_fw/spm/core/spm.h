@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2021-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -27,6 +27,7 @@
 #define TFM_HANDLE_STATUS_IDLE          0 /* Handle created             */
 #define TFM_HANDLE_STATUS_ACTIVE        1 /* Handle in use              */
 #define TFM_HANDLE_STATUS_TO_FREE       2 /* Free the handle            */
+#define TFM_HANDLE_STATUS_CACHED        3 /* Kept for stateless reuse   */
 
 /* The mask used for timeout values */
 #define PSA_TIMEOUT_MASK        PSA_BLOCK
@@ -146,6 +147,27 @@ psa_status_t spm_validate_connection(const struct connection_t *p_connection);
 /* Panic if invalid connection is given. */
 void spm_free_connection(struct connection_t *p_connection);
 
+#if defined(CONFIG_TFM_CONNECTION_POOL_ENABLE) && \
+    (CONFIG_TFM_STATELESS_CONN_CACHE_NUM > 0)
+/* Statistics of the stateless connection cache */
+struct spm_conn_cache_stats_t {
+    uint32_t hits;          /* Calls served by a cached connection       */
+    uint32_t misses;        /* Calls which allocated from the pool       */
+    uint32_t reclaims;      /* Cached connections given back to the pool */
+};
+
+/*
+ * Take the cached stateless connection bound to 'service' and the current
+ * client, if any. Connections of stateless services are cached when freed,
+ * and given back to the pool only when it runs out of connections.
+ */
+struct connection_t *spm_get_cached_connection(const struct service_t *service,
+                                               int32_t client_id);
+
+/* Copy the statistics of the stateless connection cache to 'p_stats'. */
+void spm_get_conn_cache_stats(struct spm_conn_cache_stats_t *p_stats);
+#endif
+
 /******************** Partition management functions *************************/
 
 #if CONFIG_TFM_SPM_BACKEND_IPC == 1
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -13,6 +13,7 @@
 #include "tfm_pools.h"
 #include "load/service_defs.h"
 #include "private/assert.h"
+#include "tfm_spm_log.h"
 
 #if !(defined CONFIG_TFM_CONN_HANDLE_MAX_NUM) || (CONFIG_TFM_CONN_HANDLE_MAX_NUM == 0)
 #error "CONFIG_TFM_CONN_HANDLE_MAX_NUM must be defined and not zero."
@@ -22,6 +23,22 @@
 TFM_POOL_DECLARE(connection_pool, sizeof(struct connection_t),
                  CONFIG_TFM_CONN_HANDLE_MAX_NUM);
 
+#if CONFIG_TFM_STATELESS_CONN_CACHE_NUM > 0
+/*
+ * Stateless connections parked after their reply. They stay allocated from
+ * the pool and bound to their client and service, in the CACHED status which
+ * no client or service API accepts.
+ */
+static struct connection_t *conn_cache[CONFIG_TFM_STATELESS_CONN_CACHE_NUM];
+
+/* Value of conn_cache_clock when each cached connection was parked */
+static uint32_t conn_cache_stamp[CONFIG_TFM_STATELESS_CONN_CACHE_NUM];
+static uint32_t conn_cache_clock;
+
+/* Statistics of the cache, logged when a connection is reclaimed */
+static struct spm_conn_cache_stats_t conn_cache_stats;
+#endif
+
 /*********************** Connection handle conversion APIs *******************/
 
 #define CONVERSION_FACTOR_BITOFFSET    3
@@ -114,9 +131,104 @@ void spm_init_connection_space(void)
     }
 }
 
+#if CONFIG_TFM_STATELESS_CONN_CACHE_NUM > 0
+struct connection_t *spm_get_cached_connection(const struct service_t *service,
+                                               int32_t client_id)
+{
+    const struct partition_t *p_client = GET_CURRENT_COMPONENT();
+    struct connection_t *p_conn;
+    uint32_t i;
+
+    for (i = 0; i < CONFIG_TFM_STATELESS_CONN_CACHE_NUM; i++) {
+        p_conn = conn_cache[i];
+        if ((p_conn != NULL) && (p_conn->service == service) &&
+            (p_conn->p_client == p_client) &&
+            (p_conn->msg.client_id == client_id)) {
+            conn_cache[i] = NULL;
+            conn_cache_stats.hits++;
+            return p_conn;
+        }
+    }
+
+    conn_cache_stats.misses++;
+
+    return NULL;
+}
+
+void spm_get_conn_cache_stats(struct spm_conn_cache_stats_t *p_stats)
+{
+    SPM_ASSERT(p_stats != NULL);
+
+    *p_stats = conn_cache_stats;
+}
+
+/* Park a stateless connection, return false if the cache is full. */
+static bool conn_cache_park(struct connection_t *p_connection)
+{
+    uint32_t i;
+
+    for (i = 0; i < CONFIG_TFM_STATELESS_CONN_CACHE_NUM; i++) {
+        if (conn_cache[i] == NULL) {
+            p_connection->status = TFM_HANDLE_STATUS_CACHED;
+            conn_cache[i] = p_connection;
+            conn_cache_stamp[i] = conn_cache_clock++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Give the least recently parked connection back to the pool. A cached
+ * connection leaves the cache while it is used, so it is also the least
+ * recently used one.
+ */
+static bool conn_cache_reclaim(void)
+{
+    uint32_t i, oldest = CONFIG_TFM_STATELESS_CONN_CACHE_NUM;
+
+    for (i = 0; i < CONFIG_TFM_STATELESS_CONN_CACHE_NUM; i++) {
+        /* Compare the distance to the clock, which may have wrapped */
+        if ((conn_cache[i] != NULL) &&
+            ((oldest == CONFIG_TFM_STATELESS_CONN_CACHE_NUM) ||
+             ((conn_cache_clock - conn_cache_stamp[i]) >
+              (conn_cache_clock - conn_cache_stamp[oldest])))) {
+            oldest = i;
+        }
+    }
+
+    if (oldest == CONFIG_TFM_STATELESS_CONN_CACHE_NUM) {
+        return false;
+    }
+
+    tfm_pool_free(connection_pool, conn_cache[oldest]);
+    conn_cache[oldest] = NULL;
+    conn_cache_stats.reclaims++;
+
+    SPMLOG_DBGMSGVAL("Connection cache hits: ", conn_cache_stats.hits);
+    SPMLOG_DBGMSGVAL("Connection cache misses: ", conn_cache_stats.misses);
+    SPMLOG_DBGMSGVAL("Connection cache reclaims: ",
+                     conn_cache_stats.reclaims);
+
+    return true;
+}
+#endif /* CONFIG_TFM_STATELESS_CONN_CACHE_NUM > 0 */
+
 struct connection_t *spm_allocate_connection(void)
 {
-    return (struct connection_t *)tfm_pool_alloc(connection_pool);
+    struct connection_t *p_conn;
+
+    p_conn = (struct connection_t *)tfm_pool_alloc(connection_pool);
+
+#if CONFIG_TFM_STATELESS_CONN_CACHE_NUM > 0
+    /* Cached connections only hold chunks while the pool is not exhausted. */
+    if ((p_conn == NULL) && conn_cache_reclaim()) {
+        p_conn = (struct connection_t *)tfm_pool_alloc(connection_pool);
+    }
+#endif
+
+    return p_conn;
 }
 
 psa_status_t spm_validate_connection(const struct connection_t *p_connection)
@@ -134,6 +246,14 @@ void spm_free_connection(struct connection_t *p_connection)
 {
     SPM_ASSERT(p_connection != NULL);
 
+#if CONFIG_TFM_STATELESS_CONN_CACHE_NUM > 0
+    if ((p_connection->service != NULL) &&
+        SERVICE_IS_STATELESS(p_connection->service->p_ldinf->flags) &&
+        conn_cache_park(p_connection)) {
+        return;
+    }
+#endif
+
     /* Return handle buffer to pool */
     tfm_pool_free(connection_pool, p_connection);
 }
@@ -27,6 +27,7 @@
 #include "tfm_hal_interrupt.h"
 #include "tfm_hal_isolation.h"
 #include "spm.h"
+#include "spm_id_index.h"
 #include "tfm_peripherals_def.h"
 #include "tfm_nspm.h"
 #include "tfm_core_trustzone.h"
@@ -46,6 +47,97 @@
 static struct service_head_t services_listhead;
 struct service_t *stateless_services_ref_tbl[STATIC_HANDLE_NUM_LIMIT];
 
+/*
+ * ID lookup tables. The sorted ID lists are generated at build time, and the
+ * runtime objects are bound to the same index while loading. Lookups are
+ * bounded binary searches which never write to shared data.
+ */
+#if SPM_SERVICE_INDEX_NUM > 0
+static const uint32_t sorted_sids[SPM_SERVICE_INDEX_NUM] = {
+    SPM_SORTED_SID_LIST
+};
+static const struct service_t *services_by_idx[SPM_SERVICE_INDEX_NUM];
+#endif
+
+#if CONFIG_TFM_DOORBELL_API == 1
+static const int32_t sorted_pids[SPM_PARTITION_INDEX_NUM] = {
+    SPM_SORTED_PID_LIST
+};
+static struct partition_t *partitions_by_idx[SPM_PARTITION_INDEX_NUM];
+#endif
+
+#define SPM_INVALID_ID_IDX              (~0U)
+
+#if SPM_SERVICE_INDEX_NUM > 0
+static uint32_t sid_to_index(uint32_t sid)
+{
+    uint32_t lo = 0, hi = SPM_SERVICE_INDEX_NUM, mid;
+
+    while (lo < hi) {
+        mid = lo + ((hi - lo) >> 1);
+        if (sorted_sids[mid] == sid) {
+            return mid;
+        } else if (sorted_sids[mid] < sid) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return SPM_INVALID_ID_IDX;
+}
+#endif
+
+#if CONFIG_TFM_DOORBELL_API == 1
+static uint32_t pid_to_index(int32_t pid)
+{
+    uint32_t lo = 0, hi = SPM_PARTITION_INDEX_NUM, mid;
+
+    while (lo < hi) {
+        mid = lo + ((hi - lo) >> 1);
+        if (sorted_pids[mid] == pid) {
+            return mid;
+        } else if (sorted_pids[mid] < pid) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return SPM_INVALID_ID_IDX;
+}
+#endif
+
+/* Bind the loaded runtime objects to the build-time ID lookup tables. */
+static void spm_bind_id_index_assuredly(void)
+{
+#if SPM_SERVICE_INDEX_NUM > 0
+    struct service_t *p_service;
+    uint32_t sidx;
+
+    UNI_LIST_FOREACH(p_service, &services_listhead, next) {
+        sidx = sid_to_index(p_service->p_ldinf->sid);
+        if ((sidx == SPM_INVALID_ID_IDX) || services_by_idx[sidx]) {
+            tfm_core_panic();
+        }
+        services_by_idx[sidx] = p_service;
+    }
+#endif
+
+#if CONFIG_TFM_DOORBELL_API == 1
+    struct partition_t *p_part;
+    uint32_t pidx;
+
+    UNI_LIST_FOREACH(p_part, PARTITION_LIST_ADDR, next) {
+        pidx = pid_to_index(p_part->p_ldinf->pid);
+        if ((pidx == SPM_INVALID_ID_IDX) || partitions_by_idx[pidx]) {
+            tfm_core_panic();
+        }
+        partitions_by_idx[pidx] = p_part;
+    }
+#endif
+}
+
 /* Partition management functions */
 
 /* This API is only used in IPC backend. */
@@ -112,14 +204,15 @@ struct connection_t *spm_get_handle_by_signal(struct partition_t *p_ptn,
 
 const struct service_t *tfm_spm_get_service_by_sid(uint32_t sid)
 {
-    struct service_t *p_prev, *p_curr;
+#if SPM_SERVICE_INDEX_NUM > 0
+    uint32_t idx = sid_to_index(sid);
 
-    UNI_LIST_FOREACH_NODE_PREV(p_prev, p_curr, &services_listhead, next) {
-        if (p_curr->p_ldinf->sid == sid) {
-            UNI_LIST_MOVE_AFTER(&services_listhead, p_prev, p_curr, next);
-            return p_curr;
-        }
+    if (idx != SPM_INVALID_ID_IDX) {
+        return services_by_idx[idx];
     }
+#else
+    (void)sid;
+#endif
 
     return NULL;
 }
@@ -136,12 +229,10 @@ const struct service_t *tfm_spm_get_service_by_sid(uint32_t sid)
  */
 struct partition_t *tfm_spm_get_partition_by_id(int32_t partition_id)
 {
-    struct partition_t *p_part;
+    uint32_t idx = pid_to_index(partition_id);
 
-    UNI_LIST_FOREACH(p_part, PARTITION_LIST_ADDR, next) {
-        if (p_part->p_ldinf->pid == partition_id) {
-            return p_part;
-        }
+    if (idx != SPM_INVALID_ID_IDX) {
+        return partitions_by_idx[idx];
     }
 
     return NULL;
@@ -256,7 +347,15 @@ psa_status_t spm_get_idle_connection(struct connection_t **p_connection,
          * Protection should be established after the context management is
          * implemented.
          */
+#if defined(CONFIG_TFM_CONNECTION_POOL_ENABLE) && \
+    (CONFIG_TFM_STATELESS_CONN_CACHE_NUM > 0)
+        connection = spm_get_cached_connection(service, client_id);
+        if (connection == NULL) {
+            connection = spm_allocate_connection();
+        }
+#else
         connection = spm_allocate_connection();
+#endif
         if (connection == NULL) {
             return PSA_ERROR_CONNECTION_BUSY;
         }
@@ -318,6 +417,11 @@ struct connection_t *spm_msg_handle_to_connection(psa_handle_t msg_handle)
         return NULL;
     }
 
+    /* A cached stateless connection carries no message */
+    if (p_conn_handle->status == TFM_HANDLE_STATUS_CACHED) {
+        return NULL;
+    }
+
     /* Check that the running partition owns the message */
     partition_id = tfm_spm_partition_get_running_partition_id();
     if (partition_id != p_conn_handle->service->partition->p_ldinf->pid) {
@@ -432,6 +536,8 @@ uint32_t tfm_spm_init(void)
         backend_init_comp_assuredly(partition, service_setting);
     }
 
+    spm_bind_id_index_assuredly();
+
 #if CONFIG_TFM_POST_PARTITION_INIT_HOOK == 1
     /*
      * Platform can use CONFIG_TFM_POST_PARTITION_INIT_HOOK option to add extra initialization
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config_spm.h"
+#include "critical_section.h"
+#include "spm_trace.h"
+#include "tfm_hal_defs.h"
+#include "tfm_hal_trace.h"
+#include "utilities.h"
+
+#if CONFIG_TFM_SPM_TRACE == 1
+
+#define TRACE_REC_MASK          (CONFIG_TFM_SPM_TRACE_REC_NUM - 1)
+
+static struct spm_trace_rec_t trace_recs[CONFIG_TFM_SPM_TRACE_REC_NUM];
+
+/*
+ * Free-running counters of produced and drained records. The unsigned
+ * difference is the number of pending records, even after wrapping.
+ */
+static uint32_t trace_head;
+static uint32_t trace_tail;
+
+void spm_trace_init(void)
+{
+    if (tfm_hal_trace_timer_init() != TFM_HAL_SUCCESS) {
+        tfm_core_panic();
+    }
+}
+
+void spm_trace_record(uint32_t point, int32_t client_id, uint32_t sid)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    struct spm_trace_rec_t *p_rec;
+
+    /*
+     * Records come from Thread mode SPM code, PendSV and interrupt handlers.
+     * Masking interrupts for a few stores is the cheapest way to keep a
+     * record whole on every architecture, including those without exclusive
+     * access instructions.
+     */
+    CRITICAL_SECTION_ENTER(cs);
+    p_rec = &trace_recs[trace_head & TRACE_REC_MASK];
+    p_rec->cycles    = tfm_hal_trace_get_cycles();
+    p_rec->point     = point;
+    p_rec->client_id = client_id;
+    p_rec->sid       = sid;
+    trace_head++;
+    CRITICAL_SECTION_LEAVE(cs);
+}
+
+size_t spm_trace_drain(void *buf, size_t size)
+{
+    struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+    struct spm_trace_rec_t *p_out = (struct spm_trace_rec_t *)buf;
+    size_t n_out = size / sizeof(struct spm_trace_rec_t);
+    size_t n_done = 0;
+    uint32_t pending;
+
+    if (n_out == 0) {
+        return 0;
+    }
+
+    CRITICAL_SECTION_ENTER(cs);
+
+    pending = trace_head - trace_tail;
+    if (pending > CONFIG_TFM_SPM_TRACE_REC_NUM) {
+        /* The oldest records have been overwritten, report how many. */
+        p_out[n_done].cycles    = 0;
+        p_out[n_done].point     = SPM_TRACE_LOST;
+        p_out[n_done].client_id = 0;
+        p_out[n_done].sid       = pending - CONFIG_TFM_SPM_TRACE_REC_NUM;
+        n_done++;
+
+        trace_tail = trace_head - CONFIG_TFM_SPM_TRACE_REC_NUM;
+    }
+
+    while ((n_done < n_out) && (trace_tail != trace_head)) {
+        spm_memcpy(&p_out[n_done], &trace_recs[trace_tail & TRACE_REC_MASK],
+                   sizeof(struct spm_trace_rec_t));
+        trace_tail++;
+        n_done++;
+    }
+
+    CRITICAL_SECTION_LEAVE(cs);
+
+    return n_done * sizeof(struct spm_trace_rec_t);
+}
+
+#endif /* CONFIG_TFM_SPM_TRACE == 1 */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -43,10 +43,16 @@ psa_status_t tfm_pool_init(struct tfm_pool_instance_t *pool, size_t poolsz,
     /* Chain pool chunks */
     UNI_LIST_INIT_NODE(pool, next);
 
+    /*
+     * Chunks are laid out with the stride checked by
+     * is_valid_chunk_data_in_pool(). The chunk header can be padded beyond
+     * its data member, e.g. on 64-bit hosts.
+     */
     pchunk = (struct tfm_pool_chunk_t *)pool->chunks;
     for (i = 0; i < num; i++) {
         UNI_LIST_INSERT_AFTER(pool, pchunk, next);
-        pchunk = (struct tfm_pool_chunk_t *)&pchunk->data[chunksz];
+        pchunk = (struct tfm_pool_chunk_t *)((uint8_t *)pchunk +
+                                sizeof(struct tfm_pool_chunk_t) + chunksz);
     }
 
     /* Prepare instance and insert to pool list */
@@ -13,6 +13,7 @@
 #include "internal_status_code.h"
 #include "memory_symbols.h"
 #include "spm.h"
+#include "spm_trace.h"
 #include "svc_num.h"
 #include "tfm_arch.h"
 #include "tfm_svcalls.h"
@@ -195,7 +196,7 @@ bool tfm_svc_thread_mode_spm_active(void)
 static uint32_t handle_spm_svc_requests(uint32_t svc_number, uint32_t exc_return,
                                         uint32_t *svc_args, uint32_t *msp)
 {
-#if TFM_SP_LOG_RAW_ENABLED
+#if TFM_SP_LOG_RAW_ENABLED || (CONFIG_TFM_SPM_TRACE == 1)
     struct partition_t *curr_partition;
     fih_int fih_rc = FIH_FAILURE;
 #endif
@@ -234,6 +235,23 @@ static uint32_t handle_spm_svc_requests(uint32_t svc_number, uint32_t exc_return
         }
         break;
 #endif
+#if CONFIG_TFM_SPM_TRACE == 1
+    case TFM_SVC_GET_SPM_TRACE:
+        /* The trace exposes the call pattern of every client. */
+        curr_partition = GET_CURRENT_COMPONENT();
+        if (!IS_PSA_ROT(curr_partition->p_ldinf)) {
+            svc_args[0] = (uint32_t)PSA_ERROR_NOT_PERMITTED;
+            break;
+        }
+        FIH_CALL(tfm_hal_memory_check, fih_rc, curr_partition->boundary, (uintptr_t)svc_args[0],
+                 svc_args[1], TFM_HAL_ACCESS_READWRITE);
+        if (fih_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+            svc_args[0] = (uint32_t)spm_trace_drain((void *)svc_args[0], svc_args[1]);
+        } else {
+            tfm_core_panic();
+        }
+        break;
+#endif
 #if TFM_ISOLATION_LEVEL > 1
     case TFM_SVC_THREAD_MODE_SPM_RETURN:
         exc_return = thread_mode_spm_return(svc_args[0]);
@@ -8,12 +8,16 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "thread.h"
 #include "tfm_arch.h"
 #include "utilities.h"
 #include "private/assert.h"
 #include "critical_section.h"
+#if CONFIG_TFM_SPM_SCHED_BITMAP == 1
+#include "psa_manifest/pid.h"
+#endif
 
 /* Declaration of current thread pointer. */
 struct thread_t *p_curr_thrd;
@@ -34,6 +38,102 @@ void thrd_set_query_callback(thrd_query_state_t fn)
     query_state_cb = fn;
 }
 
+#if CONFIG_TFM_SPM_SCHED_BITMAP == 1
+
+/* The Idle Partition and the TrustZone NS Agent are not in manifest lists */
+#define RDY_SLOT_NUM        (TFM_MAX_USER_PARTITIONS + 2)
+#define RDY_MAP_WORDS       ((RDY_SLOT_NUM + 31) / 32)
+#define RDY_SLOT_WORD(s)    ((s) >> 5)
+/* The lowest slot (highest priority) goes to the MSB so that CLZ finds it. */
+#define RDY_SLOT_BIT(s)     (1UL << (31 - ((s) & 0x1F)))
+
+/*
+ * Slots are assigned in the order of the priority-sorted thread list, so the
+ * first set bit of the ready bitmap is the same thread the list walk would
+ * pick. A thread is 'ready' unless it is waiting for signals that are not
+ * asserted yet; backend signal handling keeps the bitmap updated.
+ */
+static uint32_t rdy_map[RDY_MAP_WORDS];
+static struct thread_t *rdy_slots[RDY_MAP_WORDS * 32];
+static bool rdy_map_valid = false;
+
+void thrd_mark_ready(struct thread_t *p_thrd)
+{
+    if (rdy_map_valid) {
+        rdy_map[RDY_SLOT_WORD(p_thrd->rdy_slot)] |=
+                                            RDY_SLOT_BIT(p_thrd->rdy_slot);
+    }
+}
+
+void thrd_mark_blocked(struct thread_t *p_thrd)
+{
+    if (rdy_map_valid) {
+        rdy_map[RDY_SLOT_WORD(p_thrd->rdy_slot)] &=
+                                            ~RDY_SLOT_BIT(p_thrd->rdy_slot);
+    }
+}
+
+static void thrd_build_rdy_map(void)
+{
+    struct thread_t *p_thrd = LIST_HEAD;
+    uint32_t slot = 0;
+
+    while (p_thrd) {
+        SPM_ASSERT(slot < RDY_SLOT_NUM);
+
+        p_thrd->rdy_slot = slot;
+        rdy_slots[slot] = p_thrd;
+        /* Every thread is a candidate, the first query settles the state. */
+        rdy_map[RDY_SLOT_WORD(slot)] |= RDY_SLOT_BIT(slot);
+
+        slot++;
+        p_thrd = p_thrd->next;
+    }
+
+    rdy_map_valid = true;
+}
+
+struct thread_t *thrd_next(void)
+{
+    struct thread_t *p_thrd = NULL;
+    uint32_t retval = 0;
+    uint32_t word = 0;
+    uint32_t slot;
+    struct critical_section_t cs_signal = CRITICAL_SECTION_STATIC_INIT;
+
+    CRITICAL_SECTION_ENTER(cs_signal);
+    while (word < RDY_MAP_WORDS) {
+        if (rdy_map[word] == 0) {
+            word++;
+            continue;
+        }
+
+        slot = (word << 5) + __CLZ(rdy_map[word]);
+        p_thrd = rdy_slots[slot];
+
+        /* Collect the return value if the signals have been asserted. */
+        p_thrd->state = query_state_cb(p_thrd, &retval);
+
+        if (p_thrd->state == THRD_STATE_RET_VAL_AVAIL) {
+            tfm_arch_set_context_ret_code(p_thrd->p_context_ctrl, retval);
+            p_thrd->state = THRD_STATE_RUNNABLE;
+        }
+
+        if (p_thrd->state == THRD_STATE_RUNNABLE) {
+            break;
+        }
+
+        /* Stale candidate, drop it and look for the next one. */
+        rdy_map[word] &= ~RDY_SLOT_BIT(slot);
+        p_thrd = NULL;
+    }
+    CRITICAL_SECTION_LEAVE(cs_signal);
+
+    return p_thrd;
+}
+
+#else /* CONFIG_TFM_SPM_SCHED_BITMAP == 1 */
+
 struct thread_t *thrd_next(void)
 {
     struct thread_t *p_thrd = RNBL_HEAD;
@@ -65,6 +165,8 @@ struct thread_t *thrd_next(void)
     return p_thrd;
 }
 
+#endif /* CONFIG_TFM_SPM_SCHED_BITMAP == 1 */
+
 static void insert_by_prior(struct thread_t **head, struct thread_t *node)
 {
     if ((*head == NULL) || (node->priority <= (*head)->priority)) {
@@ -113,11 +215,22 @@ void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state)
     } else {
         RNBL_HEAD = LIST_HEAD;
     }
+
+    if (p_thrd->state == THRD_STATE_RUNNABLE) {
+        THRD_MARK_READY(p_thrd);
+    }
 }
 
 uint32_t thrd_start_scheduler(struct thread_t **ppth)
 {
-    struct thread_t *pth = thrd_next();
+    struct thread_t *pth;
+
+#if CONFIG_TFM_SPM_SCHED_BITMAP == 1
+    /* All threads are started at this point, assign the ready slots. */
+    thrd_build_rdy_map();
+#endif
+
+    pth = thrd_next();
 
     arch_attempt_schedule();
 
@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "config_spm.h"
 #include "tfm_arch.h"
 
 /* State codes */
@@ -48,6 +49,9 @@ struct thread_t {
     uint16_t               flags;             /* Flags and align, DO NOT REMOVE!   */
     struct context_ctrl_t *p_context_ctrl;    /* Context control (sp, splimit, lr) */
     struct thread_t       *next;              /* Next thread in list               */
+#if CONFIG_TFM_SPM_SCHED_BITMAP == 1
+    uint32_t               rdy_slot;          /* Slot in the ready bitmap          */
+#endif
 };
 
 /* Query thread state function type */
@@ -128,6 +132,36 @@ void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state);
  */
 void thrd_start(struct thread_t *p_thrd, thrd_fn_t fn, thrd_fn_t exit_fn, void *param);
 
+#if CONFIG_TFM_SPM_SCHED_BITMAP == 1
+/*
+ * Mark the thread as a scheduling candidate in the ready bitmap.
+ *
+ * Parameters :
+ *  p_thrd         -     Pointer of thread_t struct
+ *
+ * Note :
+ *  The caller must hold the signal critical section.
+ */
+void thrd_mark_ready(struct thread_t *p_thrd);
+
+/*
+ * Remove the thread from the ready bitmap as it is blocked on signals.
+ *
+ * Parameters :
+ *  p_thrd         -     Pointer of thread_t struct
+ *
+ * Note :
+ *  The caller must hold the signal critical section.
+ */
+void thrd_mark_blocked(struct thread_t *p_thrd);
+
+#define THRD_MARK_READY(p_thrd)             thrd_mark_ready(p_thrd)
+#define THRD_MARK_BLOCKED(p_thrd)           thrd_mark_blocked(p_thrd)
+#else
+#define THRD_MARK_READY(p_thrd)
+#define THRD_MARK_BLOCKED(p_thrd)
+#endif /* CONFIG_TFM_SPM_SCHED_BITMAP == 1 */
+
 /*
  * Get the next thread to run in list.
  *
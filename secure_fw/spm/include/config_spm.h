@@ -32,4 +32,19 @@
 #error "Invalid config: CONFIG_TFM_SPM_BACKEND_SFN AND CONFIG_TFM_DOORBELL_API!"
 #endif
 
+#if (CONFIG_TFM_SPM_BACKEND_SFN == 1) && CONFIG_TFM_SPM_SCHED_BITMAP
+#error "Invalid config: CONFIG_TFM_SPM_BACKEND_SFN AND CONFIG_TFM_SPM_SCHED_BITMAP!"
+#endif
+
+#if (CONFIG_TFM_SPM_TRACE == 1) && \
+    ((CONFIG_TFM_SPM_TRACE_REC_NUM == 0) || \
+     ((CONFIG_TFM_SPM_TRACE_REC_NUM & (CONFIG_TFM_SPM_TRACE_REC_NUM - 1)) != 0))
+#error "Invalid config: CONFIG_TFM_SPM_TRACE_REC_NUM must be a power of 2!"
+#endif
+
+#if defined(CONFIG_TFM_CONNECTION_POOL_ENABLE) && \
+    (CONFIG_TFM_STATELESS_CONN_CACHE_NUM > CONFIG_TFM_CONN_HANDLE_MAX_NUM)
+#error "Invalid config: CONFIG_TFM_STATELESS_CONN_CACHE_NUM > CONFIG_TFM_CONN_HANDLE_MAX_NUM!"
+#endif
+
 #endif /* __CONFIG_PARTITION_SPM_H__ */
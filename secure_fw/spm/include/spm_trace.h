@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SPM_TRACE_H__
+#define __SPM_TRACE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config_spm.h"
+
+/*
+ * SPM trace points. The values are part of the record format decoded by
+ * tools/spm_trace_decode.py, do not renumber them.
+ */
+#define SPM_TRACE_PSA_CALL          1   /* tfm_spm_client_psa_call() entry   */
+#define SPM_TRACE_CALL_PARAMS       2   /* spm_associate_call_params() entry */
+#define SPM_TRACE_MESSAGING         3   /* backend_messaging() entry         */
+#define SPM_TRACE_PSA_GET           4   /* Message retrieved by psa_get()    */
+#define SPM_TRACE_PSA_REPLY         5   /* psa_reply() entry                 */
+#define SPM_TRACE_REPLYING          6   /* backend_replying() entry          */
+#define SPM_TRACE_SCHEDULE          7   /* ipc_schedule() switches thread    */
+#define SPM_TRACE_LOST              255 /* Records overwritten before drain  */
+
+/* One trace record, 16 bytes */
+struct spm_trace_rec_t {
+    uint32_t cycles;        /* Value of tfm_hal_trace_get_cycles()          */
+    uint32_t point;         /* SPM_TRACE_*                                  */
+    int32_t  client_id;     /* Client of the call, or the scheduled pid     */
+    uint32_t sid;           /* Target SID if known, or the count of LOST    */
+};
+
+#if CONFIG_TFM_SPM_TRACE == 1
+
+/* Start the trace counter. Called once during SPM initialization. */
+void spm_trace_init(void);
+
+/* Append a record, overwriting the oldest one when the buffer is full. */
+void spm_trace_record(uint32_t point, int32_t client_id, uint32_t sid);
+
+/*
+ * Move the pending records to 'buf', oldest first. A SPM_TRACE_LOST record is
+ * emitted first if records were overwritten since the last drain.
+ * Return the number of bytes written.
+ */
+size_t spm_trace_drain(void *buf, size_t size);
+
+#define SPM_TRACE(point, client_id, sid)                                    \
+            spm_trace_record((point), (int32_t)(client_id), (uint32_t)(sid))
+
+/* Trace a point with the client and SID of a connection */
+#define SPM_TRACE_CONN(point, p_conn)                                       \
+            SPM_TRACE((point), (p_conn)->msg.client_id,                     \
+                      (p_conn)->service ? (p_conn)->service->p_ldinf->sid : 0)
+
+#else /* CONFIG_TFM_SPM_TRACE == 1 */
+
+#define SPM_TRACE(point, client_id, sid)
+#define SPM_TRACE_CONN(point, p_conn)
+
+#endif /* CONFIG_TFM_SPM_TRACE == 1 */
+
+#endif /* __SPM_TRACE_H__ */
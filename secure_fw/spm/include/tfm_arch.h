@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -16,6 +16,14 @@
 #include <stddef.h>
 #include <inttypes.h>
 #include "fih.h"
+
+#define SCHEDULER_ATTEMPTED 2 /* Schedule attempt when scheduler is locked. */
+#define SCHEDULER_LOCKED    1
+#define SCHEDULER_UNLOCKED  0
+
+#if defined(TFM_ARCH_HOST)
+#include "tfm_arch_host.h"
+#else /* TFM_ARCH_HOST */
 #include "tfm_hal_device_header.h"
 #include "cmsis_compiler.h"
 
@@ -29,10 +37,6 @@
 #error "Unsupported ARM Architecture."
 #endif
 
-#define SCHEDULER_ATTEMPTED 2 /* Schedule attempt when scheduler is locked. */
-#define SCHEDULER_LOCKED    1
-#define SCHEDULER_UNLOCKED  0
-
 #define XPSR_T32            0x01000000
 
 /* Define IRQ level */
@@ -249,6 +253,7 @@ __STATIC_INLINE bool tfm_arch_is_priv(void)
 #else
 #define ARCH_FLUSH_FP_CONTEXT()
 #endif
+#endif /* TFM_ARCH_HOST */
 
 /* Set secure exceptions priority. */
 void tfm_arch_set_secure_exception_priorities(void);
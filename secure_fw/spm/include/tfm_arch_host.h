@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#ifndef __TFM_ARCH_HOST_H__
+#define __TFM_ARCH_HOST_H__
+
+/*
+ * Host simulation of the architecture layer. It lets the SPM core run as an
+ * ordinary process so that the IPC backend can be measured on a build machine.
+ * Threads are host execution contexts switched with ucontext, PendSV is
+ * replaced by a direct call to the scheduler and the interrupt mask is a plain
+ * variable. No isolation is provided.
+ *
+ * Stack addresses are pointer sized, so 64-bit hosts are supported. The thread
+ * switch does not use the 32-bit context values returned by ipc_schedule().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ucontext.h>
+
+#include "tfm_core_trustzone.h"
+#include "utilities.h"
+#include "private/assert.h"
+
+#if CONFIG_TFM_SECURE_THREAD_MASK_NS_INTERRUPT == 1
+#error CONFIG_TFM_SECURE_THREAD_MASK_NS_INTERRUPT is not supported on the host architecture
+#endif
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE                         static inline
+#endif
+
+#define EXC_RETURN_THREAD_PSP                   (0)
+#define EXC_NUM_THREAD_MODE                     (0)
+#define EXC_NUM_SVCALL                          (11)
+#define EXC_NUM_PENDSV                          (14)
+
+/* Simulated processor state, owned by tfm_arch_host.c */
+extern uint32_t host_irq_masked;
+extern uint32_t host_exc_num;
+
+/* State context defined by architecture */
+struct tfm_state_context_t {
+    uint32_t    r0;
+    uint32_t    r1;
+    uint32_t    r2;
+    uint32_t    r3;
+    uint32_t    r12;
+    uint32_t    lr;
+    uint32_t    ra;
+    uint32_t    xpsr;
+};
+
+/* Context addition to state context */
+struct tfm_additional_context_t {
+    uint32_t    integ_sign;    /* Integrity signature */
+    uint32_t    reserved;      /* Reserved */
+    uint32_t    callee[8];     /* Unused on the host */
+};
+
+/* Full thread context */
+struct full_context_t {
+    struct tfm_additional_context_t addi_ctx;
+    struct tfm_state_context_t      stat_ctx;
+};
+
+/*
+ * Context control. The first four members keep the layout and meaning of the
+ * Cortex-M version so the common ARCH_CTXCTRL_* helpers apply unchanged.
+ */
+struct context_ctrl_t {
+    uintptr_t               sp;           /* Stack pointer (higher address)  */
+    uint32_t                exc_ret;      /* Unused on the host              */
+    uintptr_t               sp_limit;     /* Stack limit (lower address)     */
+    uintptr_t               sp_base;      /* Stack usage start (higher addr) */
+    uint32_t                ret_code;     /* R0 to return on resume          */
+    uintptr_t               pfn;          /* Thread entry                    */
+    uintptr_t               param;        /* Thread entry parameter          */
+    uintptr_t               pfnlr;        /* Called when the entry returns   */
+    ucontext_t              uctx;         /* Host execution context          */
+};
+
+/* Assign stack and stack limit to the context control instance. */
+#define ARCH_CTXCTRL_INIT(x, buf, sz) do {                                   \
+            (x)->sp             = ((uintptr_t)(buf) + (sz)) & ~(uintptr_t)7; \
+            (x)->sp_limit       = ((uintptr_t)(buf) + 7) & ~(uintptr_t)7;    \
+            (x)->sp_base        = (x)->sp;                                   \
+            (x)->exc_ret        = 0;                                         \
+        } while (0)
+
+/* Allocate 'size' bytes in stack. */
+#define ARCH_CTXCTRL_ALLOCATE_STACK(x, size)                                 \
+            ((x)->sp             -= ((size) + 7) & ~0x7)
+
+/* The last allocated pointer. */
+#define ARCH_CTXCTRL_ALLOCATED_PTR(x)         ((x)->sp)
+
+/* Set state context parameter r0. */
+#define ARCH_STATE_CTX_SET_R0(x, r0_val)                                  \
+            ((x)->r0             = (uint32_t)(r0_val))
+
+/* Claim a statically initialized context control instance. */
+#define ARCH_CLAIM_CTXCTRL_INSTANCE(name, stack_buf, stack_size)          \
+            struct context_ctrl_t name = {                                \
+                .sp        = (uintptr_t)&stack_buf[stack_size],           \
+                .sp_base   = (uintptr_t)&stack_buf[stack_size],           \
+                .sp_limit  = (uintptr_t)stack_buf,                        \
+                .exc_ret   = 0,                                           \
+            }
+
+#define ARCH_FLUSH_FP_CONTEXT()
+
+/* Run the scheduling deferred while the interrupts were masked. */
+void tfm_arch_host_irq_unmasked(void);
+
+__STATIC_INLINE uint32_t __save_disable_irq(void)
+{
+    uint32_t result = host_irq_masked;
+
+    host_irq_masked = 1;
+    return result;
+}
+
+__STATIC_INLINE void __restore_irq(uint32_t status)
+{
+    host_irq_masked = status;
+    if (!status) {
+        tfm_arch_host_irq_unmasked();
+    }
+}
+
+__STATIC_INLINE uint32_t __get_active_exc_num(void)
+{
+    return host_exc_num;
+}
+
+/* The host process stack pointer, close enough for the SPM stack checks. */
+__STATIC_INLINE uintptr_t __get_PSP(void)
+{
+    return (uintptr_t)__builtin_frame_address(0);
+}
+
+__STATIC_INLINE uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+__STATIC_INLINE bool tfm_arch_is_priv(void)
+{
+    return true;
+}
+
+__STATIC_INLINE bool is_default_stacking_rules_apply(uint32_t lr)
+{
+    (void)lr;
+
+    return false;
+}
+
+__STATIC_INLINE uintptr_t arch_seal_thread_stack(uintptr_t stk)
+{
+    stk -= TFM_STACK_SEALED_SIZE;
+
+    *((uint32_t *)stk)       = TFM_STACK_SEAL_VALUE;
+    *((uint32_t *)(stk + 4)) = TFM_STACK_SEAL_VALUE;
+
+    return stk;
+}
+
+__STATIC_INLINE void tfm_arch_set_msplim(uint32_t msplim)
+{
+    (void)msplim;
+}
+
+__STATIC_INLINE void tfm_arch_config_branch_protection(void)
+{
+}
+
+/*
+ * Call an SPM PSA API implementation from a partition thread. This replaces
+ * tfm_arch_thread_fn_call(): the scheduler lock is taken for the call and the
+ * pending scheduling, if any, takes place before returning. The returned value
+ * is the one written by tfm_arch_set_context_ret_code() if the thread was
+ * blocked in between, otherwise 'result'.
+ */
+void tfm_arch_host_enter_spm(void);
+uint32_t tfm_arch_host_leave_spm(uint32_t result);
+
+#endif /* __TFM_ARCH_HOST_H__ */
@@ -0,0 +1,634 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file crypto_host_harness.c
+ *
+ * \brief Host benchmarks of the crypto service.
+ *
+ * \details The client interface and the crypto modules are built for the
+ *          host, on top of the service model of crypto_host_service.c and the
+ *          OpenSSL backend of crypto_host_library.c. Clients are threads which
+ *          call the PSA Crypto API, and the service serves their requests one
+ *          at a time, as the partition does. The workloads are:
+ *
+ *          - latency: a client signs hashes back to back with ECDSA P-256,
+ *            either with psa_sign_hash() or with the interruptible functions
+ *            and the given max ops, while another client sends short SHA-256
+ *            requests at random times. The latency of the short requests and
+ *            the time of a signature are reported. The signatures and hashes
+ *            are checked.
+ *          - rng: a client asks for random bytes with psa_generate_random(),
+ *            8 bytes at a time by default. The time per request, with and
+ *            without the thread switches of the host model, and the number of
+ *            DRBG calls per request are reported. Built with and without
+ *            CRYPTO_RNG_POOL_SIZE, it measures the pool of random bytes. With
+ *            -f, tfm_crypto_generate_random_fresh() is called instead, which
+ *            bypasses the pool. The number of DRBG calls is checked against
+ *            the pool size, and each output must differ from the previous one.
+ *          - mac: a client computes the HMAC-SHA256 of small messages, in
+ *            rounds of as many messages as a batch holds, first with one
+ *            psa_mac_compute() call per message and then with one batch per
+ *            round. The time per MAC, with and without the thread switches of
+ *            the host model, is reported for both. The MACs are checked.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include "config_tfm.h"
+#include "crypto_host_library.h"
+#include "crypto_host_service.h"
+#include "psa/crypto.h"
+#include "tfm_crypto_batch.h"
+#include "tfm_crypto_random.h"
+
+/* Client IDs of the client threads */
+#define SIGNER_CLIENT_ID        (-1)
+#define SHORT_CLIENT_ID         (-2)
+
+/* Size of the input of the short requests */
+#define SHORT_INPUT_SIZE        (64u)
+
+/* Number of signatures kept to be verified at the end of the run */
+#define NUM_CHECKED_SIGNATURES  (16u)
+
+/* Any key ID, the backend uses the same key for all */
+#define SIGN_KEY_ID             ((psa_key_id_t)1)
+
+#define SIGN_ALG                PSA_ALG_ECDSA(PSA_ALG_SHA_256)
+
+/* Largest request of the rng workload */
+#define MAX_RANDOM_SIZE         (1024u)
+
+/* Largest message of the mac workload */
+#define MAX_MAC_INPUT_SIZE      (256u)
+
+/* Any key ID, the backend derives the HMAC key from it */
+#define MAC_KEY_ID              ((psa_key_id_t)2)
+
+#define MAC_ALG                 PSA_ALG_HMAC(PSA_ALG_SHA_256)
+#define MAC_SIZE                PSA_HASH_LENGTH(PSA_ALG_SHA_256)
+
+/* Aligns a size up to the alignment of the batch buffers */
+#define BATCH_ALIGN(x)          (((x) + (TFM_CRYPTO_IOVEC_ALIGNMENT - 1)) & \
+                                 ~(TFM_CRYPTO_IOVEC_ALIGNMENT - 1))
+
+enum workload_t {
+    WORKLOAD_LATENCY,
+    WORKLOAD_RNG,
+    WORKLOAD_MAC,
+};
+
+static enum workload_t g_workload = WORKLOAD_LATENCY;
+static uint32_t g_num_requests = 2000;
+static uint32_t g_num_signers = 1;
+static uint32_t g_max_ops;
+static uint32_t g_max_think_us = 200;
+static uint32_t g_random_size = 8;
+static bool g_random_fresh;
+static uint32_t g_batch_size = TFM_CRYPTO_BATCH_MAX_NUM;
+static uint64_t g_num_errors;
+
+/* Signer state */
+static volatile bool g_stop_signers;
+static uint64_t g_num_signatures;
+static uint64_t g_sign_time_ns;
+static uint8_t g_hashes[NUM_CHECKED_SIGNATURES][PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+static uint8_t g_signatures[NUM_CHECKED_SIGNATURES][PSA_SIGNATURE_MAX_SIZE];
+static size_t g_signature_lengths[NUM_CHECKED_SIGNATURES];
+static pthread_mutex_t g_signer_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Prints the mean, median, 99th percentile and max of the samples in us */
+static void print_latencies(const char *name, uint64_t *samples, uint32_t num)
+{
+    uint64_t sum = 0;
+    uint32_t i;
+
+    if (num == 0) {
+        return;
+    }
+
+    qsort(samples, num, sizeof(samples[0]), compare_u64);
+    for (i = 0; i < num; i++) {
+        sum += samples[i];
+    }
+
+    printf("%s: mean %.1f us, median %.1f us, p99 %.1f us, max %.1f us\n",
+           name, (double)sum / num / 1000.0,
+           (double)samples[num / 2] / 1000.0,
+           (double)samples[(uint64_t)num * 99 / 100] / 1000.0,
+           (double)samples[num - 1] / 1000.0);
+}
+
+/* ---- Latency workload ---- */
+
+static psa_status_t sign_one(const uint8_t *hash, uint8_t *signature,
+                             size_t *signature_length)
+{
+    psa_sign_hash_interruptible_operation_t operation =
+                                    PSA_SIGN_HASH_INTERRUPTIBLE_OPERATION_INIT;
+    psa_status_t status;
+
+    if (g_max_ops == 0) {
+        return psa_sign_hash(SIGN_KEY_ID, SIGN_ALG,
+                             hash, PSA_HASH_LENGTH(PSA_ALG_SHA_256),
+                             signature, PSA_SIGNATURE_MAX_SIZE,
+                             signature_length);
+    }
+
+    psa_interruptible_set_max_ops(g_max_ops);
+
+    status = psa_sign_hash_start(&operation, SIGN_KEY_ID, SIGN_ALG,
+                                 hash, PSA_HASH_LENGTH(PSA_ALG_SHA_256));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    do {
+        status = psa_sign_hash_complete(&operation, signature,
+                                        PSA_SIGNATURE_MAX_SIZE,
+                                        signature_length);
+    } while (status == PSA_OPERATION_INCOMPLETE);
+
+    return status;
+}
+
+static void *signer_thread(void *arg)
+{
+    uint8_t hash[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+    uint8_t signature[PSA_SIGNATURE_MAX_SIZE];
+    size_t signature_length;
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t n;
+    psa_status_t status;
+
+    crypto_host_set_client_id((int32_t)(intptr_t)arg);
+
+    while (!g_stop_signers) {
+        pthread_mutex_lock(&g_signer_lock);
+        n = g_num_signatures++;
+        pthread_mutex_unlock(&g_signer_lock);
+
+        (void)memset(hash, (int)(n & 0xFF), sizeof(hash));
+        (void)memcpy(hash, &n, sizeof(n));
+
+        start = now_ns();
+        status = sign_one(hash, signature, &signature_length);
+        elapsed = now_ns() - start;
+
+        pthread_mutex_lock(&g_signer_lock);
+        g_sign_time_ns += elapsed;
+        if (status != PSA_SUCCESS) {
+            g_num_errors++;
+        } else if (n < NUM_CHECKED_SIGNATURES) {
+            (void)memcpy(g_hashes[n], hash, sizeof(hash));
+            (void)memcpy(g_signatures[n], signature, signature_length);
+            g_signature_lengths[n] = signature_length;
+        }
+        pthread_mutex_unlock(&g_signer_lock);
+    }
+
+    return NULL;
+}
+
+static int run_latency(void)
+{
+    pthread_t signers[4];
+    uint64_t *latencies;
+    uint8_t input[SHORT_INPUT_SIZE];
+    uint8_t hash[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+    uint8_t expected[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+    unsigned int expected_length;
+    size_t hash_length;
+    unsigned int seed = 1;
+    uint64_t start;
+    uint64_t num_signatures;
+    uint32_t i;
+    psa_status_t status;
+
+    if (g_num_signers > sizeof(signers) / sizeof(signers[0])) {
+        printf("at most %zu signers\n", sizeof(signers) / sizeof(signers[0]));
+        return 1;
+    }
+
+    latencies = calloc(g_num_requests, sizeof(latencies[0]));
+    if (latencies == NULL) {
+        return 1;
+    }
+
+    for (i = 0; i < g_num_signers; i++) {
+        (void)pthread_create(&signers[i], NULL, signer_thread,
+                             (void *)(intptr_t)(SIGNER_CLIENT_ID - (int32_t)i * 2));
+    }
+
+    crypto_host_set_client_id(SHORT_CLIENT_ID);
+
+    for (i = 0; i < g_num_requests; i++) {
+        if (g_max_think_us > 0) {
+            (void)usleep((useconds_t)(rand_r(&seed) % g_max_think_us));
+        }
+
+        (void)memset(input, (int)i, sizeof(input));
+
+        start = now_ns();
+        status = psa_hash_compute(PSA_ALG_SHA_256, input, sizeof(input),
+                                  hash, sizeof(hash), &hash_length);
+        latencies[i] = now_ns() - start;
+
+        (void)EVP_Digest(input, sizeof(input), expected, &expected_length,
+                         EVP_sha256(), NULL);
+        if ((status != PSA_SUCCESS) || (hash_length != expected_length) ||
+            (memcmp(hash, expected, hash_length) != 0)) {
+            g_num_errors++;
+        }
+    }
+
+    g_stop_signers = true;
+    for (i = 0; i < g_num_signers; i++) {
+        (void)pthread_join(signers[i], NULL);
+    }
+
+    /* The signers are stopped, check some of their signatures */
+    num_signatures = g_num_signatures;
+    for (i = 0; (i < NUM_CHECKED_SIGNATURES) && (i < num_signatures); i++) {
+        if (psa_verify_hash(SIGN_KEY_ID, SIGN_ALG, g_hashes[i], sizeof(hash),
+                            g_signatures[i],
+                            g_signature_lengths[i]) != PSA_SUCCESS) {
+            g_num_errors++;
+        }
+    }
+
+    if (g_num_signers == 0) {
+        printf("no signer:\n");
+    } else if (g_max_ops == 0) {
+        printf("%" PRIu32 " signers, psa_sign_hash(): %" PRIu64
+               " signatures, %.1f us per signature\n",
+               g_num_signers, num_signatures,
+               (num_signatures != 0) ?
+               ((double)g_sign_time_ns / num_signatures / 1000.0) : 0.0);
+    } else {
+        printf("%" PRIu32 " signers, interruptible with max ops %" PRIu32
+               ": %" PRIu64 " signatures, %.1f us per signature\n",
+               g_num_signers, g_max_ops, num_signatures,
+               (num_signatures != 0) ?
+               ((double)g_sign_time_ns / num_signatures / 1000.0) : 0.0);
+    }
+    print_latencies("  short request latency", latencies, g_num_requests);
+
+    free(latencies);
+
+    return 0;
+}
+
+/* ---- RNG workload ---- */
+
+/* DRBG calls expected for the requests, including the pool fill at init */
+static uint64_t expected_drbg_calls(void)
+{
+    uint64_t num_bytes = (uint64_t)g_num_requests * g_random_size;
+
+#if CRYPTO_RNG_POOL_SIZE > 0
+    if ((g_random_size <= CRYPTO_RNG_POOL_MAX_REQUEST) && !g_random_fresh) {
+        /* Refilled only once empty, the fill at init counts as the first */
+        if (num_bytes == 0) {
+            return 1;
+        }
+
+        return (num_bytes + CRYPTO_RNG_POOL_SIZE - 1) / CRYPTO_RNG_POOL_SIZE;
+    }
+
+    return 1 + g_num_requests;
+#else
+    (void)num_bytes;
+
+    return g_num_requests;
+#endif
+}
+
+static int run_rng(void)
+{
+    uint8_t output[2][MAX_RANDOM_SIZE];
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t dispatch_ns;
+    uint64_t num_drbg_calls;
+    uint32_t i;
+    psa_status_t status;
+
+    if ((g_random_size == 0) || (g_random_size > MAX_RANDOM_SIZE)) {
+        printf("the size must be between 1 and %u\n", MAX_RANDOM_SIZE);
+        return 1;
+    }
+
+    crypto_host_set_client_id(SHORT_CLIENT_ID);
+
+    (void)memset(output, 0, sizeof(output));
+    dispatch_ns = crypto_host_service_get_dispatch_time_ns();
+
+    start = now_ns();
+    for (i = 0; i < g_num_requests; i++) {
+        if (g_random_fresh) {
+            status = tfm_crypto_generate_random_fresh(output[i & 1],
+                                                      g_random_size);
+        } else {
+            status = psa_generate_random(output[i & 1], g_random_size);
+        }
+        if ((status != PSA_SUCCESS) ||
+            (memcmp(output[0], output[1], g_random_size) == 0)) {
+            g_num_errors++;
+        }
+    }
+    elapsed = now_ns() - start;
+
+    dispatch_ns = crypto_host_service_get_dispatch_time_ns() - dispatch_ns;
+    num_drbg_calls = crypto_host_library_get_num_drbg_calls();
+
+    if (num_drbg_calls != expected_drbg_calls()) {
+        printf("%" PRIu64 " DRBG calls, %" PRIu64 " expected\n",
+               num_drbg_calls, expected_drbg_calls());
+        g_num_errors++;
+    }
+
+    printf("rng pool %u bytes, %" PRIu32 " %srequests of %" PRIu32 " bytes: "
+           "%.2f us per request, %.3f us in the service, "
+           "%.3f DRBG calls per request\n",
+           CRYPTO_RNG_POOL_SIZE, g_num_requests,
+           g_random_fresh ? "fresh " : "", g_random_size,
+           (g_num_requests != 0) ?
+           ((double)elapsed / g_num_requests / 1000.0) : 0.0,
+           (g_num_requests != 0) ?
+           ((double)dispatch_ns / g_num_requests / 1000.0) : 0.0,
+           (g_num_requests != 0) ?
+           ((double)num_drbg_calls / g_num_requests) : 0.0);
+
+    return 0;
+}
+
+/* ---- MAC workload ---- */
+
+/* Checks a MAC computed by the service against OpenSSL */
+static void check_mac(const uint8_t *input, const uint8_t *mac,
+                      size_t mac_length)
+{
+    uint8_t key[CRYPTO_HOST_MAC_KEY_SIZE];
+    uint8_t expected[MAC_SIZE];
+    unsigned int expected_length;
+
+    crypto_host_library_get_mac_key(MAC_KEY_ID, key);
+
+    if ((HMAC(EVP_sha256(), key, sizeof(key), input, g_random_size,
+              expected, &expected_length) == NULL) ||
+        (mac_length != expected_length) ||
+        (memcmp(mac, expected, expected_length) != 0)) {
+        g_num_errors++;
+    }
+}
+
+/* Fills the messages of a round, distinct for each round */
+static void fill_inputs(uint8_t inputs[][MAX_MAC_INPUT_SIZE], uint32_t round)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_batch_size; i++) {
+        (void)memset(inputs[i], (int)i, g_random_size);
+        (void)memcpy(inputs[i], &round,
+                     (g_random_size < sizeof(round)) ?
+                     g_random_size : sizeof(round));
+    }
+}
+
+/* Prints the time per MAC of a run */
+static void print_mac_time(const char *name, uint32_t num_macs,
+                           uint64_t elapsed, uint64_t dispatch_ns)
+{
+    printf("  %s: %.2f us per MAC, %.3f us in the service\n", name,
+           (num_macs != 0) ? ((double)elapsed / num_macs / 1000.0) : 0.0,
+           (num_macs != 0) ? ((double)dispatch_ns / num_macs / 1000.0) : 0.0);
+}
+
+static int run_mac(void)
+{
+    static uint8_t inputs[TFM_CRYPTO_BATCH_MAX_NUM][MAX_MAC_INPUT_SIZE];
+    static uint8_t in_buf[TFM_CRYPTO_BATCH_MAX_NUM *
+                          BATCH_ALIGN(MAX_MAC_INPUT_SIZE)]
+                          __attribute__((aligned(TFM_CRYPTO_IOVEC_ALIGNMENT)));
+    static uint8_t out_buf[TFM_CRYPTO_BATCH_MAX_NUM * BATCH_ALIGN(MAC_SIZE)]
+                          __attribute__((aligned(TFM_CRYPTO_IOVEC_ALIGNMENT)));
+    struct tfm_crypto_batch_cmd cmds[TFM_CRYPTO_BATCH_MAX_NUM];
+    struct tfm_crypto_batch_result results[TFM_CRYPTO_BATCH_MAX_NUM];
+    struct tfm_crypto_batch_t batch;
+    uint8_t *macs[TFM_CRYPTO_BATCH_MAX_NUM];
+    uint8_t single_macs[TFM_CRYPTO_BATCH_MAX_NUM][MAC_SIZE];
+    size_t single_lengths[TFM_CRYPTO_BATCH_MAX_NUM];
+    psa_status_t single_status[TFM_CRYPTO_BATCH_MAX_NUM];
+    uint32_t num_rounds;
+    uint32_t round;
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t dispatch_ns;
+    uint32_t i;
+    psa_status_t status;
+
+    if ((g_random_size == 0) || (g_random_size > MAX_MAC_INPUT_SIZE) ||
+        (g_batch_size == 0) || (g_batch_size > TFM_CRYPTO_BATCH_MAX_NUM)) {
+        printf("the size must be between 1 and %u, the batch size between 1 "
+               "and %u\n", MAX_MAC_INPUT_SIZE, TFM_CRYPTO_BATCH_MAX_NUM);
+        return 1;
+    }
+
+    crypto_host_set_client_id(SHORT_CLIENT_ID);
+
+    num_rounds = (g_num_requests + g_batch_size - 1) / g_batch_size;
+
+    printf("mac of %" PRIu32 " bytes, %" PRIu32 " rounds of %" PRIu32
+           " messages:\n", g_random_size, num_rounds, g_batch_size);
+
+    /* One call per message */
+    elapsed = 0;
+    dispatch_ns = crypto_host_service_get_dispatch_time_ns();
+    for (round = 0; round < num_rounds; round++) {
+        fill_inputs(inputs, round);
+
+        start = now_ns();
+        for (i = 0; i < g_batch_size; i++) {
+            single_status[i] = psa_mac_compute(MAC_KEY_ID, MAC_ALG,
+                                               inputs[i], g_random_size,
+                                               single_macs[i], MAC_SIZE,
+                                               &single_lengths[i]);
+        }
+        elapsed += now_ns() - start;
+
+        for (i = 0; i < g_batch_size; i++) {
+            if (single_status[i] != PSA_SUCCESS) {
+                g_num_errors++;
+            } else {
+                check_mac(inputs[i], single_macs[i], single_lengths[i]);
+            }
+        }
+    }
+    dispatch_ns = crypto_host_service_get_dispatch_time_ns() - dispatch_ns;
+    print_mac_time("single", num_rounds * g_batch_size, elapsed, dispatch_ns);
+
+    /* One batch per round, built as a client would for each round */
+    elapsed = 0;
+    dispatch_ns = crypto_host_service_get_dispatch_time_ns();
+    for (round = 0; round < num_rounds; round++) {
+        fill_inputs(inputs, round);
+
+        start = now_ns();
+        tfm_crypto_batch_init(&batch, cmds, g_batch_size, in_buf,
+                              sizeof(in_buf), out_buf, sizeof(out_buf));
+        for (i = 0; i < g_batch_size; i++) {
+            if (tfm_crypto_batch_add_mac_compute(&batch, MAC_KEY_ID, MAC_ALG,
+                                                 inputs[i], g_random_size,
+                                                 MAC_SIZE,
+                                                 &macs[i]) != PSA_SUCCESS) {
+                g_num_errors++;
+                return 1;
+            }
+        }
+        status = tfm_crypto_batch_run(&batch, results);
+        elapsed += now_ns() - start;
+
+        if (status != PSA_SUCCESS) {
+            g_num_errors++;
+            continue;
+        }
+        for (i = 0; i < g_batch_size; i++) {
+            if (results[i].status != PSA_SUCCESS) {
+                g_num_errors++;
+            } else {
+                check_mac(inputs[i], macs[i], results[i].out_len[0]);
+            }
+        }
+    }
+    dispatch_ns = crypto_host_service_get_dispatch_time_ns() - dispatch_ns;
+    print_mac_time("batched", num_rounds * g_batch_size, elapsed, dispatch_ns);
+
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [options]\n"
+           "  -w <workload>  latency, rng or mac (default latency)\n"
+           "  -n <num>       Number of short requests, random requests or MACs\n"
+           "                 (default 2000)\n"
+           "  -s <num>       Number of signing clients, at most 4 (default 1)\n"
+           "  -m <num>       Max ops of each call of the interruptible signature,\n"
+           "                 0 to use psa_sign_hash() (default 0)\n"
+           "  -t <us>        Max time between two short requests (default 200)\n"
+           "  -b <bytes>     Size of the random requests, at most %u, or of the MAC\n"
+           "                 inputs, at most %u (default 8)\n"
+           "  -k <num>       Number of MACs per batch, at most %u (default %u)\n"
+           "  -f             Random requests bypass the pool of random bytes\n"
+           "  -h             Print this help\n",
+           prog, MAX_RANDOM_SIZE, MAX_MAC_INPUT_SIZE, TFM_CRYPTO_BATCH_MAX_NUM,
+           TFM_CRYPTO_BATCH_MAX_NUM);
+}
+
+int main(int argc, char *argv[])
+{
+    int opt;
+    int ret;
+
+    while ((opt = getopt(argc, argv, "w:n:s:m:t:b:k:fh")) != -1) {
+        switch (opt) {
+        case 'w':
+            if (strcmp(optarg, "latency") == 0) {
+                g_workload = WORKLOAD_LATENCY;
+            } else if (strcmp(optarg, "rng") == 0) {
+                g_workload = WORKLOAD_RNG;
+            } else if (strcmp(optarg, "mac") == 0) {
+                g_workload = WORKLOAD_MAC;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'n':
+            g_num_requests = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            g_num_signers = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'm':
+            g_max_ops = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            g_max_think_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'b':
+            g_random_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            g_random_fresh = true;
+            break;
+        case 'k':
+            g_batch_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (crypto_host_service_start() != PSA_SUCCESS) {
+        printf("cannot start the crypto service\n");
+        return 1;
+    }
+
+    switch (g_workload) {
+    case WORKLOAD_LATENCY:
+        ret = run_latency();
+        break;
+    case WORKLOAD_RNG:
+        ret = run_rng();
+        break;
+    case WORKLOAD_MAC:
+        ret = run_mac();
+        break;
+    default:
+        ret = 1;
+        break;
+    }
+
+    crypto_host_service_stop();
+
+    printf("%" PRIu64 " errors\n", g_num_errors);
+
+    return ((ret == 0) && (g_num_errors == 0)) ? 0 : 1;
+}
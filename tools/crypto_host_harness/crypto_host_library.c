@@ -0,0 +1,764 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file crypto_host_library.c
+ *
+ * \brief Host backend of the PSA Crypto functions called by the crypto
+ *        modules, in place of Mbed TLS, built on OpenSSL. The names are
+ *        prefixed as in the partition by crypto_spe.h.
+ *
+ * \details Every key ID refers to the same ECDSA P-256 key pair, generated at
+ *          init. The ECDSA signature runs its scalar multiplication one point
+ *          doubling or addition at a time, each counting as a basic operation
+ *          as in the Mbed TLS restartable ECP, so that the interruptible
+ *          functions stop after the max ops set by the caller. The blocking
+ *          psa_sign_hash() runs the same steps in a single call. Random bytes
+ *          come from a CTR-DRBG with AES-256, as in the Mbed TLS
+ *          configuration of the service, and its calls are counted. MACs are
+ *          HMAC-SHA256 with the key given by crypto_host_library_get_mac_key()
+ *          for the key ID. The functions which the benchmarks do not use
+ *          return PSA_ERROR_NOT_SUPPORTED.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/obj_mac.h>
+#include <openssl/params.h>
+
+#include "config_tfm.h"
+#include "tfm_mbedcrypto_include.h"
+
+#include "crypto_host_library.h"
+#include "crypto_library.h"
+
+/* Size of a P-256 scalar or coordinate in bytes */
+#define ECC_P256_SIZE           (32u)
+
+/* Max bytes of a DRBG call, MBEDTLS_CTR_DRBG_MAX_REQUEST of Mbed TLS */
+#define DRBG_MAX_REQUEST        (1024u)
+
+/* Number of interruptible signatures in progress at once */
+#define NUM_SIGN_STATES         (CRYPTO_CONC_OPER_NUM)
+
+/* State of an interruptible signature, referred to by the operation handle */
+struct sign_state_t {
+    bool in_use;
+    BIGNUM *k;              /* Ephemeral scalar */
+    BIGNUM *e;              /* Hash as an integer */
+    EC_POINT *r_point;      /* k.G being computed */
+    int bit;                /* Next bit of k to process */
+    bool add_pending;       /* Whether G is added before the next doubling */
+    uint32_t num_ops;       /* Basic operations done so far */
+};
+
+static EC_GROUP *g_group;
+static BN_CTX *g_bn_ctx;
+static BIGNUM *g_priv_key;
+static EC_POINT *g_pub_key;
+static uint32_t g_max_ops = PSA_INTERRUPTIBLE_MAX_OPS_UNLIMITED;
+static struct sign_state_t g_sign_states[NUM_SIGN_STATES];
+static EVP_RAND_CTX *g_drbg;
+static uint64_t g_num_drbg_calls;
+
+tfm_crypto_library_key_id_t tfm_crypto_library_key_id_init(int32_t owner,
+                                                            psa_key_id_t key_id)
+{
+    return mbedtls_svc_key_id_make(owner, key_id);
+}
+
+/* Instantiates the DRBG, seeded by the default entropy source of OpenSSL */
+static psa_status_t drbg_init(void)
+{
+    EVP_RAND *rand;
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string("cipher", "AES-256-CTR", 0),
+        OSSL_PARAM_END,
+    };
+
+    rand = EVP_RAND_fetch(NULL, "CTR-DRBG", NULL);
+    if (rand == NULL) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    g_drbg = EVP_RAND_CTX_new(rand, NULL);
+    EVP_RAND_free(rand);
+    if (g_drbg == NULL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    if (!EVP_RAND_instantiate(g_drbg, 0, 0, NULL, 0, params)) {
+        return PSA_ERROR_INSUFFICIENT_ENTROPY;
+    }
+
+    return PSA_SUCCESS;
+}
+
+uint64_t crypto_host_library_get_num_drbg_calls(void)
+{
+    return g_num_drbg_calls;
+}
+
+psa_status_t crypto_host_library_init(void)
+{
+    psa_status_t status;
+
+    status = drbg_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    g_group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    g_bn_ctx = BN_CTX_new();
+    g_priv_key = BN_new();
+    if ((g_group == NULL) || (g_bn_ctx == NULL) || (g_priv_key == NULL)) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    g_pub_key = EC_POINT_new(g_group);
+    if (g_pub_key == NULL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    do {
+        if (!BN_rand_range(g_priv_key, EC_GROUP_get0_order(g_group))) {
+            return PSA_ERROR_INSUFFICIENT_ENTROPY;
+        }
+    } while (BN_is_zero(g_priv_key));
+
+    if (!EC_POINT_mul(g_group, g_pub_key, g_priv_key, NULL, NULL, g_bn_ctx)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/* ---- Random ---- */
+
+psa_status_t psa_generate_random(uint8_t *output, size_t output_size)
+{
+    size_t len;
+
+    g_num_drbg_calls++;
+
+    /* Split as the Mbed TLS DRBG does, by its max request size */
+    while (output_size > 0) {
+        len = (output_size < DRBG_MAX_REQUEST) ? output_size : DRBG_MAX_REQUEST;
+        if (!EVP_RAND_generate(g_drbg, output, len, 0, 0, NULL, 0)) {
+            return PSA_ERROR_INSUFFICIENT_ENTROPY;
+        }
+        output += len;
+        output_size -= len;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/* ---- MAC ---- */
+
+void crypto_host_library_get_mac_key(psa_key_id_t key_id,
+                                     uint8_t key[CRYPTO_HOST_MAC_KEY_SIZE])
+{
+    (void)memset(key, 0xA5, CRYPTO_HOST_MAC_KEY_SIZE);
+    (void)memcpy(key, &key_id, sizeof(key_id));
+}
+
+psa_status_t psa_mac_compute(mbedtls_svc_key_id_t key,
+                             psa_algorithm_t alg,
+                             const uint8_t *input,
+                             size_t input_length,
+                             uint8_t *mac,
+                             size_t mac_size,
+                             size_t *mac_length)
+{
+    uint8_t key_bytes[CRYPTO_HOST_MAC_KEY_SIZE];
+    unsigned int len;
+
+    if (alg != PSA_ALG_HMAC(PSA_ALG_SHA_256)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+    if (mac_size < PSA_HASH_LENGTH(PSA_ALG_SHA_256)) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    crypto_host_library_get_mac_key(CRYPTO_LIBRARY_GET_KEY_ID(key), key_bytes);
+
+    if (HMAC(EVP_sha256(), key_bytes, sizeof(key_bytes), input, input_length,
+             mac, &len) == NULL) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    *mac_length = len;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_mac_verify(mbedtls_svc_key_id_t key,
+                            psa_algorithm_t alg,
+                            const uint8_t *input,
+                            size_t input_length,
+                            const uint8_t *mac,
+                            size_t mac_length)
+{
+    uint8_t expected[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+    size_t expected_length;
+    psa_status_t status;
+
+    status = psa_mac_compute(key, alg, input, input_length,
+                             expected, sizeof(expected), &expected_length);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if ((mac_length != expected_length) ||
+        (CRYPTO_memcmp(mac, expected, expected_length) != 0)) {
+        return PSA_ERROR_INVALID_SIGNATURE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_mac_sign_setup(psa_mac_operation_t *operation,
+                                mbedtls_svc_key_id_t key,
+                                psa_algorithm_t alg)
+{
+    (void)operation;
+    (void)key;
+    (void)alg;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_mac_verify_setup(psa_mac_operation_t *operation,
+                                  mbedtls_svc_key_id_t key,
+                                  psa_algorithm_t alg)
+{
+    (void)operation;
+    (void)key;
+    (void)alg;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_mac_update(psa_mac_operation_t *operation,
+                            const uint8_t *input,
+                            size_t input_length)
+{
+    (void)operation;
+    (void)input;
+    (void)input_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_mac_sign_finish(psa_mac_operation_t *operation,
+                                 uint8_t *mac,
+                                 size_t mac_size,
+                                 size_t *mac_length)
+{
+    (void)operation;
+    (void)mac;
+    (void)mac_size;
+    (void)mac_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_mac_verify_finish(psa_mac_operation_t *operation,
+                                   const uint8_t *mac,
+                                   size_t mac_length)
+{
+    (void)operation;
+    (void)mac;
+    (void)mac_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_mac_abort(psa_mac_operation_t *operation)
+{
+    (void)operation;
+
+    return PSA_SUCCESS;
+}
+
+/* ---- Hash ---- */
+
+psa_status_t psa_hash_compute(psa_algorithm_t alg,
+                              const uint8_t *input,
+                              size_t input_length,
+                              uint8_t *hash,
+                              size_t hash_size,
+                              size_t *hash_length)
+{
+    unsigned int len;
+
+    if (alg != PSA_ALG_SHA_256) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+    if (hash_size < PSA_HASH_LENGTH(PSA_ALG_SHA_256)) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (!EVP_Digest(input, input_length, hash, &len, EVP_sha256(), NULL)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    *hash_length = len;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_hash_compare(psa_algorithm_t alg,
+                              const uint8_t *input,
+                              size_t input_length,
+                              const uint8_t *hash,
+                              size_t hash_length)
+{
+    (void)alg;
+    (void)input;
+    (void)input_length;
+    (void)hash;
+    (void)hash_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_setup(psa_hash_operation_t *operation,
+                            psa_algorithm_t alg)
+{
+    (void)operation;
+    (void)alg;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_update(psa_hash_operation_t *operation,
+                             const uint8_t *input,
+                             size_t input_length)
+{
+    (void)operation;
+    (void)input;
+    (void)input_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_finish(psa_hash_operation_t *operation,
+                             uint8_t *hash,
+                             size_t hash_size,
+                             size_t *hash_length)
+{
+    (void)operation;
+    (void)hash;
+    (void)hash_size;
+    (void)hash_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_verify(psa_hash_operation_t *operation,
+                             const uint8_t *hash,
+                             size_t hash_length)
+{
+    (void)operation;
+    (void)hash;
+    (void)hash_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_abort(psa_hash_operation_t *operation)
+{
+    (void)operation;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_hash_clone(const psa_hash_operation_t *source_operation,
+                            psa_hash_operation_t *target_operation)
+{
+    (void)source_operation;
+    (void)target_operation;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+/* ---- ECDSA ---- */
+
+static void sign_state_free(struct sign_state_t *st)
+{
+    BN_clear_free(st->k);
+    BN_free(st->e);
+    EC_POINT_free(st->r_point);
+    (void)memset(st, 0, sizeof(*st));
+}
+
+static psa_status_t sign_state_setup(struct sign_state_t *st,
+                                     psa_algorithm_t alg,
+                                     const uint8_t *hash, size_t hash_length)
+{
+    if (!PSA_ALG_IS_ECDSA(alg)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+    if ((hash_length == 0) || (hash_length > PSA_HASH_MAX_SIZE)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    st->in_use = true;
+    st->k = BN_new();
+    st->e = BN_bin2bn(hash, (int)((hash_length < ECC_P256_SIZE) ?
+                                  hash_length : ECC_P256_SIZE), NULL);
+    st->r_point = EC_POINT_new(g_group);
+    if ((st->k == NULL) || (st->e == NULL) || (st->r_point == NULL)) {
+        sign_state_free(st);
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    do {
+        if (!BN_rand_range(st->k, EC_GROUP_get0_order(g_group))) {
+            sign_state_free(st);
+            return PSA_ERROR_INSUFFICIENT_ENTROPY;
+        }
+    } while (BN_is_zero(st->k));
+
+    (void)EC_POINT_set_to_infinity(g_group, st->r_point);
+    st->bit = BN_num_bits(st->k) - 1;
+    st->add_pending = false;
+    st->num_ops = 0;
+
+    return PSA_SUCCESS;
+}
+
+/* Runs one basic operation, returns true once k.G is computed */
+static bool sign_state_step(struct sign_state_t *st)
+{
+    if (st->add_pending) {
+        (void)EC_POINT_add(g_group, st->r_point, st->r_point,
+                           EC_GROUP_get0_generator(g_group), g_bn_ctx);
+        st->add_pending = false;
+    } else {
+        (void)EC_POINT_dbl(g_group, st->r_point, st->r_point, g_bn_ctx);
+        st->add_pending = BN_is_bit_set(st->k, st->bit);
+        st->bit--;
+    }
+    st->num_ops++;
+
+    return (st->bit < 0) && !st->add_pending;
+}
+
+/* Computes the signature (r, s) once k.G is known */
+static psa_status_t sign_state_finish(struct sign_state_t *st,
+                                      uint8_t *signature,
+                                      size_t signature_size,
+                                      size_t *signature_length)
+{
+    const BIGNUM *order = EC_GROUP_get0_order(g_group);
+    psa_status_t status = PSA_ERROR_GENERIC_ERROR;
+    BIGNUM *r = BN_new();
+    BIGNUM *s = BN_new();
+    BIGNUM *k_inv = BN_new();
+
+    if (signature_size < 2 * ECC_P256_SIZE) {
+        status = PSA_ERROR_BUFFER_TOO_SMALL;
+        goto out;
+    }
+
+    if ((r == NULL) || (s == NULL) || (k_inv == NULL) ||
+        !EC_POINT_get_affine_coordinates(g_group, st->r_point, r, NULL,
+                                         g_bn_ctx) ||
+        !BN_nnmod(r, r, order, g_bn_ctx) || BN_is_zero(r) ||
+        !BN_mod_inverse(k_inv, st->k, order, g_bn_ctx) ||
+        !BN_mod_mul(s, r, g_priv_key, order, g_bn_ctx) ||
+        !BN_mod_add(s, s, st->e, order, g_bn_ctx) ||
+        !BN_mod_mul(s, s, k_inv, order, g_bn_ctx) || BN_is_zero(s)) {
+        goto out;
+    }
+
+    (void)BN_bn2binpad(r, signature, ECC_P256_SIZE);
+    (void)BN_bn2binpad(s, signature + ECC_P256_SIZE, ECC_P256_SIZE);
+    *signature_length = 2 * ECC_P256_SIZE;
+    status = PSA_SUCCESS;
+
+out:
+    BN_free(r);
+    BN_free(s);
+    BN_clear_free(k_inv);
+
+    return status;
+}
+
+psa_status_t psa_sign_hash(mbedtls_svc_key_id_t key,
+                           psa_algorithm_t alg,
+                           const uint8_t *hash,
+                           size_t hash_length,
+                           uint8_t *signature,
+                           size_t signature_size,
+                           size_t *signature_length)
+{
+    struct sign_state_t st = {0};
+    psa_status_t status;
+
+    (void)key;
+
+    status = sign_state_setup(&st, alg, hash, hash_length);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    while (!sign_state_step(&st)) {
+    }
+
+    status = sign_state_finish(&st, signature, signature_size,
+                               signature_length);
+    sign_state_free(&st);
+
+    return status;
+}
+
+psa_status_t psa_verify_hash(mbedtls_svc_key_id_t key,
+                             psa_algorithm_t alg,
+                             const uint8_t *hash,
+                             size_t hash_length,
+                             const uint8_t *signature,
+                             size_t signature_length)
+{
+    const BIGNUM *order = EC_GROUP_get0_order(g_group);
+    psa_status_t status = PSA_ERROR_INVALID_SIGNATURE;
+    BIGNUM *r = NULL;
+    BIGNUM *s = NULL;
+    BIGNUM *e = NULL;
+    BIGNUM *w = BN_new();
+    BIGNUM *u1 = BN_new();
+    BIGNUM *u2 = BN_new();
+    BIGNUM *x = BN_new();
+    EC_POINT *point = EC_POINT_new(g_group);
+
+    (void)key;
+
+    if (!PSA_ALG_IS_ECDSA(alg)) {
+        status = PSA_ERROR_NOT_SUPPORTED;
+        goto out;
+    }
+    if ((hash_length == 0) || (signature_length != 2 * ECC_P256_SIZE)) {
+        goto out;
+    }
+
+    r = BN_bin2bn(signature, ECC_P256_SIZE, NULL);
+    s = BN_bin2bn(signature + ECC_P256_SIZE, ECC_P256_SIZE, NULL);
+    e = BN_bin2bn(hash, (int)((hash_length < ECC_P256_SIZE) ?
+                              hash_length : ECC_P256_SIZE), NULL);
+
+    if ((r == NULL) || (s == NULL) || (e == NULL) || (w == NULL) ||
+        (u1 == NULL) || (u2 == NULL) || (x == NULL) || (point == NULL) ||
+        BN_is_zero(r) || BN_is_zero(s) ||
+        (BN_cmp(r, order) >= 0) || (BN_cmp(s, order) >= 0) ||
+        !BN_mod_inverse(w, s, order, g_bn_ctx) ||
+        !BN_mod_mul(u1, e, w, order, g_bn_ctx) ||
+        !BN_mod_mul(u2, r, w, order, g_bn_ctx) ||
+        !EC_POINT_mul(g_group, point, u1, g_pub_key, u2, g_bn_ctx) ||
+        !EC_POINT_get_affine_coordinates(g_group, point, x, NULL, g_bn_ctx) ||
+        !BN_nnmod(x, x, order, g_bn_ctx)) {
+        goto out;
+    }
+
+    if (BN_cmp(x, r) == 0) {
+        status = PSA_SUCCESS;
+    }
+
+out:
+    BN_free(r);
+    BN_free(s);
+    BN_free(e);
+    BN_free(w);
+    BN_free(u1);
+    BN_free(u2);
+    BN_free(x);
+    EC_POINT_free(point);
+
+    return status;
+}
+
+psa_status_t psa_sign_message(mbedtls_svc_key_id_t key,
+                              psa_algorithm_t alg,
+                              const uint8_t *input,
+                              size_t input_length,
+                              uint8_t *signature,
+                              size_t signature_size,
+                              size_t *signature_length)
+{
+    (void)key;
+    (void)alg;
+    (void)input;
+    (void)input_length;
+    (void)signature;
+    (void)signature_size;
+    (void)signature_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_verify_message(mbedtls_svc_key_id_t key,
+                                psa_algorithm_t alg,
+                                const uint8_t *input,
+                                size_t input_length,
+                                const uint8_t *signature,
+                                size_t signature_length)
+{
+    (void)key;
+    (void)alg;
+    (void)input;
+    (void)input_length;
+    (void)signature;
+    (void)signature_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+/* ---- Interruptible ECDSA ---- */
+
+void psa_interruptible_set_max_ops(uint32_t max_ops)
+{
+    g_max_ops = max_ops;
+}
+
+static struct sign_state_t *sign_state_get(
+                        const psa_sign_hash_interruptible_operation_t *operation)
+{
+    uint32_t idx = operation->handle;
+
+    if ((idx == 0) || (idx > NUM_SIGN_STATES) ||
+        !g_sign_states[idx - 1].in_use) {
+        return NULL;
+    }
+
+    return &g_sign_states[idx - 1];
+}
+
+uint32_t psa_sign_hash_get_num_ops(
+                        const psa_sign_hash_interruptible_operation_t *operation)
+{
+    struct sign_state_t *st = sign_state_get(operation);
+
+    return (st != NULL) ? st->num_ops : 0;
+}
+
+uint32_t psa_verify_hash_get_num_ops(
+                      const psa_verify_hash_interruptible_operation_t *operation)
+{
+    (void)operation;
+
+    return 0;
+}
+
+psa_status_t psa_sign_hash_start(
+                              psa_sign_hash_interruptible_operation_t *operation,
+                              mbedtls_svc_key_id_t key, psa_algorithm_t alg,
+                              const uint8_t *hash, size_t hash_length)
+{
+    uint32_t idx;
+
+    (void)key;
+
+    if (sign_state_get(operation) != NULL) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    for (idx = 0; idx < NUM_SIGN_STATES; idx++) {
+        if (!g_sign_states[idx].in_use) {
+            break;
+        }
+    }
+    if (idx == NUM_SIGN_STATES) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    operation->handle = idx + 1;
+
+    return sign_state_setup(&g_sign_states[idx], alg, hash, hash_length);
+}
+
+psa_status_t psa_sign_hash_complete(
+                              psa_sign_hash_interruptible_operation_t *operation,
+                              uint8_t *signature, size_t signature_size,
+                              size_t *signature_length)
+{
+    struct sign_state_t *st = sign_state_get(operation);
+    uint32_t ops = 0;
+    psa_status_t status;
+
+    if (st == NULL) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    while (!sign_state_step(st)) {
+        if ((g_max_ops != PSA_INTERRUPTIBLE_MAX_OPS_UNLIMITED) &&
+            (++ops >= g_max_ops)) {
+            return PSA_OPERATION_INCOMPLETE;
+        }
+    }
+
+    /* The operation ends, successfully or not */
+    status = sign_state_finish(st, signature, signature_size,
+                               signature_length);
+    sign_state_free(st);
+    operation->handle = 0;
+
+    return status;
+}
+
+psa_status_t psa_sign_hash_abort(
+                              psa_sign_hash_interruptible_operation_t *operation)
+{
+    struct sign_state_t *st = sign_state_get(operation);
+
+    if (st != NULL) {
+        sign_state_free(st);
+    }
+    operation->handle = 0;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_verify_hash_start(
+                            psa_verify_hash_interruptible_operation_t *operation,
+                            mbedtls_svc_key_id_t key, psa_algorithm_t alg,
+                            const uint8_t *hash, size_t hash_length,
+                            const uint8_t *signature, size_t signature_length)
+{
+    (void)operation;
+    (void)key;
+    (void)alg;
+    (void)hash;
+    (void)hash_length;
+    (void)signature;
+    (void)signature_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_verify_hash_complete(
+                            psa_verify_hash_interruptible_operation_t *operation)
+{
+    (void)operation;
+
+    return PSA_ERROR_BAD_STATE;
+}
+
+psa_status_t psa_verify_hash_abort(
+                            psa_verify_hash_interruptible_operation_t *operation)
+{
+    (void)operation;
+
+    return PSA_SUCCESS;
+}
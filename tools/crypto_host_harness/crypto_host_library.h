@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file crypto_host_library.h
+ *
+ * \brief Host backend of the PSA Crypto functions called by the crypto
+ *        modules, in place of Mbed TLS.
+ */
+
+#ifndef __CRYPTO_HOST_LIBRARY_H__
+#define __CRYPTO_HOST_LIBRARY_H__
+
+#include <stdint.h>
+
+#include "psa/crypto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size of the HMAC-SHA256 keys */
+#define CRYPTO_HOST_MAC_KEY_SIZE    (32u)
+
+/**
+ * \brief Initialises the backend and generates the key pair used for every
+ *        key ID
+ *
+ * \return PSA_SUCCESS or the error of the initialisation
+ */
+psa_status_t crypto_host_library_init(void);
+
+/**
+ * \brief Returns the number of calls to psa_generate_random(), each of which
+ *        is a call to the DRBG
+ *
+ * \return Number of DRBG calls since init
+ */
+uint64_t crypto_host_library_get_num_drbg_calls(void);
+
+/**
+ * \brief Gives the HMAC key which a key ID refers to, whatever its owner
+ *
+ * \param[in]  key_id  Key ID
+ * \param[out] key     Key bytes
+ */
+void crypto_host_library_get_mac_key(psa_key_id_t key_id,
+                                     uint8_t key[CRYPTO_HOST_MAC_KEY_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRYPTO_HOST_LIBRARY_H__ */
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "config_tfm.h"
+#include "crypto_host_library.h"
+#include "crypto_host_service.h"
+#include "psa/client.h"
+#include "psa_manifest/sid.h"
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+#include "tfm_crypto_key.h"
+
+/* Aligns a value x up to an alignment a */
+#define ALIGN(x, a) (((x) + ((a) - 1)) & ~((a) - 1))
+
+/* A request queued by psa_call() */
+struct request_t {
+    const psa_invec *in_vec;
+    size_t in_len;
+    psa_outvec *out_vec;
+    size_t out_len;
+    int32_t client_id;
+    psa_status_t status;
+    bool done;
+    pthread_cond_t done_cond;
+    struct request_t *next;
+};
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_queue_cond = PTHREAD_COND_INITIALIZER;
+static struct request_t *g_queue_head;
+static struct request_t *g_queue_tail;
+static bool g_stop;
+static pthread_t g_service_thread;
+
+static __thread int32_t g_thread_client_id = -1;
+
+/* Client ID of the request being served */
+static int32_t g_caller_id;
+
+/* Time spent in the dispatcher, which excludes the thread switches */
+static uint64_t g_dispatch_time_ns;
+
+/* Scratch of the iovecs, as used by the partition without MM-IOVEC */
+static uint8_t g_scratch[CRYPTO_IOVEC_BUFFER_SIZE]
+                                 __attribute__((aligned(TFM_CRYPTO_IOVEC_ALIGNMENT)));
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void crypto_host_set_client_id(int32_t client_id)
+{
+    g_thread_client_id = client_id;
+}
+
+psa_status_t tfm_crypto_get_caller_id(int32_t *id)
+{
+    *id = g_caller_id;
+
+    return PSA_SUCCESS;
+}
+
+/* Same dispatch as the partition, for the modules built in the harness */
+psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
+                                       size_t in_len,
+                                       psa_outvec out_vec[],
+                                       size_t out_len)
+{
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    struct tfm_crypto_key_id_s encoded_key = TFM_CRYPTO_KEY_ID_S_INIT;
+    enum tfm_crypto_group_id_t group_id;
+
+    (void)in_len;
+    (void)out_len;
+
+    if (in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    group_id = TFM_CRYPTO_GET_GROUP_ID(iov->function_id);
+
+    encoded_key.key_id = iov->key_id;
+    encoded_key.owner = g_caller_id;
+
+    switch (group_id) {
+    case TFM_CRYPTO_GROUP_ID_RANDOM:
+        return tfm_crypto_random_interface(in_vec, out_vec);
+    case TFM_CRYPTO_GROUP_ID_BATCH:
+        return tfm_crypto_batch_interface(in_vec, out_vec);
+    case TFM_CRYPTO_GROUP_ID_HASH:
+        return tfm_crypto_hash_interface(in_vec, out_vec);
+    case TFM_CRYPTO_GROUP_ID_MAC:
+        return tfm_crypto_mac_interface(in_vec, out_vec, &encoded_key);
+    case TFM_CRYPTO_GROUP_ID_ASYM_SIGN:
+        return tfm_crypto_asymmetric_sign_interface(in_vec, out_vec,
+                                                    &encoded_key);
+    default:
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+}
+
+/* Copies the iovecs of the request to the scratch and calls the dispatcher */
+static psa_status_t serve_request(struct request_t *req)
+{
+    psa_invec in_vec[PSA_MAX_IOVEC] = { {NULL, 0} };
+    psa_outvec out_vec[PSA_MAX_IOVEC] = { {NULL, 0} };
+    size_t used = 0;
+    size_t size;
+    uint64_t start;
+    psa_status_t status;
+    size_t i;
+
+    if ((req->in_len < 1) || (req->in_len > PSA_MAX_IOVEC) ||
+        (req->out_len > PSA_MAX_IOVEC)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    for (i = 0; i < req->in_len; i++) {
+        size = ALIGN(req->in_vec[i].len, TFM_CRYPTO_IOVEC_ALIGNMENT);
+        if (size > sizeof(g_scratch) - used) {
+            return PSA_ERROR_INSUFFICIENT_MEMORY;
+        }
+        if (req->in_vec[i].len > 0) {
+            (void)memcpy(&g_scratch[used], req->in_vec[i].base,
+                         req->in_vec[i].len);
+        }
+        in_vec[i].base = &g_scratch[used];
+        in_vec[i].len = req->in_vec[i].len;
+        used += size;
+    }
+
+    for (i = 0; i < req->out_len; i++) {
+        size = ALIGN(req->out_vec[i].len, TFM_CRYPTO_IOVEC_ALIGNMENT);
+        if (size > sizeof(g_scratch) - used) {
+            return PSA_ERROR_INSUFFICIENT_MEMORY;
+        }
+        out_vec[i].base = &g_scratch[used];
+        out_vec[i].len = req->out_vec[i].len;
+        used += size;
+    }
+
+    g_caller_id = req->client_id;
+
+    start = now_ns();
+    status = tfm_crypto_api_dispatcher(in_vec, req->in_len,
+                                       out_vec, req->out_len);
+    g_dispatch_time_ns += now_ns() - start;
+
+    /* Write the outputs, as psa_write() does */
+    for (i = 0; i < req->out_len; i++) {
+        if (out_vec[i].len > 0) {
+            (void)memcpy(req->out_vec[i].base, out_vec[i].base,
+                         out_vec[i].len);
+        }
+        req->out_vec[i].len = out_vec[i].len;
+    }
+
+    (void)memset(g_scratch, 0, used);
+
+    return status;
+}
+
+static void *service_thread(void *arg)
+{
+    struct request_t *req;
+
+    (void)arg;
+
+    pthread_mutex_lock(&g_lock);
+    while (true) {
+        while ((g_queue_head == NULL) && !g_stop) {
+            pthread_cond_wait(&g_queue_cond, &g_lock);
+        }
+        if (g_queue_head == NULL) {
+            break;
+        }
+
+        req = g_queue_head;
+        g_queue_head = req->next;
+        if (g_queue_head == NULL) {
+            g_queue_tail = NULL;
+        }
+        pthread_mutex_unlock(&g_lock);
+
+        req->status = serve_request(req);
+
+        pthread_mutex_lock(&g_lock);
+        req->done = true;
+        pthread_cond_signal(&req->done_cond);
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    return NULL;
+}
+
+psa_status_t psa_call(psa_handle_t handle, int32_t type,
+                      const psa_invec *in_vec, size_t in_len,
+                      psa_outvec *out_vec, size_t out_len)
+{
+    struct request_t req = {
+        .in_vec = in_vec,
+        .in_len = in_len,
+        .out_vec = out_vec,
+        .out_len = out_len,
+        .client_id = g_thread_client_id,
+    };
+
+    if ((handle != TFM_CRYPTO_HANDLE) || (type != PSA_IPC_CALL)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    pthread_cond_init(&req.done_cond, NULL);
+
+    pthread_mutex_lock(&g_lock);
+    if (g_queue_tail != NULL) {
+        g_queue_tail->next = &req;
+    } else {
+        g_queue_head = &req;
+    }
+    g_queue_tail = &req;
+    pthread_cond_signal(&g_queue_cond);
+
+    while (!req.done) {
+        pthread_cond_wait(&req.done_cond, &g_lock);
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    pthread_cond_destroy(&req.done_cond);
+
+    return req.status;
+}
+
+psa_status_t crypto_host_service_start(void)
+{
+    psa_status_t status;
+
+    status = crypto_host_library_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = tfm_crypto_init_alloc();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = tfm_crypto_random_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    g_stop = false;
+    if (pthread_create(&g_service_thread, NULL, service_thread, NULL) != 0) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+void crypto_host_service_stop(void)
+{
+    pthread_mutex_lock(&g_lock);
+    g_stop = true;
+    pthread_cond_signal(&g_queue_cond);
+    pthread_mutex_unlock(&g_lock);
+
+    (void)pthread_join(g_service_thread, NULL);
+}
+
+uint64_t crypto_host_service_get_dispatch_time_ns(void)
+{
+    uint64_t time_ns;
+
+    pthread_mutex_lock(&g_lock);
+    time_ns = g_dispatch_time_ns;
+    pthread_mutex_unlock(&g_lock);
+
+    return time_ns;
+}
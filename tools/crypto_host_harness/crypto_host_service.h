@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file crypto_host_service.h
+ *
+ * \brief Host model of the crypto partition. psa_call() queues the request of
+ *        the calling thread, and a single service thread serves the requests
+ *        one at a time and in arrival order, as the partition does, copying
+ *        the iovecs through a scratch buffer.
+ */
+
+#ifndef __CRYPTO_HOST_SERVICE_H__
+#define __CRYPTO_HOST_SERVICE_H__
+
+#include <stdint.h>
+
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Initialises the crypto modules and the library, and starts the
+ *        service thread
+ *
+ * \return PSA_SUCCESS or the error of the initialisation
+ */
+psa_status_t crypto_host_service_start(void);
+
+/**
+ * \brief Stops the service thread, once the queued requests are served
+ */
+void crypto_host_service_stop(void);
+
+/**
+ * \brief Sets the client ID sent with the requests of the calling thread
+ *
+ * \param[in] client_id  Client ID, negative for a non-secure client
+ */
+void crypto_host_set_client_id(int32_t client_id);
+
+/**
+ * \brief Returns the time spent by the service in the dispatcher, which is
+ *        the cost of the requests without the thread switches of the host
+ *        model. To be read while no request is in progress.
+ *
+ * \return Time in ns since the service started
+ */
+uint64_t crypto_host_service_get_dispatch_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRYPTO_HOST_SERVICE_H__ */
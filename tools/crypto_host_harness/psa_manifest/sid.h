@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host service handles, only the crypto service is used */
+
+#ifndef __CRYPTO_HOST_HARNESS_SID_H__
+#define __CRYPTO_HOST_HARNESS_SID_H__
+
+#define TFM_CRYPTO_HANDLE    (0x40000100U)
+
+#endif /* __CRYPTO_HOST_HARNESS_SID_H__ */
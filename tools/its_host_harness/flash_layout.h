@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Host flash layout of the ITS host harness. The geometry of the simulated
+ * device is chosen at run time, only the largest NOR program unit is fixed at
+ * build time as it sizes the filesystem alignment buffers. It must be at most
+ * 16, larger program units select the NAND back end in its_flash.h.
+ */
+#ifndef ITS_HOST_MAX_PROGRAM_UNIT
+#define ITS_HOST_MAX_PROGRAM_UNIT  16
+#endif
+
+#define TFM_HAL_ITS_FLASH_DRIVER   Driver_SIM_FLASH
+#define TFM_HAL_ITS_PROGRAM_UNIT   ITS_HOST_MAX_PROGRAM_UNIT
+
+/* The ITS encryption sources include the PS HAL, PS is not built */
+#define TFM_HAL_PS_FLASH_DRIVER    Driver_SIM_FLASH
+#define TFM_HAL_PS_PROGRAM_UNIT    ITS_HOST_MAX_PROGRAM_UNIT
+
+#endif /* __FLASH_LAYOUT_H__ */
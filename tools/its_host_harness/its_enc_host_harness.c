@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file its_enc_host_harness.c
+ *
+ * \brief Host test harness of the chunked encryption of ITS files.
+ *
+ * \details The ITS service core is built with ITS_ENCRYPTION and
+ *          ITS_ENCRYPTION_CHUNK_SIZE, on top of the filesystem and the NOR
+ *          back end over the simulated flash device. The AEAD of the platform
+ *          is replaced by a stub, which is not secure but detects any change
+ *          of the nonce, the additional data, the ciphertext or the tag. Each
+ *          test writes files through tfm_its_set() and reads them back through
+ *          tfm_its_get(). The tampering tests then modify the stored files
+ *          through a second filesystem context, mount the ITS filesystem again
+ *          and check that the reads covering the modified chunks fail.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config_tfm.h"
+#include "flash/its_flash.h"
+#include "flash_fs/its_flash_fs.h"
+#include "its_crypto_interface.h"
+#include "psa/storage_common.h"
+#include "sim_flash.h"
+#include "tfm_hal_its.h"
+#include "tfm_hal_its_encryption.h"
+#include "tfm_internal_trusted_storage.h"
+#include "tfm_its_req_mngr.h"
+
+#if !defined(ITS_ENCRYPTION) || !ITS_ENCRYPTION_CHUNK_SIZE
+#error "The harness needs ITS_ENCRYPTION and ITS_ENCRYPTION_CHUNK_SIZE"
+#endif
+
+/* Geometry of the simulated flash, with room for the largest files */
+#define HARNESS_SECTOR_SIZE      4096
+#define HARNESS_NUM_SECTORS      8
+
+/* Owner of the files written by the harness */
+#define HARNESS_CLIENT_ID        (-1)
+
+/* Sizes written by the tests: empty, within one chunk, on and around chunk
+ * boundaries, and the largest asset.
+ */
+static const size_t test_sizes[] = {
+    0, 1, ITS_ENCRYPTION_CHUNK_SIZE - 1, ITS_ENCRYPTION_CHUNK_SIZE,
+    ITS_ENCRYPTION_CHUNK_SIZE + 1, (3 * ITS_ENCRYPTION_CHUNK_SIZE) + 5,
+    ITS_MAX_ASSET_SIZE,
+};
+
+/* Data of the request being served, as seen by the request manager */
+static const uint8_t *req_src;
+static uint8_t *req_dst;
+
+static uint8_t data_in[ITS_MAX_ASSET_SIZE];
+static uint8_t data_out[ITS_MAX_ASSET_SIZE];
+static uint8_t data_old[ITS_MAX_ASSET_SIZE];
+
+/* Stored content of a file, as read and written by the tampering tests */
+static uint8_t stored[ITS_UTILS_ALIGN(ITS_ENC_STORED_SIZE(ITS_MAX_ASSET_SIZE),
+                                      ITS_FLASH_ALIGNMENT)];
+static uint8_t stored_old[sizeof(stored)];
+
+/* Second filesystem context over the ITS flash area */
+static struct its_flash_fs_config_t raw_cfg;
+static struct its_flash_fs_ctx_t raw_ctx;
+
+static uint64_t rng_state = 1;
+static uint32_t nonce_counter;
+
+static uint32_t rand_u32(void)
+{
+    /* xorshift64* */
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (uint32_t)((rng_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static void fill_random(uint8_t *data, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        data[i] = (uint8_t)rand_u32();
+    }
+}
+
+/* Request manager of the ITS partition, serving the buffers of the harness */
+size_t its_req_mngr_read(uint8_t *buf, size_t num_bytes)
+{
+    (void)memcpy(buf, req_src, num_bytes);
+    req_src += num_bytes;
+
+    return num_bytes;
+}
+
+void its_req_mngr_write(const uint8_t *buf, size_t num_bytes)
+{
+    (void)memcpy(req_dst, buf, num_bytes);
+    req_dst += num_bytes;
+}
+
+enum tfm_hal_status_t tfm_hal_its_fs_info(struct tfm_hal_its_fs_info_t *fs_info)
+{
+    fs_info->flash_area_addr = 0;
+    fs_info->flash_area_size = HARNESS_SECTOR_SIZE * HARNESS_NUM_SECTORS;
+    fs_info->sectors_per_block = 1;
+
+    return TFM_HAL_SUCCESS;
+}
+
+/**
+ * \brief Stub keyed hash of the AEAD, FNV-1a over the given buffers.
+ */
+static uint64_t stub_hash(uint64_t hash, const uint8_t *buf, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        hash ^= buf[i];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Computes the tag of the stub AEAD, which covers the key derivation
+ *        label, the nonce, the additional data and the ciphertext.
+ */
+static void stub_tag(const struct tfm_hal_its_auth_crypt_ctx *ctx,
+                     const uint8_t *ciphertext, size_t ciphertext_size,
+                     uint8_t *tag, size_t tag_size)
+{
+    uint64_t hash[2] = { 0xCBF29CE484222325ULL, 0x84222325CBF29CE4ULL };
+    size_t i, h;
+
+    for (h = 0; h < 2; h++) {
+        hash[h] = stub_hash(hash[h], ctx->deriv_label, ctx->deriv_label_size);
+        hash[h] = stub_hash(hash[h], ctx->nonce, ctx->nonce_size);
+        hash[h] = stub_hash(hash[h], ctx->aad, ctx->aad_size);
+        hash[h] = stub_hash(hash[h], ciphertext, ciphertext_size);
+    }
+
+    for (i = 0; i < tag_size; i++) {
+        tag[i] = (uint8_t)(hash[(i / 8) % 2] >> (8 * (i % 8)));
+    }
+}
+
+/**
+ * \brief Applies the keystream of the stub AEAD, derived from the nonce.
+ */
+static void stub_crypt(const struct tfm_hal_its_auth_crypt_ctx *ctx,
+                       const uint8_t *input, uint8_t *output, size_t size)
+{
+    uint64_t state = stub_hash(0xCBF29CE484222325ULL, ctx->nonce,
+                               ctx->nonce_size) | 1;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        output[i] = input[i] ^ (uint8_t)((state * 0x2545F4914F6CDD1DULL) >> 56);
+    }
+}
+
+/* Nonces are unique, as required from the HAL */
+enum tfm_hal_status_t tfm_hal_its_aead_generate_nonce(uint8_t *nonce,
+                                                      const size_t nonce_size)
+{
+    (void)memset(nonce, 0, nonce_size);
+    nonce_counter++;
+    (void)memcpy(nonce, &nonce_counter,
+                 ITS_UTILS_MIN(nonce_size, sizeof(nonce_counter)));
+
+    return TFM_HAL_SUCCESS;
+}
+
+enum tfm_hal_status_t tfm_hal_its_aead_encrypt(
+                                         struct tfm_hal_its_auth_crypt_ctx *ctx,
+                                         const uint8_t *plaintext,
+                                         const size_t plaintext_size,
+                                         uint8_t *ciphertext,
+                                         const size_t ciphertext_size,
+                                         uint8_t *tag,
+                                         const size_t tag_size)
+{
+    if (ciphertext_size < plaintext_size) {
+        return TFM_HAL_ERROR_INVALID_INPUT;
+    }
+
+    stub_crypt(ctx, plaintext, ciphertext, plaintext_size);
+    stub_tag(ctx, ciphertext, plaintext_size, tag, tag_size);
+
+    return TFM_HAL_SUCCESS;
+}
+
+enum tfm_hal_status_t tfm_hal_its_aead_decrypt(
+                                         struct tfm_hal_its_auth_crypt_ctx *ctx,
+                                         const uint8_t *ciphertext,
+                                         const size_t ciphertext_size,
+                                         uint8_t *tag,
+                                         const size_t tag_size,
+                                         uint8_t *plaintext,
+                                         const size_t plaintext_size)
+{
+    uint8_t expected[TFM_ITS_AUTH_TAG_LENGTH];
+
+    if ((plaintext_size < ciphertext_size) || (tag_size > sizeof(expected))) {
+        return TFM_HAL_ERROR_INVALID_INPUT;
+    }
+
+    stub_tag(ctx, ciphertext, ciphertext_size, expected, tag_size);
+    if (memcmp(expected, tag, tag_size) != 0) {
+        return TFM_HAL_ERROR_GENERIC;
+    }
+
+    stub_crypt(ctx, ciphertext, plaintext, ciphertext_size);
+
+    return TFM_HAL_SUCCESS;
+}
+
+static psa_status_t its_set(psa_storage_uid_t uid, const uint8_t *data,
+                            size_t size)
+{
+    req_src = data;
+
+    return tfm_its_set(HARNESS_CLIENT_ID, uid, size, PSA_STORAGE_FLAG_NONE);
+}
+
+static psa_status_t its_get(psa_storage_uid_t uid, size_t offset, size_t size,
+                            uint8_t *data, size_t *p_len)
+{
+    req_dst = data;
+
+    return tfm_its_get(HARNESS_CLIENT_ID, uid, offset, size, p_len);
+}
+
+/**
+ * \brief Reads a range of a file and checks it against the expected data.
+ *
+ * \return 0 if the range reads back as expected, -1 otherwise.
+ */
+static int check_range(psa_storage_uid_t uid, const uint8_t *expected,
+                       size_t file_size, size_t offset, size_t size)
+{
+    size_t len = 0;
+    size_t expected_len = ITS_UTILS_MIN(size, file_size - offset);
+    psa_status_t status;
+
+    (void)memset(data_out, 0, sizeof(data_out));
+
+    status = its_get(uid, offset, size, data_out, &len);
+    if ((status != PSA_SUCCESS) || (len != expected_len) ||
+        (memcmp(data_out, expected + offset, len) != 0)) {
+        fprintf(stderr, "Read of %zu bytes at %zu of a file of %zu bytes "
+                "failed, status %d, %zu bytes read\n", size, offset,
+                file_size, (int)status, len);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void file_id(psa_storage_uid_t uid, uint8_t *fid)
+{
+    int32_t client_id = HARNESS_CLIENT_ID;
+
+    /* As tfm_its_get_fid() */
+    (void)memcpy(fid, &client_id, sizeof(client_id));
+    (void)memcpy(fid + sizeof(client_id), &uid, sizeof(uid));
+}
+
+/**
+ * \brief Reads the stored content of a file through the second filesystem
+ *        context.
+ */
+static psa_status_t raw_read(psa_storage_uid_t uid, uint8_t *buf,
+                             size_t *p_size)
+{
+    uint8_t fid[ITS_FILE_ID_SIZE];
+    struct its_flash_fs_file_info_t finfo;
+    psa_status_t status;
+
+    file_id(uid, fid);
+
+    /* The ITS context may have changed the filesystem since the last mount */
+    status = its_flash_fs_prepare(&raw_ctx);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = its_flash_fs_file_get_info(&raw_ctx, fid, &finfo);
+    if (status == PSA_SUCCESS) {
+        *p_size = finfo.size_current;
+        status = its_flash_fs_file_read(&raw_ctx, fid, finfo.size_current, 0,
+                                        buf);
+    }
+
+    if (status != PSA_SUCCESS) {
+        fprintf(stderr, "Read of the stored file failed, status %d\n",
+                (int)status);
+    }
+
+    return status;
+}
+
+/**
+ * \brief Replaces the stored content of a file through the second filesystem
+ *        context, then mounts the ITS filesystem again.
+ */
+static psa_status_t raw_write(psa_storage_uid_t uid, const uint8_t *buf,
+                              size_t size)
+{
+    uint8_t fid[ITS_FILE_ID_SIZE];
+    struct its_flash_fs_file_info_t finfo = {0};
+    psa_status_t status;
+
+    file_id(uid, fid);
+
+    finfo.size_max = size;
+    finfo.flags = ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE;
+
+    status = its_flash_fs_file_write(&raw_ctx, fid, &finfo, size, 0, buf);
+    if (status != PSA_SUCCESS) {
+        fprintf(stderr, "Write of the stored file failed, status %d\n",
+                (int)status);
+        return status;
+    }
+
+    status = tfm_its_init();
+    if (status != PSA_SUCCESS) {
+        fprintf(stderr, "ITS mount failed, status %d\n", (int)status);
+    }
+
+    return status;
+}
+
+/**
+ * \brief Checks that a read of any chunk in bad_chunks, a bit mask of chunk
+ *        indexes, fails, and that the other chunks read back as expected.
+ */
+static int check_tampered(psa_storage_uid_t uid, const uint8_t *expected,
+                          size_t file_size, uint32_t bad_chunks)
+{
+    size_t len;
+    uint32_t i;
+    uint32_t num_chunks = (file_size + ITS_ENCRYPTION_CHUNK_SIZE - 1) /
+                          ITS_ENCRYPTION_CHUNK_SIZE;
+
+    for (i = 0; i < num_chunks; i++) {
+        if ((bad_chunks & (1U << i)) == 0) {
+            if (check_range(uid, expected, file_size,
+                            i * ITS_ENCRYPTION_CHUNK_SIZE,
+                            ITS_ENCRYPTION_CHUNK_SIZE) != 0) {
+                return -1;
+            }
+        } else if (its_get(uid, i * ITS_ENCRYPTION_CHUNK_SIZE, 1, data_out,
+                           &len) == PSA_SUCCESS) {
+            fprintf(stderr, "Chunk %" PRIu32 " of the tampered file was "
+                    "accepted\n", i);
+            return -1;
+        }
+    }
+
+    /* A read of the whole file covers the bad chunks */
+    if (its_get(uid, 0, file_size, data_out, &len) == PSA_SUCCESS) {
+        fprintf(stderr, "The tampered file was accepted\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Every size is written and read back whole, as existing and new files */
+static int test_round_trip(void)
+{
+    struct psa_storage_info_t info = {0};
+    psa_status_t status;
+    size_t i;
+
+    for (i = 0; i < sizeof(test_sizes) / sizeof(test_sizes[0]); i++) {
+        fill_random(data_in, test_sizes[i]);
+
+        status = its_set(1, data_in, test_sizes[i]);
+        if (status == PSA_SUCCESS) {
+            status = tfm_its_get_info(HARNESS_CLIENT_ID, 1, &info);
+        }
+        if ((status != PSA_SUCCESS) || (info.size != test_sizes[i])) {
+            fprintf(stderr, "Write of %zu bytes failed, status %d\n",
+                    test_sizes[i], (int)status);
+            return -1;
+        }
+
+        if (check_range(1, data_in, test_sizes[i], 0, ITS_MAX_ASSET_SIZE)
+            != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Random ranges, within and across chunks, of files of every size */
+static int test_partial_reads(uint32_t num_ops)
+{
+    size_t file_size, offset, size;
+    uint32_t n;
+    size_t i;
+
+    for (i = 0; i < sizeof(test_sizes) / sizeof(test_sizes[0]); i++) {
+        file_size = test_sizes[i];
+        fill_random(data_in, file_size);
+
+        if (its_set(2, data_in, file_size) != PSA_SUCCESS) {
+            fprintf(stderr, "Write of %zu bytes failed\n", file_size);
+            return -1;
+        }
+
+        for (n = 0; n < num_ops; n++) {
+            offset = rand_u32() % (file_size + 1);
+            size = rand_u32() % (file_size - offset + 2);
+
+            if (check_range(2, data_in, file_size, offset, size) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Two chunks of a file are swapped in storage */
+static int test_chunk_swap(void)
+{
+    size_t file_size = (3 * ITS_ENCRYPTION_CHUNK_SIZE) + 5;
+    size_t stored_size;
+    uint8_t tmp[ITS_ENC_CHUNK_STRIDE];
+
+    fill_random(data_in, file_size);
+
+    if ((its_set(3, data_in, file_size) != PSA_SUCCESS) ||
+        (raw_read(3, stored, &stored_size) != PSA_SUCCESS)) {
+        return -1;
+    }
+
+    (void)memcpy(tmp, stored + ITS_ENC_CHUNK_OFFSET(1), sizeof(tmp));
+    (void)memcpy(stored + ITS_ENC_CHUNK_OFFSET(1),
+                 stored + ITS_ENC_CHUNK_OFFSET(2), sizeof(tmp));
+    (void)memcpy(stored + ITS_ENC_CHUNK_OFFSET(2), tmp, sizeof(tmp));
+
+    if (raw_write(3, stored, stored_size) != PSA_SUCCESS) {
+        return -1;
+    }
+
+    /* Chunks 0 and 3 are intact, reads of them alone still succeed */
+    return check_tampered(3, data_in, file_size, (1U << 1) | (1U << 2));
+}
+
+/* A chunk of an earlier write of a file of the same size is spliced in */
+static int test_splice(void)
+{
+    size_t file_size = ITS_MAX_ASSET_SIZE;
+    size_t stored_size, old_size;
+
+    fill_random(data_in, file_size);
+
+    if ((its_set(4, data_in, file_size) != PSA_SUCCESS) ||
+        (raw_read(4, stored_old, &old_size) != PSA_SUCCESS)) {
+        return -1;
+    }
+
+    (void)memcpy(data_old, data_in, file_size);
+    fill_random(data_in, file_size);
+
+    if ((its_set(4, data_in, file_size) != PSA_SUCCESS) ||
+        (raw_read(4, stored, &stored_size) != PSA_SUCCESS) ||
+        (old_size != stored_size)) {
+        return -1;
+    }
+
+    /* The chunk alone is valid, but it belongs to another write */
+    (void)memcpy(stored + ITS_ENC_CHUNK_OFFSET(1),
+                 stored_old + ITS_ENC_CHUNK_OFFSET(1), ITS_ENC_CHUNK_STRIDE);
+
+    if ((raw_write(4, stored, stored_size) != PSA_SUCCESS) ||
+        (check_tampered(4, data_in, file_size, 1U << 1) != 0)) {
+        return -1;
+    }
+
+    /* With the header of the earlier write as well, only the chunk of that
+     * write is accepted.
+     */
+    (void)memcpy(stored, stored_old, ITS_ENC_FILE_HEADER_SIZE);
+
+    if (raw_write(4, stored, stored_size) != PSA_SUCCESS) {
+        return -1;
+    }
+
+    return check_tampered(4, data_old, file_size, ~(uint32_t)(1U << 1));
+}
+
+/* The stored file loses its last chunk, or ends within a chunk */
+static int test_truncation(void)
+{
+    size_t file_size = (3 * ITS_ENCRYPTION_CHUNK_SIZE) + 5;
+    size_t stored_size, len;
+    struct psa_storage_info_t info;
+    const size_t cuts[] = {
+        ITS_ENC_CHUNK_OFFSET(3),
+        ITS_ENC_CHUNK_OFFSET(3) - ITS_FLASH_ALIGNMENT,
+        ITS_ENC_CHUNK_OFFSET(1) + ITS_ENC_CHUNK_OVERHEAD + 1,
+    };
+    psa_storage_uid_t uid;
+    size_t i;
+
+    /* A file left with a size which is not one of an encrypted file cannot be
+     * replaced, so each cut is made in its own file.
+     */
+    for (i = 0; i < sizeof(cuts) / sizeof(cuts[0]); i++) {
+        uid = 10 + i;
+        fill_random(data_in, file_size);
+
+        if ((its_set(uid, data_in, file_size) != PSA_SUCCESS) ||
+            (raw_read(uid, stored, &stored_size) != PSA_SUCCESS) ||
+            (raw_write(uid, stored, cuts[i]) != PSA_SUCCESS)) {
+            return -1;
+        }
+
+        /* Either the size is not one of a chunked file, or the file size
+         * authenticated with the chunks does not match.
+         */
+        if ((tfm_its_get_info(HARNESS_CLIENT_ID, uid, &info) == PSA_SUCCESS) &&
+            (its_get(uid, 0, file_size, data_out, &len) == PSA_SUCCESS)) {
+            fprintf(stderr, "File truncated to %zu bytes was accepted\n",
+                    cuts[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* A write of the largest file updates the filesystem as a write of one chunk:
+ * one copy of the data block and one swap of the metadata block.
+ */
+static int test_single_update(void)
+{
+    uint64_t erases[2];
+    const size_t sizes[2] = { 1, ITS_MAX_ASSET_SIZE };
+    uint64_t start;
+    size_t i;
+
+    for (i = 0; i < 2; i++) {
+        fill_random(data_in, sizes[i]);
+
+        /* The second write reuses the file, it is a single update */
+        if (its_set(6 + i, data_in, sizes[i]) != PSA_SUCCESS) {
+            return -1;
+        }
+
+        start = sim_flash_get_stats()->erases;
+        if (its_set(6 + i, data_in, sizes[i]) != PSA_SUCCESS) {
+            return -1;
+        }
+        erases[i] = sim_flash_get_stats()->erases - start;
+
+        if (check_range(6 + i, data_in, sizes[i], 0, sizes[i]) != 0) {
+            return -1;
+        }
+    }
+
+    if (erases[0] != erases[1]) {
+        fprintf(stderr, "Write of %zu bytes erased %" PRIu64 " blocks, and "
+                "of %zu bytes %" PRIu64 "\n", sizes[0], erases[0], sizes[1],
+                erases[1]);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int setup(void)
+{
+    const struct sim_flash_config_t flash = {
+        .model = SIM_FLASH_NOR,
+        .sector_size = HARNESS_SECTOR_SIZE,
+        .sector_count = HARNESS_NUM_SECTORS,
+        .program_unit = ITS_HOST_MAX_PROGRAM_UNIT,
+        .erased_value = 0xFF,
+    };
+    struct tfm_hal_its_fs_info_t fs_info;
+
+    if (sim_flash_create(&flash) != 0) {
+        fprintf(stderr, "Invalid flash geometry\n");
+        return -1;
+    }
+
+    if (tfm_its_init() != PSA_SUCCESS) {
+        fprintf(stderr, "ITS initialisation failed\n");
+        return -1;
+    }
+
+    /* The same filesystem configuration as the ITS partition */
+    (void)tfm_hal_its_fs_info(&fs_info);
+    raw_cfg.flash_dev = &ITS_FLASH_DEV;
+    raw_cfg.flash_area_addr = fs_info.flash_area_addr;
+    raw_cfg.sector_size = flash.sector_size;
+    raw_cfg.block_size = flash.sector_size * fs_info.sectors_per_block;
+    raw_cfg.num_blocks = fs_info.flash_area_size / raw_cfg.block_size;
+    raw_cfg.program_unit = ITS_FLASH_ALIGNMENT;
+    raw_cfg.max_file_size = sizeof(stored);
+    raw_cfg.max_num_files = ITS_NUM_ASSETS + 1;
+    raw_cfg.erase_val = flash.erased_value;
+
+    if (its_flash_fs_init_ctx(&raw_ctx, &raw_cfg, &ITS_FLASH_OPS)
+        != PSA_SUCCESS) {
+        fprintf(stderr, "Filesystem configuration rejected\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [options]\n"
+           "  -t <test>    round_trip, partial_reads, chunk_swap, splice,\n"
+           "               truncation, single_update or all (all)\n"
+           "  -n <num>     Random reads per file size (1000)\n"
+           "  -r <seed>    Random seed (1)\n"
+           "  -h           Show this help\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *test = "all";
+    uint32_t num_ops = 1000;
+    bool all;
+    int opt, ret = 0;
+
+    while ((opt = getopt(argc, argv, "t:n:r:h")) != -1) {
+        switch (opt) {
+        case 't':
+            test = optarg;
+            break;
+        case 'n':
+            num_ops = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            rng_state = strtoull(optarg, NULL, 0) | 1;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    if (setup() != 0) {
+        return 1;
+    }
+
+    printf("Chunks of %d bytes, stored with a stride of %d bytes, files of up "
+           "to %d bytes\n", ITS_ENCRYPTION_CHUNK_SIZE, ITS_ENC_CHUNK_STRIDE,
+           ITS_MAX_ASSET_SIZE);
+
+    all = (strcmp(test, "all") == 0);
+
+#define RUN_TEST(name, call)                                                   \
+    if (all || (strcmp(test, name) == 0)) {                                    \
+        if ((call) != 0) {                                                     \
+            printf("%s: FAILED\n", name);                                      \
+            ret = 1;                                                           \
+        } else {                                                               \
+            printf("%s: passed\n", name);                                      \
+        }                                                                      \
+    }
+
+    RUN_TEST("round_trip", test_round_trip());
+    RUN_TEST("partial_reads", test_partial_reads(num_ops));
+    RUN_TEST("chunk_swap", test_chunk_swap());
+    RUN_TEST("splice", test_splice());
+    RUN_TEST("truncation", test_truncation());
+    RUN_TEST("single_update", test_single_update());
+
+#undef RUN_TEST
+
+    sim_flash_destroy();
+
+    return ret;
+}
@@ -0,0 +1,1158 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file its_host_harness.c
+ *
+ * \brief Host benchmark and power loss harness of the ITS flash filesystem.
+ *
+ * \details The filesystem and the ITS NOR and NAND flash back ends are linked
+ *          against a simulated flash device. Each workload runs a random
+ *          sequence of file operations, checks every read against a shadow
+ *          copy of the files and reports the throughput, the bytes programmed
+ *          per byte written and the erase counts. With -p, every program and
+ *          erase operation of every file update is in turn interrupted by a
+ *          power loss, after which the filesystem is mounted again and must
+ *          hold either the old or the new content of the file.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "config_tfm.h"
+#include "flash/its_flash_nand.h"
+#include "flash/its_flash_nor.h"
+#include "flash_fs/its_flash_fs.h"
+#include "psa/storage_common.h"
+#include "sim_flash.h"
+
+enum workload_t {
+    WORKLOAD_COUNTERS, /* Frequent updates of small files */
+    WORKLOAD_BLOBS,    /* Updates of a few files of the maximum size */
+    WORKLOAD_CHURN,    /* Creation, growth and deletion of files of any size */
+    WORKLOAD_TXN,      /* Atomic updates of several files, some aborted */
+    WORKLOAD_COUNT,
+};
+
+static const char *const workload_names[WORKLOAD_COUNT] = {
+    "counters",
+    "blobs",
+    "churn",
+    "transactions",
+};
+
+/* Maximum number of files updated by a transaction */
+#define TXN_MAX_FILES 4
+
+enum file_op_type_t {
+    FILE_OP_SET,    /* Replaces the file, as psa_its_set() does */
+    FILE_OP_APPEND, /* Writes at the end of the file, within its maximum size */
+    FILE_OP_DELETE,
+    FILE_OP_READ,
+    FILE_OP_COMPACT, /* Compaction step, as run when the system is idle */
+    FILE_OP_TXN,     /* Sets and deletes of consecutive files, committed with
+                      * a single batch update as by the ITS transactions
+                      */
+};
+
+struct file_op_t {
+    enum file_op_type_t type;
+    uint32_t file;
+    size_t size;      /* New maximum size of the file for FILE_OP_SET */
+    size_t offset;
+    size_t len;       /* Number of bytes written or read */
+    uint32_t pattern; /* Seed of the data written */
+    /* FILE_OP_TXN only */
+    uint32_t num_files;          /* Files updated, from file onwards */
+    uint32_t remove_mask;        /* Bit n set if file + n is deleted */
+    size_t txn_len[TXN_MAX_FILES]; /* Sizes of the files set */
+    bool abort;                  /* Discarded instead of committed */
+};
+
+struct shadow_file_t {
+    bool exists;
+    size_t size;
+    size_t size_max;
+    uint8_t *data;
+};
+
+struct harness_opts_t {
+    struct sim_flash_config_t flash;
+    uint32_t sectors_per_block;
+    uint32_t num_blocks;
+    uint32_t max_num_files;
+    uint32_t max_file_size;
+    uint32_t num_ops;
+    uint32_t seed;
+    int workload;      /* WORKLOAD_COUNT to run all workloads */
+    bool power_loss;
+    bool deferred_compaction;
+    uint32_t idle_steps; /* Compaction steps run after each operation */
+    uint32_t cache_lines; /* Flash cache lines, 0 to disable the cache */
+    uint32_t cache_line_size;
+    uint32_t max_wear_spread; /* Largest erase count difference between the
+                               * data blocks, UINT32_MAX for no check
+                               */
+};
+
+struct harness_t {
+    struct its_flash_fs_config_t cfg;
+    struct its_flash_fs_ctx_t ctx;
+    const struct its_flash_fs_ops_t *ops;
+    struct its_flash_nand_dev_t nand_dev;
+    struct its_flash_cache_t cache;
+#if ITS_RAM_FILE_INDEX
+    struct its_flash_fs_index_t index;
+#endif
+    struct shadow_file_t *files;
+    uint32_t num_files;    /* Number of files used by the workload */
+    uint8_t *buf;
+    uint8_t *txn_buf;      /* Data of the files set by a transaction */
+    uint8_t *image;
+    uint64_t rng;
+    uint64_t bytes_written;
+    uint64_t ops_done;
+    uint64_t ops_full;
+    uint64_t deletes;
+    uint64_t delete_ns;     /* Flash time spent in deletions */
+    uint64_t delete_max_ns; /* Longest flash time of a deletion */
+    uint64_t idle_ns;       /* Flash time spent in idle compaction steps */
+    uint64_t txn_commits;
+    uint64_t txn_aborts;
+};
+
+static struct harness_t h;
+static jmp_buf power_loss_env;
+
+static void power_loss_handler(void)
+{
+    longjmp(power_loss_env, 1);
+}
+
+static uint32_t rand_u32(uint64_t *state)
+{
+    /* xorshift64* */
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (uint32_t)((*state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static uint32_t rand_range(uint32_t lo, uint32_t hi)
+{
+    return lo + (rand_u32(&h.rng) % (hi - lo + 1));
+}
+
+static void fill_pattern(uint8_t *data, size_t len, uint32_t pattern)
+{
+    uint64_t state = ((uint64_t)pattern << 1) | 1;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        data[i] = (uint8_t)rand_u32(&state);
+    }
+}
+
+static void file_id(uint32_t file, uint8_t *fid)
+{
+    (void)memset(fid, 0, ITS_FILE_ID_SIZE);
+    (void)memcpy(fid, "HOST", 4);
+    (void)memcpy(fid + 4, &file, sizeof(file));
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+/**
+ * \brief Mounts the filesystem, discarding any state left in RAM.
+ */
+static psa_status_t mount(void)
+{
+    psa_status_t err;
+
+    if (h.cfg.flash_dev == &h.nand_dev) {
+        h.nand_dev.buf_block_id_0 = ITS_BLOCK_INVALID_ID;
+        h.nand_dev.buf_block_id_1 = ITS_BLOCK_INVALID_ID;
+        (void)memset(h.nand_dev.write_buf_0, 0, h.nand_dev.buf_size);
+        (void)memset(h.nand_dev.write_buf_1, 0, h.nand_dev.buf_size);
+    }
+
+    (void)memset(&h.ctx, 0, sizeof(h.ctx));
+    err = its_flash_fs_init_ctx(&h.ctx, &h.cfg, h.ops);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    return its_flash_fs_prepare(&h.ctx);
+}
+
+static int setup(const struct harness_opts_t *opts)
+{
+    size_t erase_count_size;
+
+    if (sim_flash_create(&opts->flash) != 0) {
+        fprintf(stderr, "Invalid flash geometry\n");
+        return -1;
+    }
+
+    (void)memset(&h.cfg, 0, sizeof(h.cfg));
+    h.cfg.sector_size = opts->flash.sector_size;
+    h.cfg.block_size = opts->flash.sector_size * opts->sectors_per_block;
+    h.cfg.num_blocks = opts->num_blocks;
+    h.cfg.max_num_files = opts->max_num_files;
+    h.cfg.erase_val = opts->flash.erased_value;
+    h.cfg.deferred_compaction = opts->deferred_compaction;
+
+    if (opts->flash.model == SIM_FLASH_NAND) {
+        /* Blocks are buffered and programmed in one shot by the back end */
+        h.nand_dev.driver = &Driver_SIM_FLASH;
+        h.nand_dev.buf_block_id_0 = ITS_BLOCK_INVALID_ID;
+        h.nand_dev.buf_block_id_1 = ITS_BLOCK_INVALID_ID;
+        h.nand_dev.buf_size = h.cfg.block_size;
+        h.nand_dev.write_buf_0 = calloc(1, h.cfg.block_size);
+        h.nand_dev.write_buf_1 = calloc(1, h.cfg.block_size);
+        if ((h.nand_dev.write_buf_0 == NULL) ||
+            (h.nand_dev.write_buf_1 == NULL)) {
+            return -1;
+        }
+        h.cfg.flash_dev = &h.nand_dev;
+        h.cfg.program_unit = 1;
+        h.ops = &its_flash_fs_ops_nand;
+    } else {
+        if (opts->flash.program_unit > ITS_FLASH_MAX_ALIGNMENT) {
+            fprintf(stderr, "NOR program unit above %d, rebuild with a larger "
+                    "ITS_HOST_MAX_PROGRAM_UNIT\n", ITS_FLASH_MAX_ALIGNMENT);
+            return -1;
+        }
+        h.cfg.flash_dev = &Driver_SIM_FLASH;
+        h.cfg.program_unit = opts->flash.program_unit;
+        h.ops = &its_flash_fs_ops_nor;
+    }
+    h.cfg.max_file_size = ITS_UTILS_ALIGN(opts->max_file_size,
+                                          h.cfg.program_unit);
+
+#if ITS_RAM_FILE_INDEX
+    h.index.active_fid = calloc(opts->max_num_files, ITS_FILE_ID_SIZE);
+    h.index.scratch_fid = calloc(opts->max_num_files, ITS_FILE_ID_SIZE);
+    h.index.hash = calloc(ITS_FLASH_FS_INDEX_HASH_SIZE(opts->max_num_files),
+                          sizeof(uint16_t));
+    h.index.free_map = calloc((opts->max_num_files + 31) / 32,
+                              sizeof(uint32_t));
+    h.cfg.index = &h.index;
+#endif
+
+#if ITS_METADATA_JOURNAL_SIZE
+    /* As for the ITS partition, the journal needs appendable flash */
+    if ((opts->flash.model == SIM_FLASH_NOR) && (h.cfg.num_blocks > 2)) {
+        h.cfg.journal_size = ITS_METADATA_JOURNAL_SIZE;
+        h.cfg.journal_map = calloc(opts->max_num_files, sizeof(uint16_t));
+    }
+#endif
+
+#if ITS_WEAR_LEVELING_THRESHOLD
+    erase_count_size = ITS_UTILS_ALIGN(h.cfg.num_blocks * sizeof(uint32_t),
+                                       ITS_FLASH_MAX_ALIGNMENT);
+    h.cfg.erase_count = calloc(1, erase_count_size);
+    h.cfg.wear_threshold = ITS_WEAR_LEVELING_THRESHOLD;
+#else
+    (void)erase_count_size;
+#endif
+
+    if (opts->cache_lines != 0) {
+        h.cache.num_lines = opts->cache_lines;
+        h.cache.line_size = opts->cache_line_size;
+        h.cache.lines = calloc(opts->cache_lines, sizeof(*h.cache.lines));
+        h.cache.data = calloc(opts->cache_lines, opts->cache_line_size);
+        h.cache.wc_buf = calloc(1, opts->cache_line_size);
+        if ((h.cache.lines == NULL) || (h.cache.data == NULL) ||
+            (h.cache.wc_buf == NULL)) {
+            return -1;
+        }
+        h.cfg.cache = &h.cache;
+    }
+
+    h.files = calloc(opts->max_num_files, sizeof(*h.files));
+    h.buf = malloc(h.cfg.max_file_size);
+    h.txn_buf = malloc(TXN_MAX_FILES * h.cfg.max_file_size);
+    h.image = malloc(sim_flash_image_size());
+    if ((h.files == NULL) || (h.buf == NULL) || (h.txn_buf == NULL) ||
+        (h.image == NULL)) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < opts->max_num_files; i++) {
+        h.files[i].data = malloc(h.cfg.max_file_size);
+        if (h.files[i].data == NULL) {
+            return -1;
+        }
+    }
+
+    if (its_flash_fs_init_ctx(&h.ctx, &h.cfg, h.ops) != PSA_SUCCESS) {
+        fprintf(stderr, "Filesystem configuration rejected\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Gives the index of the n-th file updated by a transaction.
+ */
+static uint32_t txn_file(const struct file_op_t *op, uint32_t n)
+{
+    return (op->file + n) % h.num_files;
+}
+
+/**
+ * \brief Commits a transaction with a single batch update of the filesystem.
+ *        An aborted transaction is discarded before it reaches the
+ *        filesystem, as its changes are only staged in RAM.
+ */
+static psa_status_t run_txn(const struct file_op_t *op)
+{
+    struct its_flash_fs_file_op_t ops[TXN_MAX_FILES];
+    uint8_t fid[TXN_MAX_FILES][ITS_FILE_ID_SIZE];
+    uint8_t *data;
+    uint32_t n;
+
+    if (op->abort) {
+        return PSA_SUCCESS;
+    }
+
+    (void)memset(ops, 0, sizeof(ops));
+    for (n = 0; n < op->num_files; n++) {
+        file_id(txn_file(op, n), fid[n]);
+        ops[n].fid = fid[n];
+        if (op->remove_mask & (1u << n)) {
+            ops[n].remove = true;
+        } else {
+            data = h.txn_buf + n * h.cfg.max_file_size;
+            fill_pattern(data, op->txn_len[n], op->pattern + n);
+            ops[n].data = data;
+            ops[n].finfo.size_current = op->txn_len[n];
+            ops[n].finfo.flags = ITS_FLASH_FS_FLAG_CREATE |
+                                 ITS_FLASH_FS_FLAG_TRUNCATE;
+        }
+    }
+
+    return its_flash_fs_file_write_batch(&h.ctx, ops, op->num_files);
+}
+
+/**
+ * \brief Generates the next operation of the workload.
+ */
+static void next_op(int workload, uint32_t n, struct file_op_t *op)
+{
+    const struct shadow_file_t *file;
+    uint32_t r = rand_range(0, 99);
+
+    (void)memset(op, 0, sizeof(*op));
+    op->file = rand_range(0, h.num_files - 1);
+    op->pattern = n;
+    file = &h.files[op->file];
+
+    switch (workload) {
+    case WORKLOAD_COUNTERS:
+        op->type = (r < 75) ? FILE_OP_SET : FILE_OP_READ;
+        /* Each counter keeps its size, between 4 and 16 bytes */
+        op->size = 4 + (op->file % 4) * 4;
+        break;
+    case WORKLOAD_BLOBS:
+        op->type = (r < 50) ? FILE_OP_SET : FILE_OP_READ;
+        op->size = rand_range(h.cfg.max_file_size / 2, h.cfg.max_file_size);
+        break;
+    case WORKLOAD_TXN:
+        op->type = (r < 75) ? FILE_OP_TXN : FILE_OP_READ;
+        break;
+    default:
+        if (r < 35) {
+            op->type = FILE_OP_SET;
+        } else if (r < 50) {
+            op->type = FILE_OP_APPEND;
+        } else if (r < 75) {
+            op->type = FILE_OP_DELETE;
+        } else {
+            op->type = FILE_OP_READ;
+        }
+        op->size = rand_range(1, h.cfg.max_file_size);
+        break;
+    }
+
+    if (op->type == FILE_OP_SET) {
+        op->len = op->size;
+    } else if (op->type == FILE_OP_TXN) {
+        op->num_files = rand_range(1, ITS_UTILS_MIN(TXN_MAX_FILES,
+                                                    h.num_files));
+        op->abort = (rand_range(0, 99) < 10);
+        for (uint32_t i = 0; i < op->num_files; i++) {
+            /* Only existing files can be deleted by a transaction */
+            if (h.files[txn_file(op, i)].exists && (rand_range(0, 99) < 25)) {
+                op->remove_mask |= 1u << i;
+            } else {
+                op->txn_len[i] = rand_range(1, h.cfg.max_file_size / 2);
+            }
+        }
+    } else if (op->type == FILE_OP_APPEND) {
+        if (!file->exists || (file->size == file->size_max)) {
+            /* Nothing to append to, create the file with room to grow */
+            op->type = FILE_OP_SET;
+            op->len = op->size / 2;
+        } else {
+            /* Writes start on a program unit, so the end of the last one is
+             * written again.
+             */
+            op->offset = file->size - (file->size % h.cfg.program_unit);
+            op->len = rand_range(file->size - op->offset + 1,
+                                 file->size_max - op->offset);
+        }
+    } else if ((op->type == FILE_OP_READ) && file->exists &&
+               (file->size != 0)) {
+        op->offset = rand_range(0, file->size - 1);
+        op->len = rand_range(1, file->size - op->offset);
+    }
+}
+
+/**
+ * \brief Runs a file operation on the filesystem.
+ *
+ * \return Returns the status of the filesystem call. A read is checked against
+ *         the shadow copy, and PSA_ERROR_DATA_CORRUPT is returned on mismatch.
+ */
+static psa_status_t run_op(const struct file_op_t *op)
+{
+    const struct shadow_file_t *file = &h.files[op->file];
+    struct its_flash_fs_file_info_t finfo = {0};
+    uint8_t fid[ITS_FILE_ID_SIZE];
+    psa_status_t err;
+
+    file_id(op->file, fid);
+
+    switch (op->type) {
+    case FILE_OP_SET:
+        finfo.size_max = op->size;
+        finfo.size_current = op->len;
+        finfo.flags = ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE;
+        fill_pattern(h.buf, op->len, op->pattern);
+        return its_flash_fs_file_write(&h.ctx, fid, &finfo, op->len, 0, h.buf);
+    case FILE_OP_APPEND:
+        finfo.size_max = file->size_max;
+        finfo.size_current = file->size;
+        (void)memcpy(h.buf, file->data + op->offset, file->size - op->offset);
+        fill_pattern(h.buf + (file->size - op->offset),
+                     op->offset + op->len - file->size, op->pattern);
+        return its_flash_fs_file_write(&h.ctx, fid, &finfo, op->len,
+                                       op->offset, h.buf);
+    case FILE_OP_DELETE:
+        err = its_flash_fs_file_delete(&h.ctx, fid);
+        if (!file->exists) {
+            return (err == PSA_ERROR_DOES_NOT_EXIST) ? PSA_SUCCESS :
+                                                       PSA_ERROR_DATA_CORRUPT;
+        }
+        return err;
+    case FILE_OP_COMPACT:
+        err = its_flash_fs_compact_step(&h.ctx);
+        return (err == PSA_ERROR_DOES_NOT_EXIST) ? PSA_SUCCESS : err;
+    case FILE_OP_TXN:
+        return run_txn(op);
+    default:
+        err = its_flash_fs_file_read(&h.ctx, fid, op->len, op->offset, h.buf);
+        if (!file->exists) {
+            return (err == PSA_ERROR_DOES_NOT_EXIST) ? PSA_SUCCESS :
+                                                       PSA_ERROR_DATA_CORRUPT;
+        }
+        if ((err == PSA_SUCCESS) &&
+            (memcmp(h.buf, file->data + op->offset, op->len) != 0)) {
+            err = PSA_ERROR_DATA_CORRUPT;
+        }
+        return err;
+    }
+}
+
+/**
+ * \brief Applies a successful file operation to a shadow copy of the files.
+ */
+static void apply_op(struct shadow_file_t *files, const struct file_op_t *op)
+{
+    struct shadow_file_t *file = &files[op->file];
+    uint32_t n;
+
+    switch (op->type) {
+    case FILE_OP_SET:
+        file->exists = true;
+        file->size_max = ITS_UTILS_ALIGN(op->size, h.cfg.program_unit);
+        file->size = op->len;
+        fill_pattern(file->data, op->len, op->pattern);
+        break;
+    case FILE_OP_APPEND:
+        fill_pattern(file->data + file->size, op->offset + op->len - file->size,
+                     op->pattern);
+        file->size = op->offset + op->len;
+        break;
+    case FILE_OP_DELETE:
+        file->exists = false;
+        break;
+    case FILE_OP_TXN:
+        for (n = 0; (n < op->num_files) && !op->abort; n++) {
+            file = &files[txn_file(op, n)];
+            if (op->remove_mask & (1u << n)) {
+                file->exists = false;
+            } else {
+                file->exists = true;
+                file->size_max = ITS_UTILS_ALIGN(op->txn_len[n],
+                                                 h.cfg.program_unit);
+                file->size = op->txn_len[n];
+                fill_pattern(file->data, op->txn_len[n], op->pattern + n);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * \brief Gives the number of bytes written by a successful file operation.
+ */
+static size_t op_bytes_written(const struct file_op_t *op)
+{
+    size_t len = 0;
+    uint32_t n;
+
+    if ((op->type == FILE_OP_SET) || (op->type == FILE_OP_APPEND)) {
+        len = op->len;
+    } else if ((op->type == FILE_OP_TXN) && !op->abort) {
+        for (n = 0; n < op->num_files; n++) {
+            len += op->txn_len[n];
+        }
+    }
+
+    return len;
+}
+
+/**
+ * \brief Checks that a file in the filesystem matches its shadow copy.
+ */
+static bool file_matches(uint32_t idx, const struct shadow_file_t *file)
+{
+    struct its_flash_fs_file_info_t finfo;
+    uint8_t fid[ITS_FILE_ID_SIZE];
+    psa_status_t err;
+
+    file_id(idx, fid);
+    err = its_flash_fs_file_get_info(&h.ctx, fid, &finfo);
+    if (!file->exists) {
+        return err == PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    if ((err != PSA_SUCCESS) || (finfo.size_current != file->size) ||
+        (finfo.size_max != file->size_max)) {
+        return false;
+    }
+
+    err = its_flash_fs_file_read(&h.ctx, fid, file->size, 0, h.buf);
+
+    return (err == PSA_SUCCESS) &&
+           (memcmp(h.buf, file->data, file->size) == 0);
+}
+
+/**
+ * \brief Checks all the files against the given shadow copy.
+ */
+static bool files_match(const struct shadow_file_t *files)
+{
+    for (uint32_t i = 0; i < h.num_files; i++) {
+        if (!file_matches(i, &files[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool is_update(const struct file_op_t *op)
+{
+    return (op->type != FILE_OP_READ) &&
+           !((op->type == FILE_OP_TXN) && op->abort);
+}
+
+static void free_files(struct shadow_file_t *files)
+{
+    if (files != NULL) {
+        for (uint32_t i = 0; i < h.num_files; i++) {
+            free(files[i].data);
+        }
+        free(files);
+    }
+}
+
+/**
+ * \brief Makes a copy of the shadow copy of the files.
+ */
+static struct shadow_file_t *copy_files(void)
+{
+    struct shadow_file_t *files = calloc(h.num_files, sizeof(*files));
+
+    if (files == NULL) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < h.num_files; i++) {
+        files[i] = h.files[i];
+        files[i].data = malloc(h.cfg.max_file_size);
+        if (files[i].data == NULL) {
+            free_files(files);
+            return NULL;
+        }
+        (void)memcpy(files[i].data, h.files[i].data, h.cfg.max_file_size);
+    }
+
+    return files;
+}
+
+/**
+ * \brief Runs an update with a power loss at each of its program and erase
+ *        operations in turn. The flash content is restored before each run,
+ *        and the last run completes the update.
+ *
+ * \param[in]  op   Update to run
+ * \param[out] err  Status of the completed update
+ *
+ * \return Returns the number of power losses, or -1 on a recovery failure.
+ */
+static long power_loss_sweep(const struct file_op_t *op, psa_status_t *err)
+{
+    struct shadow_file_t *old_files, *new_files;
+    volatile long cuts = 0;
+    volatile uint64_t k;
+    psa_status_t status;
+
+    old_files = copy_files();
+    new_files = copy_files();
+    if ((old_files == NULL) || (new_files == NULL)) {
+        free_files(old_files);
+        free_files(new_files);
+        return -1;
+    }
+    apply_op(new_files, op);
+
+    sim_flash_save(h.image);
+
+    for (k = 0; ; k++) {
+        sim_flash_restore(h.image);
+        status = mount();
+        if (status != PSA_SUCCESS) {
+            break;
+        }
+
+        if (setjmp(power_loss_env) == 0) {
+            sim_flash_set_power_loss(sim_flash_get_write_ops() + k,
+                                     power_loss_handler);
+            *err = run_op(op);
+            sim_flash_set_power_loss(0, NULL);
+            break;
+        }
+
+        /* Power was lost, the update must be either complete or not visible,
+         * for all the files it changes.
+         */
+        cuts++;
+        status = mount();
+        if (status != PSA_SUCCESS) {
+            fprintf(stderr, "Mount failed (%d) after power loss at write %"
+                    PRIu64 " of the update\n", (int)status, k);
+            break;
+        }
+
+        if (!files_match(old_files) && !files_match(new_files)) {
+            fprintf(stderr, "Inconsistent files after power loss at write %"
+                    PRIu64 " of the update\n", k);
+            status = PSA_ERROR_DATA_CORRUPT;
+            break;
+        }
+
+        /* The filesystem must accept the update again after recovery */
+        if (files_match(old_files)) {
+            status = run_op(op);
+        }
+        if ((status != PSA_SUCCESS) &&
+            (status != PSA_ERROR_INSUFFICIENT_STORAGE)) {
+            fprintf(stderr, "Update failed (%d) after power loss at write %"
+                    PRIu64 "\n", (int)status, k);
+            break;
+        }
+    }
+
+    free_files(old_files);
+    free_files(new_files);
+
+    return (status == PSA_SUCCESS) ? cuts : -1;
+}
+
+/**
+ * \brief Prints the erase counts of the blocks.
+ *
+ * \return Returns the difference between the erase counts of the most and
+ *         least worn data blocks.
+ */
+static uint32_t print_erase_counts(void)
+{
+    const uint32_t *counts = sim_flash_get_erase_counts();
+    uint32_t blk, s, min = UINT32_MAX, max = 0, count;
+    uint32_t data_min = UINT32_MAX, data_max = 0;
+    uint32_t spb = h.cfg.block_size / h.cfg.sector_size;
+    uint64_t meta_erases = 0, data_erases = 0;
+
+    printf("  erases per block:");
+    for (blk = 0; blk < h.cfg.num_blocks; blk++) {
+        count = 0;
+        for (s = 0; s < spb; s++) {
+            count = ITS_UTILS_MAX(count, counts[blk * spb + s]);
+        }
+        min = ITS_UTILS_MIN(min, count);
+        max = ITS_UTILS_MAX(max, count);
+        /* The two first blocks are the metadata blocks */
+        if (blk >= 2) {
+            data_min = ITS_UTILS_MIN(data_min, count);
+            data_max = ITS_UTILS_MAX(data_max, count);
+            data_erases += count;
+        } else {
+            meta_erases += count;
+        }
+        printf(" %" PRIu32, count);
+    }
+    printf("\n  erases min/max: %" PRIu32 "/%" PRIu32 "\n", min, max);
+    printf("  erases of metadata blocks: %" PRIu64 ", of data blocks: %" PRIu64
+           " (%.3f per op)\n", meta_erases, data_erases,
+           (h.ops_done != 0) ?
+           (double)(meta_erases + data_erases) / (double)h.ops_done : 0.0);
+
+    return (data_max >= data_min) ? data_max - data_min : 0;
+}
+
+/**
+ * \brief Runs an operation, with a power loss sweep if it is an update and
+ *        power losses are checked.
+ *
+ * \return Returns the number of power losses, or -1 on a recovery failure.
+ */
+static long run_checked_op(const struct harness_opts_t *opts,
+                           const struct file_op_t *op, psa_status_t *err)
+{
+    if (opts->power_loss && is_update(op)) {
+        return power_loss_sweep(op, err);
+    }
+
+    *err = run_op(op);
+
+    return 0;
+}
+
+static int run_workload(const struct harness_opts_t *opts, int workload)
+{
+    const struct sim_flash_stats_t *stats = sim_flash_get_stats();
+    struct file_op_t op;
+    struct file_op_t idle_op = {.type = FILE_OP_COMPACT};
+    long cuts = 0, ret;
+    double start, host_s, dev_s;
+    uint64_t busy_ns;
+    psa_status_t err;
+    uint32_t n, i, wear_spread = 0;
+
+    h.rng = ((uint64_t)opts->seed << 8) | (uint64_t)(workload + 1);
+    /* One file metadata entry is kept for atomic replacement, as by the ITS
+     * partition.
+     */
+    h.num_files = (workload == WORKLOAD_BLOBS) ?
+                  ITS_UTILS_MIN(opts->max_num_files - 1, 4) :
+                  opts->max_num_files - 1;
+    h.bytes_written = 0;
+    h.ops_done = 0;
+    h.ops_full = 0;
+    h.deletes = 0;
+    h.delete_ns = 0;
+    h.delete_max_ns = 0;
+    h.idle_ns = 0;
+    h.txn_commits = 0;
+    h.txn_aborts = 0;
+    for (n = 0; n < opts->max_num_files; n++) {
+        h.files[n].exists = false;
+    }
+
+    if ((its_flash_fs_wipe_all(&h.ctx) != PSA_SUCCESS) ||
+        (mount() != PSA_SUCCESS)) {
+        fprintf(stderr, "%s: cannot create the filesystem\n",
+                workload_names[workload]);
+        return -1;
+    }
+    sim_flash_reset_stats();
+
+    start = now_s();
+    for (n = 0; n < opts->num_ops; n++) {
+        next_op(workload, n, &op);
+
+        busy_ns = stats->busy_ns;
+        ret = run_checked_op(opts, &op, &err);
+        if (ret < 0) {
+            fprintf(stderr, "%s: power loss check failed at op %" PRIu32
+                    "\n", workload_names[workload], n);
+            return -1;
+        }
+        cuts += ret;
+
+        if ((op.type == FILE_OP_DELETE) && h.files[op.file].exists) {
+            busy_ns = stats->busy_ns - busy_ns;
+            h.deletes++;
+            h.delete_ns += busy_ns;
+            h.delete_max_ns = ITS_UTILS_MAX(h.delete_max_ns, busy_ns);
+        }
+
+        if (err == PSA_SUCCESS) {
+            apply_op(h.files, &op);
+            h.bytes_written += op_bytes_written(&op);
+            if (op.type == FILE_OP_TXN) {
+                if (op.abort) {
+                    h.txn_aborts++;
+                } else {
+                    h.txn_commits++;
+                }
+            }
+        } else if (err == PSA_ERROR_INSUFFICIENT_STORAGE) {
+            h.ops_full++;
+        } else {
+            fprintf(stderr, "%s: op %" PRIu32 " failed (%d)\n",
+                    workload_names[workload], n, (int)err);
+            return -1;
+        }
+        h.ops_done++;
+
+        /* The system is idle until the next operation */
+        busy_ns = stats->busy_ns;
+        for (i = 0; i < opts->idle_steps; i++) {
+            ret = run_checked_op(opts, &idle_op, &err);
+            if ((ret < 0) || (err != PSA_SUCCESS)) {
+                fprintf(stderr, "%s: compaction failed after op %" PRIu32
+                        "\n", workload_names[workload], n);
+                return -1;
+            }
+            cuts += ret;
+        }
+        h.idle_ns += stats->busy_ns - busy_ns;
+    }
+    host_s = now_s() - start;
+    dev_s = (double)(stats->busy_ns - h.idle_ns) / 1e9;
+
+    if ((mount() != PSA_SUCCESS) || !files_match(h.files)) {
+        fprintf(stderr, "%s: files differ after remount\n",
+                workload_names[workload]);
+        return -1;
+    }
+
+    printf("%s:\n", workload_names[workload]);
+    printf("  ops: %" PRIu64 " (%" PRIu64 " out of space)\n", h.ops_done,
+           h.ops_full);
+    if (workload == WORKLOAD_TXN) {
+        printf("  transactions: %" PRIu64 " committed, %" PRIu64
+               " aborted\n", h.txn_commits, h.txn_aborts);
+    }
+    if (opts->power_loss) {
+        printf("  power losses recovered: %ld\n", cuts);
+    } else {
+        printf("  ops/s: %.0f (host %.3f s, flash %.3f s)\n",
+               (double)h.ops_done / (host_s + dev_s), host_s, dev_s);
+        printf("  bytes written: %" PRIu64 ", programmed: %" PRIu64
+               " (%.2f per byte), read: %" PRIu64 "\n",
+               h.bytes_written, stats->bytes_programmed,
+               (h.bytes_written != 0) ?
+               (double)stats->bytes_programmed / (double)h.bytes_written : 0.0,
+               stats->bytes_read);
+        printf("  program operations: %" PRIu64 ", read operations: %" PRIu64
+               "\n", stats->programs, stats->reads);
+        if (h.deletes != 0) {
+            printf("  delete flash time: avg %.0f us, max %.0f us\n",
+                   (double)h.delete_ns / (double)h.deletes / 1e3,
+                   (double)h.delete_max_ns / 1e3);
+        }
+        if (opts->idle_steps != 0) {
+            printf("  idle compaction flash time: %.3f s\n",
+                   (double)h.idle_ns / 1e9);
+        }
+        wear_spread = print_erase_counts();
+    }
+
+    if (stats->violations != 0) {
+        fprintf(stderr, "%s: %" PRIu64 " flash operations broke the rules of "
+                "the device\n", workload_names[workload], stats->violations);
+        return -1;
+    }
+
+    if (wear_spread > opts->max_wear_spread) {
+        fprintf(stderr, "%s: erase counts of the data blocks differ by %"
+                PRIu32 ", more than %" PRIu32 "\n", workload_names[workload],
+                wear_spread, opts->max_wear_spread);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [options]\n"
+           "  -m, --model nor|nand     flash technology (nor)\n"
+           "  -u, --program-unit N     program unit, page size for NAND\n"
+           "  -s, --sector-size N      erase sector size (4096)\n"
+           "  -k, --sectors-per-block N  sectors per filesystem block (1)\n"
+           "  -b, --blocks N           filesystem blocks (8)\n"
+           "  -f, --files N            maximum number of files (16)\n"
+           "  -z, --file-size N        maximum file size (1024)\n"
+           "  -w, --workload NAME      counters, blobs, churn, transactions or "
+           "all (all)\n"
+           "  -n, --ops N              operations per workload (2000)\n"
+           "  -r, --seed N             random seed (1)\n"
+           "  -p, --power-loss         lose power at each flash write of each "
+           "update\n"
+           "  -c, --deferred-compaction  only mark deleted files\n"
+           "  -i, --idle-steps N       compaction steps after each operation "
+           "(0)\n"
+           "  -l, --cache-lines N      flash cache lines (0)\n"
+           "      --cache-line-size N  flash cache line size (64)\n"
+           "      --read-op-ns N       read time per operation\n"
+           "      --read-ns N          read time per byte\n"
+           "      --program-ns N       program time per program unit\n"
+           "      --erase-ns N         erase time per sector\n"
+           "      --max-wear-spread N  fail if the erase counts of the data "
+           "blocks\n"
+           "                           differ by more than N\n", prog);
+}
+
+static int parse_opts(int argc, char *argv[], struct harness_opts_t *opts)
+{
+    static const struct option long_opts[] = {
+        {"model", required_argument, NULL, 'm'},
+        {"program-unit", required_argument, NULL, 'u'},
+        {"sector-size", required_argument, NULL, 's'},
+        {"sectors-per-block", required_argument, NULL, 'k'},
+        {"blocks", required_argument, NULL, 'b'},
+        {"files", required_argument, NULL, 'f'},
+        {"file-size", required_argument, NULL, 'z'},
+        {"workload", required_argument, NULL, 'w'},
+        {"ops", required_argument, NULL, 'n'},
+        {"seed", required_argument, NULL, 'r'},
+        {"power-loss", no_argument, NULL, 'p'},
+        {"deferred-compaction", no_argument, NULL, 'c'},
+        {"idle-steps", required_argument, NULL, 'i'},
+        {"cache-lines", required_argument, NULL, 'l'},
+        {"cache-line-size", required_argument, NULL, 'L'},
+        {"read-op-ns", required_argument, NULL, 'O'},
+        {"read-ns", required_argument, NULL, 'R'},
+        {"program-ns", required_argument, NULL, 'P'},
+        {"erase-ns", required_argument, NULL, 'E'},
+        {"max-wear-spread", required_argument, NULL, 'W'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    /* Timings default to typical values of the technology, 0 when unset */
+    uint32_t program_unit = 0, read_ns = 0, program_ns = 0, erase_ns = 0;
+    uint32_t read_op_ns = 0;
+    bool timing_set[4] = {false, false, false, false};
+    int c, w;
+
+    (void)memset(opts, 0, sizeof(*opts));
+    opts->flash.model = SIM_FLASH_NOR;
+    opts->flash.sector_size = 4096;
+    opts->flash.erased_value = 0xFF;
+    opts->sectors_per_block = 1;
+    opts->num_blocks = 8;
+    opts->max_num_files = 16;
+    opts->max_file_size = 1024;
+    opts->num_ops = 2000;
+    opts->seed = 1;
+    opts->workload = WORKLOAD_COUNT;
+    opts->cache_line_size = 64;
+    opts->max_wear_spread = UINT32_MAX;
+
+    while ((c = getopt_long(argc, argv, "m:u:s:k:b:f:z:w:n:r:pci:l:h", long_opts,
+                            NULL)) != -1) {
+        switch (c) {
+        case 'm':
+            if (strcmp(optarg, "nor") == 0) {
+                opts->flash.model = SIM_FLASH_NOR;
+            } else if (strcmp(optarg, "nand") == 0) {
+                opts->flash.model = SIM_FLASH_NAND;
+            } else {
+                return -1;
+            }
+            break;
+        case 'u':
+            program_unit = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            opts->flash.sector_size = strtoul(optarg, NULL, 0);
+            break;
+        case 'k':
+            opts->sectors_per_block = strtoul(optarg, NULL, 0);
+            break;
+        case 'b':
+            opts->num_blocks = strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            opts->max_num_files = strtoul(optarg, NULL, 0);
+            break;
+        case 'z':
+            opts->max_file_size = strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            opts->workload = -1;
+            for (w = 0; w < WORKLOAD_COUNT; w++) {
+                if (strcmp(optarg, workload_names[w]) == 0) {
+                    opts->workload = w;
+                }
+            }
+            if (strcmp(optarg, "all") == 0) {
+                opts->workload = WORKLOAD_COUNT;
+            } else if (opts->workload < 0) {
+                return -1;
+            }
+            break;
+        case 'n':
+            opts->num_ops = strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            opts->seed = strtoul(optarg, NULL, 0);
+            break;
+        case 'p':
+            opts->power_loss = true;
+            break;
+        case 'c':
+            opts->deferred_compaction = true;
+            break;
+        case 'i':
+            opts->idle_steps = strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            opts->cache_lines = strtoul(optarg, NULL, 0);
+            break;
+        case 'L':
+            opts->cache_line_size = strtoul(optarg, NULL, 0);
+            break;
+        case 'O':
+            read_op_ns = strtoul(optarg, NULL, 0);
+            timing_set[3] = true;
+            break;
+        case 'R':
+            read_ns = strtoul(optarg, NULL, 0);
+            timing_set[0] = true;
+            break;
+        case 'P':
+            program_ns = strtoul(optarg, NULL, 0);
+            timing_set[1] = true;
+            break;
+        case 'E':
+            erase_ns = strtoul(optarg, NULL, 0);
+            timing_set[2] = true;
+            break;
+        case 'W':
+            opts->max_wear_spread = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if (opts->flash.model == SIM_FLASH_NAND) {
+        /* 512 byte pages: 25 us page access then 25 ns per byte, 250 us
+         * program, 2 ms erase
+         */
+        opts->flash.program_unit = 512;
+        opts->flash.read_op_ns = 25000;
+        opts->flash.read_ns = 25;
+        opts->flash.program_ns = 250000;
+        opts->flash.erase_ns = 2000000;
+    } else {
+        /* 4 byte program unit: 1 us read command, 20 us program, 20 ms
+         * sector erase
+         */
+        opts->flash.program_unit = 4;
+        opts->flash.read_op_ns = 1000;
+        opts->flash.read_ns = 10;
+        opts->flash.program_ns = 20000;
+        opts->flash.erase_ns = 20000000;
+    }
+    if (program_unit != 0) {
+        opts->flash.program_unit = program_unit;
+    }
+    if (timing_set[0]) {
+        opts->flash.read_ns = read_ns;
+    }
+    if (timing_set[1]) {
+        opts->flash.program_ns = program_ns;
+    }
+    if (timing_set[2]) {
+        opts->flash.erase_ns = erase_ns;
+    }
+    if (timing_set[3]) {
+        opts->flash.read_op_ns = read_op_ns;
+    }
+
+    if ((opts->sectors_per_block == 0) || (opts->max_num_files < 2) ||
+        (opts->max_file_size == 0) || (opts->num_blocks > UINT16_MAX) ||
+        (opts->max_num_files > UINT16_MAX) ||
+        (opts->max_file_size > UINT16_MAX)) {
+        return -1;
+    }
+    opts->flash.sector_count = opts->num_blocks * opts->sectors_per_block;
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    struct harness_opts_t opts;
+    int w, ret = 0;
+
+    if (parse_opts(argc, argv, &opts) != 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (setup(&opts) != 0) {
+        return 1;
+    }
+
+    printf("%s flash: %" PRIu32 " blocks of %" PRIu32 " bytes, program unit %"
+           PRIu32 ", journal %" PRIu32 " bytes, wear leveling %s, "
+           "compaction %s, cache %" PRIu32 " lines of %" PRIu32 " bytes\n",
+           (opts.flash.model == SIM_FLASH_NAND) ? "NAND" : "NOR",
+           (uint32_t)h.cfg.num_blocks, h.cfg.block_size,
+           opts.flash.program_unit, h.cfg.journal_size,
+           (h.cfg.erase_count != NULL) ? "on" : "off",
+           h.cfg.deferred_compaction ? "deferred" : "immediate",
+           opts.cache_lines, opts.cache_line_size);
+
+    for (w = 0; w < WORKLOAD_COUNT; w++) {
+        if ((opts.workload == w) || (opts.workload == WORKLOAD_COUNT)) {
+            if (run_workload(&opts, w) != 0) {
+                ret = 1;
+            }
+        }
+    }
+
+    sim_flash_destroy();
+
+    return ret;
+}
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_flash.h"
+
+/* Driver version */
+#define ARM_FLASH_DRV_VERSION  ARM_DRIVER_VERSION_MAJOR_MINOR(1, 0)
+
+/* Programming state of a page */
+#define PAGE_ERASED      0
+#define PAGE_PROGRAMMED  1
+#define PAGE_TORN        2 /* Interrupted NAND program */
+
+struct sim_flash_t {
+    struct sim_flash_config_t cfg;
+    ARM_FLASH_INFO info;
+    uint8_t *mem;            /* Device content */
+    uint8_t *programmed;     /* Programming state of each page */
+    uint32_t *erase_count;   /* Erase count of each sector */
+    uint32_t pages_per_sector;
+    struct sim_flash_stats_t stats;
+    uint64_t write_ops;      /* Number of program and erase operations */
+    uint64_t power_loss_op;
+    sim_flash_power_loss_cb_t power_loss_cb;
+};
+
+static struct sim_flash_t sim;
+
+static const ARM_DRIVER_VERSION DriverVersion = {
+    ARM_FLASH_API_VERSION,
+    ARM_FLASH_DRV_VERSION
+};
+
+/* Items are bytes, so that any program unit can be modelled */
+static const ARM_FLASH_CAPABILITIES DriverCapabilities = {
+    0, /* event_ready */
+    0, /* data_width = 0:8-bit, 1:16-bit, 2:32-bit */
+    1  /* erase_chip */
+};
+
+static uint32_t flash_size(void)
+{
+    return sim.cfg.sector_size * sim.cfg.sector_count;
+}
+
+static uint32_t num_pages(void)
+{
+    return flash_size() / sim.cfg.program_unit;
+}
+
+/**
+ * \brief Checks whether the next program or erase operation is the one during
+ *        which power is lost.
+ *
+ * \return Returns true if power is lost, in which case the caller performs half
+ *         of the operation and then calls power_loss().
+ */
+static bool power_is_lost(void)
+{
+    return (sim.power_loss_cb != NULL) &&
+           (sim.write_ops == sim.power_loss_op);
+}
+
+static void power_loss(void)
+{
+    sim_flash_power_loss_cb_t cb = sim.power_loss_cb;
+
+    sim.power_loss_cb = NULL;
+    sim.write_ops++;
+    cb();
+}
+
+/**
+ * \brief Checks that the pages can be programmed under the rules of the
+ *        modelled technology.
+ */
+static bool can_program(uint32_t addr, uint32_t size)
+{
+    uint32_t page = addr / sim.cfg.program_unit;
+    uint32_t end = (addr + size) / sim.cfg.program_unit;
+    uint32_t first = page - (page % sim.pages_per_sector);
+    uint32_t i;
+
+    for (i = page; i < end; i++) {
+        if (sim.programmed[i] != PAGE_ERASED) {
+            return false;
+        }
+    }
+
+    if (sim.cfg.model == SIM_FLASH_NAND) {
+        /* Pages of a sector must be programmed in increasing order */
+        for (i = page + 1; i < first + sim.pages_per_sector; i++) {
+            if (sim.programmed[i] != PAGE_ERASED) {
+                return false;
+            }
+        }
+    } else {
+        /* An erased page may have been left partially programmed by a power
+         * loss, which is only visible in its content.
+         */
+        for (i = 0; i < size; i++) {
+            if (sim.mem[addr + i] != sim.cfg.erased_value) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void program_pages(uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    uint32_t i;
+
+    (void)memcpy(sim.mem + addr, data, size);
+    for (i = 0; i < size; i += sim.cfg.program_unit) {
+        sim.programmed[(addr + i) / sim.cfg.program_unit] = PAGE_PROGRAMMED;
+    }
+
+    sim.stats.programs++;
+    sim.stats.bytes_programmed += size;
+    sim.stats.busy_ns += (uint64_t)(size / sim.cfg.program_unit) *
+                         sim.cfg.program_ns;
+}
+
+static void erase_range(uint32_t addr, uint32_t size)
+{
+    (void)memset(sim.mem + addr, sim.cfg.erased_value, size);
+    (void)memset(sim.programmed + (addr / sim.cfg.program_unit), PAGE_ERASED,
+                 size / sim.cfg.program_unit);
+}
+
+static ARM_DRIVER_VERSION ARM_Flash_GetVersion(void)
+{
+    return DriverVersion;
+}
+
+static ARM_FLASH_CAPABILITIES ARM_Flash_GetCapabilities(void)
+{
+    return DriverCapabilities;
+}
+
+static int32_t ARM_Flash_Initialize(ARM_Flash_SignalEvent_t cb_event)
+{
+    (void)cb_event;
+
+    if (sim.mem == NULL) {
+        return ARM_DRIVER_ERROR;
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_Uninitialize(void)
+{
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_PowerControl(ARM_POWER_STATE state)
+{
+    return (state == ARM_POWER_FULL) ? ARM_DRIVER_OK :
+                                       ARM_DRIVER_ERROR_UNSUPPORTED;
+}
+
+static int32_t ARM_Flash_ReadData(uint32_t addr, void *data, uint32_t cnt)
+{
+    uint32_t i;
+
+    if ((addr > flash_size()) || (cnt > flash_size() - addr)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    for (i = addr / sim.cfg.program_unit;
+         i < (addr + cnt + sim.cfg.program_unit - 1) / sim.cfg.program_unit;
+         i++) {
+        if (sim.programmed[i] == PAGE_TORN) {
+            return ARM_DRIVER_ERROR;
+        }
+    }
+
+    (void)memcpy(data, sim.mem + addr, cnt);
+
+    sim.stats.reads++;
+    sim.stats.bytes_read += cnt;
+    sim.stats.busy_ns += sim.cfg.read_op_ns +
+                         ((uint64_t)cnt * sim.cfg.read_ns);
+
+    return (int32_t)cnt;
+}
+
+static int32_t ARM_Flash_ProgramData(uint32_t addr, const void *data,
+                                     uint32_t cnt)
+{
+    uint32_t half;
+
+    if ((addr > flash_size()) || (cnt > flash_size() - addr) ||
+        ((addr % sim.cfg.program_unit) != 0) ||
+        ((cnt % sim.cfg.program_unit) != 0)) {
+        sim.stats.violations++;
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    if (!can_program(addr, cnt)) {
+        sim.stats.violations++;
+        return ARM_DRIVER_ERROR;
+    }
+
+    if (power_is_lost()) {
+        half = (cnt / sim.cfg.program_unit / 2) * sim.cfg.program_unit;
+        program_pages(addr, data, half);
+        if (sim.cfg.model == SIM_FLASH_NAND) {
+            /* The ITS NAND back end requires incomplete writes to be detected
+             * by the driver, which reports them until the pages are erased.
+             */
+            (void)memset(sim.programmed + (addr / sim.cfg.program_unit),
+                         PAGE_TORN, cnt / sim.cfg.program_unit);
+        }
+        power_loss();
+    }
+
+    program_pages(addr, data, cnt);
+    sim.write_ops++;
+
+    return (int32_t)cnt;
+}
+
+static int32_t ARM_Flash_EraseSector(uint32_t addr)
+{
+    if ((addr >= flash_size()) || ((addr % sim.cfg.sector_size) != 0)) {
+        sim.stats.violations++;
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    sim.erase_count[addr / sim.cfg.sector_size]++;
+    sim.stats.erases++;
+    sim.stats.busy_ns += sim.cfg.erase_ns;
+
+    if (power_is_lost()) {
+        /* The end of the sector keeps its old content */
+        erase_range(addr, sim.cfg.sector_size / 2);
+        power_loss();
+    }
+
+    erase_range(addr, sim.cfg.sector_size);
+    sim.write_ops++;
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_EraseChip(void)
+{
+    uint32_t addr;
+    int32_t err;
+
+    for (addr = 0; addr < flash_size(); addr += sim.cfg.sector_size) {
+        err = ARM_Flash_EraseSector(addr);
+        if (err != ARM_DRIVER_OK) {
+            return err;
+        }
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+static ARM_FLASH_STATUS ARM_Flash_GetStatus(void)
+{
+    ARM_FLASH_STATUS status = {0, 0, 0};
+
+    return status;
+}
+
+static ARM_FLASH_INFO *ARM_Flash_GetInfo(void)
+{
+    return &sim.info;
+}
+
+ARM_DRIVER_FLASH Driver_SIM_FLASH = {
+    ARM_Flash_GetVersion,
+    ARM_Flash_GetCapabilities,
+    ARM_Flash_Initialize,
+    ARM_Flash_Uninitialize,
+    ARM_Flash_PowerControl,
+    ARM_Flash_ReadData,
+    ARM_Flash_ProgramData,
+    ARM_Flash_EraseSector,
+    ARM_Flash_EraseChip,
+    ARM_Flash_GetStatus,
+    ARM_Flash_GetInfo
+};
+
+int sim_flash_create(const struct sim_flash_config_t *cfg)
+{
+    sim_flash_destroy();
+
+    if ((cfg->program_unit == 0) || (cfg->sector_count == 0) ||
+        (cfg->sector_size == 0) ||
+        ((cfg->sector_size % cfg->program_unit) != 0) ||
+        ((uint64_t)cfg->sector_size * cfg->sector_count > UINT32_MAX)) {
+        return -1;
+    }
+
+    sim.cfg = *cfg;
+    sim.pages_per_sector = cfg->sector_size / cfg->program_unit;
+    sim.info.sector_info = NULL; /* Uniform sector layout */
+    sim.info.sector_count = cfg->sector_count;
+    sim.info.sector_size = cfg->sector_size;
+    sim.info.page_size = cfg->program_unit;
+    sim.info.program_unit = cfg->program_unit;
+    sim.info.erased_value = cfg->erased_value;
+
+    sim.mem = malloc(flash_size());
+    sim.programmed = malloc(num_pages());
+    sim.erase_count = calloc(cfg->sector_count, sizeof(uint32_t));
+    if ((sim.mem == NULL) || (sim.programmed == NULL) ||
+        (sim.erase_count == NULL)) {
+        sim_flash_destroy();
+        return -1;
+    }
+
+    erase_range(0, flash_size());
+
+    return 0;
+}
+
+void sim_flash_destroy(void)
+{
+    free(sim.mem);
+    free(sim.programmed);
+    free(sim.erase_count);
+    (void)memset(&sim, 0, sizeof(sim));
+}
+
+size_t sim_flash_image_size(void)
+{
+    return flash_size() + num_pages();
+}
+
+void sim_flash_save(uint8_t *image)
+{
+    (void)memcpy(image, sim.mem, flash_size());
+    (void)memcpy(image + flash_size(), sim.programmed, num_pages());
+}
+
+void sim_flash_restore(const uint8_t *image)
+{
+    (void)memcpy(sim.mem, image, flash_size());
+    (void)memcpy(sim.programmed, image + flash_size(), num_pages());
+}
+
+const struct sim_flash_stats_t *sim_flash_get_stats(void)
+{
+    return &sim.stats;
+}
+
+const uint32_t *sim_flash_get_erase_counts(void)
+{
+    return sim.erase_count;
+}
+
+void sim_flash_reset_stats(void)
+{
+    (void)memset(&sim.stats, 0, sizeof(sim.stats));
+    (void)memset(sim.erase_count, 0, sim.cfg.sector_count * sizeof(uint32_t));
+}
+
+uint64_t sim_flash_get_write_ops(void)
+{
+    return sim.write_ops;
+}
+
+void sim_flash_set_power_loss(uint64_t op, sim_flash_power_loss_cb_t cb)
+{
+    sim.power_loss_op = op;
+    sim.power_loss_cb = cb;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file sim_flash.h
+ *
+ * \brief Simulated flash device for the ITS host harness. It is exposed as a
+ *        CMSIS flash driver, so that the ITS NOR and NAND back ends run
+ *        unmodified on top of it. The device enforces the programming rules of
+ *        the modelled technology, accounts a simulated latency for each
+ *        operation and can lose power at a chosen program or erase operation.
+ */
+
+#ifndef __SIM_FLASH_H__
+#define __SIM_FLASH_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Driver_Flash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Flash technologies modelled by the simulated device.
+ */
+enum sim_flash_model_t {
+    SIM_FLASH_NOR,  /**< Program units must be erased before being programmed
+                     *   and can be programmed in any order
+                     */
+    SIM_FLASH_NAND, /**< Whole pages are programmed at most once per erase, in
+                     *   increasing order within a sector. Pages left
+                     *   incompletely programmed by a power loss fail to read
+                     *   until they are erased.
+                     */
+};
+
+/**
+ * \struct sim_flash_config_t
+ *
+ * \brief Geometry and timing of the simulated device.
+ */
+struct sim_flash_config_t {
+    enum sim_flash_model_t model; /**< Flash technology */
+    uint32_t sector_size;    /**< Size of an erase sector */
+    uint32_t sector_count;   /**< Number of erase sectors */
+    uint32_t program_unit;   /**< Minimum program size, the page size for NAND
+                              */
+    uint8_t erased_value;    /**< Value of a byte after erase */
+    uint32_t read_op_ns;     /**< Latency of each read operation, such as a
+                              *   page access, in nanoseconds
+                              */
+    uint32_t read_ns;        /**< Read latency per byte, in nanoseconds */
+    uint32_t program_ns;     /**< Program latency per program unit, in
+                              *   nanoseconds
+                              */
+    uint32_t erase_ns;       /**< Erase latency per sector, in nanoseconds */
+};
+
+/**
+ * \struct sim_flash_stats_t
+ *
+ * \brief Operation counters of the simulated device.
+ */
+struct sim_flash_stats_t {
+    uint64_t bytes_read;       /**< Number of bytes read */
+    uint64_t bytes_programmed; /**< Number of bytes programmed */
+    uint64_t reads;            /**< Number of read operations */
+    uint64_t programs;         /**< Number of program operations */
+    uint64_t erases;           /**< Number of sectors erased */
+    uint64_t busy_ns;          /**< Simulated time spent in operations */
+    uint64_t violations;       /**< Operations rejected because they break the
+                                *   rules of the flash technology
+                                */
+};
+
+/**
+ * \brief Called when the device loses power. It must not return, typically it
+ *        long jumps back to the harness.
+ */
+typedef void (*sim_flash_power_loss_cb_t)(void);
+
+/**
+ * \brief The simulated flash device, as a CMSIS flash driver.
+ */
+extern ARM_DRIVER_FLASH Driver_SIM_FLASH;
+
+/**
+ * \brief Creates the simulated device, fully erased.
+ *
+ * \param[in] cfg  Device geometry and timing
+ *
+ * \return 0 on success, -1 if the geometry is invalid or allocation fails.
+ */
+int sim_flash_create(const struct sim_flash_config_t *cfg);
+
+/**
+ * \brief Frees the simulated device.
+ */
+void sim_flash_destroy(void);
+
+/**
+ * \brief Gets the size of the device content, as needed by
+ *        sim_flash_save() and sim_flash_restore().
+ */
+size_t sim_flash_image_size(void);
+
+/**
+ * \brief Copies the device content and the programming state of its pages to
+ *        the buffer.
+ */
+void sim_flash_save(uint8_t *image);
+
+/**
+ * \brief Restores the device content saved with sim_flash_save().
+ */
+void sim_flash_restore(const uint8_t *image);
+
+/**
+ * \brief Gets the operation counters of the device.
+ */
+const struct sim_flash_stats_t *sim_flash_get_stats(void);
+
+/**
+ * \brief Gets the number of times each sector has been erased.
+ */
+const uint32_t *sim_flash_get_erase_counts(void);
+
+/**
+ * \brief Clears the operation and erase counters.
+ */
+void sim_flash_reset_stats(void);
+
+/**
+ * \brief Gets the number of program and erase operations performed so far.
+ */
+uint64_t sim_flash_get_write_ops(void);
+
+/**
+ * \brief Makes the device lose power during a program or erase operation.
+ *
+ * \param[in] op  Index of the program or erase operation, as counted by
+ *                sim_flash_get_write_ops(), during which power is lost. The
+ *                first half of the pages or of the sector is written, the rest
+ *                keeps its previous content, and cb is called.
+ * \param[in] cb  Power loss callback, NULL to disarm the power loss
+ */
+void sim_flash_set_power_loss(uint64_t op, sim_flash_power_loss_cb_t cb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_FLASH_H__ */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host definitions of the CMSIS compiler macros used by the mailbox */
+
+#ifndef __MAILBOX_RING_HARNESS_CMSIS_COMPILER_H__
+#define __MAILBOX_RING_HARNESS_CMSIS_COMPILER_H__
+
+#define __ALIGNED(x)        __attribute__((aligned(x)))
+#define __STATIC_INLINE     static inline
+
+#define __DMB()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#endif /* __MAILBOX_RING_HARNESS_CMSIS_COMPILER_H__ */
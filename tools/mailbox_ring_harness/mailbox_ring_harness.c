@@ -0,0 +1,580 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file mailbox_ring_harness.c
+ *
+ * \brief Host stress test and benchmark of the mailbox transports.
+ *
+ * \details The NS mailbox library is built with an NS OS and either the ring
+ *          transport or the pend and replied bitmaps, on top of pthreads.
+ *          Several client threads send PSA client calls at the same time
+ *          through tfm_ns_mailbox_client_call(). A thread plays the SPE side:
+ *          it consumes the request ring or the pend bitmap, checks every
+ *          request, and replies to the pending ones in a random order through
+ *          the completion ring or the replied bitmap, then runs the NS mailbox
+ *          interrupt handler as the doorbell would. Each client checks that it
+ *          gets the reply to its own call. The rings wrap many times over the
+ *          run, for any number of slots.
+ *
+ *          Each call is timed, and the harness reports the calls per second
+ *          and the percentiles of the call latency. The bitmap transport takes
+ *          a lock between the cores, which is a mutex on the host.
+ *
+ *          The simulated SPE holds at most NUM_SPE_MAILBOX_QUEUE_SLOT calls,
+ *          as the SPE mailbox does. The other requests are left pending, and
+ *          are taken as soon as a reply frees an SPE slot.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tfm_ns_mailbox.h"
+
+#ifdef MAILBOX_RING_TRANSPORT
+#define TRANSPORT_NAME  "ring"
+#else
+#define TRANSPORT_NAME  "bitmap"
+#endif
+
+/* Number of calls held by the simulated SPE */
+#ifndef NUM_SPE_MAILBOX_QUEUE_SLOT
+#define NUM_SPE_MAILBOX_QUEUE_SLOT  NUM_MAILBOX_QUEUE_SLOT
+#endif
+
+/* Maximum number of client threads */
+#define MAX_CLIENTS  32
+
+struct client_t {
+    pthread_t thread;
+    uint32_t id;
+    sem_t wake;           /* Posted by tfm_ns_mailbox_os_wake_task_isr() */
+    uint32_t num_calls;
+    uint32_t num_errors;
+    uint64_t *latency_ns; /* Latency of each call */
+};
+
+static struct ns_mailbox_queue_t g_queue;
+static struct client_t g_clients[MAX_CLIENTS];
+static uint32_t g_num_clients = 4;
+static uint32_t g_calls_per_client = 100000;
+static bool g_reply_all;
+
+/* NS side synchronization */
+static pthread_mutex_t g_spin_lock = PTHREAD_MUTEX_INITIALIZER;
+static sem_t g_slot_sem;
+static pthread_key_t g_task_key;
+
+#ifndef MAILBOX_RING_TRANSPORT
+/* Critical section between the cores, guarding the bitmaps */
+static pthread_mutex_t g_core_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* SPE side state */
+static pthread_mutex_t g_doorbell_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_doorbell = PTHREAD_COND_INITIALIZER;
+static bool g_doorbell_rung;
+static bool g_stop;
+#ifdef MAILBOX_RING_TRANSPORT
+static uint32_t g_spe_req_tail;
+static uint32_t g_spe_cpl_head;
+#endif
+static uint64_t g_spe_requests;
+static uint64_t g_spe_errors;
+static uint32_t g_spe_max_in_flight;
+static bool g_spe_backlog;      /* Requests left pending, SPE slots full */
+
+/* Reply expected for a call, derived from the call parameters */
+static int32_t expected_reply(const struct mailbox_msg_t *msg)
+{
+    return (int32_t)((uint32_t)msg->client_id * 2654435761U
+                     + (uint32_t)msg->params.psa_call_params.in_len);
+}
+
+/* ---- NS mailbox HAL ---- */
+
+int32_t tfm_ns_mailbox_hal_init(struct ns_mailbox_queue_t *queue)
+{
+    (void)queue;
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_hal_notify_peer(void)
+{
+    pthread_mutex_lock(&g_doorbell_lock);
+    g_doorbell_rung = true;
+    pthread_cond_signal(&g_doorbell);
+    pthread_mutex_unlock(&g_doorbell_lock);
+
+    return MAILBOX_SUCCESS;
+}
+
+#ifdef MAILBOX_RING_TRANSPORT
+/* The ring transport does not take the critical section between cores */
+uint32_t tfm_ns_mailbox_hal_enter_critical(void)
+{
+    abort();
+}
+
+void tfm_ns_mailbox_hal_exit_critical(uint32_t state)
+{
+    (void)state;
+    abort();
+}
+
+uint32_t tfm_ns_mailbox_hal_enter_critical_isr(void)
+{
+    abort();
+}
+
+void tfm_ns_mailbox_hal_exit_critical_isr(uint32_t state)
+{
+    (void)state;
+    abort();
+}
+#else /* MAILBOX_RING_TRANSPORT */
+uint32_t tfm_ns_mailbox_hal_enter_critical(void)
+{
+    pthread_mutex_lock(&g_core_lock);
+
+    return 0;
+}
+
+void tfm_ns_mailbox_hal_exit_critical(uint32_t state)
+{
+    (void)state;
+    pthread_mutex_unlock(&g_core_lock);
+}
+
+uint32_t tfm_ns_mailbox_hal_enter_critical_isr(void)
+{
+    return tfm_ns_mailbox_hal_enter_critical();
+}
+
+void tfm_ns_mailbox_hal_exit_critical_isr(uint32_t state)
+{
+    tfm_ns_mailbox_hal_exit_critical(state);
+}
+#endif /* MAILBOX_RING_TRANSPORT */
+
+/* ---- NS OS wrapper ---- */
+
+int32_t tfm_ns_mailbox_os_lock_init(void)
+{
+    return (sem_init(&g_slot_sem, 0, NUM_MAILBOX_QUEUE_SLOT) == 0) ?
+           MAILBOX_SUCCESS : MAILBOX_GENERIC_ERROR;
+}
+
+int32_t tfm_ns_mailbox_os_lock_acquire(void)
+{
+    return (sem_wait(&g_slot_sem) == 0) ? MAILBOX_SUCCESS
+                                        : MAILBOX_GENERIC_ERROR;
+}
+
+int32_t tfm_ns_mailbox_os_lock_release(void)
+{
+    return (sem_post(&g_slot_sem) == 0) ? MAILBOX_SUCCESS
+                                        : MAILBOX_GENERIC_ERROR;
+}
+
+const void *tfm_ns_mailbox_os_get_task_handle(void)
+{
+    return pthread_getspecific(g_task_key);
+}
+
+void tfm_ns_mailbox_os_wait_reply(void)
+{
+    struct client_t *client = pthread_getspecific(g_task_key);
+
+    (void)sem_wait(&client->wake);
+}
+
+void tfm_ns_mailbox_os_wake_task_isr(const void *task_handle)
+{
+    struct client_t *client = (struct client_t *)task_handle;
+
+    (void)sem_post(&client->wake);
+}
+
+void tfm_ns_mailbox_os_spin_lock(void)
+{
+    pthread_mutex_lock(&g_spin_lock);
+}
+
+void tfm_ns_mailbox_os_spin_unlock(void)
+{
+    pthread_mutex_unlock(&g_spin_lock);
+}
+
+/* ---- Simulated SPE ---- */
+
+/* Adds a new request to the pending ones */
+static void spe_add_pending(uint8_t idx, uint8_t pending[],
+                            uint32_t *num_pending, bool in_flight[])
+{
+    if ((idx >= NUM_MAILBOX_QUEUE_SLOT) || in_flight[idx]) {
+        printf("request of slot %u invalid\n", idx);
+        g_spe_errors++;
+        exit(EXIT_FAILURE);
+    }
+    in_flight[idx] = true;
+    pending[(*num_pending)++] = idx;
+    g_spe_requests++;
+}
+
+#ifdef MAILBOX_RING_TRANSPORT
+/* Consumes the new requests, adds them to the pending ones */
+static void spe_receive(uint8_t pending[], uint32_t *num_pending,
+                        bool in_flight[])
+{
+    struct mailbox_status_t *status = &g_queue.status;
+    uint32_t head = __atomic_load_n(&status->req_head.val, __ATOMIC_ACQUIRE);
+
+    if ((head >= MAILBOX_RING_IDX_WRAP) ||
+        (MAILBOX_RING_COUNT(head, g_spe_req_tail) > NUM_MAILBOX_QUEUE_SLOT)) {
+        printf("request ring head %" PRIu32 " invalid, tail %" PRIu32 "\n",
+               head, g_spe_req_tail);
+        g_spe_errors++;
+        exit(EXIT_FAILURE);
+    }
+
+    for (; (g_spe_req_tail != head) &&
+           (*num_pending < NUM_SPE_MAILBOX_QUEUE_SLOT);
+         g_spe_req_tail = MAILBOX_RING_NEXT(g_spe_req_tail)) {
+        spe_add_pending(status->req[MAILBOX_RING_ENTRY(g_spe_req_tail)],
+                        pending, num_pending, in_flight);
+    }
+
+    g_spe_backlog = (g_spe_req_tail != head);
+
+    __atomic_store_n(&status->req_tail.val, g_spe_req_tail, __ATOMIC_RELEASE);
+
+    if (*num_pending > g_spe_max_in_flight) {
+        g_spe_max_in_flight = *num_pending;
+    }
+}
+
+/* Publishes the reply of a slot */
+static void spe_complete(uint8_t idx)
+{
+    g_queue.status.cpl[MAILBOX_RING_ENTRY(g_spe_cpl_head)] = idx;
+    g_spe_cpl_head = MAILBOX_RING_NEXT(g_spe_cpl_head);
+}
+
+/* Makes the replies visible to NSPE */
+static void spe_complete_done(void)
+{
+    __atomic_store_n(&g_queue.status.cpl_head.val, g_spe_cpl_head,
+                     __ATOMIC_RELEASE);
+}
+#else /* MAILBOX_RING_TRANSPORT */
+/* Takes the pending slots, as the SPE mailbox does, adds them to the pending
+ * ones. The pend bits of the slots not taken are kept.
+ */
+static void spe_receive(uint8_t pending[], uint32_t *num_pending,
+                        bool in_flight[])
+{
+    mailbox_queue_status_t pend_slots;
+    mailbox_queue_status_t taken = 0;
+    uint8_t idx;
+
+    pthread_mutex_lock(&g_core_lock);
+    pend_slots = g_queue.status.pend_slots;
+
+    if ((pend_slots >> (NUM_MAILBOX_QUEUE_SLOT - 1)) > 1) {
+        printf("pend slots 0x%" PRIx32 " invalid\n", pend_slots);
+        g_spe_errors++;
+        exit(EXIT_FAILURE);
+    }
+
+    for (idx = 0; (idx < NUM_MAILBOX_QUEUE_SLOT) &&
+                  (*num_pending < NUM_SPE_MAILBOX_QUEUE_SLOT); idx++) {
+        if (pend_slots & (1UL << idx)) {
+            spe_add_pending(idx, pending, num_pending, in_flight);
+            taken |= 1UL << idx;
+        }
+    }
+
+    g_queue.status.pend_slots &= ~taken;
+    pthread_mutex_unlock(&g_core_lock);
+
+    g_spe_backlog = ((pend_slots & ~taken) != 0);
+
+    if (*num_pending > g_spe_max_in_flight) {
+        g_spe_max_in_flight = *num_pending;
+    }
+}
+
+static mailbox_queue_status_t g_spe_replied;
+
+static void spe_complete(uint8_t idx)
+{
+    g_spe_replied |= 1UL << idx;
+}
+
+static void spe_complete_done(void)
+{
+    pthread_mutex_lock(&g_core_lock);
+    g_queue.status.replied_slots |= g_spe_replied;
+    pthread_mutex_unlock(&g_core_lock);
+
+    g_spe_replied = 0;
+}
+#endif /* MAILBOX_RING_TRANSPORT */
+
+/* Replies to some of the pending requests in a random order, or to all of
+ * them in order with -a.
+ */
+static void spe_reply(uint8_t pending[], uint32_t *num_pending,
+                      bool in_flight[], unsigned int *seed)
+{
+    uint32_t num_replies = g_reply_all ? *num_pending :
+                           1 + (uint32_t)rand_r(seed) % *num_pending;
+    uint32_t pos;
+    uint8_t idx;
+
+    while (num_replies-- > 0) {
+        if (g_reply_all) {
+            idx = pending[*num_pending - 1 - num_replies];
+        } else {
+            pos = (uint32_t)rand_r(seed) % *num_pending;
+            idx = pending[pos];
+            pending[pos] = pending[--(*num_pending)];
+        }
+        in_flight[idx] = false;
+
+        g_queue.slots[idx].reply.return_val =
+                                   expected_reply(&g_queue.slots[idx].msg);
+
+        spe_complete(idx);
+    }
+
+    if (g_reply_all) {
+        *num_pending = 0;
+    }
+
+    spe_complete_done();
+
+    /* The doorbell interrupt of the NS core */
+    (void)tfm_ns_mailbox_wake_reply_owner_isr();
+}
+
+static void *spe_thread(void *arg)
+{
+    uint8_t pending[NUM_MAILBOX_QUEUE_SLOT];
+    bool in_flight[NUM_MAILBOX_QUEUE_SLOT] = { false };
+    uint32_t num_pending = 0;
+    unsigned int seed = 1;
+
+    (void)arg;
+
+    while (true) {
+        pthread_mutex_lock(&g_doorbell_lock);
+        while (!g_doorbell_rung && !g_stop && (num_pending == 0) &&
+               !g_spe_backlog) {
+            pthread_cond_wait(&g_doorbell, &g_doorbell_lock);
+        }
+        g_doorbell_rung = false;
+        if (g_stop) {
+            pthread_mutex_unlock(&g_doorbell_lock);
+            break;
+        }
+        pthread_mutex_unlock(&g_doorbell_lock);
+
+        spe_receive(pending, &num_pending, in_flight);
+
+        /* Let requests pile up from time to time */
+        if ((num_pending > 0) &&
+            (g_reply_all || ((rand_r(&seed) % 4) != 0))) {
+            spe_reply(pending, &num_pending, in_flight, &seed);
+        }
+    }
+
+    return NULL;
+}
+
+/* ---- Clients ---- */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void *client_thread(void *arg)
+{
+    struct client_t *client = arg;
+    struct psa_client_params_t params;
+    struct mailbox_msg_t msg;
+    int32_t reply;
+    int32_t ret;
+    uint32_t n;
+    uint64_t start;
+
+    (void)pthread_setspecific(g_task_key, client);
+
+    (void)memset(&params, 0, sizeof(params));
+    (void)memset(&msg, 0, sizeof(msg));
+
+    for (n = 0; n < g_calls_per_client; n++) {
+        params.psa_call_params.handle = (psa_handle_t)client->id;
+        params.psa_call_params.in_len = n;
+
+        start = now_ns();
+        ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL, &params,
+                                         (int32_t)client->id, &reply);
+        client->latency_ns[n] = now_ns() - start;
+
+        msg.client_id = (int32_t)client->id;
+        msg.params = params;
+        if ((ret != MAILBOX_SUCCESS) || (reply != expected_reply(&msg))) {
+            client->num_errors++;
+        }
+        client->num_calls++;
+    }
+
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Sorts the latencies of all the calls and prints their percentiles */
+static void print_latencies(uint64_t *latency_ns, uint64_t num_calls)
+{
+    static const uint32_t percentiles[] = { 50, 90, 99 };
+    uint32_t i;
+
+    if (num_calls == 0) {
+        return;
+    }
+
+    qsort(latency_ns, num_calls, sizeof(latency_ns[0]), compare_u64);
+
+    printf("latency:");
+    for (i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++) {
+        printf(" p%" PRIu32 " %" PRIu64 " ns,", percentiles[i],
+               latency_ns[(num_calls - 1) * percentiles[i] / 100]);
+    }
+    printf(" max %" PRIu64 " ns\n", latency_ns[num_calls - 1]);
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [options]\n"
+           "  -t <num>  Number of client threads (default 4, at most %d)\n"
+           "  -n <num>  Number of calls per client (default 100000)\n"
+           "  -a        SPE replies to all the pending calls in order, instead\n"
+           "            of to some of them in a random order\n",
+           prog, MAX_CLIENTS);
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t spe;
+    uint64_t num_calls = 0;
+    uint64_t num_errors = 0;
+    uint64_t *latency_ns;
+    uint64_t start, elapsed_ns;
+    uint32_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:n:ah")) != -1) {
+        switch (opt) {
+        case 'a':
+            g_reply_all = true;
+            break;
+        case 't':
+            g_num_clients = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            g_calls_per_client = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if ((g_num_clients == 0) || (g_num_clients > MAX_CLIENTS)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* The latencies of the clients are contiguous, to be sorted together */
+    latency_ns = calloc((size_t)g_num_clients * g_calls_per_client + 1,
+                        sizeof(*latency_ns));
+    if (latency_ns == NULL) {
+        printf("cannot allocate the latencies\n");
+        return EXIT_FAILURE;
+    }
+
+    if ((pthread_key_create(&g_task_key, NULL) != 0) ||
+        (tfm_ns_mailbox_init(&g_queue) != MAILBOX_SUCCESS)) {
+        printf("cannot initialize the mailbox\n");
+        return EXIT_FAILURE;
+    }
+
+    (void)pthread_create(&spe, NULL, spe_thread, NULL);
+
+    start = now_ns();
+
+    for (i = 0; i < g_num_clients; i++) {
+        g_clients[i].id = i + 1;
+        g_clients[i].latency_ns = &latency_ns[(size_t)i * g_calls_per_client];
+        (void)sem_init(&g_clients[i].wake, 0, 0);
+        (void)pthread_create(&g_clients[i].thread, NULL, client_thread,
+                             &g_clients[i]);
+    }
+
+    for (i = 0; i < g_num_clients; i++) {
+        (void)pthread_join(g_clients[i].thread, NULL);
+        num_calls += g_clients[i].num_calls;
+        num_errors += g_clients[i].num_errors;
+    }
+
+    elapsed_ns = now_ns() - start;
+
+    pthread_mutex_lock(&g_doorbell_lock);
+    g_stop = true;
+    pthread_cond_signal(&g_doorbell);
+    pthread_mutex_unlock(&g_doorbell_lock);
+    (void)pthread_join(spe, NULL);
+
+    printf("%s, %d slots, %d SPE slots, %" PRIu32 " clients: %" PRIu64
+           " calls, %" PRIu64 " requests seen by SPE, at most %" PRIu32
+           " in flight, %" PRIu64 " errors\n", TRANSPORT_NAME,
+           NUM_MAILBOX_QUEUE_SLOT, NUM_SPE_MAILBOX_QUEUE_SLOT, g_num_clients,
+           num_calls, g_spe_requests, g_spe_max_in_flight,
+           num_errors + g_spe_errors);
+    printf("%.0f calls/s\n", (elapsed_ns != 0) ?
+           (double)num_calls * 1e9 / (double)elapsed_ns : 0.0);
+    print_latencies(latency_ns, num_calls);
+
+    free(latency_ns);
+
+    return ((num_errors == 0) && (g_spe_errors == 0) &&
+            (g_spe_requests == num_calls) &&
+            (g_spe_max_in_flight <= NUM_SPE_MAILBOX_QUEUE_SLOT)) ?
+           EXIT_SUCCESS : EXIT_FAILURE;
+}
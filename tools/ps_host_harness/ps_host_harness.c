@@ -0,0 +1,1048 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file ps_host_harness.c
+ *
+ * \brief Host power loss harness of the PS segmented object system.
+ *
+ * \details The PS object system and object table are linked against a
+ *          simulated ITS service, which holds the files in RAM, and a stub of
+ *          the PS crypto layer, which encrypts and authenticates with a keyed
+ *          checksum. A random sequence of object creations, writes, reads and
+ *          deletions, which grow and shrink the objects by whole segments, is
+ *          checked against a shadow copy of the objects. With -p, every ITS
+ *          update of every operation is in turn interrupted by a power loss,
+ *          after which the object system is prepared again and the object
+ *          must hold either its old or its new content. The run then goes on
+ *          from one of the interrupted operations from time to time, so that
+ *          the files they leave behind pile up. At the end, all the objects
+ *          are deleted and the files left are checked.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config_tfm.h"
+#include "crypto/ps_crypto_interface.h"
+#include "psa/internal_trusted_storage.h"
+#include "ps_object_defs.h"
+#include "ps_object_system.h"
+#include "tfm_ps_req_mngr.h"
+
+#if !PS_OBJECT_SEGMENT_SIZE
+#error "The harness needs PS_OBJECT_SEGMENT_SIZE to be set"
+#endif
+
+/* Number of objects the operations are spread over */
+#define HARNESS_NUM_UIDS  (PS_NUM_ASSETS + 2)
+
+/* Size of the checksum used by the crypto stub, filling the tag */
+#define STUB_TAG_WORDS  (PS_TAG_LEN_BYTES / sizeof(uint64_t))
+
+/* The ITS files are limited as by the filesystem of PS */
+#define SIM_ITS_MAX_FILES      PS_MAX_NUM_OBJECTS
+#define SIM_ITS_MAX_FILE_SIZE  PS_MAX_OBJECT_SIZE
+
+struct sim_its_file_t {
+    bool used;
+    psa_storage_uid_t uid;
+    size_t len;
+    uint8_t data[SIM_ITS_MAX_FILE_SIZE];
+};
+
+struct sim_its_t {
+    struct sim_its_file_t files[SIM_ITS_MAX_FILES];
+};
+
+/* Content of an object of the shadow copy */
+struct shadow_obj_t {
+    bool exists;
+    uint32_t size;
+    uint32_t capacity;
+    psa_storage_create_flags_t flags;
+    uint8_t data[PS_MAX_ASSET_SIZE];
+};
+
+enum obj_op_type_t {
+    OBJ_OP_CREATE,
+    OBJ_OP_WRITE,
+    OBJ_OP_READ,
+    OBJ_OP_DELETE,
+    OBJ_OP_COUNT,
+};
+
+struct obj_op_t {
+    enum obj_op_type_t type;
+    uint32_t obj;
+    uint32_t offset;
+    uint32_t size;
+    psa_storage_create_flags_t flags;
+    uint8_t data[PS_MAX_ASSET_SIZE];
+};
+
+struct harness_stats_t {
+    uint64_t ops[OBJ_OP_COUNT];
+    uint64_t power_losses;
+    uint64_t its_updates;
+    uint32_t max_files;
+};
+
+static struct sim_its_t g_its;
+static struct shadow_obj_t g_shadow[HARNESS_NUM_UIDS];
+static struct harness_stats_t g_stats;
+
+/* Number of ITS updates allowed before the power is lost, -1 for no loss */
+static long g_updates_left = -1;
+static bool g_power_lost;
+
+/* Source of the data written and destination of the data read, as done by
+ * the request manager with the client buffers
+ */
+static const uint8_t *g_req_src;
+static uint8_t g_req_dst[PS_MAX_ASSET_SIZE];
+static size_t g_req_dst_len;
+
+/* ---- Stub of the PS crypto layer ---- */
+
+static uint8_t g_iv[PS_IV_LEN_BYTES];
+
+static uint64_t stub_mix(uint64_t h, const uint8_t *p, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+
+    return h;
+}
+
+static uint64_t stub_key(const union ps_crypto_t *crypto)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    h = stub_mix(h, (const uint8_t *)&crypto->ref.uid,
+                 sizeof(crypto->ref.uid));
+    h = stub_mix(h, (const uint8_t *)&crypto->ref.client_id,
+                 sizeof(crypto->ref.client_id));
+
+    return stub_mix(h, crypto->ref.iv, PS_IV_LEN_BYTES);
+}
+
+static void stub_tag(uint64_t key, const uint8_t *add, size_t add_len,
+                     const uint8_t *data, size_t len, uint8_t *tag)
+{
+    uint64_t h[STUB_TAG_WORDS];
+    size_t i;
+
+    h[0] = stub_mix(stub_mix(key ^ 0x55, add, add_len), data, len);
+    for (i = 1; i < STUB_TAG_WORDS; i++) {
+        h[i] = stub_mix(h[i - 1], (const uint8_t *)&len, sizeof(len));
+    }
+
+    (void)memcpy(tag, h, PS_TAG_LEN_BYTES);
+}
+
+static void stub_keystream(uint64_t key, uint8_t *data, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        key ^= key << 13;
+        key ^= key >> 7;
+        key ^= key << 17;
+        data[i] ^= (uint8_t)key;
+    }
+}
+
+psa_status_t ps_crypto_init(void)
+{
+    return PSA_SUCCESS;
+}
+
+uint32_t ps_crypto_to_blocks(size_t in_len)
+{
+    return 1 + ((in_len + 15) / 16);
+}
+
+void ps_crypto_set_iv(const union ps_crypto_t *crypto)
+{
+    (void)memcpy(g_iv, crypto->ref.iv, PS_IV_LEN_BYTES);
+}
+
+psa_status_t ps_crypto_get_iv(union ps_crypto_t *crypto)
+{
+    uint64_t counter;
+
+    (void)memcpy(&counter, g_iv, sizeof(counter));
+    counter++;
+    (void)memcpy(g_iv, &counter, sizeof(counter));
+    (void)memcpy(crypto->ref.iv, g_iv, PS_IV_LEN_BYTES);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t ps_crypto_encrypt_and_tag(union ps_crypto_t *crypto,
+                                       const uint8_t *add,
+                                       size_t add_len,
+                                       const uint8_t *in,
+                                       size_t in_len,
+                                       uint8_t *out,
+                                       size_t out_size,
+                                       size_t *out_len)
+{
+    uint64_t key = stub_key(crypto);
+
+    /* The tag is appended to the output, as by the real crypto layer */
+    if (out_size < in_len + PS_TAG_LEN_BYTES) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    (void)memmove(out, in, in_len);
+    stub_keystream(key, out, in_len);
+    stub_tag(key, add, add_len, out, in_len, crypto->ref.tag);
+    (void)memcpy(out + in_len, crypto->ref.tag, PS_TAG_LEN_BYTES);
+    *out_len = in_len;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t ps_crypto_auth_and_decrypt(const union ps_crypto_t *crypto,
+                                        const uint8_t *add,
+                                        size_t add_len,
+                                        uint8_t *in,
+                                        size_t in_len,
+                                        uint8_t *out,
+                                        size_t out_size,
+                                        size_t *out_len)
+{
+    uint64_t key = stub_key(crypto);
+    uint8_t tag[PS_TAG_LEN_BYTES];
+
+    if (out_size < in_len + PS_TAG_LEN_BYTES) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    stub_tag(key, add, add_len, in, in_len, tag);
+    if (memcmp(tag, crypto->ref.tag, PS_TAG_LEN_BYTES) != 0) {
+        return PSA_ERROR_INVALID_SIGNATURE;
+    }
+
+    (void)memmove(out, in, in_len);
+    stub_keystream(key, out, in_len);
+    *out_len = in_len;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t ps_crypto_generate_auth_tag(union ps_crypto_t *crypto,
+                                         const uint8_t *add,
+                                         uint32_t add_len)
+{
+    stub_tag(stub_key(crypto), add, add_len, NULL, 0, crypto->ref.tag);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t ps_crypto_authenticate(const union ps_crypto_t *crypto,
+                                    const uint8_t *add,
+                                    uint32_t add_len)
+{
+    uint8_t tag[PS_TAG_LEN_BYTES];
+
+    stub_tag(stub_key(crypto), add, add_len, NULL, 0, tag);
+
+    return (memcmp(tag, crypto->ref.tag, PS_TAG_LEN_BYTES) == 0) ?
+           PSA_SUCCESS : PSA_ERROR_INVALID_SIGNATURE;
+}
+
+/* ---- Simulated ITS service ---- */
+
+/* Accounts for an ITS update, returns false if the power is lost before it */
+static bool sim_its_update(void)
+{
+    if (g_power_lost) {
+        return false;
+    }
+
+    if (g_updates_left == 0) {
+        g_power_lost = true;
+        g_stats.power_losses++;
+        return false;
+    }
+
+    if (g_updates_left > 0) {
+        g_updates_left--;
+    }
+    g_stats.its_updates++;
+
+    return true;
+}
+
+static struct sim_its_file_t *sim_its_find(psa_storage_uid_t uid)
+{
+    uint32_t i;
+
+    for (i = 0; i < SIM_ITS_MAX_FILES; i++) {
+        if (g_its.files[i].used && (g_its.files[i].uid == uid)) {
+            return &g_its.files[i];
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t sim_its_num_files(void)
+{
+    uint32_t i;
+    uint32_t num = 0;
+
+    for (i = 0; i < SIM_ITS_MAX_FILES; i++) {
+        num += g_its.files[i].used ? 1 : 0;
+    }
+
+    return num;
+}
+
+psa_status_t psa_its_set(psa_storage_uid_t uid,
+                         size_t data_length,
+                         const void *p_data,
+                         psa_storage_create_flags_t create_flags)
+{
+    struct sim_its_file_t *file = sim_its_find(uid);
+    uint32_t i;
+    uint32_t num_files;
+
+    (void)create_flags;
+
+    if (data_length > SIM_ITS_MAX_FILE_SIZE) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (file == NULL) {
+        for (i = 0; (i < SIM_ITS_MAX_FILES) && g_its.files[i].used; i++) {
+        }
+        if (i == SIM_ITS_MAX_FILES) {
+            return PSA_ERROR_INSUFFICIENT_STORAGE;
+        }
+        file = &g_its.files[i];
+    }
+
+    if (!sim_its_update()) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    file->used = true;
+    file->uid = uid;
+    file->len = data_length;
+    (void)memcpy(file->data, p_data, data_length);
+
+    num_files = sim_its_num_files();
+    if (num_files > g_stats.max_files) {
+        g_stats.max_files = num_files;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_its_get(psa_storage_uid_t uid,
+                         size_t data_offset,
+                         size_t data_size,
+                         void *p_data,
+                         size_t *p_data_length)
+{
+    struct sim_its_file_t *file;
+
+    if (g_power_lost) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    file = sim_its_find(uid);
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    if (data_offset > file->len) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *p_data_length = file->len - data_offset;
+    if (*p_data_length > data_size) {
+        *p_data_length = data_size;
+    }
+    (void)memcpy(p_data, file->data + data_offset, *p_data_length);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_its_get_info(psa_storage_uid_t uid,
+                              struct psa_storage_info_t *p_info)
+{
+    struct sim_its_file_t *file;
+
+    if (g_power_lost) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    file = sim_its_find(uid);
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    p_info->capacity = file->len;
+    p_info->size = file->len;
+    p_info->flags = PSA_STORAGE_FLAG_NONE;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_its_remove(psa_storage_uid_t uid)
+{
+    struct sim_its_file_t *file;
+
+    if (g_power_lost) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    file = sim_its_find(uid);
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    if (!sim_its_update()) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    file->used = false;
+
+    return PSA_SUCCESS;
+}
+
+/* ---- Request manager ---- */
+
+void ps_req_mngr_write_asset_data(const uint8_t *in_data, uint32_t size)
+{
+    (void)memcpy(g_req_dst + g_req_dst_len, in_data, size);
+    g_req_dst_len += size;
+}
+
+psa_status_t ps_req_mngr_read_asset_data(uint8_t *out_data, uint32_t size)
+{
+    (void)memcpy(out_data, g_req_src, size);
+    g_req_src += size;
+
+    return PSA_SUCCESS;
+}
+
+void tfm_core_panic(void)
+{
+    printf("panic\n");
+    exit(EXIT_FAILURE);
+}
+
+/* ---- Harness ---- */
+
+static psa_storage_uid_t obj_uid(uint32_t obj)
+{
+    return (psa_storage_uid_t)obj + 1;
+}
+
+/* Spreads the objects over a few clients */
+static int32_t obj_client_id(uint32_t obj)
+{
+    return -(int32_t)(obj % 3) - 1;
+}
+
+/* Picks a size which is often on a segment boundary or next to one */
+static uint32_t random_size(uint32_t max)
+{
+    uint32_t size;
+
+    switch (rand() % 4) {
+    case 0:
+        size = (uint32_t)(rand() % (PS_OBJECT_MAX_SEGMENTS + 1))
+               * PS_OBJECT_SEGMENT_SIZE;
+        size += (uint32_t)(rand() % 3) - 1;
+        break;
+    case 1:
+        size = (uint32_t)rand() % (PS_OBJECT_SEGMENT_SIZE / 2);
+        break;
+    default:
+        size = (uint32_t)rand() % (max + 1);
+        break;
+    }
+
+    return (size > max) ? max : size;
+}
+
+static void next_op(struct obj_op_t *op)
+{
+    const struct shadow_obj_t *obj;
+    uint32_t i;
+
+    (void)memset(op, 0, sizeof(*op));
+    op->obj = (uint32_t)rand() % HARNESS_NUM_UIDS;
+    obj = &g_shadow[op->obj];
+
+    for (i = 0; i < PS_MAX_ASSET_SIZE; i++) {
+        op->data[i] = (uint8_t)rand();
+    }
+
+    op->type = (enum obj_op_type_t)(rand() % OBJ_OP_COUNT);
+    if (!obj->exists && (op->type != OBJ_OP_DELETE)) {
+        op->type = OBJ_OP_CREATE;
+    }
+
+    switch (op->type) {
+    case OBJ_OP_CREATE:
+        op->size = random_size(PS_MAX_ASSET_SIZE);
+        op->flags = (rand() % 32 == 0) ? PSA_STORAGE_FLAG_WRITE_ONCE
+                                       : PSA_STORAGE_FLAG_NONE;
+        break;
+    case OBJ_OP_WRITE:
+        op->offset = random_size(obj->size);
+        op->size = random_size(obj->capacity - op->offset);
+        break;
+    case OBJ_OP_READ:
+        op->offset = random_size(obj->size);
+        op->size = random_size(PS_MAX_ASSET_SIZE);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Applies an operation to a copy of an object, returns false if the
+ * operation is expected to fail
+ */
+static bool shadow_apply(const struct obj_op_t *op, struct shadow_obj_t *obj)
+{
+    uint32_t num_exist = 0;
+    uint32_t i;
+
+    switch (op->type) {
+    case OBJ_OP_CREATE:
+        for (i = 0; i < HARNESS_NUM_UIDS; i++) {
+            num_exist += g_shadow[i].exists ? 1 : 0;
+        }
+        if (obj->exists ? (obj->flags & PSA_STORAGE_FLAG_WRITE_ONCE)
+                        : (num_exist == PS_NUM_ASSETS)) {
+            return false;
+        }
+        obj->exists = true;
+        obj->size = op->size;
+        obj->capacity = op->size;
+        obj->flags = op->flags;
+        (void)memcpy(obj->data, op->data, op->size);
+        return true;
+    case OBJ_OP_WRITE:
+        if (obj->flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+            return false;
+        }
+        (void)memcpy(obj->data + op->offset, op->data, op->size);
+        if (op->offset + op->size > obj->size) {
+            obj->size = op->offset + op->size;
+        }
+        return true;
+    case OBJ_OP_DELETE:
+        if (!obj->exists || (obj->flags & PSA_STORAGE_FLAG_WRITE_ONCE)) {
+            return false;
+        }
+        obj->exists = false;
+        return true;
+    default:
+        return true;
+    }
+}
+
+static psa_status_t run_op(const struct obj_op_t *op)
+{
+    psa_storage_uid_t uid = obj_uid(op->obj);
+    int32_t client_id = obj_client_id(op->obj);
+    const struct shadow_obj_t *obj = &g_shadow[op->obj];
+    size_t len;
+    uint32_t expected;
+    psa_status_t status;
+
+    g_stats.ops[op->type]++;
+    g_req_src = op->data;
+
+    switch (op->type) {
+    case OBJ_OP_CREATE:
+        return ps_object_create(uid, client_id, op->flags, op->size);
+    case OBJ_OP_WRITE:
+        return ps_object_write(uid, client_id, op->offset, op->size);
+    case OBJ_OP_DELETE:
+        return ps_object_delete(uid, client_id);
+    default:
+        g_req_dst_len = 0;
+        status = ps_object_read(uid, client_id, op->offset, op->size, &len);
+        if ((status != PSA_SUCCESS) || g_power_lost) {
+            return status;
+        }
+        expected = obj->size - op->offset;
+        if (expected > op->size) {
+            expected = op->size;
+        }
+        if ((len != expected) || (g_req_dst_len != len) ||
+            (memcmp(g_req_dst, obj->data + op->offset, len) != 0)) {
+            printf("read of object %" PRIu32 " does not match\n", op->obj);
+            return PSA_ERROR_DATA_CORRUPT;
+        }
+        return PSA_SUCCESS;
+    }
+}
+
+/* Checks that the object system holds the given content for an object */
+static bool obj_matches(uint32_t obj, const struct shadow_obj_t *content)
+{
+    struct psa_storage_info_t info;
+    psa_status_t status;
+    size_t len;
+
+    status = ps_object_get_info(obj_uid(obj), obj_client_id(obj), &info);
+    if (!content->exists) {
+        return status == PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    if ((status != PSA_SUCCESS) || (info.size != content->size) ||
+        (info.capacity != content->capacity) ||
+        (info.flags != content->flags)) {
+        return false;
+    }
+
+    g_req_dst_len = 0;
+    status = ps_object_read(obj_uid(obj), obj_client_id(obj), 0,
+                            PS_MAX_ASSET_SIZE, &len);
+
+    return (status == PSA_SUCCESS) && (len == content->size) &&
+           (g_req_dst_len == len) &&
+           (memcmp(g_req_dst, content->data, len) == 0);
+}
+
+static bool all_match(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < HARNESS_NUM_UIDS; i++) {
+        if (!obj_matches(i, &g_shadow[i])) {
+            printf("object %" PRIu32 " does not match\n", i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Runs an operation and checks its status against the shadow copy, which is
+ * updated. Returns false on a mismatch.
+ */
+static bool run_checked_op(uint32_t n, const struct obj_op_t *op)
+{
+    struct shadow_obj_t next = g_shadow[op->obj];
+    bool expect_success = shadow_apply(op, &next);
+    psa_status_t status = run_op(op);
+
+    if ((status == PSA_SUCCESS) != expect_success) {
+        printf("op %" PRIu32 " type %d on object %" PRIu32
+               " returned %d\n", n, op->type, op->obj, (int)status);
+        return false;
+    }
+
+    if (status == PSA_SUCCESS) {
+        g_shadow[op->obj] = next;
+    }
+
+    return true;
+}
+
+/* Interrupts the operation after each of its ITS updates in turn, and checks
+ * that the object holds its old or its new content after each reboot. Then
+ * goes on from the completed operation, or from one of the interrupted ones.
+ */
+static bool run_power_loss_op(uint32_t n, const struct obj_op_t *op)
+{
+    static struct sim_its_t its_before;
+    static struct sim_its_t its_kept;
+    struct shadow_obj_t before = g_shadow[op->obj];
+    struct shadow_obj_t next = before;
+    struct shadow_obj_t kept;
+    bool keep_interrupted = (rand() % 4 == 0);
+    bool have_kept = false;
+    long cut;
+
+    (void)shadow_apply(op, &next);
+    its_before = g_its;
+
+    for (cut = 0; ; cut++) {
+        g_its = its_before;
+        if (ps_system_prepare() != PSA_SUCCESS) {
+            printf("op %" PRIu32 ": prepare failed\n", n);
+            return false;
+        }
+
+        g_updates_left = cut;
+        (void)run_op(op);
+        g_updates_left = -1;
+
+        if (!g_power_lost) {
+            break;
+        }
+
+        g_power_lost = false;
+        if (ps_system_prepare() != PSA_SUCCESS) {
+            printf("op %" PRIu32 ": prepare failed after power loss %ld\n",
+                   n, cut);
+            return false;
+        }
+
+        if (obj_matches(op->obj, &next)) {
+            g_shadow[op->obj] = next;
+        } else if (obj_matches(op->obj, &before)) {
+            g_shadow[op->obj] = before;
+        } else {
+            printf("op %" PRIu32 " type %d: object %" PRIu32
+                   " neither old nor new after power loss %ld\n",
+                   n, op->type, op->obj, cut);
+            return false;
+        }
+
+        if (!all_match()) {
+            return false;
+        }
+
+        if (keep_interrupted && (!have_kept || (rand() % 2 == 0))) {
+            its_kept = g_its;
+            kept = g_shadow[op->obj];
+            have_kept = true;
+        }
+
+        g_shadow[op->obj] = before;
+    }
+
+    if (have_kept) {
+        g_its = its_kept;
+        g_shadow[op->obj] = kept;
+    } else {
+        /* Check the status of the complete operation from the start */
+        g_its = its_before;
+        if ((ps_system_prepare() != PSA_SUCCESS) || !run_checked_op(n, op)) {
+            return false;
+        }
+    }
+
+    return ps_system_prepare() == PSA_SUCCESS;
+}
+
+/* Deletes the objects and checks the files left. An interrupted create or
+ * delete can leave files under a file ID which is free in the object table,
+ * they are removed when the file ID is allocated again. The table is filled
+ * with new objects first, which allocates all its free entries but the one
+ * kept spare, so at most the files of one object may be left beyond the object
+ * table and the write once objects.
+ */
+static bool check_files_left(void)
+{
+    /* Indexed by file ID, which is below the number of files */
+    bool file_ids[SIM_ITS_MAX_FILES + 2] = { false };
+    struct obj_op_t op;
+    uint32_t expected = 1;
+    uint32_t expected_ids = 1;
+    uint32_t num_file_ids = 0;
+    uint32_t i;
+
+    (void)memset(&op, 0, sizeof(op));
+    op.type = OBJ_OP_CREATE;
+    op.size = PS_OBJECT_SEGMENT_SIZE;
+
+    for (i = 0; i < HARNESS_NUM_UIDS; i++) {
+        if (!g_shadow[i].exists) {
+            op.obj = i;
+            if (!run_checked_op(0, &op)) {
+                return false;
+            }
+        }
+    }
+
+    op.type = OBJ_OP_DELETE;
+
+    for (i = 0; i < HARNESS_NUM_UIDS; i++) {
+        if (!g_shadow[i].exists) {
+            continue;
+        }
+
+        if (g_shadow[i].flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+            expected += 1 + ((g_shadow[i].size + PS_OBJECT_SEGMENT_SIZE - 1)
+                             / PS_OBJECT_SEGMENT_SIZE);
+            expected_ids++;
+            continue;
+        }
+
+        op.obj = i;
+        if (!run_checked_op(0, &op)) {
+            return false;
+        }
+    }
+
+    if ((sim_its_num_files() < expected) ||
+        (sim_its_num_files() > expected + 2 * (PS_OBJECT_MAX_SEGMENTS + 1))) {
+        printf("%" PRIu32 " files left, %" PRIu32 " expected\n",
+               sim_its_num_files(), expected);
+        return false;
+    }
+
+    /* The files of an object share the low 32 bits of their ID, its file ID */
+    for (i = 0; i < SIM_ITS_MAX_FILES; i++) {
+        if (g_its.files[i].used) {
+            file_ids[(uint32_t)g_its.files[i].uid] = true;
+        }
+    }
+    for (i = 0; i < sizeof(file_ids); i++) {
+        num_file_ids += file_ids[i] ? 1 : 0;
+    }
+
+    if (num_file_ids > expected_ids + 1) {
+        printf("files of %" PRIu32 " file IDs left, %" PRIu32 " expected\n",
+               num_file_ids, expected_ids + 1);
+        return false;
+    }
+
+    return true;
+}
+
+/* Updates of a single object which change its number of segments, each
+ * interrupted in turn after each of its ITS updates
+ */
+enum scenario_t {
+    SCENARIO_CREATE, /* Creates an object of the maximum size */
+    SCENARIO_GROW,   /* Creates an object of one segment again with all */
+    SCENARIO_SHRINK, /* Creates an object of all segments again with one */
+    SCENARIO_WRITE,  /* Rewrites two segments of an object */
+    SCENARIO_DELETE, /* Deletes an object of the maximum size */
+    SCENARIO_COUNT,
+};
+
+static const char *const scenario_names[SCENARIO_COUNT] = {
+    "create",
+    "grow",
+    "shrink",
+    "write",
+    "delete",
+};
+
+static void scenario_op(struct obj_op_t *op, enum obj_op_type_t type,
+                        uint32_t offset, uint32_t size)
+{
+    uint32_t i;
+
+    (void)memset(op, 0, sizeof(*op));
+    op->type = type;
+    op->offset = offset;
+    op->size = size;
+
+    for (i = 0; i < PS_MAX_ASSET_SIZE; i++) {
+        op->data[i] = (uint8_t)rand();
+    }
+}
+
+/* Runs a scenario, interrupting its update after each ITS update in turn.
+ * After each power loss, the object must hold its old or its new content.
+ * Then all the objects are deleted, and one is created and deleted again,
+ * which allocates again the file ID of the first object if it was freed. No
+ * file other than the object table may be left.
+ */
+static bool run_scenario(enum scenario_t scenario)
+{
+    const uint32_t max_size = PS_MAX_ASSET_SIZE;
+    struct shadow_obj_t before;
+    struct shadow_obj_t next;
+    struct obj_op_t setup;
+    struct obj_op_t update;
+    struct obj_op_t reuse;
+    struct obj_op_t remove;
+    bool has_setup = true;
+    bool completed = false;
+    long cut;
+
+    switch (scenario) {
+    case SCENARIO_CREATE:
+        has_setup = false;
+        scenario_op(&update, OBJ_OP_CREATE, 0, max_size);
+        break;
+    case SCENARIO_GROW:
+        scenario_op(&setup, OBJ_OP_CREATE, 0, PS_OBJECT_SEGMENT_SIZE);
+        scenario_op(&update, OBJ_OP_CREATE, 0, max_size);
+        break;
+    case SCENARIO_SHRINK:
+        scenario_op(&setup, OBJ_OP_CREATE, 0, max_size);
+        scenario_op(&update, OBJ_OP_CREATE, 0, PS_OBJECT_SEGMENT_SIZE);
+        break;
+    case SCENARIO_WRITE:
+        scenario_op(&setup, OBJ_OP_CREATE, 0, max_size);
+        scenario_op(&update, OBJ_OP_WRITE, PS_OBJECT_SEGMENT_SIZE / 2,
+                    PS_OBJECT_SEGMENT_SIZE);
+        break;
+    default:
+        scenario_op(&setup, OBJ_OP_CREATE, 0, max_size);
+        scenario_op(&update, OBJ_OP_DELETE, 0, 0);
+        break;
+    }
+
+    scenario_op(&reuse, OBJ_OP_CREATE, 0, PS_OBJECT_SEGMENT_SIZE);
+    scenario_op(&remove, OBJ_OP_DELETE, 0, 0);
+
+    for (cut = 0; !completed; cut++) {
+        (void)memset(&g_its, 0, sizeof(g_its));
+        (void)memset(g_shadow, 0, sizeof(g_shadow));
+        if ((ps_system_wipe_all() != PSA_SUCCESS) ||
+            (ps_system_prepare() != PSA_SUCCESS)) {
+            printf("cannot create the object system\n");
+            return false;
+        }
+
+        if (has_setup && !run_checked_op(0, &setup)) {
+            return false;
+        }
+
+        before = g_shadow[update.obj];
+        next = before;
+        (void)shadow_apply(&update, &next);
+
+        g_updates_left = cut;
+        (void)run_op(&update);
+        g_updates_left = -1;
+
+        completed = !g_power_lost;
+        g_power_lost = false;
+        if (ps_system_prepare() != PSA_SUCCESS) {
+            printf("%s: prepare failed after power loss %ld\n",
+                   scenario_names[scenario], cut);
+            return false;
+        }
+
+        if (obj_matches(update.obj, &next)) {
+            g_shadow[update.obj] = next;
+        } else if (!completed && obj_matches(update.obj, &before)) {
+            g_shadow[update.obj] = before;
+        } else {
+            printf("%s: object neither old nor new after power loss %ld\n",
+                   scenario_names[scenario], cut);
+            return false;
+        }
+
+        if (g_shadow[update.obj].exists && !run_checked_op(0, &remove)) {
+            return false;
+        }
+
+        if (!run_checked_op(0, &reuse) || !run_checked_op(0, &remove)) {
+            return false;
+        }
+
+        if (sim_its_num_files() != 1) {
+            printf("%s: %" PRIu32 " files left after power loss %ld\n",
+                   scenario_names[scenario], sim_its_num_files(), cut);
+            return false;
+        }
+    }
+
+    printf("%s: %ld power losses\n", scenario_names[scenario], cut - 1);
+
+    return true;
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [options]\n"
+           "  -n <num>   Number of operations (default 2000)\n"
+           "  -s <seed>  Seed of the random operations (default 1)\n"
+           "  -p         Interrupt each ITS update of each operation with a\n"
+           "             power loss, after running the same for updates\n"
+           "             which change the number of segments of an object\n",
+           prog);
+}
+
+int main(int argc, char *argv[])
+{
+    struct obj_op_t op;
+    uint32_t num_ops = 2000;
+    uint32_t seed = 1;
+    bool power_loss = false;
+    uint32_t scenario;
+    uint32_t n;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:ph")) != -1) {
+        switch (opt) {
+        case 'n':
+            num_ops = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'p':
+            power_loss = true;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+
+    for (scenario = 0; power_loss && (scenario < SCENARIO_COUNT); scenario++) {
+        if (!run_scenario((enum scenario_t)scenario)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    (void)memset(&g_its, 0, sizeof(g_its));
+    if ((ps_system_wipe_all() != PSA_SUCCESS) ||
+        (ps_system_prepare() != PSA_SUCCESS)) {
+        printf("cannot create the object system\n");
+        return EXIT_FAILURE;
+    }
+
+    for (n = 0; n < num_ops; n++) {
+        next_op(&op);
+
+        if (power_loss ? !run_power_loss_op(n, &op)
+                       : !run_checked_op(n, &op)) {
+            return EXIT_FAILURE;
+        }
+
+        if (power_loss || (n % 64 == 0)) {
+            if (!all_match()) {
+                printf("after op %" PRIu32 "\n", n);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (!check_files_left()) {
+        return EXIT_FAILURE;
+    }
+
+    printf("segment size %d, %d segments per object\n",
+           PS_OBJECT_SEGMENT_SIZE, PS_OBJECT_MAX_SEGMENTS);
+    printf("ops: %" PRIu64 " create, %" PRIu64 " write, %" PRIu64
+           " read, %" PRIu64 " delete\n",
+           g_stats.ops[OBJ_OP_CREATE], g_stats.ops[OBJ_OP_WRITE],
+           g_stats.ops[OBJ_OP_READ], g_stats.ops[OBJ_OP_DELETE]);
+    printf("ITS updates: %" PRIu64 ", power losses: %" PRIu64 "\n",
+           g_stats.its_updates, g_stats.power_losses);
+    printf("files: %" PRIu32 " at most, %" PRIu32 " left, limit %d\n",
+           g_stats.max_files, sim_its_num_files(), SIM_ITS_MAX_FILES);
+
+    return EXIT_SUCCESS;
+}
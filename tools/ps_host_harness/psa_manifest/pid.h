@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __PSA_MANIFEST_PID_H__
+#define __PSA_MANIFEST_PID_H__
+
+/* Partition ID of PS in the host harness, generated from the manifests in a
+ * TF-M build
+ */
+#define TFM_SP_PS  1
+
+#endif /* __PSA_MANIFEST_PID_H__ */
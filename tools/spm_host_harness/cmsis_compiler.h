@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host definitions of the CMSIS compiler macros used by the SPM */
+
+#ifndef __SPM_HOST_HARNESS_CMSIS_COMPILER_H__
+#define __SPM_HOST_HARNESS_CMSIS_COMPILER_H__
+
+#define __ALIGNED(x)        __attribute__((aligned(x)))
+#define __STATIC_INLINE     static inline
+
+#endif /* __SPM_HOST_HARNESS_CMSIS_COMPILER_H__ */
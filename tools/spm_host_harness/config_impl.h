@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host build configuration, in place of the generated config_impl.h */
+
+#ifndef __SPM_HOST_HARNESS_CONFIG_IMPL_H__
+#define __SPM_HOST_HARNESS_CONFIG_IMPL_H__
+
+#include "config_tfm.h"
+
+/* Backends */
+#define CONFIG_TFM_SPM_BACKEND_IPC                               1
+#define CONFIG_TFM_SPM_BACKEND_SFN                               0
+
+#define CONFIG_TFM_CONNECTION_BASED_SERVICE_API                  1
+#define CONFIG_TFM_MMIO_REGION_ENABLE                            0
+#define CONFIG_TFM_FLIH_API                                      0
+#define CONFIG_TFM_SLIH_API                                      0
+
+/* SPM has to have its own stack if Trustzone isn't present. */
+#define CONFIG_TFM_SPM_THREAD_STACK_SIZE                         0x4000
+
+#define CONFIG_TFM_AROT_PRESENT                                  0
+
+#endif /* __SPM_HOST_HARNESS_CONFIG_IMPL_H__ */
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host partition IDs */
+
+#ifndef __SPM_HOST_HARNESS_PID_H__
+#define __SPM_HOST_HARNESS_PID_H__
+
+#define TFM_SP_HARNESS_CLIENT        (256)
+#define TFM_SP_HARNESS_SERVICE       (257)
+
+#define TFM_MAX_USER_PARTITIONS      (2)
+
+#endif /* __SPM_HOST_HARNESS_PID_H__ */
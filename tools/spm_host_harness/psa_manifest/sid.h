@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host services, provided by the service partition of the harness */
+
+#ifndef __SPM_HOST_HARNESS_SID_H__
+#define __SPM_HOST_HARNESS_SID_H__
+
+/* Stateless service, reached through its static handle */
+#define HARNESS_STATELESS_SID        (0x0000F000U)
+#define HARNESS_STATELESS_VERSION    (1U)
+#define HARNESS_STATELESS_HANDLE     (0x40000100U)
+
+/* Connection based service */
+#define HARNESS_CONNECTED_SID        (0x0000F001U)
+#define HARNESS_CONNECTED_VERSION    (1U)
+
+#endif /* __SPM_HOST_HARNESS_SID_H__ */
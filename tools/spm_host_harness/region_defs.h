@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host memory layout, the SPM regions are defined by spm_host_platform.c */
+
+#ifndef __SPM_HOST_HARNESS_REGION_DEFS_H__
+#define __SPM_HOST_HARNESS_REGION_DEFS_H__
+
+#endif /* __SPM_HOST_HARNESS_REGION_DEFS_H__ */
@@ -0,0 +1,652 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file spm_host_harness.c
+ *
+ * \brief Host benchmark of the PSA API latencies of the SPM IPC backend.
+ *
+ * \details The SPM core and the IPC backend are built unmodified for the host
+ *          architecture (TFM_ARCH_HOST), where partition threads are host
+ *          execution contexts. Three partitions are loaded by the ROM loader:
+ *          a client, a service partition with one stateless and one
+ *          connection based service, and an idle partition which only runs
+ *          if the other two are blocked. The client measures the latency of
+ *          psa_call() on the stateless service, of psa_connect(), psa_call()
+ *          and psa_close() on the connection based service, and of the
+ *          doorbell signal between the two partitions. The service measures
+ *          psa_read() and psa_write(). The batch workload compares a
+ *          sequence of psa_call() with one tfm_psa_call_batch() of the same
+ *          requests. Every reply is checked, and the average, the
+ *          percentiles and the rate of each operation are reported.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "psa/client.h"
+#include "psa/service.h"
+#include "spm.h"
+#include "tfm_arch.h"
+#include "tfm_psa_call_batch.h"
+#include "load/partition_defs.h"
+#include "load/service_defs.h"
+#include "load/spm_load_api.h"
+#include "psa_manifest/pid.h"
+#include "psa_manifest/sid.h"
+
+/* Signals of the services, the low signals are reserved by the SPM */
+#define HARNESS_STATELESS_SIGNAL    (0x10u)
+#define HARNESS_CONNECTED_SIGNAL    (0x20u)
+
+/* Host stacks also serve the C library, so they are larger than on target */
+#define HARNESS_STACK_SIZE          (0x10000)
+
+/* Largest payload of a call */
+#define HARNESS_MAX_PAYLOAD         (4096)
+
+/* Pattern applied by the service to the payload it echoes */
+#define HARNESS_ECHO_PATTERN        (0xA5u)
+
+struct harness_idle_load_info_t {
+    struct partition_load_info_t    load_info;
+    uintptr_t                       stack_addr;
+    uintptr_t                       heap_addr;
+} __attribute__((aligned(4)));
+
+struct harness_client_load_info_t {
+    struct partition_load_info_t    load_info;
+    uintptr_t                       stack_addr;
+    uintptr_t                       heap_addr;
+    uint32_t                        deps[2];
+} __attribute__((aligned(4)));
+
+struct harness_service_load_info_t {
+    struct partition_load_info_t    load_info;
+    uintptr_t                       stack_addr;
+    uintptr_t                       heap_addr;
+    struct service_load_info_t      services[2];
+} __attribute__((aligned(4)));
+
+/* The partitions loaded by the ROM loader, in the order of a load list */
+struct harness_load_list_t {
+    struct harness_idle_load_info_t     idle;
+    struct harness_client_load_info_t   client;
+    struct harness_service_load_info_t  service;
+};
+
+/* Latency samples of one operation */
+struct harness_samples_t {
+    const char *name;
+    uint64_t *ns;
+    uint32_t num;
+};
+
+enum harness_stat_t {
+    STAT_STATELESS_CALL = 0,
+    STAT_CONNECT,
+    STAT_CONNECTED_CALL,
+    STAT_CLOSE,
+    STAT_PSA_READ,
+    STAT_PSA_WRITE,
+    STAT_SIGNAL,
+    STAT_SIGNAL_ROUND_TRIP,
+    STAT_SINGLE_CALLS,
+    STAT_BATCH_CALL,
+    STAT_NUM
+};
+
+static void idle_main(void);
+static void client_main(void);
+static void service_main(void);
+
+static uint8_t idle_stack[HARNESS_STACK_SIZE] __attribute__((aligned(8)));
+static uint8_t client_stack[HARNESS_STACK_SIZE] __attribute__((aligned(8)));
+static uint8_t service_stack[HARNESS_STACK_SIZE] __attribute__((aligned(8)));
+
+/* Delimited by the linker, see spm_host_platform.c */
+const struct harness_load_list_t harness_load_list
+    __attribute__((used, section("spm_host_load_list"))) = {
+    .idle = {
+        .load_info = {
+            .psa_ff_ver         = 0x0101 | PARTITION_INFO_MAGIC,
+            .pid                = TFM_SP_IDLE,
+            .flags              = PARTITION_MODEL_IPC
+                                | PARTITION_MODEL_PSA_ROT
+                                | PARTITION_PRI_LOWEST,
+            .entry              = ENTRY_TO_POSITION(idle_main),
+            .stack_size         = sizeof(idle_stack),
+        },
+        .stack_addr             = (uintptr_t)idle_stack,
+    },
+    .client = {
+        .load_info = {
+            .psa_ff_ver         = 0x0101 | PARTITION_INFO_MAGIC,
+            .pid                = TFM_SP_HARNESS_CLIENT,
+            .flags              = PARTITION_MODEL_IPC
+                                | PARTITION_MODEL_PSA_ROT
+                                | PARTITION_PRI_NORMAL,
+            .entry              = ENTRY_TO_POSITION(client_main),
+            .stack_size         = sizeof(client_stack),
+            .ndeps              = 2,
+        },
+        .stack_addr             = (uintptr_t)client_stack,
+        .deps = {
+            HARNESS_STATELESS_SID,
+            HARNESS_CONNECTED_SID,
+        },
+    },
+    .service = {
+        .load_info = {
+            .psa_ff_ver         = 0x0101 | PARTITION_INFO_MAGIC,
+            .pid                = TFM_SP_HARNESS_SERVICE,
+            .flags              = PARTITION_MODEL_IPC
+                                | PARTITION_MODEL_PSA_ROT
+                                | PARTITION_PRI_HIGH,
+            .entry              = ENTRY_TO_POSITION(service_main),
+            .stack_size         = sizeof(service_stack),
+            .nservices          = 2,
+        },
+        .stack_addr             = (uintptr_t)service_stack,
+        .services = {
+            {
+                .name_strid     = STRING_PTR_TO_STRID("HARNESS_STATELESS"),
+                .sid            = HARNESS_STATELESS_SID,
+                .flags          = SERVICE_FLAG_STATELESS | 0x0
+                                | SERVICE_VERSION_POLICY_STRICT,
+                .version        = HARNESS_STATELESS_VERSION,
+                .signal         = HARNESS_STATELESS_SIGNAL,
+            },
+            {
+                .name_strid     = STRING_PTR_TO_STRID("HARNESS_CONNECTED"),
+                .sid            = HARNESS_CONNECTED_SID,
+                .flags          = SERVICE_VERSION_POLICY_STRICT,
+                .version        = HARNESS_CONNECTED_VERSION,
+                .signal         = HARNESS_CONNECTED_SIGNAL,
+            },
+        },
+    },
+};
+
+static uint32_t g_num_iterations = 100000;
+static uint32_t g_payload_size = 64;
+static uint32_t g_batch_size = 8;
+static bool g_run_calls = true;
+static bool g_run_connections = true;
+static bool g_run_signals = true;
+static bool g_run_batches = true;
+
+static struct harness_samples_t g_stats[STAT_NUM] = {
+    [STAT_STATELESS_CALL]       = { .name = "psa_call (stateless)" },
+    [STAT_CONNECT]              = { .name = "psa_connect" },
+    [STAT_CONNECTED_CALL]       = { .name = "psa_call (connected)" },
+    [STAT_CLOSE]                = { .name = "psa_close" },
+    [STAT_PSA_READ]             = { .name = "psa_read" },
+    [STAT_PSA_WRITE]            = { .name = "psa_write" },
+    [STAT_SIGNAL]               = { .name = "signal (notify to wake)" },
+    [STAT_SIGNAL_ROUND_TRIP]    = { .name = "signal (round trip)" },
+    [STAT_SINGLE_CALLS]         = { .name = "psa_call x batch size" },
+    [STAT_BATCH_CALL]           = { .name = "tfm_psa_call_batch" },
+};
+
+/* Time the service woke up on the doorbell, for the client to read */
+static uint64_t g_service_wake_ns;
+
+static uint64_t g_num_errors;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void record(enum harness_stat_t stat, uint64_t ns)
+{
+    struct harness_samples_t *p_stat = &g_stats[stat];
+
+    if (p_stat->num < g_num_iterations) {
+        p_stat->ns[p_stat->num++] = ns;
+    }
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const struct harness_samples_t *p_stat,
+                           uint32_t pct)
+{
+    return p_stat->ns[((uint64_t)(p_stat->num - 1) * pct) / 100];
+}
+
+static void print_stats(void)
+{
+    struct harness_samples_t *p_stat;
+    uint64_t total;
+    uint32_t i, j;
+
+    printf("%u iterations, %u byte payload, batch of %u, latencies in ns\n",
+           g_num_iterations, g_payload_size, g_batch_size);
+    printf("%-24s %10s %8s %8s %8s %8s %8s\n", "operation", "ops/s",
+           "mean", "p50", "p90", "p99", "max");
+
+    for (i = 0; i < STAT_NUM; i++) {
+        p_stat = &g_stats[i];
+        if (p_stat->num == 0) {
+            continue;
+        }
+
+        qsort(p_stat->ns, p_stat->num, sizeof(p_stat->ns[0]), compare_u64);
+
+        total = 0;
+        for (j = 0; j < p_stat->num; j++) {
+            total += p_stat->ns[j];
+        }
+        if (total == 0) {
+            total = 1;
+        }
+
+        printf("%-24s %10.0f %8" PRIu64 " %8" PRIu64 " %8" PRIu64
+               " %8" PRIu64 " %8" PRIu64 "\n",
+               p_stat->name, (double)p_stat->num * 1e9 / (double)total,
+               total / p_stat->num, percentile(p_stat, 50),
+               percentile(p_stat, 90), percentile(p_stat, 99),
+               p_stat->ns[p_stat->num - 1]);
+    }
+}
+
+/* Read the payload, echo it with the pattern applied, and reply */
+static void serve_call(const psa_msg_t *p_msg)
+{
+    static uint8_t buf[HARNESS_MAX_PAYLOAD];
+    psa_status_t status = PSA_SUCCESS;
+    size_t len, i;
+    uint64_t t0, t1, t2;
+
+    if ((p_msg->in_size[0] > sizeof(buf)) ||
+        (p_msg->out_size[0] < p_msg->in_size[0])) {
+        psa_reply(p_msg->handle, PSA_ERROR_PROGRAMMER_ERROR);
+        return;
+    }
+
+    t0 = now_ns();
+    len = psa_read(p_msg->handle, 0, buf, p_msg->in_size[0]);
+    t1 = now_ns();
+
+    if (len != p_msg->in_size[0]) {
+        status = PSA_ERROR_GENERIC_ERROR;
+    }
+
+    for (i = 0; i < len; i++) {
+        buf[i] ^= HARNESS_ECHO_PATTERN;
+    }
+
+    t2 = now_ns();
+    psa_write(p_msg->handle, 0, buf, len);
+    record(STAT_PSA_WRITE, now_ns() - t2);
+    record(STAT_PSA_READ, t1 - t0);
+
+    psa_reply(p_msg->handle, status);
+}
+
+static void service_main(void)
+{
+    psa_signal_t signals;
+    psa_msg_t msg;
+
+    while (1) {
+        signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
+
+        if (signals & PSA_DOORBELL) {
+            g_service_wake_ns = now_ns();
+            psa_clear();
+            psa_notify(TFM_SP_HARNESS_CLIENT);
+        }
+
+        if (signals & HARNESS_STATELESS_SIGNAL) {
+            if (psa_get(HARNESS_STATELESS_SIGNAL, &msg) != PSA_SUCCESS) {
+                psa_panic();
+            }
+            serve_call(&msg);
+        }
+
+        if (signals & HARNESS_CONNECTED_SIGNAL) {
+            if (psa_get(HARNESS_CONNECTED_SIGNAL, &msg) != PSA_SUCCESS) {
+                psa_panic();
+            }
+
+            switch (msg.type) {
+            case PSA_IPC_CONNECT:
+            case PSA_IPC_DISCONNECT:
+                psa_reply(msg.handle, PSA_SUCCESS);
+                break;
+            case PSA_IPC_CALL:
+                serve_call(&msg);
+                break;
+            default:
+                psa_reply(msg.handle, PSA_ERROR_NOT_SUPPORTED);
+                break;
+            }
+        }
+    }
+}
+
+/* Check the status and the echo of one call */
+static void check_echo(psa_status_t status, const psa_outvec *p_out_vec,
+                       const uint8_t *p_in)
+{
+    const uint8_t *p_out = p_out_vec->base;
+    uint32_t i;
+
+    if ((status != PSA_SUCCESS) || (p_out_vec->len != g_payload_size)) {
+        g_num_errors++;
+        return;
+    }
+
+    for (i = 0; i < g_payload_size; i++) {
+        if (p_out[i] != (uint8_t)(p_in[i] ^ HARNESS_ECHO_PATTERN)) {
+            g_num_errors++;
+            return;
+        }
+    }
+}
+
+/* Call a service with the payload and check the echo */
+static uint64_t timed_call(psa_handle_t handle, const uint8_t *p_in,
+                           uint8_t *p_out)
+{
+    psa_invec in_vec[] = { { p_in, g_payload_size } };
+    psa_outvec out_vec[] = { { p_out, g_payload_size } };
+    psa_status_t status;
+    uint64_t t0, t1;
+
+    memset(p_out, 0, g_payload_size);
+
+    t0 = now_ns();
+    status = psa_call(handle, PSA_IPC_CALL, in_vec, 1, out_vec, 1);
+    t1 = now_ns();
+
+    check_echo(status, &out_vec[0], p_in);
+
+    return t1 - t0;
+}
+
+static void run_stateless_calls(const uint8_t *p_in, uint8_t *p_out)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_num_iterations; i++) {
+        record(STAT_STATELESS_CALL,
+               timed_call(HARNESS_STATELESS_HANDLE, p_in, p_out));
+    }
+}
+
+static void run_connections(const uint8_t *p_in, uint8_t *p_out)
+{
+    psa_handle_t handle;
+    uint64_t t0, t1;
+    uint32_t i;
+
+    for (i = 0; i < g_num_iterations; i++) {
+        t0 = now_ns();
+        handle = psa_connect(HARNESS_CONNECTED_SID, HARNESS_CONNECTED_VERSION);
+        t1 = now_ns();
+        record(STAT_CONNECT, t1 - t0);
+
+        if (handle <= 0) {
+            g_num_errors++;
+            continue;
+        }
+
+        record(STAT_CONNECTED_CALL, timed_call(handle, p_in, p_out));
+
+        t0 = now_ns();
+        psa_close(handle);
+        t1 = now_ns();
+        record(STAT_CLOSE, t1 - t0);
+    }
+}
+
+static void run_signals(void)
+{
+    psa_signal_t signals;
+    uint64_t t0, t1;
+    uint32_t i;
+
+    for (i = 0; i < g_num_iterations; i++) {
+        t0 = now_ns();
+        psa_notify(TFM_SP_HARNESS_SERVICE);
+        signals = psa_wait(PSA_DOORBELL, PSA_BLOCK);
+        t1 = now_ns();
+
+        if (signals != PSA_DOORBELL) {
+            g_num_errors++;
+            continue;
+        }
+        psa_clear();
+
+        record(STAT_SIGNAL, g_service_wake_ns - t0);
+        record(STAT_SIGNAL_ROUND_TRIP, t1 - t0);
+    }
+}
+
+/*
+ * Issue the same requests to the stateless service as a sequence of
+ * psa_call() and as one tfm_psa_call_batch(). Each sample is the time of
+ * the whole sequence or batch.
+ */
+static void run_batches(const uint8_t *p_in, uint8_t *p_out)
+{
+    struct tfm_psa_call_desc_t descs[TFM_PSA_CALL_BATCH_MAX_NUM];
+    psa_invec in_vec[] = { { p_in, g_payload_size } };
+    psa_outvec out_vecs[TFM_PSA_CALL_BATCH_MAX_NUM];
+    psa_status_t status;
+    uint64_t t0, t1;
+    uint32_t i, j;
+
+    for (j = 0; j < g_batch_size; j++) {
+        out_vecs[j].base = p_out + j * g_payload_size;
+        descs[j].handle  = HARNESS_STATELESS_HANDLE;
+        descs[j].type    = PSA_IPC_CALL;
+        descs[j].in_vec  = in_vec;
+        descs[j].in_len  = 1;
+        descs[j].out_vec = &out_vecs[j];
+        descs[j].out_len = 1;
+    }
+
+    for (i = 0; i < g_num_iterations; i++) {
+        for (j = 0; j < g_batch_size; j++) {
+            out_vecs[j].len = g_payload_size;
+        }
+
+        t0 = now_ns();
+        for (j = 0; j < g_batch_size; j++) {
+            descs[j].status = psa_call(HARNESS_STATELESS_HANDLE, PSA_IPC_CALL,
+                                       in_vec, 1, &out_vecs[j], 1);
+        }
+        t1 = now_ns();
+        record(STAT_SINGLE_CALLS, t1 - t0);
+
+        for (j = 0; j < g_batch_size; j++) {
+            check_echo(descs[j].status, &out_vecs[j], p_in);
+            out_vecs[j].len = g_payload_size;
+            descs[j].status = PSA_ERROR_GENERIC_ERROR;
+        }
+
+        t0 = now_ns();
+        status = tfm_psa_call_batch(descs, g_batch_size);
+        t1 = now_ns();
+        record(STAT_BATCH_CALL, t1 - t0);
+
+        if (status != PSA_SUCCESS) {
+            g_num_errors++;
+            continue;
+        }
+
+        for (j = 0; j < g_batch_size; j++) {
+            check_echo(descs[j].status, &out_vecs[j], p_in);
+        }
+    }
+}
+
+static void client_main(void)
+{
+    static uint8_t in[HARNESS_MAX_PAYLOAD];
+    static uint8_t out[HARNESS_MAX_PAYLOAD * TFM_PSA_CALL_BATCH_MAX_NUM];
+    uint32_t i;
+
+    for (i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    if (g_run_calls) {
+        run_stateless_calls(in, out);
+    }
+
+    if (g_run_connections) {
+        run_connections(in, out);
+    }
+
+    if (g_run_signals) {
+        run_signals();
+    }
+
+    if (g_run_batches) {
+        run_batches(in, out);
+    }
+
+    print_stats();
+
+    if (g_num_errors != 0) {
+        printf("%" PRIu64 " errors\n", g_num_errors);
+        exit(EXIT_FAILURE);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+/* Only scheduled when both partitions are blocked, which is a deadlock */
+static void idle_main(void)
+{
+    printf("All partitions are blocked\n");
+    exit(EXIT_FAILURE);
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [options]\n"
+           "  -n <num>     Iterations of each operation (default %u)\n"
+           "  -s <bytes>   Payload of the calls, up to %u (default %u)\n"
+           "  -b <num>     Requests of a batch, up to %u (default %u)\n"
+           "  -w <list>    Comma separated workloads among 'call',\n"
+           "               'connection', 'signal' and 'batch' (default all)\n"
+           "  -h           Show this help\n",
+           prog, g_num_iterations, HARNESS_MAX_PAYLOAD, g_payload_size,
+           TFM_PSA_CALL_BATCH_MAX_NUM, g_batch_size);
+}
+
+static bool parse_workloads(char *list)
+{
+    char *name;
+
+    g_run_calls = false;
+    g_run_connections = false;
+    g_run_signals = false;
+    g_run_batches = false;
+
+    for (name = strtok(list, ","); name != NULL; name = strtok(NULL, ",")) {
+        if (strcmp(name, "call") == 0) {
+            g_run_calls = true;
+        } else if (strcmp(name, "connection") == 0) {
+            g_run_connections = true;
+        } else if (strcmp(name, "signal") == 0) {
+            g_run_signals = true;
+        } else if (strcmp(name, "batch") == 0) {
+            g_run_batches = true;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* The load information must be laid out as the ROM loader walks it */
+static bool load_list_is_valid(void)
+{
+    return (LOAD_INFSZ_BYTES(&harness_load_list.idle.load_info) ==
+            sizeof(harness_load_list.idle)) &&
+           (LOAD_INFSZ_BYTES(&harness_load_list.client.load_info) ==
+            sizeof(harness_load_list.client)) &&
+           (LOAD_INFSZ_BYTES(&harness_load_list.service.load_info) ==
+            sizeof(harness_load_list.service));
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:b:w:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            g_num_iterations = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            g_payload_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'b':
+            g_batch_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            if (!parse_workloads(optarg)) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if ((g_num_iterations == 0) || (g_payload_size == 0) ||
+        (g_payload_size > HARNESS_MAX_PAYLOAD) || (g_batch_size == 0) ||
+        (g_batch_size > TFM_PSA_CALL_BATCH_MAX_NUM)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!load_list_is_valid()) {
+        printf("Unexpected layout of the partition load information\n");
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < STAT_NUM; i++) {
+        g_stats[i].ns = calloc(g_num_iterations, sizeof(uint64_t));
+        if (g_stats[i].ns == NULL) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* As the SPM initialization SVC does, then enter the first thread */
+    tfm_arch_free_msp_and_exc_ret(0, tfm_spm_init());
+
+    /* Not reached, the client ends the process */
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host platform of the SPM: memory regions and HAL */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fih.h"
+#include "spm.h"
+#include "tfm_hal_defs.h"
+#include "tfm_hal_isolation.h"
+#include "tfm_hal_platform.h"
+#include "tfm_nspm.h"
+#include "tfm_plat_otp.h"
+#include "load/partition_defs.h"
+#include "load/service_defs.h"
+
+/*
+ * Runtime pools for the partitions and services of the harness. The build
+ * defines the region symbols of the ROM loader on the section bounds.
+ */
+#define HARNESS_PARTITION_NUM    (3)
+#define HARNESS_SERVICE_NUM      (2)
+
+static struct partition_t part_rt_pool[HARNESS_PARTITION_NUM]
+    __attribute__((used, section("spm_host_part_rt_pool")));
+static struct service_t serv_rt_pool[HARNESS_SERVICE_NUM]
+    __attribute__((used, section("spm_host_serv_rt_pool")));
+
+/* Isolation level 1, with every partition in the same boundary */
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_bind_boundary(
+                                    const struct partition_load_info_t *p_ldinf,
+                                    uintptr_t *p_boundary)
+{
+    (void)p_ldinf;
+
+    *p_boundary = 0;
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_activate_boundary(
+                            const struct partition_load_info_t *p_ldinf,
+                            uintptr_t boundary)
+{
+    (void)p_ldinf;
+    (void)boundary;
+
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+FIH_RET_TYPE(bool) tfm_hal_boundary_need_switch(uintptr_t boundary_from,
+                                                uintptr_t boundary_to)
+{
+    (void)boundary_from;
+    (void)boundary_to;
+
+    FIH_RET(fih_int_encode(false));
+}
+
+/* All of the process memory is accessible */
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_memory_check(
+                                           uintptr_t boundary, uintptr_t base,
+                                           size_t size, uint32_t access_type)
+{
+    (void)boundary;
+    (void)access_type;
+
+    if ((base == 0) && (size != 0)) {
+        FIH_RET(fih_int_encode(TFM_HAL_ERROR_MEM_FAULT));
+    }
+
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+/* Reached on a core panic, CONFIG_TFM_HALT_ON_CORE_PANIC is set */
+void tfm_hal_system_halt(void)
+{
+    fprintf(stderr, "SPM panic\n");
+    abort();
+}
+
+/* There is no non-secure client on the host */
+void tfm_nspm_ctx_init(void)
+{
+}
+
+int32_t tfm_nspm_get_current_client_id(void)
+{
+    return 0;
+}
+
+enum tfm_plat_err_t tfm_plat_otp_read(enum tfm_otp_element_id_t id,
+                                      size_t out_len, uint8_t *out)
+{
+    enum plat_otp_lcs_t lcs = PLAT_OTP_LCS_SECURED;
+
+    if ((id != PLAT_OTP_ID_LCS) || (out_len < sizeof(lcs))) {
+        return TFM_PLAT_ERR_UNSUPPORTED;
+    }
+
+    *(enum plat_otp_lcs_t *)out = lcs;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
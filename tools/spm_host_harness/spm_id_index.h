@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host ID lookup lists, in place of the generated spm_id_index.h */
+
+#ifndef __SPM_HOST_HARNESS_SPM_ID_INDEX_H__
+#define __SPM_HOST_HARNESS_SPM_ID_INDEX_H__
+
+#include "psa_manifest/pid.h"
+#include "psa_manifest/sid.h"
+
+#define SPM_SERVICE_INDEX_NUM                                    2
+#define SPM_SORTED_SID_LIST \
+    HARNESS_STATELESS_SID, \
+    HARNESS_CONNECTED_SID, \
+
+#define SPM_PARTITION_INDEX_NUM                                  3
+#define SPM_SORTED_PID_LIST \
+    (TFM_SP_IDLE), \
+    (TFM_SP_HARNESS_CLIENT), \
+    (TFM_SP_HARNESS_SERVICE), \
+
+#endif /* __SPM_HOST_HARNESS_SPM_ID_INDEX_H__ */
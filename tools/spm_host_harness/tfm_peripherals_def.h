@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* The host has no peripherals */
+
+#ifndef __SPM_HOST_HARNESS_TFM_PERIPHERALS_DEF_H__
+#define __SPM_HOST_HARNESS_TFM_PERIPHERALS_DEF_H__
+
+#endif /* __SPM_HOST_HARNESS_TFM_PERIPHERALS_DEF_H__ */
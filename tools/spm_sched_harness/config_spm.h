@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host configuration of the SPM thread module */
+
+#ifndef __SPM_SCHED_HARNESS_CONFIG_SPM_H__
+#define __SPM_SCHED_HARNESS_CONFIG_SPM_H__
+
+/* CONFIG_TFM_SPM_SCHED_BITMAP is set by the build of each harness */
+#ifndef CONFIG_TFM_SPM_SCHED_BITMAP
+#define CONFIG_TFM_SPM_SCHED_BITMAP    0
+#endif
+
+#endif /* __SPM_SCHED_HARNESS_CONFIG_SPM_H__ */
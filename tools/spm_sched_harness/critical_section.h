@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host definitions of the SPM critical section, the harness is single thread */
+
+#ifndef __SPM_SCHED_HARNESS_CRITICAL_SECTION_H__
+#define __SPM_SCHED_HARNESS_CRITICAL_SECTION_H__
+
+struct critical_section_t {
+    int unused;
+};
+
+#define CRITICAL_SECTION_STATIC_INIT    {0}
+#define CRITICAL_SECTION_ENTER(cs)      ((void)(cs))
+#define CRITICAL_SECTION_LEAVE(cs)      ((void)(cs))
+
+#endif /* __SPM_SCHED_HARNESS_CRITICAL_SECTION_H__ */
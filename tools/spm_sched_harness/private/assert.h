@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host definition of the SPM assertion */
+
+#ifndef __SPM_SCHED_HARNESS_ASSERT_H__
+#define __SPM_SCHED_HARNESS_ASSERT_H__
+
+#include <assert.h>
+
+#define SPM_ASSERT(cond)    assert(cond)
+
+#endif /* __SPM_SCHED_HARNESS_ASSERT_H__ */
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host partition IDs, only the number of partitions is used */
+
+#ifndef __SPM_SCHED_HARNESS_PID_H__
+#define __SPM_SCHED_HARNESS_PID_H__
+
+/* TFM_MAX_USER_PARTITIONS is set by the build of each harness */
+#ifndef TFM_MAX_USER_PARTITIONS
+#define TFM_MAX_USER_PARTITIONS    (62)
+#endif
+
+#endif /* __SPM_SCHED_HARNESS_PID_H__ */
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file spm_sched_harness.c
+ *
+ * \brief Host benchmark of the cost of the SPM scheduler pick.
+ *
+ * \details The SPM thread module is built on the host, with or without the
+ *          ready bitmap (CONFIG_TFM_SPM_SCHED_BITMAP). The harness starts a
+ *          number of partition threads of distinct priorities and an idle
+ *          thread of the lowest priority which is always runnable, then
+ *          plays rounds in which a few random partitions get a signal. The
+ *          scheduler is called until it picks the idle thread again, and each
+ *          partition it picks runs and waits for a signal again, as in the
+ *          IPC backend. Every pick is checked against the highest priority
+ *          thread which can run, and the average time taken by thrd_next() is
+ *          reported.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "thread.h"
+#include "utilities.h"
+#include "psa_manifest/pid.h"
+
+/* The idle thread takes one of the two slots not used by user partitions */
+#define MAX_PARTITIONS    (TFM_MAX_USER_PARTITIONS + 1)
+
+/* Signal asserted to wake a partition up */
+#define WAKE_SIGNAL       (1u)
+
+struct partition_t {
+    struct thread_t thrd;
+    struct context_ctrl_t ctx_ctrl;
+    uint32_t signals_waiting;
+    uint32_t signals_asserted;
+};
+
+/* Partitions by decreasing priority, the last one is the idle thread */
+static struct partition_t g_partitions[MAX_PARTITIONS + 1];
+static uint32_t g_num_partitions = 8;
+static uint32_t g_num_rounds = 1000000;
+static uint32_t g_max_wakeups = 3;
+static unsigned int g_seed = 1;
+
+static uint64_t g_num_picks;
+static uint64_t g_pick_time_ns;
+static uint64_t g_num_errors;
+
+/* Entry of the threads, never run on the host */
+static void partition_entry(void *param)
+{
+    (void)param;
+}
+
+/* Same logic as the query callback of the IPC backend */
+static uint32_t query_state(const struct thread_t *p_thrd, uint32_t *p_retval)
+{
+    struct partition_t *p_pt = TO_CONTAINER(p_thrd->p_context_ctrl,
+                                            struct partition_t, ctx_ctrl);
+    uint32_t signals = p_pt->signals_waiting & p_pt->signals_asserted;
+
+    if (signals != 0) {
+        p_pt->signals_waiting = 0;
+        p_pt->signals_asserted &= ~signals;
+        *p_retval = signals;
+        return THRD_STATE_RET_VAL_AVAIL;
+    }
+
+    if (p_pt->signals_waiting != 0) {
+        return THRD_STATE_BLOCK;
+    }
+
+    return p_thrd->state;
+}
+
+/* Same logic as backend_assert_signal() */
+static void assert_signal(struct partition_t *p_pt, uint32_t signal)
+{
+    p_pt->signals_asserted |= signal;
+
+    if (p_pt->signals_asserted & p_pt->signals_waiting) {
+        THRD_MARK_READY(&p_pt->thrd);
+    }
+}
+
+/* Same logic as backend_wait_signals() */
+static void wait_signals(struct partition_t *p_pt, uint32_t signals)
+{
+    if ((p_pt->signals_asserted & signals) == 0) {
+        p_pt->signals_waiting = signals;
+        THRD_MARK_BLOCKED(&p_pt->thrd);
+    }
+}
+
+/* The highest priority thread which can run */
+static struct thread_t *expected_next(void)
+{
+    struct partition_t *p_pt;
+    uint32_t i;
+
+    for (i = 0; i < g_num_partitions; i++) {
+        p_pt = &g_partitions[i];
+        if ((p_pt->signals_waiting == 0) ||
+            (p_pt->signals_waiting & p_pt->signals_asserted)) {
+            return &p_pt->thrd;
+        }
+    }
+
+    return &g_partitions[g_num_partitions].thrd;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Time taken by a call to now_ns(), which each measure includes */
+static uint64_t timer_overhead_ns(void)
+{
+    const uint32_t num_samples = 100000;
+    uint64_t start = now_ns();
+    uint32_t i;
+
+    for (i = 0; i < num_samples; i++) {
+        (void)now_ns();
+    }
+
+    return (now_ns() - start) / num_samples;
+}
+
+/* Calls the scheduler until it picks the idle thread */
+static void schedule_until_idle(uint64_t overhead_ns)
+{
+    struct thread_t *p_idle = &g_partitions[g_num_partitions].thrd;
+    struct thread_t *p_expected;
+    struct thread_t *p_thrd;
+    uint64_t start;
+    uint64_t elapsed;
+
+    do {
+        p_expected = expected_next();
+
+        start = now_ns();
+        p_thrd = thrd_next();
+        elapsed = now_ns() - start;
+
+        g_pick_time_ns += (elapsed > overhead_ns) ? (elapsed - overhead_ns) : 0;
+        g_num_picks++;
+
+        if (p_thrd != p_expected) {
+            g_num_errors++;
+            return;
+        }
+
+        /* The partition runs and waits for the next signal */
+        if (p_thrd != p_idle) {
+            wait_signals(TO_CONTAINER(p_thrd->p_context_ctrl,
+                                      struct partition_t, ctx_ctrl),
+                         WAKE_SIGNAL);
+        }
+    } while (p_thrd != p_idle);
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [options]\n"
+           "  -p <num>  Number of partitions, idle thread excluded (default 8, at most %d)\n"
+           "  -n <num>  Number of rounds (default 1000000)\n"
+           "  -w <num>  Maximum number of partitions woken up per round (default 3)\n"
+           "  -s <num>  Random seed (default 1)\n"
+           "  -h        Print this help\n",
+           prog, MAX_PARTITIONS);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t overhead_ns;
+    uint32_t num_wakeups;
+    uint32_t round;
+    uint32_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:n:w:s:h")) != -1) {
+        switch (opt) {
+        case 'p':
+            g_num_partitions = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            g_num_rounds = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            g_max_wakeups = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            g_seed = (unsigned int)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if ((g_num_partitions == 0) || (g_num_partitions > MAX_PARTITIONS) ||
+        (g_max_wakeups == 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    thrd_set_query_callback(query_state);
+
+    /* Started in the reverse order to exercise the insertion by priority */
+    for (i = g_num_partitions + 1; i-- > 0;) {
+        THRD_INIT(&g_partitions[i].thrd, &g_partitions[i].ctx_ctrl,
+                  (i < g_num_partitions) ? (2 * i + 1) : THRD_PRIOR_LOWEST);
+        thrd_start(&g_partitions[i].thrd, partition_entry, THRD_GENERAL_EXIT,
+                   NULL);
+    }
+
+    (void)thrd_start_scheduler(&CURRENT_THREAD);
+
+    overhead_ns = timer_overhead_ns();
+
+    /* All the partitions run until they wait for a signal */
+    schedule_until_idle(overhead_ns);
+    g_num_picks = 0;
+    g_pick_time_ns = 0;
+
+    for (round = 0; (round < g_num_rounds) && (g_num_errors == 0); round++) {
+        num_wakeups = 1 + (uint32_t)rand_r(&g_seed) % g_max_wakeups;
+        while (num_wakeups-- > 0) {
+            assert_signal(&g_partitions[(uint32_t)rand_r(&g_seed) %
+                                        g_num_partitions],
+                          WAKE_SIGNAL);
+        }
+
+        schedule_until_idle(overhead_ns);
+    }
+
+    printf("%s scheduler, %" PRIu32 " partitions: %" PRIu64 " picks, "
+           "%.1f ns per pick, %" PRIu64 " errors\n",
+           (CONFIG_TFM_SPM_SCHED_BITMAP == 1) ? "bitmap" : "list",
+           g_num_partitions, g_num_picks,
+           (g_num_picks != 0) ? ((double)g_pick_time_ns / g_num_picks) : 0.0,
+           g_num_errors);
+
+    return (g_num_errors == 0) ? 0 : 1;
+}
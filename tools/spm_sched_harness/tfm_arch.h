@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host definitions of the architecture interfaces used by the thread module */
+
+#ifndef __SPM_SCHED_HARNESS_TFM_ARCH_H__
+#define __SPM_SCHED_HARNESS_TFM_ARCH_H__
+
+#include <stdint.h>
+
+#define __CLZ(x)            ((uint32_t)__builtin_clz(x))
+
+struct context_ctrl_t {
+    uint32_t ret_code;    /* Last return code set by the scheduler */
+};
+
+static inline void tfm_arch_set_context_ret_code(
+                                        const struct context_ctrl_t *p_ctx_ctrl,
+                                        uint32_t ret_code)
+{
+    ((struct context_ctrl_t *)p_ctx_ctrl)->ret_code = ret_code;
+}
+
+static inline void tfm_arch_init_context(struct context_ctrl_t *p_ctx_ctrl,
+                                         uintptr_t pfn, void *param,
+                                         uintptr_t pfnlr)
+{
+    (void)pfn;
+    (void)param;
+    (void)pfnlr;
+
+    p_ctx_ctrl->ret_code = 0;
+}
+
+static inline uint32_t tfm_arch_refresh_hardware_context(
+                                        const struct context_ctrl_t *p_ctx_ctrl)
+{
+    (void)p_ctx_ctrl;
+
+    return 0;
+}
+
+static inline uint32_t arch_attempt_schedule(void)
+{
+    return 0;
+}
+
+#endif /* __SPM_SCHED_HARNESS_TFM_ARCH_H__ */
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host definitions of the SPM utilities */
+
+#ifndef __SPM_SCHED_HARNESS_UTILITIES_H__
+#define __SPM_SCHED_HARNESS_UTILITIES_H__
+
+#include <stddef.h>
+
+#define TO_CONTAINER(ptr, type, member) \
+    ((type *)((unsigned long)(ptr) - offsetof(type, member)))
+
+#endif /* __SPM_SCHED_HARNESS_UTILITIES_H__ */
@@ -0,0 +1,184 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2026, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Decode SPM trace records drained by tfm_spm_trace_drain().
+
+The input is either the raw records (16 bytes each, little endian) or the same
+bytes dumped as hexadecimal text, for example from a debug log. Each psa_call()
+is followed from its SPM_TRACE_PSA_CALL record to the SPM_TRACE_REPLYING
+record of the same client, then a latency histogram and a per-stage breakdown
+are printed for every SID.
+"""
+
+import argparse
+import logging
+import re
+import struct
+import sys
+from collections import defaultdict
+
+logging.basicConfig(level=logging.INFO, format='%(message)s')
+logger = logging.getLogger(__name__)
+
+# Must match secure_fw/spm/include/spm_trace.h
+SPM_TRACE_PSA_CALL    = 1
+SPM_TRACE_CALL_PARAMS = 2
+SPM_TRACE_MESSAGING   = 3
+SPM_TRACE_PSA_GET     = 4
+SPM_TRACE_PSA_REPLY   = 5
+SPM_TRACE_REPLYING    = 6
+SPM_TRACE_SCHEDULE    = 7
+SPM_TRACE_LOST        = 255
+
+REC_FORMAT = '<IIiI'
+REC_SIZE = struct.calcsize(REC_FORMAT)
+
+STAGES = [
+    (SPM_TRACE_PSA_CALL,    'call'),
+    (SPM_TRACE_CALL_PARAMS, 'params'),
+    (SPM_TRACE_MESSAGING,   'messaging'),
+    (SPM_TRACE_PSA_GET,     'get'),
+    (SPM_TRACE_PSA_REPLY,   'service'),
+    (SPM_TRACE_REPLYING,    'reply'),
+]
+
+COUNTER_MASK = 0xFFFFFFFF
+
+def load_records(path):
+    """
+    Read the trace file, accept raw binary or hexadecimal text
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    try:
+        text = data.decode('ascii')
+        if re.fullmatch(r'[0-9a-fA-Fx\s,:]*', text):
+            text = re.sub(r'0x', '', text)
+            data = bytes.fromhex(re.sub(r'[\s,:]', '', text))
+    except (UnicodeDecodeError, ValueError):
+        pass
+
+    if len(data) % REC_SIZE:
+        logger.warning('Ignoring {} trailing bytes'.format(len(data) % REC_SIZE))
+
+    return [struct.unpack_from(REC_FORMAT, data, off)
+            for off in range(0, len(data) - REC_SIZE + 1, REC_SIZE)]
+
+def elapsed(start, end):
+    """
+    The counter is 32 bits and free running
+    """
+    return (end - start) & COUNTER_MASK
+
+def collect_calls(records):
+    """
+    Pair the records of each client into complete calls. A call is a list of
+    (point, cycles) tuples and the SID it targets.
+    """
+    calls = []
+    pending = {}
+    lost = 0
+
+    for cycles, point, client_id, sid in records:
+        if point == SPM_TRACE_LOST:
+            # Calls in flight may have lost some of their records
+            lost += sid
+            pending.clear()
+            continue
+
+        if point == SPM_TRACE_SCHEDULE:
+            continue
+
+        if point == SPM_TRACE_PSA_CALL:
+            pending[client_id] = {'sid': None, 'points': [(point, cycles)]}
+            continue
+
+        call = pending.get(client_id)
+        if call is None:
+            continue
+
+        if sid:
+            call['sid'] = sid
+        call['points'].append((point, cycles))
+
+        if point == SPM_TRACE_REPLYING:
+            del pending[client_id]
+            if call['sid'] is not None:
+                calls.append(call)
+
+    return calls, lost, len(pending)
+
+def print_histogram(latencies):
+    """
+    Histogram with power-of-two buckets
+    """
+    buckets = defaultdict(int)
+    for lat in latencies:
+        buckets[lat.bit_length()] += 1
+
+    width = max(buckets.values())
+    for order in sorted(buckets):
+        low = (1 << (order - 1)) if order else 0
+        high = (1 << order) - 1
+        bar = '#' * max(1, buckets[order] * 40 // width)
+        logger.info('    {:>10} - {:<10} {:>6} {}'.format(low, high,
+                                                        buckets[order], bar))
+
+def print_stages(calls):
+    """
+    Average cycles spent between consecutive trace points
+    """
+    sums = defaultdict(int)
+    counts = defaultdict(int)
+
+    for call in calls:
+        points = dict(call['points'])
+        for (start, _), (end, name) in zip(STAGES, STAGES[1:]):
+            if start in points and end in points:
+                sums[name] += elapsed(points[start], points[end])
+                counts[name] += 1
+
+    for _, name in STAGES[1:]:
+        if counts[name]:
+            logger.info('    {:<10} {:>10}'.format(name,
+                                                   sums[name] // counts[name]))
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode SPM trace records')
+    parser.add_argument('trace', help='Raw or hexadecimal trace dump')
+    args = parser.parse_args()
+
+    records = load_records(args.trace)
+    calls, lost, incomplete = collect_calls(records)
+
+    logger.info('{} records, {} complete calls'.format(len(records), len(calls)))
+    if lost:
+        logger.info('{} records were overwritten before being drained'.format(lost))
+    if incomplete:
+        logger.info('{} calls still in flight at the end of the trace'.format(incomplete))
+
+    by_sid = defaultdict(list)
+    for call in calls:
+        by_sid[call['sid']].append(call)
+
+    for sid in sorted(by_sid):
+        latencies = [elapsed(c['points'][0][1], c['points'][-1][1])
+                     for c in by_sid[sid]]
+        logger.info('')
+        logger.info('SID 0x{:08x}: {} calls, min {} avg {} max {} cycles'.format(
+                    sid, len(latencies), min(latencies),
+                    sum(latencies) // len(latencies), max(latencies)))
+        print_histogram(latencies)
+        logger.info('  Average per stage:')
+        print_stages(by_sid[sid])
+
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -31,6 +31,10 @@ OUT_DIR = None # The root directory that files are generated to
 # PID[0, TFM_PID_BASE - 1] are reserved for TF-M SPM and test usages
 TFM_PID_BASE = 256
 
+# TF-M internal partitions which are not described by manifest lists
+TFM_BUILTIN_PARTITIONS = [{'name': 'TFM_SP_IDLE',     'pid': 1},
+                          {'name': 'TFM_SP_TZ_AGENT', 'pid': 2}]
+
 # variable for checking for duplicated sid
 sid_list = []
 
@@ -531,6 +535,8 @@ def process_partition_manifests(manifest_lists, configs):
     context['partitions'] = partition_list
     context['config_impl'] = config_impl
     context['stateless_services'] = process_stateless_services(partition_list)
+    context['sorted_services'], context['sorted_partitions'] = \
+        process_id_index(partition_list)
 
     return context
 
@@ -718,6 +724,41 @@ def process_stateless_services(partitions):
 
     return reordered_stateless_services
 
+def process_id_index(partitions):
+    """
+    This function builds the SID and PID index tables used by SPM for the
+    service and partition lookups. Both lists are sorted by ID so that SPM can
+    do a bounded binary search on read-only data, and the position in the list
+    is the index of the runtime object.
+    """
+
+    sorted_services = []
+    sorted_partitions = TFM_BUILTIN_PARTITIONS.copy()
+
+    for partition in partitions:
+        sorted_partitions.append({'name': partition['manifest']['name'],
+                                  'pid': int(str(partition['attr']['pid']), 0)})
+
+        for service in partition['manifest'].get('services', []):
+            sorted_services.append({'name': service['name'],
+                                    'sid': int(str(service['sid']), 0)})
+
+    sorted_services.sort(key=lambda srv: srv['sid'])
+    sorted_partitions.sort(key=lambda pt: pt['pid'])
+
+    # The tables must be collision-free for the lookups to be exact
+    for i in range(1, len(sorted_services)):
+        if sorted_services[i]['sid'] == sorted_services[i - 1]['sid']:
+            raise Exception('Service ID: 0x{:08x} has duplications!'
+                            .format(sorted_services[i]['sid']))
+
+    for i in range(1, len(sorted_partitions)):
+        if sorted_partitions[i]['pid'] == sorted_partitions[i - 1]['pid']:
+            raise Exception('PID No. {} has already been used!'
+                            .format(sorted_partitions[i]['pid']))
+
+    return sorted_services, sorted_partitions
+
 def parse_args():
     parser = argparse.ArgumentParser(description='Parse secure partition manifest list and generate files listed by the file list',
                                      epilog='Note that environment variables in template files will be replaced with their values',